@@ -20,12 +20,18 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fcntl.h>
 #include <functional>
+#include <memory>
+#include <new>
 #include <string>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 #include "nogdb/nogdb.h"
@@ -46,6 +52,25 @@ struct BenchResult {
     double perIterUs;
 };
 
+// ---------------------------------------------------------------------------
+// Allocation counting
+// ---------------------------------------------------------------------------
+
+static std::atomic<unsigned long> allocationCount { 0 };
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
 static double nsToMs(long long ns) { return static_cast<double>(ns) / 1e6; }
 static double nsToUs(long long ns) { return static_cast<double>(ns) / 1e3; }
 
@@ -119,6 +144,33 @@ static void bench_vertex_insert(nogdb::Context& ctx, std::vector<BenchResult>& r
     });
     results.push_back(r);
 
+    // The same single-vertex writes from concurrent clients, committed in groups by the batch writer
+    const unsigned int CLIENTS = 8;
+    std::atomic<unsigned long> group_counter { 0 };
+    auto r1 = runBench("vertex insert (10k, 8 clients, group commit)", 1, [&] {
+        std::vector<std::thread> clients;
+        for (unsigned int c = 0; c < CLIENTS; ++c) {
+            clients.emplace_back([&] {
+                for (unsigned long i = 0; i < N / CLIENTS; ++i) {
+                    auto value = group_counter++;
+                    ctx.beginBatchTxn()
+                        .addVertex("Person",
+                            nogdb::Record {}
+                                .set("name", std::string("group_") + std::to_string(value))
+                                .set("age", int32_t(value % 100)))
+                        .commit()
+                        .get();
+                }
+            });
+        }
+        for (auto& client : clients) {
+            client.join();
+        }
+    });
+    r1.iterations = N;
+    r1.perIterUs = r1.totalMs * 1e3 / static_cast<double>(r1.iterations);
+    results.push_back(r1);
+
     // Batch insert
     unsigned long batch_counter = 0;
     const unsigned long BATCH = 1000;
@@ -131,7 +183,7 @@ static void bench_vertex_insert(nogdb::Context& ctx, std::vector<BenchResult>& r
                     .set("name", std::string("batch_") + std::to_string(batch_counter++))
                     .set("age", int32_t(batch_counter % 100)));
         }
-        txn.commit();
+        txn.commit().get();
     });
     r2.iterations = REPS * BATCH;
     r2.perIterUs = r2.totalMs * 1e3 / static_cast<double>(r2.iterations);
@@ -194,6 +246,73 @@ static void bench_find_full_scan(nogdb::Context& ctx, std::vector<BenchResult>&
         txn.rollback();
     });
     results.push_back(r2);
+
+    auto r3 = runBench("find().getView() full scan (Person)", N, [&] {
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto views = txn.find("Person").getView();
+        (void)views.size();
+        txn.rollback();
+    });
+    results.push_back(r3);
+
+    // reading one property per record is where decoding the whole record costs the most
+    auto r4 = runBench("find().get() full scan + getInt(age)", N, [&] {
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto total = 0LL;
+        for (const auto& result : txn.find("Person").get()) {
+            total += result.record.getInt("age");
+        }
+        (void)total;
+        txn.rollback();
+    });
+    results.push_back(r4);
+
+    auto r5 = runBench("find().getView() full scan + getInt(age)", N, [&] {
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto total = 0LL;
+        for (const auto& view : txn.find("Person").getView()) {
+            total += view.record.getInt("age");
+        }
+        (void)total;
+        txn.rollback();
+    });
+    results.push_back(r5);
+
+    auto r6 = runBench("find().getCursor() scan + getView().getInt(age)", N, [&] {
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto cursor = txn.find("Person").getCursor();
+        auto total = 0LL;
+        while (cursor.next()) {
+            total += cursor.getView().record.getInt("age");
+        }
+        (void)total;
+        txn.rollback();
+    });
+    results.push_back(r6);
+}
+
+static void bench_point_read(nogdb::Context& ctx, std::vector<BenchResult>& results)
+{
+    auto descriptors = std::vector<nogdb::RecordDescriptor> {};
+    {
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto cursor = txn.find("Person").getCursor();
+        while (cursor.next() && descriptors.size() < 1000) {
+            descriptors.push_back(cursor->descriptor);
+        }
+        txn.rollback();
+    }
+
+    // short read-only transactions are dominated by the cost of beginning and completing them
+    const unsigned long N = 50000;
+    unsigned long counter = 0;
+    auto r = runBench("begin+fetchRecord+rollback (READ_ONLY)", N, [&] {
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto record = txn.fetchRecord(descriptors[counter++ % descriptors.size()]);
+        (void)record.size();
+        txn.rollback();
+    });
+    results.push_back(r);
 }
 
 static void bench_find_condition(nogdb::Context& ctx, std::vector<BenchResult>& results)
@@ -275,6 +394,51 @@ static void bench_traversal(nogdb::Context& ctx, std::vector<BenchResult>& resul
     results.push_back(r2);
 }
 
+static void bench_traversal_fanout(nogdb::Context& ctx, std::vector<BenchResult>& results)
+{
+    // A dedicated graph with a wide fan-out so that adjacency lookups on the
+    // relation tables dominate the cost rather than record decoding.
+    const unsigned long NUM_NODES = 2000;
+    const unsigned long FAN_OUT = 16;
+    std::vector<nogdb::RecordDescriptor> nodes;
+    {
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.addClass("Node", nogdb::ClassType::VERTEX);
+        txn.addClass("Link", nogdb::ClassType::EDGE);
+        for (unsigned long i = 0; i < NUM_NODES; ++i) {
+            nodes.push_back(txn.addVertex("Node"));
+        }
+        for (unsigned long i = 0; i < NUM_NODES; ++i) {
+            for (unsigned long j = 1; j <= FAN_OUT; ++j) {
+                txn.addEdge("Link", nodes[i], nodes[(i * 31 + j * 97) % NUM_NODES]);
+            }
+        }
+        txn.commit();
+    }
+
+    auto r = runBench("findOutEdge() on every Node (16 edges each)", 10, [&] {
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        for (const auto& node : nodes) {
+            auto rs = txn.findOutEdge(node).get();
+            (void)rs.size();
+        }
+        txn.rollback();
+    });
+    results.push_back(r);
+
+    const unsigned long N = 50;
+    unsigned long vi = 0;
+    auto r2 = runBench("traverseOut BFS depth 1-2 (fan-out 16)", N, [&] {
+        auto src = nodes[(vi * 37) % nodes.size()];
+        ++vi;
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto rs = txn.traverseOut(src).depth(1, 2).get();
+        (void)rs.size();
+        txn.rollback();
+    });
+    results.push_back(r2);
+}
+
 static void bench_shortest_path(nogdb::Context& ctx, std::vector<BenchResult>& results)
 {
     std::vector<nogdb::RecordDescriptor> vertices;
@@ -315,12 +479,825 @@ static void bench_shortest_path(nogdb::Context& ctx, std::vector<BenchResult>& r
     results.push_back(r2);
 }
 
+static void bench_commit_durability(std::vector<BenchResult>& results)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_durability";
+    const unsigned long N = 2000;
+    const struct {
+        nogdb::DurabilityMode mode;
+        const char* name;
+    } modes[] = {
+        { nogdb::DurabilityMode::FULL, "commit latency, DurabilityMode::FULL" },
+        { nogdb::DurabilityMode::NO_META_SYNC, "commit latency, DurabilityMode::NO_META_SYNC" },
+        { nogdb::DurabilityMode::ASYNC, "commit latency, DurabilityMode::ASYNC (100ms flush)" },
+    };
+
+    for (const auto& m : modes) {
+        removeDBDir(dbPath.c_str());
+        nogdb::ContextInitializer(dbPath)
+            .setMaxDBSize(256UL * 1024 * 1024)
+            .setDurability(m.mode, 100)
+            .init();
+        {
+            nogdb::Context ctx(dbPath);
+            {
+                auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                txn.addClass("Item", nogdb::ClassType::VERTEX);
+                txn.addProperty("Item", "value", nogdb::PropertyType::INTEGER);
+                txn.commit();
+            }
+            int i = 0;
+            auto r = runBench(m.name, N, [&] {
+                auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                txn.addVertex("Item", nogdb::Record {}.set("value", i++));
+                txn.commit();
+            });
+            results.push_back(r);
+        }
+        removeDBDir(dbPath.c_str());
+    }
+}
+
+static void bench_bulk_load(std::vector<BenchResult>& results)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_bulk";
+    const unsigned long NUM_VERTICES = 20000;
+    const unsigned long FAN_OUT = 8;
+    const unsigned long NUM_RECORDS = NUM_VERTICES * (FAN_OUT + 1);
+
+    struct Loader {
+        const char* name;
+        std::function<void(nogdb::Context&)> load;
+    };
+    // the same graph with an indexed vertex property, loaded in one transaction by each path
+    const Loader loaders[] = {
+        { "load 20k vertices + 160k edges, Transaction", [&](nogdb::Context& ctx) {
+             auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+             std::vector<nogdb::RecordDescriptor> vertices;
+             for (unsigned long i = 0; i < NUM_VERTICES; ++i) {
+                 vertices.push_back(txn.addVertex("Node", nogdb::Record {}.set("key", int32_t((i * 7919) % NUM_VERTICES))));
+             }
+             for (unsigned long i = 0; i < NUM_VERTICES; ++i) {
+                 for (unsigned long j = 1; j <= FAN_OUT; ++j) {
+                     txn.addEdge("Link", vertices[i], vertices[(i * 31 + j * 97) % NUM_VERTICES]);
+                 }
+             }
+             txn.commit();
+         } },
+        { "load 20k vertices + 160k edges, BulkLoader", [&](nogdb::Context& ctx) {
+             auto loader = ctx.beginBulkLoad();
+             std::vector<nogdb::RecordDescriptor> vertices;
+             for (unsigned long i = 0; i < NUM_VERTICES; ++i) {
+                 vertices.push_back(loader.addVertex("Node", nogdb::Record {}.set("key", int32_t((i * 7919) % NUM_VERTICES))));
+             }
+             for (unsigned long i = 0; i < NUM_VERTICES; ++i) {
+                 for (unsigned long j = 1; j <= FAN_OUT; ++j) {
+                     loader.addEdge("Link", vertices[i], vertices[(i * 31 + j * 97) % NUM_VERTICES]);
+                 }
+             }
+             loader.commit();
+         } },
+    };
+
+    for (const auto& loader : loaders) {
+        removeDBDir(dbPath.c_str());
+        nogdb::ContextInitializer(dbPath).setMaxDBSize(1024UL * 1024 * 1024).init();
+        {
+            nogdb::Context ctx(dbPath);
+            {
+                auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                txn.addClass("Node", nogdb::ClassType::VERTEX);
+                txn.addProperty("Node", "key", nogdb::PropertyType::INTEGER);
+                txn.addIndex("Node", "key", false);
+                txn.addClass("Link", nogdb::ClassType::EDGE);
+                txn.commit();
+            }
+            auto r = runBench(loader.name, 1, [&] { loader.load(ctx); });
+            r.iterations = NUM_RECORDS;
+            r.perIterUs = r.totalMs * 1e3 / static_cast<double>(r.iterations);
+            results.push_back(r);
+        }
+        removeDBDir(dbPath.c_str());
+    }
+}
+
+static void bench_large_values(std::vector<BenchResult>& results)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_large_values";
+    const unsigned long NUM_RECORDS = 5000;
+    const unsigned long N = 50;
+    const auto payload = std::string(4096, 'p');
+    const struct {
+        unsigned int threshold;
+        const char* scanName;
+        const char* viewName;
+    } settings[] = {
+        { 0, "filtered scan on int, 4KB blobs inline", "filtered getView() on int, 4KB blobs inline" },
+        { 1024, "filtered scan on int, 4KB blobs out of line", "filtered getView() on int, 4KB blobs out of line" },
+    };
+
+    for (const auto& setting : settings) {
+        removeDBDir(dbPath.c_str());
+        nogdb::ContextInitializer(dbPath)
+            .setMaxDBSize(1024UL * 1024 * 1024)
+            .setLargeValueThreshold(setting.threshold)
+            .init();
+        {
+            nogdb::Context ctx(dbPath);
+            {
+                auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                txn.addClass("Document", nogdb::ClassType::VERTEX);
+                txn.addProperty("Document", "payload", nogdb::PropertyType::BLOB);
+                txn.addProperty("Document", "size", nogdb::PropertyType::INTEGER);
+                for (unsigned long i = 0; i < NUM_RECORDS; ++i) {
+                    txn.addVertex("Document", nogdb::Record {}
+                                                  .set("payload", nogdb::Bytes { payload })
+                                                  .set("size", int32_t(i % 100)));
+                }
+                txn.commit();
+            }
+            // 1% of the records match, only their blobs are read when they are stored out of line
+            auto r = runBench(setting.scanName, N, [&] {
+                auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+                auto rs = txn.find("Document").where(nogdb::Condition("size").eq(int32_t { 42 })).get();
+                (void)rs.size();
+                txn.rollback();
+            });
+            results.push_back(r);
+
+            auto r2 = runBench(setting.viewName, N, [&] {
+                auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+                auto total = 0LL;
+                for (const auto& view : txn.find("Document").getView()) {
+                    if (view.record.getInt("size") == 42) {
+                        total += static_cast<long long>(view.record.get("payload").size());
+                    }
+                }
+                (void)total;
+                txn.rollback();
+            });
+            results.push_back(r2);
+        }
+        removeDBDir(dbPath.c_str());
+    }
+}
+
+static void bench_record_format(std::vector<BenchResult>& results)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_record_format";
+    const unsigned long NUM_RECORDS = 10000;
+    const unsigned long NUM_PROPERTIES = 32;
+    const unsigned long N = 50;
+    const struct {
+        nogdb::RecordFormat recordFormat;
+        const char* viewName;
+        const char* filterName;
+    } settings[] = {
+        { nogdb::RecordFormat::V1, "getView() + get(last of 32 properties), V1", "filtered scan on last of 32 properties, V1" },
+        { nogdb::RecordFormat::V2, "getView() + get(last of 32 properties), V2", "filtered scan on last of 32 properties, V2" },
+    };
+
+    for (const auto& setting : settings) {
+        removeDBDir(dbPath.c_str());
+        nogdb::ContextInitializer(dbPath)
+            .setMaxDBSize(1024UL * 1024 * 1024)
+            .setRecordFormat(setting.recordFormat)
+            .init();
+        {
+            nogdb::Context ctx(dbPath);
+            {
+                auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                txn.addClass("Wide", nogdb::ClassType::VERTEX);
+                for (unsigned long p = 0; p < NUM_PROPERTIES; ++p) {
+                    txn.addProperty("Wide", "p" + std::to_string(100 + p), nogdb::PropertyType::INTEGER);
+                }
+                for (unsigned long i = 0; i < NUM_RECORDS; ++i) {
+                    auto record = nogdb::Record {};
+                    for (unsigned long p = 0; p < NUM_PROPERTIES; ++p) {
+                        record.set("p" + std::to_string(100 + p), int32_t(i + p));
+                    }
+                    txn.addVertex("Wide", record);
+                }
+                txn.commit();
+            }
+            const auto last = "p" + std::to_string(100 + NUM_PROPERTIES - 1);
+            auto r = runBench(setting.viewName, N, [&] {
+                auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+                auto total = 0LL;
+                for (const auto& view : txn.find("Wide").getView()) {
+                    total += view.record.getInt(last);
+                }
+                (void)total;
+                txn.rollback();
+            });
+            results.push_back(r);
+
+            auto r2 = runBench(setting.filterName, N, [&] {
+                auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+                auto count = txn.find("Wide").where(nogdb::Condition(last).eq(int32_t { 42 })).count();
+                (void)count;
+                txn.rollback();
+            });
+            results.push_back(r2);
+        }
+        removeDBDir(dbPath.c_str());
+    }
+}
+
+static void bench_update(std::vector<BenchResult>& results)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_update";
+    const unsigned long NUM_RECORDS = 1000;
+    const unsigned long REPS = 20;
+    removeDBDir(dbPath.c_str());
+    nogdb::ContextInitializer(dbPath).setMaxDBSize(256UL * 1024 * 1024).enableVersion().init();
+    {
+        nogdb::Context ctx(dbPath);
+        auto descriptors = std::vector<nogdb::RecordDescriptor> {};
+        {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("Order", nogdb::ClassType::VERTEX);
+            txn.addProperty("Order", "customer", nogdb::PropertyType::TEXT);
+            txn.addProperty("Order", "address", nogdb::PropertyType::TEXT);
+            txn.addProperty("Order", "note", nogdb::PropertyType::TEXT);
+            txn.addProperty("Order", "quantity", nogdb::PropertyType::INTEGER);
+            txn.addProperty("Order", "price", nogdb::PropertyType::REAL);
+            txn.addProperty("Order", "status", nogdb::PropertyType::INTEGER);
+            for (unsigned long i = 0; i < NUM_RECORDS; ++i) {
+                descriptors.push_back(txn.addVertex("Order", nogdb::Record {}
+                                                                 .set("customer", "customer " + std::to_string(i))
+                                                                 .set("address", std::string(100, 'a'))
+                                                                 .set("note", std::string(400, 'n'))
+                                                                 .set("quantity", int32_t(i % 10))
+                                                                 .set("price", 9.99)
+                                                                 .set("status", int32_t(0))));
+            }
+            txn.commit();
+        }
+
+        // changing the status of every order, by rewriting the whole record or only its status
+        int32_t status = 0;
+        auto r = runBench("update() REPLACE one of 6 props (1k per txn)", REPS, [&] {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            ++status;
+            for (const auto& descriptor : descriptors) {
+                auto record = txn.fetchRecord(descriptor);
+                txn.update(descriptor, record.set("status", status));
+            }
+            txn.commit();
+        });
+        r.iterations = REPS * NUM_RECORDS;
+        r.perIterUs = r.totalMs * 1e3 / static_cast<double>(r.iterations);
+        results.push_back(r);
+
+        auto r2 = runBench("update() PATCH one of 6 props (1k per txn)", REPS, [&] {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            auto patch = nogdb::Record {}.set("status", ++status);
+            for (const auto& descriptor : descriptors) {
+                txn.update(descriptor, patch, nogdb::UpdateMode::PATCH);
+            }
+            txn.commit();
+        });
+        r2.iterations = REPS * NUM_RECORDS;
+        r2.perIterUs = r2.totalMs * 1e3 / static_cast<double>(r2.iterations);
+        results.push_back(r2);
+    }
+    removeDBDir(dbPath.c_str());
+}
+
+// drop the clean pages of the data file from the page cache, as after a restart
+static void evictDataFile(const std::string& dbPath)
+{
+    auto fd = open((dbPath + "/data.mdb").c_str(), O_RDONLY);
+    if (fd >= 0) {
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+static void bench_warmup(std::vector<BenchResult>& results, nogdb::WarmupStats& stats)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_warmup";
+    const unsigned long NUM_RECORDS = 20000;
+    const unsigned long N = 2000;
+    removeDBDir(dbPath.c_str());
+    nogdb::ContextInitializer(dbPath).setMaxDBSize(1024UL * 1024 * 1024).init();
+    auto descriptors = std::vector<nogdb::RecordDescriptor> {};
+    {
+        nogdb::Context ctx(dbPath);
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.addClass("Account", nogdb::ClassType::VERTEX);
+        txn.addProperty("Account", "name", nogdb::PropertyType::TEXT);
+        txn.addProperty("Account", "profile", nogdb::PropertyType::TEXT);
+        for (unsigned long i = 0; i < NUM_RECORDS; ++i) {
+            descriptors.push_back(txn.addVertex("Account", nogdb::Record {}
+                                                               .set("name", "account " + std::to_string(i))
+                                                               .set("profile", std::string(1024, 'p'))));
+        }
+        txn.commit();
+    }
+
+    // the first reads after opening a database, spread over the whole class
+    auto firstReads = [&](nogdb::Context& ctx) {
+        unsigned long i = 0;
+        return [&ctx, &descriptors, i]() mutable {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto record = txn.fetchRecord(descriptors[(i++ * 7919) % descriptors.size()]);
+            (void)record.size();
+            txn.rollback();
+        };
+    };
+    evictDataFile(dbPath);
+    {
+        nogdb::Context ctx(dbPath);
+        results.push_back(runBench("fetchRecord() on a cold start", N, firstReads(ctx)));
+    }
+    evictDataFile(dbPath);
+    {
+        nogdb::Context ctx(dbPath);
+        auto t0 = Clock::now();
+        stats = ctx.warmup({ "Account" });
+        auto r = runBench("fetchRecord() after warmup()", N, firstReads(ctx));
+        auto totalNs = std::chrono::duration_cast<Ns>(Clock::now() - t0).count();
+        results.push_back(r);
+        r.name = "warmup() + fetchRecord() after warmup()";
+        r.totalMs = nsToMs(totalNs);
+        r.perIterUs = nsToUs(totalNs / static_cast<long long>(N));
+        results.push_back(r);
+    }
+    removeDBDir(dbPath.c_str());
+}
+
+// writers of independent classes, committing in one environment or each in a shard of its own
+static void bench_sharding(std::vector<BenchResult>& results)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_sharding";
+    const unsigned int NUM_WRITERS = 4;
+    const unsigned long TXNS = 50;
+    const unsigned long RECORDS_PER_TXN = 200;
+    auto className = [](unsigned int writer) { return "Sensor" + std::to_string(writer); };
+    auto writeAll = [&](std::function<nogdb::Transaction&(unsigned int, std::function<void()>&)> beginTxn) {
+        auto writers = std::vector<std::thread> {};
+        for (auto writer = 0U; writer < NUM_WRITERS; ++writer) {
+            writers.emplace_back([&, writer]() {
+                for (unsigned long i = 0; i < TXNS; ++i) {
+                    auto commit = std::function<void()> {};
+                    auto& txn = beginTxn(writer, commit);
+                    for (unsigned long j = 0; j < RECORDS_PER_TXN; ++j) {
+                        txn.addVertex(className(writer), nogdb::Record {}.set("value", int32_t(j)));
+                    }
+                    commit();
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+    };
+
+    removeDBDir(dbPath.c_str());
+    nogdb::ContextInitializer(dbPath).setMaxDBSize(1024UL * 1024 * 1024).init();
+    {
+        nogdb::Context ctx(dbPath);
+        {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            for (auto writer = 0U; writer < NUM_WRITERS; ++writer) {
+                txn.addClass(className(writer), nogdb::ClassType::VERTEX);
+                txn.addProperty(className(writer), "value", nogdb::PropertyType::INTEGER);
+            }
+            txn.commit();
+        }
+        auto r = runBench("4 writers x 200 addVertex per txn, one environment", 1, [&] {
+            writeAll([&](unsigned int, std::function<void()>& commit) -> nogdb::Transaction& {
+                auto txn = std::make_shared<nogdb::Transaction>(ctx.beginTxn(nogdb::TxnMode::READ_WRITE));
+                commit = [txn]() { txn->commit(); };
+                return *txn;
+            });
+        });
+        r.iterations = NUM_WRITERS * TXNS;
+        r.perIterUs = r.totalMs * 1e3 / static_cast<double>(r.iterations);
+        results.push_back(r);
+    }
+    removeDBDir(dbPath.c_str());
+
+    auto initializer = nogdb::ShardedContextInitializer(dbPath, NUM_WRITERS);
+    initializer.setShardSettings([](nogdb::ContextInitializer& shard) { shard.setMaxDBSize(256UL * 1024 * 1024); });
+    for (auto writer = 0U; writer < NUM_WRITERS; ++writer) {
+        initializer.placeClass(className(writer), writer);
+    }
+    {
+        auto ctx = initializer.init();
+        {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            for (auto writer = 0U; writer < NUM_WRITERS; ++writer) {
+                txn.addClass(className(writer), nogdb::ClassType::VERTEX);
+                txn.addProperty(className(writer), "value", nogdb::PropertyType::INTEGER);
+            }
+            txn.commit();
+        }
+        auto r = runBench("4 writers x 200 addVertex per txn, 4 shards", 1, [&] {
+            writeAll([&](unsigned int writer, std::function<void()>& commit) -> nogdb::Transaction& {
+                auto txn = std::make_shared<nogdb::ShardedTxn>(ctx.beginTxn(nogdb::TxnMode::READ_WRITE));
+                commit = [txn]() { txn->commit(); };
+                return txn->getShardOf(className(writer));
+            });
+        });
+        r.iterations = NUM_WRITERS * TXNS;
+        r.perIterUs = r.totalMs * 1e3 / static_cast<double>(r.iterations);
+        results.push_back(r);
+    }
+    removeDBDir(dbPath.c_str());
+}
+
+static void bench_compression(std::vector<BenchResult>& results, nogdb::CompressionStats& stats)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_compression";
+    const unsigned long NUM_RECORDS = 20000;
+    const unsigned long N = 20;
+    const char* statuses[] = { "active", "suspended", "pending", "closed" };
+    const char* cities[] = { "Bangkok", "Chiang Mai", "Khon Kaen", "Phuket", "Hat Yai" };
+
+    removeDBDir(dbPath.c_str());
+    nogdb::ContextInitializer(dbPath).setMaxDBSize(1024UL * 1024 * 1024).init();
+    {
+        nogdb::Context ctx(dbPath);
+        {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("Customer", nogdb::ClassType::VERTEX);
+            txn.addProperty("Customer", "name", nogdb::PropertyType::TEXT);
+            txn.addProperty("Customer", "status", nogdb::PropertyType::TEXT);
+            txn.addProperty("Customer", "address", nogdb::PropertyType::TEXT);
+            txn.addProperty("Customer", "segment", nogdb::PropertyType::TEXT);
+            txn.addProperty("Customer", "score", nogdb::PropertyType::INTEGER);
+            for (unsigned long i = 0; i < NUM_RECORDS; ++i) {
+                txn.addVertex("Customer", nogdb::Record {}
+                                              .set("name", "customer number " + std::to_string(i))
+                                              .set("status", statuses[i % 4])
+                                              .set("address", std::to_string(i % 500) + " Sukhumvit Road, "
+                                                      + cities[i % 5] + ", Thailand")
+                                              .set("segment", (i % 3 == 0) ? "small and medium enterprise" : "retail banking")
+                                              .set("score", int32_t(i % 100)));
+            }
+            txn.commit();
+        }
+        auto scan = [&] {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto total = 0LL;
+            for (const auto& view : txn.find("Customer").getView()) {
+                total += view.record.getInt("score");
+            }
+            (void)total;
+            txn.rollback();
+        };
+        results.push_back(runBench("full getView() scan, 20K records", N, scan));
+        {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            stats = txn.enableCompression("Customer");
+            txn.commit();
+        }
+        results.push_back(runBench("full getView() scan, 20K compressed records", N, scan));
+    }
+    removeDBDir(dbPath.c_str());
+}
+
+struct DecodingStats {
+    unsigned long records;
+    double allocationsPerRecord;
+    double allocationsPerRecordRead;
+    double allocationsPerRecordBasicInfo;
+};
+
+static void bench_record_decoding(std::vector<BenchResult>& results, DecodingStats& stats)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_decoding";
+    const unsigned long NUM_RECORDS = 20000;
+    const unsigned long N = 20;
+
+    removeDBDir(dbPath.c_str());
+    nogdb::ContextInitializer(dbPath).setMaxDBSize(1024UL * 1024 * 1024).init();
+    {
+        nogdb::Context ctx(dbPath);
+        {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("Reading", nogdb::ClassType::VERTEX);
+            txn.addProperty("Reading", "sensor", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "site", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "unit", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "note", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "sequence", nogdb::PropertyType::INTEGER);
+            txn.addProperty("Reading", "flags", nogdb::PropertyType::UNSIGNED_INTEGER);
+            txn.addProperty("Reading", "timestamp", nogdb::PropertyType::BIGINT);
+            txn.addProperty("Reading", "value", nogdb::PropertyType::REAL);
+            for (unsigned long i = 0; i < NUM_RECORDS; ++i) {
+                txn.addVertex("Reading", nogdb::Record {}
+                                             .set("sensor", "sensor-" + std::to_string(i % 64))
+                                             .set("site", "building " + std::to_string(i % 7) + ", floor " + std::to_string(i % 12))
+                                             .set("unit", "celsius")
+                                             .set("note", (i % 10 == 0) ? "calibrated after maintenance" : "scheduled")
+                                             .set("sequence", int32_t(i))
+                                             .set("flags", uint32_t(i % 16))
+                                             .set("timestamp", int64_t(1500000000000LL + i))
+                                             .set("value", 20.0 + static_cast<double>(i % 100) / 10.0));
+            }
+            txn.commit();
+        }
+        auto scan = [&] {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto rs = txn.find("Reading").get();
+            (void)rs.size();
+            txn.rollback();
+        };
+        auto scanRead = [&] {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto total = 0.0;
+            for (const auto& result : txn.find("Reading").get()) {
+                total += result.record.getReal("value");
+            }
+            (void)total;
+            txn.rollback();
+        };
+        auto scanBasicInfo = [&] {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto total = 0ULL;
+            for (const auto& result : txn.find("Reading").get()) {
+                total += result.record.getRecordId().second + result.record.getVersion();
+            }
+            (void)total;
+            txn.rollback();
+        };
+        auto countAllocations = [&](const std::function<void()>& fn) {
+            auto before = allocationCount.load();
+            fn();
+            return static_cast<double>(allocationCount.load() - before) / NUM_RECORDS;
+        };
+        scan();
+        stats.records = NUM_RECORDS;
+        stats.allocationsPerRecord = countAllocations(scan);
+        stats.allocationsPerRecordRead = countAllocations(scanRead);
+        stats.allocationsPerRecordBasicInfo = countAllocations(scanBasicInfo);
+        results.push_back(runBench("find().get() scan, 20K records of 8 properties", N, scan));
+        results.push_back(runBench("find().get() scan + getReal(value)", N, scanRead));
+    }
+    removeDBDir(dbPath.c_str());
+}
+
+static void bench_selective_filter(std::vector<BenchResult>& results)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_selective";
+    const unsigned long NUM_RECORDS = 20000;
+    const unsigned long N = 20;
+
+    removeDBDir(dbPath.c_str());
+    nogdb::ContextInitializer(dbPath).setMaxDBSize(1024UL * 1024 * 1024).init();
+    {
+        nogdb::Context ctx(dbPath);
+        {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("Reading", nogdb::ClassType::VERTEX);
+            txn.addProperty("Reading", "sensor", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "site", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "note", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "sequence", nogdb::PropertyType::INTEGER);
+            txn.addProperty("Reading", "flags", nogdb::PropertyType::UNSIGNED_INTEGER);
+            txn.addProperty("Reading", "timestamp", nogdb::PropertyType::BIGINT);
+            txn.addProperty("Reading", "value", nogdb::PropertyType::REAL);
+            for (unsigned long i = 0; i < NUM_RECORDS; ++i) {
+                txn.addVertex("Reading", nogdb::Record {}
+                                             .set("sensor", "sensor-" + std::to_string(i % 64))
+                                             .set("site", "building " + std::to_string(i % 7) + ", floor " + std::to_string(i % 12))
+                                             .set("note", (i % 100 == 0) ? "calibrated after maintenance" : "scheduled")
+                                             .set("sequence", int32_t(i))
+                                             .set("flags", uint32_t(i % 16))
+                                             .set("timestamp", int64_t(1500000000000LL + i))
+                                             .set("value", 20.0 + static_cast<double>(i % 100) / 10.0));
+            }
+            txn.commit();
+        }
+        results.push_back(runBench("where(sequence = 42).get(), 1 of 20K records", N, [&] {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto rs = txn.find("Reading").where(nogdb::Condition("sequence").eq(int32_t { 42 })).get();
+            (void)rs.size();
+            txn.rollback();
+        }));
+        results.push_back(runBench("where(note = calibrated...).count(), 1% of records", N, [&] {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto count = txn.find("Reading").where(nogdb::Condition("note").eq("calibrated after maintenance")).count();
+            (void)count;
+            txn.rollback();
+        }));
+        results.push_back(runBench("where(sequence > 19990 && flags = 3).get()", N, [&] {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto rs = txn.find("Reading")
+                          .where(nogdb::Condition("sequence").gt(int32_t { 19990 }) && nogdb::Condition("flags").eq(uint32_t { 3 }))
+                          .get();
+            (void)rs.size();
+            txn.rollback();
+        }));
+    }
+    removeDBDir(dbPath.c_str());
+}
+
+struct BytesStats {
+    double allocationsPerRecordBuilt;
+    double allocationsPerRecordCopied;
+    double allocationsPerResultCopied;
+};
+
+static void bench_bytes(std::vector<BenchResult>& results, BytesStats& stats)
+{
+    const std::string dbPath = std::string(BENCH_DB_PATH) + "_bytes";
+    const unsigned long NUM_RECORDS = 20000;
+    const unsigned long N = 20;
+
+    auto build = [](unsigned long i) {
+        return nogdb::Record {}
+            .set("sensor", "sensor-" + std::to_string(i % 64))
+            .set("unit", "celsius")
+            .set("note", (i % 10 == 0) ? "calibrated after maintenance" : "scheduled")
+            .set("sequence", int32_t(i))
+            .set("flags", uint32_t(i % 16))
+            .set("timestamp", int64_t(1500000000000LL + i))
+            .set("value", 20.0 + static_cast<double>(i % 100) / 10.0);
+    };
+    auto records = std::vector<nogdb::Record> {};
+    auto countAllocations = [&](const std::function<void()>& fn) {
+        auto before = allocationCount.load();
+        fn();
+        return static_cast<double>(allocationCount.load() - before) / NUM_RECORDS;
+    };
+    records.reserve(NUM_RECORDS);
+    stats.allocationsPerRecordBuilt = countAllocations([&] {
+        for (unsigned long i = 0; i < NUM_RECORDS; ++i) {
+            records.emplace_back(build(i));
+        }
+    });
+    stats.allocationsPerRecordCopied = countAllocations([&] {
+        auto copied = records;
+        (void)copied.size();
+    });
+    results.push_back(runBench("copy 20K records of 7 properties", N, [&] {
+        auto copied = records;
+        (void)copied.size();
+    }));
+
+    removeDBDir(dbPath.c_str());
+    nogdb::ContextInitializer(dbPath).setMaxDBSize(1024UL * 1024 * 1024).init();
+    {
+        nogdb::Context ctx(dbPath);
+        {
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("Reading", nogdb::ClassType::VERTEX);
+            txn.addProperty("Reading", "sensor", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "unit", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "note", nogdb::PropertyType::TEXT);
+            txn.addProperty("Reading", "sequence", nogdb::PropertyType::INTEGER);
+            txn.addProperty("Reading", "flags", nogdb::PropertyType::UNSIGNED_INTEGER);
+            txn.addProperty("Reading", "timestamp", nogdb::PropertyType::BIGINT);
+            txn.addProperty("Reading", "value", nogdb::PropertyType::REAL);
+            for (const auto& record : records) {
+                txn.addVertex("Reading", record);
+            }
+            txn.commit();
+        }
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto resultSet = txn.find("Reading").get();
+        // results whose properties have been turned into a map, as getAll() does
+        for (const auto& result : resultSet) {
+            (void)result.record.getAll().size();
+        }
+        stats.allocationsPerResultCopied = countAllocations([&] {
+            auto copied = resultSet;
+            (void)copied.size();
+        });
+        results.push_back(runBench("copy 20K results read with getAll()", N, [&] {
+            auto copied = resultSet;
+            (void)copied.size();
+        }));
+        txn.rollback();
+    }
+    removeDBDir(dbPath.c_str());
+}
+
+// ---------------------------------------------------------------------------
+// Reader scaling
+// ---------------------------------------------------------------------------
+
+struct ScalingResult {
+    unsigned int threads;
+    unsigned long operations;
+    double totalMs;
+    double opsPerSec;
+};
+
+// runs fn(threadIndex, iteration) opsPerThread times on each of numThreads threads at once
+static ScalingResult runParallel(unsigned int numThreads,
+    unsigned long opsPerThread,
+    const std::function<void(unsigned int, unsigned long)>& fn)
+{
+    std::vector<std::thread> workers;
+    auto t0 = Clock::now();
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        workers.emplace_back([&fn, t, opsPerThread] {
+            for (unsigned long i = 0; i < opsPerThread; ++i) {
+                fn(t, i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto t1 = Clock::now();
+    auto totalNs = std::chrono::duration_cast<Ns>(t1 - t0).count();
+    ScalingResult r;
+    r.threads = numThreads;
+    r.operations = opsPerThread * numThreads;
+    r.totalMs = nsToMs(totalNs);
+    r.opsPerSec = static_cast<double>(r.operations) * 1e9 / static_cast<double>(totalNs);
+    return r;
+}
+
+static void printScaling(const std::string& name, const std::vector<ScalingResult>& results)
+{
+    std::printf("  %s\n", name.c_str());
+    for (const auto& r : results) {
+        std::printf("    %3u threads  %8lu ops  %8.2f ms total  %12.0f ops/s  %5.2fx\n",
+            r.threads, r.operations, r.totalMs, r.opsPerSec, r.opsPerSec / results.front().opsPerSec);
+    }
+}
+
+static void bench_reader_scaling(unsigned int maxThreads)
+{
+    const unsigned long NUM_NODES = 10000;
+    const unsigned long FAN_OUT = 8;
+    auto ctx = createFreshContext();
+    std::vector<nogdb::RecordDescriptor> nodes;
+    {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.addClass("Node", nogdb::ClassType::VERTEX);
+        txn.addProperty("Node", "value", nogdb::PropertyType::INTEGER);
+        txn.addClass("Link", nogdb::ClassType::EDGE);
+        for (unsigned long i = 0; i < NUM_NODES; ++i) {
+            nodes.push_back(txn.addVertex("Node", nogdb::Record {}.set("value", int32_t(i))));
+        }
+        for (unsigned long i = 0; i < NUM_NODES; ++i) {
+            for (unsigned long j = 1; j <= FAN_OUT; ++j) {
+                txn.addEdge("Link", nodes[i], nodes[(i * 31 + j * 97) % NUM_NODES]);
+            }
+        }
+        txn.commit();
+    }
+
+    // every thread shares one context, which is how an application serves concurrent readers
+    std::vector<ScalingResult> pointReads;
+    std::vector<ScalingResult> traversals;
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+    for (auto threads : threadCounts) {
+        pointReads.push_back(runParallel(threads, 20000, [&](unsigned int t, unsigned long i) {
+            auto txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto record = txn.fetchRecord(nodes[(t * 7919 + i * 31) % nodes.size()]);
+            (void)record.size();
+            txn.rollback();
+        }));
+        traversals.push_back(runParallel(threads, 200, [&](unsigned int t, unsigned long i) {
+            auto txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto rs = txn.traverseOut(nodes[(t * 7919 + i * 37) % nodes.size()]).depth(1, 2).get();
+            (void)rs.size();
+            txn.rollback();
+        }));
+    }
+    printScaling("begin+fetchRecord+rollback (READ_ONLY)", pointReads);
+    printScaling("traverseOut BFS depth 1-2 (fan-out 8)", traversals);
+
+    delete ctx;
+    removeDBDir(BENCH_DB_PATH);
+}
+
 // ---------------------------------------------------------------------------
 // main
 // ---------------------------------------------------------------------------
 
-int main()
+int main(int argc, char* argv[])
 {
+    // nogdb_bench --threads N: measure how read throughput scales on 1..N threads
+    if (argc > 2 && std::strcmp(argv[1], "--threads") == 0) {
+        auto maxThreads = static_cast<unsigned int>(std::max(1, std::atoi(argv[2])));
+        std::printf("NogDB Reader Scaling Benchmark (1..%u threads)\n", maxThreads);
+        std::printf("=============================================\n\n");
+        try {
+            bench_reader_scaling(maxThreads);
+        } catch (const nogdb::Error& e) {
+            std::fprintf(stderr, "nogdb::Error: %s (code %d)\n", e.what(), e.code());
+            removeDBDir(BENCH_DB_PATH);
+            return 1;
+        }
+        std::printf("\nDone.\n");
+        return 0;
+    }
+
     std::printf("NogDB Micro-Benchmark Suite\n");
     std::printf("===========================\n\n");
 
@@ -336,19 +1313,101 @@ int main()
         for (const auto& r : results) printResult(r);
         results.clear();
 
+        std::printf("\n[ Bulk load ]\n");
+        bench_bulk_load(results);
+        for (const auto& r : results) printResult(r);
+        results.clear();
+
         std::printf("\n[ Find / Query ]\n");
         bench_find_full_scan(*ctx, results);
+        bench_point_read(*ctx, results);
         bench_find_condition(*ctx, results);
         bench_find_indexed(*ctx, results);
         for (const auto& r : results) printResult(r);
         results.clear();
 
+        std::printf("\n[ Record decoding ]\n");
+        auto decodingStats = DecodingStats {};
+        bench_record_decoding(results, decodingStats);
+        for (const auto& r : results) printResult(r);
+        std::printf("  %-55s  %.2f\n", "allocations per record, find().get()", decodingStats.allocationsPerRecord);
+        std::printf("  %-55s  %.2f\n", "allocations per record, find().get() + getReal()",
+            decodingStats.allocationsPerRecordRead);
+        std::printf("  %-55s  %.2f\n", "allocations per record, find().get() + getRecordId()",
+            decodingStats.allocationsPerRecordBasicInfo);
+        // records decoded per second by the plain scan
+        std::printf("  %-55s  %.0f records/s\n", "scan throughput",
+            static_cast<double>(decodingStats.records) * results[0].iterations / (results[0].totalMs / 1e3));
+        results.clear();
+
+        std::printf("\n[ Bytes ]\n");
+        auto bytesStats = BytesStats {};
+        bench_bytes(results, bytesStats);
+        for (const auto& r : results) printResult(r);
+        std::printf("  %-55s  %.2f\n", "allocations per record built", bytesStats.allocationsPerRecordBuilt);
+        std::printf("  %-55s  %.2f\n", "allocations per record copied", bytesStats.allocationsPerRecordCopied);
+        std::printf("  %-55s  %.2f\n", "allocations per result copied", bytesStats.allocationsPerResultCopied);
+        results.clear();
+
+        std::printf("\n[ Selective filter ]\n");
+        bench_selective_filter(results);
+        for (const auto& r : results) printResult(r);
+        results.clear();
+
+        std::printf("\n[ Record format ]\n");
+        bench_record_format(results);
+        for (const auto& r : results) printResult(r);
+        results.clear();
+
+        std::printf("\n[ Update ]\n");
+        bench_update(results);
+        for (const auto& r : results) printResult(r);
+        results.clear();
+
+        std::printf("\n[ Large values ]\n");
+        bench_large_values(results);
+        for (const auto& r : results) printResult(r);
+        results.clear();
+
+        std::printf("\n[ Compression ]\n");
+        auto compressionStats = nogdb::CompressionStats {};
+        bench_compression(results, compressionStats);
+        for (const auto& r : results) printResult(r);
+        std::printf("  %-55s  %zu -> %zu bytes (%.2fx), %zu bytes dictionary\n", "compression ratio",
+            compressionStats.rawBytes, compressionStats.compressedBytes,
+            static_cast<double>(compressionStats.rawBytes) / static_cast<double>(compressionStats.compressedBytes),
+            compressionStats.dictionarySize);
+        // raw bytes decoded per second by the compressed scan, parsing included
+        std::printf("  %-55s  %.1f MB/s\n", "decode throughput of the compressed scan",
+            static_cast<double>(compressionStats.rawBytes) * results[1].iterations / (results[1].totalMs / 1e3) / 1e6);
+        results.clear();
+
+        std::printf("\n[ Sharding ]\n");
+        bench_sharding(results);
+        for (const auto& r : results) printResult(r);
+        results.clear();
+
+        std::printf("\n[ Warm-up ]\n");
+        auto warmupStats = nogdb::WarmupStats {};
+        bench_warmup(results, warmupStats);
+        for (const auto& r : results) printResult(r);
+        std::printf("  %-55s  %.2f ms, %zu entries, %zu -> %zu of %zu pages resident\n", "warmup() of 20k records",
+            warmupStats.durationMs, warmupStats.entries,
+            warmupStats.residentPagesBefore, warmupStats.residentPages, warmupStats.totalPages);
+        results.clear();
+
         std::printf("\n[ Traversal ]\n");
         bench_traversal(*ctx, results);
+        bench_traversal_fanout(*ctx, results);
         bench_shortest_path(*ctx, results);
         for (const auto& r : results) printResult(r);
         results.clear();
 
+        std::printf("\n[ Durability ]\n");
+        bench_commit_durability(results);
+        for (const auto& r : results) printResult(r);
+        results.clear();
+
     } catch (const nogdb::Error& e) {
         std::fprintf(stderr, "nogdb::Error: %s (code %d)\n", e.what(), e.code());
         delete ctx;
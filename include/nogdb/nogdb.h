@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
@@ -36,6 +38,16 @@ namespace nogdb {
 
 class Context;
 
+class BatchTxn;
+
+class BulkLoader;
+
+class ShardedContext;
+
+class ShardedTxn;
+
+struct ContextSetting;
+
 class ContextInitializer {
 public:
     ContextInitializer(const std::string& dbPath);
@@ -48,6 +60,25 @@ public:
 
     ContextInitializer& enableVersion() noexcept;
 
+    ContextInitializer& setDurability(DurabilityMode mode, unsigned int flushIntervalMs = 100) noexcept;
+
+    ContextInitializer& setMapGrowth(unsigned long growthStep, unsigned long maxDBSizeLimit) noexcept;
+
+    ContextInitializer& setMapGrowthFactor(double growthFactor, unsigned long maxDBSizeLimit) noexcept;
+
+    ContextInitializer& setBatchCommit(unsigned int maxBatchSize, unsigned int maxLatencyMs) noexcept;
+
+    ContextInitializer& setStorageEngine(StorageEngine storageEngine) noexcept;
+
+    ContextInitializer& setLargeValueThreshold(unsigned int largeValueThreshold) noexcept;
+
+    ContextInitializer& setReaderMonitor(unsigned int checkIntervalMs, unsigned int maxReaderAgeMs = 0) noexcept;
+
+    ContextInitializer& setMapAdvice(MapAdvice mapAdvice) noexcept;
+
+    // the format records are written in, records in the other format stay readable
+    ContextInitializer& setRecordFormat(RecordFormat recordFormat) noexcept;
+
     Context init();
 
 private:
@@ -55,6 +86,19 @@ private:
     unsigned int _maxDB {};
     unsigned long _maxDBSize {};
     bool _versionEnabled {};
+    DurabilityMode _durabilityMode {};
+    unsigned int _flushInterval {};
+    unsigned long _growthStep {};
+    double _growthFactor {};
+    unsigned long _maxDBSizeLimit {};
+    unsigned int _batchSize {};
+    unsigned int _batchLatency {};
+    StorageEngine _storageEngine {};
+    unsigned int _largeValueThreshold {};
+    unsigned int _readerCheckInterval {};
+    unsigned int _maxReaderAge {};
+    MapAdvice _mapAdvice {};
+    RecordFormat _recordFormat {};
 };
 
 class Context {
@@ -63,7 +107,9 @@ public:
 
     ~Context() noexcept;
 
-    Context(const std::string& dbPath);
+    // a database opened read-only, e.g. by analytics processes next to the one writing it, fails every write;
+    // within a process, an environment is shared by every context of the database whatever its mode
+    Context(const std::string& dbPath, OpenMode openMode = OpenMode::READ_WRITE);
 
     Context(const Context& ctx);
 
@@ -81,26 +127,98 @@ public:
 
     bool isVersionEnabled() const { return _versionEnabled; }
 
+    DurabilityMode getDurabilityMode() const { return _durabilityMode; }
+
+    unsigned int getFlushInterval() const { return _flushInterval; }
+
+    unsigned long getMaxDBSizeLimit() const { return _maxDBSizeLimit; }
+
+    unsigned long getMapResizeCount() const;
+
+    BackupStats backup(const std::string& path, bool compact = false) const;
+
+    BackupStats backup(int fd, bool compact = false) const;
+
+    unsigned int getBatchSize() const { return _batchSize; }
+
+    unsigned int getBatchLatency() const { return _batchLatency; }
+
+    StorageEngine getStorageEngine() const { return _storageEngine; }
+
+    unsigned int getLargeValueThreshold() const { return _largeValueThreshold; }
+
+    unsigned int getReaderCheckInterval() const { return _readerCheckInterval; }
+
+    unsigned int getMaxReaderAge() const { return _maxReaderAge; }
+
+    ReaderStats getReaderStats() const;
+
+    // called by the reader monitor with the stats of a read transaction open for longer than the maximum age,
+    // once per transaction; such a transaction is not reported anywhere else
+    void setLongReaderHandler(std::function<void(const ReaderStats&)> handler);
+
+    MapAdvice getMapAdvice() const { return _mapAdvice; }
+
+    RecordFormat getRecordFormat() const { return _recordFormat; }
+
+    OpenMode getOpenMode() const { return _openMode; }
+
+    bool isReadOnly() const { return _openMode != OpenMode::READ_WRITE; }
+
+    // read the tables of the classes (every class if none is given), and optionally of their indexes
+    // and of the relations, so that the first queries after opening a database do not fault their pages
+    WarmupStats warmup(const std::vector<std::string>& classNames = {}, bool withIndexes = true, bool withRelations = true);
+
     Transaction beginTxn(const TxnMode& txnMode = TxnMode::READ_WRITE);
 
-    Transaction beginBatchTxn();
+    BatchTxn beginBatchTxn();
+
+    BulkLoader beginBulkLoad();
 
 private:
     friend class ContextInitializer;
     friend class Transaction;
-
-    Context(const std::string& dbPath, unsigned int maxDB, unsigned long maxDBSize, bool versionEnabled);
+    friend class BatchTxn;
 
     std::string _dbPath {};
     unsigned int _maxDB {};
     unsigned long _maxDBSize {};
     bool _versionEnabled {};
-
-    storage_engine::LMDBEnv* _envHandler;
+    DurabilityMode _durabilityMode {};
+    unsigned int _flushInterval {};
+    unsigned long _growthStep {};
+    double _growthFactor {};
+    unsigned long _maxDBSizeLimit {};
+    unsigned int _batchSize {};
+    unsigned int _batchLatency {};
+    StorageEngine _storageEngine {};
+    unsigned int _largeValueThreshold {};
+    unsigned int _readerCheckInterval {};
+    unsigned int _maxReaderAge {};
+    MapAdvice _mapAdvice {};
+    RecordFormat _recordFormat {};
+    OpenMode _openMode {};
+
+    storage_engine::LMDBEnv* _envHandler { nullptr };
+    void* _readTxnPool { nullptr };
+
+    // open the environment of the database with the given settings, or share the one already open,
+    // while holding the lock of the instances
+    void openInstance(const ContextSetting& setting);
+
+    void retainInstance();
+
+    void releaseInstance() noexcept;
+
+    // copy every setting of another context, but neither its environment nor its reference
+    void copySettings(const Context& ctx);
 
     struct LMDBInstance {
         storage_engine::LMDBEnv* _handler;
+        void* _readTxnPool;
+        void* _batchWriter;
         unsigned int _refCount;
+        bool _readOnly;
     };
 
     static std::unordered_map<std::string, LMDBInstance> _underlying;
@@ -124,6 +242,15 @@ public:
 
     void rollback() noexcept;
 
+    // a savepoint marks the work done so far; rollbackTo() discards the work done since the innermost
+    // savepoint and release() keeps it, both ending that savepoint. While a savepoint is set, a failed
+    // operation only discards the work done since the savepoint instead of the whole transaction
+    void savepoint();
+
+    void rollbackTo();
+
+    void release();
+
     TxnMode getTxnMode() const { return _txnMode; }
 
     bool isCompleted() const { return _txnBase == nullptr; }
@@ -138,6 +265,16 @@ public:
 
     void renameClass(const std::string& oldClassName, const std::string& newClassName);
 
+    // trains a dictionary from a sample of the records of the class and compresses all of them with it,
+    // records written later are compressed too; calling it again retrains the dictionary
+    CompressionStats enableCompression(const std::string& className, size_t maxDictionarySize = 8192);
+
+    void disableCompression(const std::string& className);
+
+    // rewrites the records of the class in the format, which records of the class written later are in too,
+    // and returns the number of records which were in the other format
+    size_t rewriteRecords(const std::string& className, RecordFormat recordFormat);
+
     const PropertyDescriptor addProperty(const std::string& className,
         const std::string& propertyName,
         PropertyType type);
@@ -156,6 +293,8 @@ public:
 
     const DBInfo getDBInfo() const;
 
+    const StorageStats getStorageStats() const;
+
     const std::vector<ClassDescriptor> getClasses() const;
 
     const std::vector<PropertyDescriptor> getProperties(const std::string& className) const;
@@ -181,7 +320,9 @@ public:
         const RecordDescriptor& dstVertexRecordDescriptor,
         const Record& record = Record {});
 
-    void update(const RecordDescriptor& recordDescriptor, const Record& record);
+    void update(const RecordDescriptor& recordDescriptor,
+        const Record& record,
+        UpdateMode mode = UpdateMode::REPLACE);
 
     void updateSrc(const RecordDescriptor& recordDescriptor, const RecordDescriptor& newSrcVertexRecordDescriptor);
 
@@ -223,6 +364,8 @@ public:
         const RecordDescriptor& dstVertexRecordDescriptor) const;
 
 private:
+    friend class Context;
+    friend class BulkLoader;
     friend class ResultSetCursor;
     friend class compare::RecordCompare;
     friend class validate::Validator;
@@ -231,6 +374,8 @@ private:
     friend class FindEdgeOperationBuilder;
     friend class TraverseOperationBuilder;
     friend class ShortestPathOperationBuilder;
+    friend class ShardedContext;
+    friend class ShardedTxn;
 
     friend struct schema::SchemaUtils;
     friend struct datarecord::DataRecordUtils;
@@ -256,6 +401,8 @@ private:
 
         adapter::schema::IndexAccess* dbIndex() const { return _index; }
 
+        void clearCache() noexcept;
+
     private:
         adapter::metadata::DBInfoAccess* _dbInfo;
         adapter::schema::ClassAccess* _class;
@@ -263,14 +410,341 @@ private:
         adapter::schema::IndexAccess* _index;
     };
 
+    struct ReadTxnPool;
+
+    static void* createReadTxnPool();
+
+    static void destroyReadTxnPool(void* pool) noexcept;
+
+    bool renewReadTxn();
+
+    bool recycleReadTxn() noexcept;
+
+    void rollbackOnError() noexcept;
+
+    void rebindAdapters();
+
     TxnMode _txnMode;
     const Context* _txnCtx;
-    storage_engine::LMDBTxn* _txnBase;
-    Adapter* _adapter;
-    relation::GraphUtils* _graph;
+    storage_engine::LMDBTxn* _txnBase { nullptr };
+    Adapter* _adapter { nullptr };
+    relation::GraphUtils* _graph { nullptr };
     mutable void* _schemaCache { nullptr };
 
     std::unordered_set<RecordId, RecordIdHash> _updatedRecords {};
+    // the records updated before each savepoint
+    std::vector<std::unordered_set<RecordId, RecordIdHash>> _savepoints {};
+};
+
+/**
+ * A group of mutations submitted to the single writer of an environment, which applies the groups
+ * submitted by all threads in one write transaction per batch window and commits them together.
+ * A batch must not outlive the context it has been created from.
+ */
+class BatchTxn {
+public:
+    struct Mutation {
+        enum class Type {
+            ADD_VERTEX,
+            ADD_EDGE,
+            UPDATE,
+            REMOVE
+        };
+
+        Type type { Type::ADD_VERTEX };
+        std::string className {};
+        RecordDescriptor recordDescriptor {};
+        RecordDescriptor srcVertexRecordDescriptor {};
+        RecordDescriptor dstVertexRecordDescriptor {};
+        Record record {};
+    };
+
+    ~BatchTxn() noexcept = default;
+
+    BatchTxn(const BatchTxn& batchTxn) = delete;
+
+    BatchTxn(BatchTxn&& batchTxn) noexcept = default;
+
+    BatchTxn& operator=(const BatchTxn& batchTxn) = delete;
+
+    BatchTxn& operator=(BatchTxn&& batchTxn) noexcept = default;
+
+    BatchTxn& addVertex(const std::string& className, const Record& record = Record {});
+
+    BatchTxn& addEdge(const std::string& className,
+        const RecordDescriptor& srcVertexRecordDescriptor,
+        const RecordDescriptor& dstVertexRecordDescriptor,
+        const Record& record = Record {});
+
+    BatchTxn& update(const RecordDescriptor& recordDescriptor, const Record& record);
+
+    BatchTxn& remove(const RecordDescriptor& recordDescriptor);
+
+    size_t size() const { return _mutations.size(); }
+
+    /**
+     * Submit the mutations to the writer and leave this batch empty for reuse.
+     * The future is completed with one descriptor per mutation, in order, once the write transaction
+     * containing them has been committed, or with the error that has made this batch fail.
+     * With a map growth policy, a write transaction which runs out of map space is replayed once
+     * the map has been grown, which waits for the other transactions of this process to end.
+     */
+    std::future<std::vector<RecordDescriptor>> commit();
+
+    void rollback() noexcept;
+
+private:
+    friend class Context;
+
+    struct Writer;
+
+    BatchTxn(void* writer);
+
+    static void* createWriter(const Context& ctx);
+
+    static void destroyWriter(void* writer) noexcept;
+
+    void* _writer { nullptr };
+    std::vector<Mutation> _mutations {};
+};
+
+/**
+ * Loads vertices and edges into a single write transaction faster than Transaction::addVertex and addEdge.
+ * Position ids are allocated in memory and records are appended to the end of their tables,
+ * while relation and index entries are buffered and written in key order when the load is committed.
+ * Unique index violations are therefore only reported by commit(), which then rolls the whole load back.
+ */
+class BulkLoader {
+public:
+    ~BulkLoader() noexcept;
+
+    BulkLoader(const BulkLoader& loader) = delete;
+
+    BulkLoader(BulkLoader&& loader) noexcept;
+
+    BulkLoader& operator=(const BulkLoader& loader) = delete;
+
+    BulkLoader& operator=(BulkLoader&& loader) noexcept;
+
+    const RecordDescriptor addVertex(const std::string& className, const Record& record = Record {});
+
+    const RecordDescriptor addEdge(const std::string& className,
+        const RecordDescriptor& srcVertexRecordDescriptor,
+        const RecordDescriptor& dstVertexRecordDescriptor,
+        const Record& record = Record {});
+
+    void commit();
+
+    void rollback() noexcept;
+
+private:
+    friend class Context;
+
+    struct LoadState;
+
+    BulkLoader(Context& ctx);
+
+    Transaction _txn;
+    LoadState* _state { nullptr };
+};
+
+/**
+ * Creates a database whose classes are spread over several environments under one root folder, so that
+ * classes in different shards are written by different writers. A class is kept in the shard its name
+ * hashes to unless it is placed in another one, or partitioned over every shard by a key of its records.
+ * A subclass must be placed along with its super class. An edge class connecting vertices of different shards
+ * must be partitioned, so that it exists in the shards of both of its ends.
+ */
+class ShardedContextInitializer {
+public:
+    ShardedContextInitializer(const std::string& rootPath, unsigned int numShards);
+
+    ~ShardedContextInitializer() = default;
+
+    // applied to the initializer of every shard, e.g. to set its map size or durability
+    ShardedContextInitializer& setShardSettings(std::function<void(ContextInitializer&)> settings);
+
+    ShardedContextInitializer& placeClass(const std::string& className, unsigned int shard);
+
+    ShardedContextInitializer& partitionClass(const std::string& className);
+
+    ShardedContext init();
+
+private:
+    std::string _rootPath {};
+    unsigned int _numShards {};
+    std::function<void(ContextInitializer&)> _shardSettings {};
+    std::map<std::string, int> _placements {};
+};
+
+class ShardedContext {
+public:
+    ShardedContext() = default;
+
+    ~ShardedContext() noexcept = default;
+
+    ShardedContext(const std::string& rootPath);
+
+    ShardedContext(const ShardedContext& ctx) = default;
+
+    ShardedContext(ShardedContext&& ctx) noexcept = default;
+
+    ShardedContext& operator=(const ShardedContext& ctx) = default;
+
+    ShardedContext& operator=(ShardedContext&& ctx) noexcept = default;
+
+    std::string getRootPath() const { return _rootPath; }
+
+    unsigned int getNumShards() const { return static_cast<unsigned int>(_shards.size()); }
+
+    Context& getShard(unsigned int shard);
+
+    bool isPartitioned(const std::string& className) const;
+
+    // the shard of a class which is not partitioned
+    unsigned int getShardOf(const std::string& className) const;
+
+    // the shard of a record of a partitioned class, chosen by the hash of its key
+    unsigned int getShardOf(const std::string& className, const Bytes& key) const;
+
+    // the shards which store the records of a class
+    std::vector<unsigned int> getShardsOf(const std::string& className) const;
+
+    ShardedTxn beginTxn(const TxnMode& txnMode = TxnMode::READ_WRITE);
+
+    // takes the writers of the shards up front, in the order of their shards
+    ShardedTxn beginTxn(const TxnMode& txnMode, const std::vector<unsigned int>& shards);
+
+    // the shards which have committed the last write over several shards while the others have not,
+    // empty unless that commit has failed part way or the process has stopped in the middle of it
+    std::vector<unsigned int> getPartialCommit() const;
+
+    // once the records written by a partial commit have been repaired
+    void clearPartialCommit();
+
+private:
+    friend class ShardedContextInitializer;
+    friend class ShardedTxn;
+
+    struct Coordinator;
+
+    std::shared_ptr<Coordinator> openCoordinator();
+
+    std::string _rootPath {};
+    std::vector<Context> _shards {};
+    // the shard of each placed class, or -1 for a partitioned one
+    std::map<std::string, int> _placements {};
+    // shared by the sharded contexts of the same root folder
+    std::shared_ptr<Coordinator> _coordinator {};
+};
+
+/**
+ * A transaction over the shards of a sharded context. A read-only transaction takes the snapshots of every
+ * shard together, so that it sees a write over several shards in all of them or in none. A read-write
+ * transaction begins the transaction of a shard the first time it is used, which waits for the writer of
+ * that shard. Two transactions taking the writers of the same shards in different orders can wait for each
+ * other forever, so shards are to be first used in ascending order, or named when the transaction begins;
+ * addEdge() and remove() take the writers they need in that order. A write over several shards is recorded
+ * in each of them before they commit one after the other: if the commit of a shard fails, the shards before
+ * it stay committed, the ones after it are rolled back, and the partial commit is reported by
+ * NOGDB_CTX_PARTIAL_COMMIT and by ShardedContext::getPartialCommit(), also after a restart.
+ */
+class ShardedTxn {
+public:
+    ~ShardedTxn() noexcept;
+
+    ShardedTxn(const ShardedTxn& txn) = delete;
+
+    ShardedTxn(ShardedTxn&& txn) noexcept = default;
+
+    ShardedTxn& operator=(const ShardedTxn& txn) = delete;
+
+    ShardedTxn& operator=(ShardedTxn&& txn) noexcept = default;
+
+    Transaction& getShard(unsigned int shard);
+
+    Transaction& getShardOf(const std::string& className);
+
+    Transaction& getShardOf(const std::string& className, const Bytes& key);
+
+    // to the shard of the class, or to every shard when it is partitioned
+    void addClass(const std::string& className, ClassType type);
+
+    void addProperty(const std::string& className, const std::string& propertyName, PropertyType type);
+
+    // a unique index of a partitioned class is only unique within each shard
+    void addIndex(const std::string& className, const std::string& propertyName, bool isUnique = false);
+
+    ShardedResultSet find(const std::string& className);
+
+    ShardedResultSet find(const std::string& className, const Condition& condition);
+
+    ShardedResultSet find(const std::string& className, const MultiCondition& multiCondition);
+
+    // an edge between vertices of different shards is added to both shards, from the source to a proxy of
+    // the destination and from a proxy of the source to the destination; returns the edge in each shard
+    std::vector<ShardedRecordDescriptor> addEdge(const std::string& className,
+        const ShardedRecordDescriptor& srcVertex,
+        const ShardedRecordDescriptor& dstVertex,
+        const Record& record = Record {});
+
+    // removes the edges of a vertex in other shards too, or the edge in the other shard of an edge
+    void remove(const ShardedRecordDescriptor& recordDescriptor);
+
+    ShardedResultSet findInEdge(const ShardedRecordDescriptor& vertex);
+
+    ShardedResultSet findOutEdge(const ShardedRecordDescriptor& vertex);
+
+    // the vertex at an end of an edge, fetched from its own shard if the edge is between shards
+    ShardedResult fetchSrc(const ShardedRecordDescriptor& edge);
+
+    ShardedResult fetchDst(const ShardedRecordDescriptor& edge);
+
+    // the vertices reached from a vertex within the depths, following the edges between shards
+    ShardedResultSet traverseIn(const ShardedRecordDescriptor& vertex, unsigned int minDepth, unsigned int maxDepth);
+
+    ShardedResultSet traverseOut(const ShardedRecordDescriptor& vertex, unsigned int minDepth, unsigned int maxDepth);
+
+    void commit();
+
+    void rollback() noexcept;
+
+    TxnMode getTxnMode() const { return _txnMode; }
+
+private:
+    friend class ShardedContext;
+
+    ShardedTxn(ShardedContext& ctx, const TxnMode& txnMode);
+
+    template <typename Find>
+    ShardedResultSet findAll(const std::string& className, Find find);
+
+    ShardedResultSet findEdges(const ShardedRecordDescriptor& vertex, bool isOut);
+
+    ShardedResult fetchEnd(const ShardedRecordDescriptor& edge, bool isDst);
+
+    ShardedResultSet traverseAll(const ShardedRecordDescriptor& vertex, unsigned int minDepth, unsigned int maxDepth, bool isOut);
+
+    void beginShards(std::vector<unsigned int> shards);
+
+    // whether the committed shard has the class of the proxies
+    bool hasProxies(unsigned int shard) const;
+
+    // the class of the proxies of a shard, 0 if the shard has none and they are not to be created
+    ClassId proxyClass(unsigned int shard, bool create = false);
+
+    // the vertex a proxy stands for, or the vertex itself if it is not a proxy
+    ShardedResult resolve(unsigned int shard, Result&& result);
+
+    // the proxy at an end of an edge copied to another shard, and the copy there along with its own proxy
+    void removeProxy(unsigned int shard, const RecordDescriptor& proxy);
+
+    void commitShards(const std::vector<unsigned int>& shards);
+
+    ShardedContext* _ctx { nullptr };
+    TxnMode _txnMode { TxnMode::READ_ONLY };
+    std::vector<std::unique_ptr<Transaction>> _txns {};
+    std::vector<ClassId> _proxyClasses {};
 };
 
 }
@@ -47,6 +47,7 @@
 
 #define NOGDB_TXN_INVALID_MODE 0xd00
 #define NOGDB_TXN_COMPLETED 0xd01
+#define NOGDB_TXN_NO_SAVEPOINT 0xd02
 #define NOGDB_TXN_UNKNOWN_ERR 0xfff
 
 #define NOGDB_CTX_INVALID_CLASSTYPE 0x1000
@@ -71,6 +72,9 @@
 #define NOGDB_CTX_UNINITIALIZED 0x7000
 #define NOGDB_CTX_ALREADY_INITIALIZED 0x7010
 #define NOGDB_CTX_DBSETTING_MISSING 0x7020
+#define NOGDB_CTX_INVALID_SHARD 0x7030
+#define NOGDB_CTX_READ_ONLY 0x7040
+#define NOGDB_CTX_PARTIAL_COMMIT 0x7050
 #define NOGDB_CTX_MAXCLASS_REACH 0x9fd0
 #define NOGDB_CTX_MAXPROPERTY_REACH 0x9fd1
 #define NOGDB_CTX_MAXINDEX_REACH 0x9fd2
@@ -317,6 +321,12 @@ public:
             return "NOGDB_CTX_ALREADY_INITIALIZED: A database already exists";
         case NOGDB_CTX_DBSETTING_MISSING:
             return "NOGDB_CTX_DBSETTING_MISSING: A database setting is missing";
+        case NOGDB_CTX_INVALID_SHARD:
+            return "NOGDB_CTX_INVALID_SHARD: A shard doesn't exist or a class is not stored in a single shard";
+        case NOGDB_CTX_READ_ONLY:
+            return "NOGDB_CTX_READ_ONLY: A context opened read-only can't write or convert a database";
+        case NOGDB_CTX_PARTIAL_COMMIT:
+            return "NOGDB_CTX_PARTIAL_COMMIT: A write over several shards has only been committed by some of them";
         case NOGDB_CTX_UNKNOWN_ERR:
         default:
             return "NOGDB_CTX_UNKNOWN_ERR: Unknown";
@@ -338,6 +348,8 @@ public:
             return "NOGDB_TXN_INVALID_MODE: An operation couldn't be executed due to an invalid transaction mode";
         case NOGDB_TXN_COMPLETED:
             return "NOGDB_TXN_COMPLETED: An operation couldn't be executed due to a completed transaction";
+        case NOGDB_TXN_NO_SAVEPOINT:
+            return "NOGDB_TXN_NO_SAVEPOINT: A savepoint couldn't be ended since none has been set";
         case NOGDB_TXN_UNKNOWN_ERR:
         default:
             return "NOGDB_TXN_UNKNOWN_ERR: Unknown";
@@ -438,6 +450,11 @@ public:
         return ("(FATAL) " + _what).c_str();
     }
 
+    int code() const noexcept
+    {
+        return _code;
+    }
+
 private:
   const int _code;
   const std::string _func {};
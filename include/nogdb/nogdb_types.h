@@ -23,9 +23,11 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
@@ -63,6 +65,10 @@ namespace adapter {
         class PropertyAccess;
 
         class IndexAccess;
+
+        struct PropertyAccessInfo;
+
+        class PropertyIdMapInfo;
     }
 }
 
@@ -126,6 +132,41 @@ enum class TxnMode {
     READ_WRITE
 };
 
+enum class DurabilityMode {
+    FULL, // flush data and meta pages on every commit
+    NO_META_SYNC, // flush data pages on every commit, meta pages on the next flush
+    ASYNC // flush nothing on commit, a background thread flushes at a fixed interval
+};
+
+enum class StorageEngine {
+    LMDB, // memory-mapped files on disk
+    MEMORY // in memory only, discarded when the last context of the database is released
+};
+
+enum class MapAdvice {
+    NORMAL, // the default read-ahead of the kernel
+    RANDOM, // no read-ahead (MDB_NORDAHEAD), for random access to a database larger than the memory
+    SEQUENTIAL, // aggressive read-ahead, for scans
+    WILLNEED, // read the whole data file ahead in the background once it is opened
+    HUGEPAGE // back the map with transparent huge pages where the file system supports them
+};
+
+enum class OpenMode {
+    READ_WRITE, // the only mode which can write, and which converts a database written by an older version
+    READ_ONLY, // the data file is mapped read-only, readers still register in the lock file
+    READ_ONLY_NO_LOCK // the lock file is not used at all, only when no process writes the database meanwhile
+};
+
+enum class RecordFormat {
+    V1, // a sequence of property blocks, read one after another to find a property
+    V2 // a table of the property ids and the offsets of their blocks ahead of the blocks
+};
+
+enum class UpdateMode {
+    REPLACE, // the record replaces every property of the existing one
+    PATCH // only the properties set in the record are written, the others keep their values
+};
+
 typedef uint16_t ClassId;
 typedef uint16_t PropertyId;
 typedef uint32_t PositionId;
@@ -145,6 +186,63 @@ struct DBInfo {
     IndexId numIndex;
 };
 
+struct TableStat {
+    std::string name; // class name, <class>.<property> of an index or relations#in/out
+    unsigned int depth;
+    size_t branchPages;
+    size_t leafPages;
+    size_t overflowPages;
+    size_t entries;
+};
+
+struct StorageStats {
+    std::string dbPath;
+    unsigned int pageSize;
+    size_t mapSize;
+    size_t usedSize;
+    size_t lastPageId;
+    unsigned int maxReaders;
+    unsigned int numReaders;
+    std::vector<TableStat> classes;
+    std::vector<TableStat> indexes; // signed numeric indexes have an extra <class>.<property>#negative table
+    std::vector<TableStat> relations;
+};
+
+struct BackupStats {
+    std::string path; // empty for a backup streamed to a file descriptor
+    bool compacted;
+    size_t bytesWritten;
+    double durationMs;
+};
+
+struct WarmupStats {
+    size_t tables;
+    size_t entries;
+    size_t residentPagesBefore; // pages of the data file in memory, as reported by mincore
+    size_t residentPages;
+    size_t totalPages; // pages of the data file in use
+    double durationMs;
+};
+
+struct ReaderStats {
+    unsigned int numReaders;
+    unsigned int staleReadersCleared; // slots left by dead processes, since the database was opened
+    size_t lastTxnId;
+    size_t oldestReaderTxnId; // the oldest snapshot being read, 0 without any reader
+    int oldestReaderPid; // of the reader open for the longest time
+    double oldestReaderAgeMs; // measured from the first check which has seen the reader
+    size_t freePages;
+    size_t pinnedFreePages; // free pages which cannot be reused until the oldest snapshot is released
+};
+
+struct CompressionStats {
+    std::string className;
+    size_t records;
+    size_t dictionarySize;
+    size_t rawBytes; // the records before compression
+    size_t compressedBytes; // the records as they are stored
+};
+
 class Transaction;
 
 class Bytes {
@@ -199,8 +297,14 @@ public:
 
     explicit operator unsigned char*() const;
 
+    // a writable value: the object is given its own copy first if the value is shared with its copies. A value
+    // of up to INLINE_CAPACITY bytes is stored in the object itself, and a pointer to it stops being valid
+    // once the object is moved
     unsigned char* getRaw() const;
 
+    // the value to be read only, which a copy of the object may share
+    const unsigned char* getConstRaw() const;
+
     size_t size() const;
 
     bool empty() const;
@@ -214,7 +318,8 @@ public:
     template <typename T>
     T convert() const
     {
-        unsigned char* ptr = getRaw();
+        // a pointer into the value may be written through, so it points into a value of the object's own
+        unsigned char* ptr = (std::is_pointer<T>::value) ? getRaw() : const_cast<unsigned char*>(getConstRaw());
         size_t size = this->size();
         return Converter<T>::convert(ptr, size, false);
     }
@@ -226,8 +331,24 @@ public:
     }
 
 private:
+    /**
+     * A value up to INLINE_CAPACITY bytes is stored in the object itself, and a larger one in a buffer shared
+     * by the copies of the object, so that copying never allocates. getRaw() gives the object its own copy
+     * of a shared value before it can be written.
+     */
+    static constexpr size_t INLINE_CAPACITY = 16;
+
     unsigned char* _value { nullptr };
     size_t _size { 0 };
+    // the value itself when inline, otherwise the reference counted header of the shared buffer
+    unsigned char _inline[INLINE_CAPACITY] {};
+
+    inline bool isInline() const { return _value == _inline; }
+
+    // a buffer of the size, inline or newly shared, to write the value into
+    unsigned char* allocate(size_t size);
+
+    void release() noexcept;
 
     static Bytes merge(const Bytes& bytes1, const Bytes& byte2);
 
@@ -561,10 +682,21 @@ public:
 
     explicit Record() = default;
 
+    Record(const Record& other);
+
+    Record& operator=(const Record& other);
+
+    Record(Record&& other) noexcept;
+
+    Record& operator=(Record&& other) noexcept;
+
     template <typename T>
     Record& set(const std::string& propName, const T& value)
     {
         if (!propName.empty() && !isBasicInfo(propName)) {
+            if (propertyInfos) {
+                unflatten();
+            }
             properties[propName] = Bytes::Converter<T>::toBytes(value);
         }
         return *this;
@@ -573,6 +705,9 @@ public:
     template <typename T>
     Record& setIfNotExists(const std::string& propName, const T& value)
     {
+        if (propertyInfos) {
+            unflatten();
+        }
         if (properties.find(propName) == properties.cend()) {
             set(propName, value);
         }
@@ -628,6 +763,7 @@ private:
     friend class algorithm::GraphTraversal;
     friend class sql_parser::Record;
     friend class ResultSetCursor;
+    friend class RecordView;
 
     Record(PropertyToBytesMap properties);
 
@@ -637,11 +773,82 @@ private:
     {
     }
 
+    /**
+     * A record decoded from the database keeps its properties flat until they are modified: every value
+     * in one buffer, and the id, offset and size of each value in it, named through the property table
+     * of its class. The map of properties is only built when getAll() is called.
+     */
+    struct FlatProperty {
+        PropertyId id;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    using PropertyIdMap = adapter::schema::PropertyIdMapInfo;
+
+    Record(std::vector<unsigned char> flatValues,
+        std::vector<FlatProperty> flatProperties,
+        std::shared_ptr<const PropertyIdMap> propertyInfos)
+        : flatValues(std::move(flatValues))
+        , flatProperties(std::move(flatProperties))
+        , propertyInfos(std::move(propertyInfos))
+    {
+    }
+
+    /**
+     * The basic info of a record decoded from the database is kept as is until it is read, and only written
+     * into the map of basic info when getBasicInfo() is called. A basic info set as bytes, such as the depth
+     * of a traversal, takes precedence over it. The class name is shared by the records of a class.
+     */
+    struct LazyBasicInfo {
+        std::shared_ptr<const std::string> className;
+        RecordId rid;
+        uint32_t depth;
+        uint64_t version;
+    };
+
     inline bool isBasicInfo(const std::string& str) const { return str.at(0) == '@'; }
 
-    PropertyToBytesMap properties {};
+    mutable PropertyToBytesMap properties {};
     mutable PropertyToBytesMap basicProperties {};
 
+    /**
+     * The const accessors of one record may be called from several threads at once. The map of properties
+     * and the map of basic info are then filled once, under a lock, by the first of them needing it, while
+     * the flags below tell the others whether it is done. A record being modified is not shared.
+     */
+    LazyBasicInfo lazyBasicInfo {};
+    // whether the lazy basic info has not been written into the map of basic info yet
+    mutable std::atomic<bool> hasLazyBasicInfo { false };
+
+    std::vector<unsigned char> flatValues {};
+    std::vector<FlatProperty> flatProperties {};
+    // only set while the properties are flat
+    std::shared_ptr<const PropertyIdMap> propertyInfos {};
+    // whether the map of properties has been built from the flat ones
+    mutable std::atomic<bool> mapped { false };
+
+    // whether a const accessor may still fill one of the maps
+    bool isPending() const;
+
+    const PropertyToBytesMap& map() const;
+
+    // the map of properties replaces the flat ones, before a modification
+    void unflatten();
+
+    const PropertyToBytesMap& basicInfo() const;
+
+    // whether a basic info is still read from the lazy basic info
+    bool isLazyBasicInfo(const std::string& propName) const;
+
+    Record& setLazyBasicInfo(std::shared_ptr<const std::string> className, const RecordId& rid, uint32_t depth,
+        uint64_t version);
+
+    bool find(const std::string& propName, const unsigned char*& value, size_t& size) const;
+
+    template <typename T>
+    T getNumeric(const std::string& propName) const;
+
     template <typename T>
     const Record& setBasicInfo(const std::string& propName, const T& value) const
     {
@@ -661,6 +868,100 @@ private:
     };
 };
 
+/**
+ * A read-only view of a record which decodes its properties straight from the memory of the database,
+ * without copying them into a Record. A view is valid until its transaction is completed, or in a
+ * read-write transaction, until the next modification.
+ */
+class RecordView {
+public:
+    RecordView() = default;
+
+    Bytes get(const std::string& propName) const;
+
+    uint8_t getTinyIntU(const std::string& propName) const;
+
+    int8_t getTinyInt(const std::string& propName) const;
+
+    uint16_t getSmallIntU(const std::string& propName) const;
+
+    int16_t getSmallInt(const std::string& propName) const;
+
+    uint32_t getIntU(const std::string& propName) const;
+
+    int32_t getInt(const std::string& propName) const;
+
+    uint64_t getBigIntU(const std::string& propName) const;
+
+    int64_t getBigInt(const std::string& propName) const;
+
+    double getReal(const std::string& propName) const;
+
+    std::string getText(const std::string& propName) const;
+
+    std::vector<std::string> getProperties() const;
+
+    std::string getClassName() const;
+
+    RecordId getRecordId() const;
+
+    uint32_t getDepth() const;
+
+    uint64_t getVersion() const;
+
+    size_t size() const;
+
+    bool empty() const;
+
+    Record toRecord() const;
+
+private:
+    friend class parser::RecordParser;
+    friend class ResultSetCursor;
+
+    using PropertyIdMap = adapter::schema::PropertyIdMapInfo;
+
+    RecordView(const unsigned char* data,
+        size_t size,
+        size_t offset,
+        std::shared_ptr<const PropertyIdMap> propertyInfos,
+        std::shared_ptr<const std::string> className,
+        const RecordId& rid,
+        VersionId version,
+        const storage_engine::LMDBTxn* txn,
+        std::shared_ptr<const std::vector<unsigned char>> buffer = nullptr)
+        : _data { data }
+        , _size { size }
+        , _offset { offset }
+        , _propertyInfos { std::move(propertyInfos) }
+        , _className { std::move(className) }
+        , _rid { rid }
+        , _version { version }
+        , _txn { txn }
+        , _buffer { std::move(buffer) }
+    {
+    }
+
+    const unsigned char* _data { nullptr };
+    size_t _size { 0 };
+    size_t _offset { 0 };
+    std::shared_ptr<const PropertyIdMap> _propertyInfos {};
+    // shared by the records of a class
+    std::shared_ptr<const std::string> _className {};
+    RecordId _rid { 0, 0 };
+    unsigned int _depth { 0 };
+    VersionId _version { 0 };
+    // to fetch the values stored out of line
+    const storage_engine::LMDBTxn* _txn { nullptr };
+    // owns the data when the record has been decompressed
+    std::shared_ptr<const std::vector<unsigned char>> _buffer {};
+
+    bool find(const std::string& propName, const unsigned char*& value, size_t& size) const;
+
+    template <typename T>
+    T getNumeric(const std::string& propName) const;
+};
+
 struct RecordDescriptor {
     RecordDescriptor() = default;
 
@@ -760,12 +1061,46 @@ struct Result {
     {
     }
 
+    Result(const RecordDescriptor& recordDescriptor_, Record&& record_)
+        : descriptor { recordDescriptor_ }
+        , record { std::move(record_) }
+    {
+    }
+
     RecordDescriptor descriptor {};
     Record record {};
 };
 
 typedef std::vector<Result> ResultSet;
 
+struct ShardedResult {
+    unsigned int shard;
+    RecordDescriptor descriptor;
+    Record record;
+};
+
+typedef std::vector<ShardedResult> ShardedResultSet;
+
+struct ShardedRecordDescriptor {
+    unsigned int shard;
+    RecordDescriptor descriptor;
+};
+
+struct ResultView {
+    ResultView() = default;
+
+    ResultView(const RecordDescriptor& recordDescriptor_, const RecordView& record_)
+        : descriptor { recordDescriptor_ }
+        , record { record_ }
+    {
+    }
+
+    RecordDescriptor descriptor {};
+    RecordView record {};
+};
+
+typedef std::vector<ResultView> ResultViewSet;
+
 class ResultSetCursor {
 public:
     friend class FindOperationBuilder;
@@ -807,13 +1142,19 @@ public:
 
     const Result* operator->() const;
 
+    ResultView getView() const;
+
 private:
     friend struct datarecord::DataRecordUtils;
 
     const Transaction* txn;
     std::vector<RecordDescriptor> metadata {};
     long long currentIndex;
-    Result result;
+    // the current record is only decoded when it is accessed
+    mutable Result result;
+    mutable bool resultLoaded { false };
+
+    bool moveTo(long long index);
 
     ResultSetCursor& addMetadata(const RecordDescriptor& recordDescriptor)
     {
@@ -1360,6 +1701,8 @@ protected:
 
     virtual ResultSetCursor getCursor() const = 0;
 
+    virtual ResultViewSet getView() const = 0;
+
     virtual unsigned long count() const = 0;
 
     const Transaction* _txn;
@@ -1411,6 +1754,8 @@ public:
 
     ResultSetCursor getCursor() const;
 
+    ResultViewSet getView() const;
+
     unsigned long count() const;
 
 private:
@@ -1469,6 +1814,8 @@ public:
 
     ResultSetCursor getCursor() const;
 
+    ResultViewSet getView() const;
+
     unsigned long count() const;
 
 private:
@@ -1530,6 +1877,8 @@ public:
 
     ResultSetCursor getCursor() const;
 
+    ResultViewSet getView() const;
+
     unsigned long count() const;
 
 private:
@@ -1602,6 +1951,8 @@ public:
 
     ResultSetCursor getCursor() const;
 
+    ResultViewSet getView() const;
+
     unsigned long count() const;
 
 private:
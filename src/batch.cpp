@@ -0,0 +1,271 @@
+/*
+ *  Copyright (C) 2019, NogDB <https://nogdb.org>
+ *  <nogdb at throughwave dot co dot th>
+ *
+ *  This file is part of libnogdb, the NogDB core library in C++.
+ *
+ *  libnogdb is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "storage_engine.hpp"
+
+#include "nogdb/nogdb.h"
+
+namespace nogdb {
+
+struct BatchTxn::Writer {
+    struct Submission {
+        std::vector<Mutation> mutations;
+        std::promise<std::vector<RecordDescriptor>> promise;
+        std::chrono::steady_clock::time_point submittedAt;
+    };
+
+    Writer(const Context& ctx)
+        : maxBatchSize { ctx._batchSize }
+        , maxLatency { ctx._batchLatency }
+    {
+        // borrow the environment without taking a reference, as the writer is destroyed
+        // by the last context releasing it
+        context.copySettings(ctx);
+        context._envHandler = ctx._envHandler;
+        context._readTxnPool = ctx._readTxnPool;
+        thread = std::thread([this]() { run(); });
+    }
+
+    ~Writer() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        cond.notify_one();
+        thread.join();
+        context._envHandler = nullptr;
+        context._readTxnPool = nullptr;
+    }
+
+    void submit(Submission&& submission)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingMutations += submission.mutations.size();
+            queue.push_back(std::move(submission));
+        }
+        cond.notify_one();
+    }
+
+    void run()
+    {
+        auto lock = std::unique_lock<std::mutex>(mutex);
+        while (true) {
+            cond.wait(lock, [this]() { return stopped || !queue.empty(); });
+            if (queue.empty()) {
+                break;
+            }
+            // keep the window open for more submissions until it is full or its latency bound is reached
+            auto deadline = queue.front().submittedAt + std::chrono::milliseconds(maxLatency);
+            cond.wait_until(lock, deadline, [this]() { return stopped || pendingMutations >= maxBatchSize; });
+            auto group = std::vector<Submission> {};
+            auto groupSize = size_t { 0 };
+            while (!queue.empty() && (group.empty() || groupSize + queue.front().mutations.size() <= maxBatchSize)) {
+                groupSize += queue.front().mutations.size();
+                group.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+            pendingMutations -= groupSize;
+            lock.unlock();
+            apply(group);
+            lock.lock();
+        }
+    }
+
+    void apply(std::vector<Submission>& group) noexcept
+    {
+        try {
+            auto results = std::vector<std::vector<RecordDescriptor>> {};
+            while (true) {
+                auto resizeCount = 0UL;
+                try {
+                    auto txn = Transaction(context, TxnMode::READ_WRITE);
+                    resizeCount = context._envHandler->getResizeCount();
+                    results.clear();
+                    results.reserve(group.size());
+                    for (const auto& submission : group) {
+                        results.emplace_back(apply(txn, submission.mutations));
+                    }
+                    txn.commit();
+                    break;
+                } catch (const FatalError& error) {
+                    if (!replayable(error.code(), resizeCount)) {
+                        throw;
+                    }
+                } catch (const Error& error) {
+                    if (!replayable(error.code(), resizeCount)) {
+                        throw;
+                    }
+                }
+            }
+            for (size_t i = 0; i < group.size(); ++i) {
+                group[i].promise.set_value(std::move(results[i]));
+            }
+        } catch (...) {
+            if (group.size() == 1) {
+                group.front().promise.set_exception(std::current_exception());
+            } else {
+                // apply every submission on its own so that only the failing one is rejected
+                for (auto& submission : group) {
+                    auto single = std::vector<Submission> {};
+                    single.push_back(std::move(submission));
+                    apply(single);
+                }
+            }
+        }
+    }
+
+    /**
+     * A batch which has run out of map space is replayed once the map has been grown,
+     * which happens as soon as no other transaction of this process is running.
+     */
+    bool replayable(int errorCode, unsigned long resizeCount)
+    {
+        return errorCode == MDB_MAP_FULL && context._envHandler->awaitGrowth(resizeCount);
+    }
+
+    static std::vector<RecordDescriptor> apply(Transaction& txn, const std::vector<Mutation>& mutations)
+    {
+        auto recordDescriptors = std::vector<RecordDescriptor> {};
+        recordDescriptors.reserve(mutations.size());
+        for (const auto& mutation : mutations) {
+            switch (mutation.type) {
+            case Mutation::Type::ADD_VERTEX:
+                recordDescriptors.emplace_back(txn.addVertex(mutation.className, mutation.record));
+                break;
+            case Mutation::Type::ADD_EDGE:
+                recordDescriptors.emplace_back(txn.addEdge(mutation.className,
+                    mutation.srcVertexRecordDescriptor, mutation.dstVertexRecordDescriptor, mutation.record));
+                break;
+            case Mutation::Type::UPDATE:
+                txn.update(mutation.recordDescriptor, mutation.record);
+                recordDescriptors.emplace_back(mutation.recordDescriptor);
+                break;
+            case Mutation::Type::REMOVE:
+                txn.remove(mutation.recordDescriptor);
+                recordDescriptors.emplace_back(mutation.recordDescriptor);
+                break;
+            }
+        }
+        return recordDescriptors;
+    }
+
+    const size_t maxBatchSize;
+    const unsigned int maxLatency;
+    Context context {};
+    std::mutex mutex {};
+    std::condition_variable cond {};
+    std::deque<Submission> queue {};
+    size_t pendingMutations { 0 };
+    bool stopped { false };
+    std::thread thread {};
+};
+
+void* BatchTxn::createWriter(const Context& ctx)
+{
+    return new Writer(ctx);
+}
+
+void BatchTxn::destroyWriter(void* writer) noexcept
+{
+    delete static_cast<Writer*>(writer);
+}
+
+BatchTxn::BatchTxn(void* writer)
+    : _writer { writer }
+{
+}
+
+BatchTxn& BatchTxn::addVertex(const std::string& className, const Record& record)
+{
+    auto mutation = Mutation {};
+    mutation.type = Mutation::Type::ADD_VERTEX;
+    mutation.className = className;
+    mutation.record = record;
+    _mutations.emplace_back(std::move(mutation));
+    return *this;
+}
+
+BatchTxn& BatchTxn::addEdge(const std::string& className,
+    const RecordDescriptor& srcVertexRecordDescriptor,
+    const RecordDescriptor& dstVertexRecordDescriptor,
+    const Record& record)
+{
+    auto mutation = Mutation {};
+    mutation.type = Mutation::Type::ADD_EDGE;
+    mutation.className = className;
+    mutation.srcVertexRecordDescriptor = srcVertexRecordDescriptor;
+    mutation.dstVertexRecordDescriptor = dstVertexRecordDescriptor;
+    mutation.record = record;
+    _mutations.emplace_back(std::move(mutation));
+    return *this;
+}
+
+BatchTxn& BatchTxn::update(const RecordDescriptor& recordDescriptor, const Record& record)
+{
+    auto mutation = Mutation {};
+    mutation.type = Mutation::Type::UPDATE;
+    mutation.recordDescriptor = recordDescriptor;
+    mutation.record = record;
+    _mutations.emplace_back(std::move(mutation));
+    return *this;
+}
+
+BatchTxn& BatchTxn::remove(const RecordDescriptor& recordDescriptor)
+{
+    auto mutation = Mutation {};
+    mutation.type = Mutation::Type::REMOVE;
+    mutation.recordDescriptor = recordDescriptor;
+    _mutations.emplace_back(std::move(mutation));
+    return *this;
+}
+
+std::future<std::vector<RecordDescriptor>> BatchTxn::commit()
+{
+    auto submission = Writer::Submission {};
+    auto future = submission.promise.get_future();
+    if (_mutations.empty()) {
+        submission.promise.set_value(std::vector<RecordDescriptor> {});
+        return future;
+    }
+    submission.mutations = std::move(_mutations);
+    submission.submittedAt = std::chrono::steady_clock::now();
+    _mutations = std::vector<Mutation> {};
+    static_cast<Writer*>(_writer)->submit(std::move(submission));
+    return future;
+}
+
+void BatchTxn::rollback() noexcept
+{
+    _mutations.clear();
+}
+
+}
@@ -0,0 +1,329 @@
+/*
+ *  Copyright (C) 2019, NogDB <https://nogdb.org>
+ *  <nogdb at throughwave dot co dot th>
+ *
+ *  This file is part of libnogdb, the NogDB core library in C++.
+ *
+ *  libnogdb is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "datarecord_adapter.hpp"
+#include "index.hpp"
+#include "parser.hpp"
+#include "relation_adapter.hpp"
+#include "schema.hpp"
+#include "validate.hpp"
+
+#include "nogdb/nogdb.h"
+
+namespace nogdb {
+using namespace adapter::datarecord;
+using namespace adapter::relation;
+using namespace adapter::schema;
+using namespace schema;
+using namespace index;
+using parser::RecordParser;
+
+struct BulkLoader::LoadState {
+    struct ClassState {
+        ClassAccessInfo classInfo {};
+        PropertyNameMapInfo propertyNameMapInfo {};
+        PropertyNameMapIndex indexInfos {};
+        std::unique_ptr<DataRecord> dataRecord {};
+        std::unique_ptr<DataValue> dataValue {};
+        PositionId firstPositionId { 0 };
+        PositionId nextPositionId { 0 };
+    };
+
+    struct IndexBuffer {
+        PropertyAccessInfo propertyInfo {};
+        IndexAccessInfo indexInfo {};
+        std::vector<std::pair<Bytes, PositionId>> entries {};
+    };
+
+    ClassState& getClassState(const Transaction* txn, const std::string& className, ClassType type)
+    {
+        auto foundClass = classNames.find(className);
+        if (foundClass != classNames.cend()) {
+            auto& classState = classes.at(foundClass->second);
+            if (classState.classInfo.type != type) {
+                throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_MISMATCH_CLASSTYPE);
+            }
+            return classState;
+        }
+        auto classInfo = SchemaUtils::getValidClassInfo(txn, className, type);
+        auto& classState = classes[classInfo.id];
+        classState.classInfo = classInfo;
+        classState.propertyNameMapInfo = SchemaUtils::getPropertyNameMapInfo(txn, classInfo.id, classInfo.superClassId);
+        for (const auto& property : classState.propertyNameMapInfo) {
+            auto indexInfo = txn->_adapter->dbIndex()->getInfo(classInfo.id, property.second.id);
+            if (indexInfo.id != IndexId {}) {
+                classState.indexInfos.emplace(property.first, std::make_pair(property.second, indexInfo));
+            }
+        }
+        classState.dataRecord.reset(new DataRecord(txn->_txnBase, classInfo.id, type));
+        classState.firstPositionId = classState.dataRecord->getNextPositionId();
+        classState.nextPositionId = classState.firstPositionId;
+        classNames.emplace(className, classInfo.id);
+        return classState;
+    }
+
+    void insertExternalValues(const Transaction* txn,
+        ClassState& classState,
+        const PositionId& positionId,
+        const parser::ExternalValues& externalValues)
+    {
+        if (externalValues.empty()) {
+            return;
+        }
+        // the values table of a class is only opened once it has a value
+        if (!classState.dataValue) {
+            classState.dataValue.reset(new DataValue(txn->_txnBase, classState.classInfo.id));
+        }
+        classState.dataValue->insert(positionId, externalValues);
+    }
+
+    bool isLoadedVertex(const RecordDescriptor& recordDescriptor) const
+    {
+        auto foundClass = classes.find(recordDescriptor.rid.first);
+        return foundClass != classes.cend()
+            && foundClass->second.classInfo.type == ClassType::VERTEX
+            && recordDescriptor.rid.second >= foundClass->second.firstPositionId
+            && recordDescriptor.rid.second < foundClass->second.nextPositionId;
+    }
+
+    void bufferIndexEntries(const ClassState& classState, const PositionId& positionId, const Record& record)
+    {
+        for (const auto& info : classState.indexInfos) {
+            auto value = record.get(info.first);
+            if (value.empty()) {
+                continue;
+            }
+            auto& buffer = indexes[info.second.second.id];
+            if (buffer.entries.empty()) {
+                buffer.propertyInfo = info.second.first;
+                buffer.indexInfo = info.second.second;
+            }
+            buffer.entries.emplace_back(std::move(value), positionId);
+        }
+    }
+
+    static bool lessIndexValue(PropertyType type, const Bytes& lhs, const Bytes& rhs)
+    {
+        switch (type) {
+        case PropertyType::UNSIGNED_TINYINT:
+            return lhs.toTinyIntU() < rhs.toTinyIntU();
+        case PropertyType::UNSIGNED_SMALLINT:
+            return lhs.toSmallIntU() < rhs.toSmallIntU();
+        case PropertyType::UNSIGNED_INTEGER:
+            return lhs.toIntU() < rhs.toIntU();
+        case PropertyType::UNSIGNED_BIGINT:
+            return lhs.toBigIntU() < rhs.toBigIntU();
+        case PropertyType::TINYINT:
+            return lhs.toTinyInt() < rhs.toTinyInt();
+        case PropertyType::SMALLINT:
+            return lhs.toSmallInt() < rhs.toSmallInt();
+        case PropertyType::INTEGER:
+            return lhs.toInt() < rhs.toInt();
+        case PropertyType::BIGINT:
+            return lhs.toBigInt() < rhs.toBigInt();
+        case PropertyType::REAL:
+            return lhs.toReal() < rhs.toReal();
+        case PropertyType::TEXT:
+            return lhs.toText() < rhs.toText();
+        default:
+            return false;
+        }
+    }
+
+    static bool lessRelation(const RelationAccessInfo& lhs, const RelationAccessInfo& rhs)
+    {
+        return (lhs.vertexId != rhs.vertexId) ? lhs.vertexId < rhs.vertexId : lhs.edgeId < rhs.edgeId;
+    }
+
+    void flush(const Transaction* txn)
+    {
+        // relation entries sorted in the order of the relation table keys
+        std::sort(outRelations.begin(), outRelations.end(), lessRelation);
+        std::sort(inRelations.begin(), inRelations.end(), lessRelation);
+        RelationAccess outRel { txn->_txnBase, Direction::OUT };
+        for (const auto& info : outRelations) {
+            outRel.create(info);
+        }
+        RelationAccess inRel { txn->_txnBase, Direction::IN };
+        for (const auto& info : inRelations) {
+            inRel.create(info);
+        }
+        // each index is built in one pass over its entries sorted by value
+        for (auto& index : indexes) {
+            auto& buffer = index.second;
+            auto type = buffer.propertyInfo.type;
+            std::stable_sort(buffer.entries.begin(), buffer.entries.end(),
+                [type](const std::pair<Bytes, PositionId>& lhs, const std::pair<Bytes, PositionId>& rhs) {
+                    return lessIndexValue(type, lhs.first, rhs.first);
+                });
+            for (const auto& entry : buffer.entries) {
+                IndexUtils::insert(txn, buffer.propertyInfo, buffer.indexInfo, entry.second, entry.first);
+            }
+        }
+        for (const auto& classState : classes) {
+            if (classState.second.nextPositionId != classState.second.firstPositionId) {
+                classState.second.dataRecord->setNextPositionId(classState.second.nextPositionId);
+            }
+        }
+    }
+
+    std::unordered_map<ClassId, ClassState> classes {};
+    std::unordered_map<std::string, ClassId> classNames {};
+    std::vector<RelationAccessInfo> outRelations {};
+    std::vector<RelationAccessInfo> inRelations {};
+    std::map<IndexId, IndexBuffer> indexes {};
+};
+
+BulkLoader::BulkLoader(Context& ctx)
+    : _txn { ctx, TxnMode::READ_WRITE }
+    , _state { new LoadState {} }
+{
+}
+
+BulkLoader::~BulkLoader() noexcept
+{
+    rollback();
+}
+
+BulkLoader::BulkLoader(BulkLoader&& loader) noexcept
+    : _txn { std::move(loader._txn) }
+    , _state { loader._state }
+{
+    loader._state = nullptr;
+}
+
+BulkLoader& BulkLoader::operator=(BulkLoader&& loader) noexcept
+{
+    if (this != &loader) {
+        rollback();
+        _txn = std::move(loader._txn);
+        _state = loader._state;
+        loader._state = nullptr;
+    }
+    return *this;
+}
+
+const RecordDescriptor BulkLoader::addVertex(const std::string& className, const Record& record)
+{
+    BEGIN_VALIDATION(&_txn)
+        .isTxnValid()
+        .isTxnCompleted()
+        .isClassNameValid(className);
+
+    auto& classState = _state->getClassState(&_txn, className, ClassType::VERTEX);
+    auto externalValues = parser::ExternalValues {};
+    auto recordBlob = RecordParser::parseRecord(
+        record, classState.propertyNameMapInfo, _txn._txnCtx->getLargeValueThreshold(), externalValues,
+        classState.dataRecord->getRecordFormat(_txn._txnCtx->getRecordFormat()));
+    auto positionId = classState.nextPositionId;
+    try {
+        if (_txn._txnCtx->isVersionEnabled()) {
+            classState.dataRecord->append(positionId, RecordParser::parseVertexRecordWithVersion(recordBlob, VersionId { 1 }));
+        } else {
+            classState.dataRecord->append(positionId, recordBlob);
+        }
+        _state->insertExternalValues(&_txn, classState, positionId, externalValues);
+    } catch (const Error& error) {
+        rollback();
+        throw NOGDB_FATAL_ERROR(error);
+    }
+    ++classState.nextPositionId;
+    _state->bufferIndexEntries(classState, positionId, record);
+    return RecordDescriptor { classState.classInfo.id, positionId };
+}
+
+const RecordDescriptor BulkLoader::addEdge(const std::string& className,
+    const RecordDescriptor& srcVertexRecordDescriptor,
+    const RecordDescriptor& dstVertexRecordDescriptor,
+    const Record& record)
+{
+    BEGIN_VALIDATION(&_txn)
+        .isTxnValid()
+        .isTxnCompleted()
+        .isClassNameValid(className);
+    // vertices loaded by this loader are known to exist without looking them up
+    if (!_state->isLoadedVertex(srcVertexRecordDescriptor)) {
+        BEGIN_VALIDATION(&_txn).isExistingSrcVertex(srcVertexRecordDescriptor);
+    }
+    if (!_state->isLoadedVertex(dstVertexRecordDescriptor)) {
+        BEGIN_VALIDATION(&_txn).isExistingDstVertex(dstVertexRecordDescriptor);
+    }
+
+    auto& classState = _state->getClassState(&_txn, className, ClassType::EDGE);
+    auto externalValues = parser::ExternalValues {};
+    auto recordBlob = RecordParser::parseRecord(
+        record, classState.propertyNameMapInfo, _txn._txnCtx->getLargeValueThreshold(), externalValues,
+        classState.dataRecord->getRecordFormat(_txn._txnCtx->getRecordFormat()));
+    auto vertexBlob = RecordParser::parseEdgeVertexSrcDst(srcVertexRecordDescriptor.rid, dstVertexRecordDescriptor.rid);
+    auto positionId = classState.nextPositionId;
+    try {
+        if (_txn._txnCtx->isVersionEnabled()) {
+            classState.dataRecord->append(positionId,
+                RecordParser::parseEdgeRecordWithVersion(vertexBlob, recordBlob, VersionId { 1 }));
+        } else {
+            classState.dataRecord->append(positionId, vertexBlob + recordBlob);
+        }
+        _state->insertExternalValues(&_txn, classState, positionId, externalValues);
+    } catch (const Error& error) {
+        rollback();
+        throw NOGDB_FATAL_ERROR(error);
+    }
+    ++classState.nextPositionId;
+    auto edgeId = RecordId { classState.classInfo.id, positionId };
+    _state->outRelations.emplace_back(srcVertexRecordDescriptor.rid, edgeId, dstVertexRecordDescriptor.rid);
+    _state->inRelations.emplace_back(dstVertexRecordDescriptor.rid, edgeId, srcVertexRecordDescriptor.rid);
+    _state->bufferIndexEntries(classState, positionId, record);
+    return RecordDescriptor { edgeId };
+}
+
+void BulkLoader::commit()
+{
+    BEGIN_VALIDATION(&_txn).isTxnCompleted();
+    try {
+        _state->flush(&_txn);
+    } catch (...) {
+        rollback();
+        throw;
+    }
+    delete _state;
+    _state = nullptr;
+    _txn.commit();
+}
+
+void BulkLoader::rollback() noexcept
+{
+    if (_state) {
+        delete _state;
+        _state = nullptr;
+    }
+    _txn.rollback();
+}
+
+}
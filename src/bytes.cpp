@@ -19,19 +19,51 @@
  *
  */
 
+#include <atomic>
+#include <cstring>
+#include <new>
+
 #include "nogdb/nogdb_types.h"
 
 namespace nogdb {
 
+namespace {
+    // the header of a value which is not inline, counting the objects referring to it
+    struct SharedBuffer {
+        std::atomic<size_t> references;
+        // an array allocated with new[] and given to the object, otherwise the value follows the header
+        unsigned char* adopted;
+    };
+
+    SharedBuffer* getSharedBuffer(const unsigned char* storage)
+    {
+        auto sharedBuffer = static_cast<SharedBuffer*>(nullptr);
+        memcpy(&sharedBuffer, storage, sizeof(sharedBuffer));
+        return sharedBuffer;
+    }
+
+    void setSharedBuffer(unsigned char* storage, SharedBuffer* sharedBuffer)
+    {
+        memcpy(storage, &sharedBuffer, sizeof(sharedBuffer));
+    }
+}
+
 Bytes::Bytes(const unsigned char* data, size_t len, bool copy)
-    : _value { nullptr }
-    , _size { len }
 {
+    static_assert(INLINE_CAPACITY >= sizeof(SharedBuffer*), "inline storage too small for a shared buffer");
     if (copy) {
-        _value = new (std::nothrow) unsigned char[_size];
-        std::copy(data, data + _size, _value);
-    } else {
-        _value = const_cast<unsigned char*>(data);
+        std::copy(data, data + len, allocate(len));
+    } else if (data) {
+        // without a copy, the bytes are owned by the object, as an array allocated with new[]
+        auto value = const_cast<unsigned char*>(data);
+        try {
+            setSharedBuffer(_inline, new SharedBuffer { { 1 }, value });
+        } catch (...) {
+            delete[] value;
+            throw;
+        }
+        _value = value;
+        _size = len;
     }
 }
 
@@ -52,15 +84,20 @@ Bytes::Bytes(const std::string& data)
 
 Bytes::~Bytes() noexcept
 {
-    if (_value) {
-        delete[] _value;
-        _value = nullptr;
-    }
+    release();
 }
 
 Bytes::Bytes(const Bytes& binaryObject)
-    : Bytes { binaryObject._value, binaryObject._size }
+    : _size { binaryObject._size }
 {
+    if (binaryObject.isInline()) {
+        _value = _inline;
+        std::copy(binaryObject._inline, binaryObject._inline + _size, _inline);
+    } else if (binaryObject._value) {
+        _value = binaryObject._value;
+        std::copy(binaryObject._inline, binaryObject._inline + INLINE_CAPACITY, _inline);
+        getSharedBuffer(_inline)->references.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 Bytes& Bytes::operator=(const Bytes& binaryObject)
@@ -74,9 +111,15 @@ Bytes& Bytes::operator=(const Bytes& binaryObject)
 }
 
 Bytes::Bytes(Bytes&& binaryObject) noexcept
-    : _value { binaryObject._value }
-    , _size { binaryObject._size }
+    : _size { binaryObject._size }
 {
+    if (binaryObject.isInline()) {
+        _value = _inline;
+        std::copy(binaryObject._inline, binaryObject._inline + _size, _inline);
+    } else {
+        _value = binaryObject._value;
+        std::copy(binaryObject._inline, binaryObject._inline + INLINE_CAPACITY, _inline);
+    }
     binaryObject._value = nullptr;
     binaryObject._size = 0;
 }
@@ -84,15 +127,53 @@ Bytes::Bytes(Bytes&& binaryObject) noexcept
 Bytes& Bytes::operator=(Bytes&& binaryObject) noexcept
 {
     if (this != &binaryObject) {
-        delete[] _value;
-        _value = binaryObject._value;
+        release();
         _size = binaryObject._size;
+        if (binaryObject.isInline()) {
+            _value = _inline;
+            std::copy(binaryObject._inline, binaryObject._inline + _size, _inline);
+        } else {
+            _value = binaryObject._value;
+            std::copy(binaryObject._inline, binaryObject._inline + INLINE_CAPACITY, _inline);
+        }
         binaryObject._value = nullptr;
         binaryObject._size = 0;
     }
     return *this;
 }
 
+unsigned char* Bytes::allocate(size_t size)
+{
+    release();
+    _size = size;
+    if (size <= INLINE_CAPACITY) {
+        _value = _inline;
+    } else {
+        auto buffer = static_cast<unsigned char*>(::operator new(sizeof(SharedBuffer) + size));
+        setSharedBuffer(_inline, new (buffer) SharedBuffer { { 1 }, nullptr });
+        _value = buffer + sizeof(SharedBuffer);
+    }
+    return _value;
+}
+
+void Bytes::release() noexcept
+{
+    if (_value && !isInline()) {
+        auto sharedBuffer = getSharedBuffer(_inline);
+        if (sharedBuffer->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (sharedBuffer->adopted) {
+                delete[] sharedBuffer->adopted;
+                delete sharedBuffer;
+            } else {
+                sharedBuffer->~SharedBuffer();
+                ::operator delete(static_cast<void*>(sharedBuffer));
+            }
+        }
+    }
+    _value = nullptr;
+    _size = 0;
+}
+
 uint8_t Bytes::toTinyIntU() const
 {
     return convert<uint8_t>();
@@ -145,10 +226,21 @@ std::string Bytes::toText() const
 
 Bytes::operator unsigned char*() const
 {
-    return _value;
+    return getRaw();
 }
 
 unsigned char* Bytes::getRaw() const
+{
+    auto self = const_cast<Bytes*>(this);
+    if (_value && !isInline() && getSharedBuffer(_inline)->references.load(std::memory_order_acquire) > 1) {
+        // the shared value is kept alive by the previous object until it has been copied
+        auto previous = Bytes { std::move(*self) };
+        std::copy(previous._value, previous._value + previous._size, self->allocate(previous._size));
+    }
+    return self->_value;
+}
+
+const unsigned char* Bytes::getConstRaw() const
 {
     return _value;
 }
@@ -168,12 +260,13 @@ Bytes Bytes::merge(const Bytes& bytes1, const Bytes& bytes2)
 
     const size_t total_size = bytes1.size() + bytes2.size();
 
-    auto* data = new unsigned char[total_size];
+    auto result = Bytes {};
+    auto* data = result.allocate(total_size);
 
-    std::copy(bytes1.getRaw(), bytes1.getRaw() + bytes1.size(), data);
-    std::copy(bytes2.getRaw(), bytes2.getRaw() + bytes2.size(), data + bytes1.size());
+    std::copy(bytes1.getConstRaw(), bytes1.getConstRaw() + bytes1.size(), data);
+    std::copy(bytes2.getConstRaw(), bytes2.getConstRaw() + bytes2.size(), data + bytes1.size());
 
-    return Bytes { data, total_size, false };
+    return result;
 };
 
 Bytes Bytes::merge(const std::vector<Bytes>& bytes)
@@ -184,14 +277,15 @@ Bytes Bytes::merge(const std::vector<Bytes>& bytes)
         total_size += b.size();
     }
 
-    auto* data = new unsigned char[total_size];
+    auto result = Bytes {};
+    auto* data = result.allocate(total_size);
 
     size_t idx = 0;
     for (const Bytes& b : bytes) {
-        std::copy(b.getRaw(), b.getRaw() + b.size(), data + idx);
+        std::copy(b.getConstRaw(), b.getConstRaw() + b.size(), data + idx);
         idx += b.size();
     }
 
-    return Bytes { data, total_size, false };
+    return result;
 }
 }
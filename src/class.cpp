@@ -19,8 +19,11 @@
  *
  */
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
+#include "compression.hpp"
 #include "constant.hpp"
 #include "datarecord_adapter.hpp"
 #include "lmdb_engine.hpp"
@@ -57,10 +60,10 @@ const ClassDescriptor Transaction::addClass(const std::string& className, ClassT
         SchemaUtils::invalidateCache(this);
         return ClassDescriptor { classId, className, ClassId { 0 }, type };
     } catch (const Error& err) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(err);
     } catch (...) {
-        rollback();
+        rollbackOnError();
         std::rethrow_exception(std::current_exception());
     }
 }
@@ -85,10 +88,10 @@ const ClassDescriptor Transaction::addSubClassOf(const std::string& superClass,
         SchemaUtils::invalidateCache(this);
         return ClassDescriptor { classId, className, superClassInfo.id, superClassInfo.type };
     } catch (const Error& err) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(err);
     } catch (...) {
-        rollback();
+        rollbackOnError();
         std::rethrow_exception(std::current_exception());
     }
 }
@@ -120,9 +123,12 @@ void Transaction::dropClass(const std::string& className)
         }
         // delete all associated relations
         auto table = DataRecord(_txnBase, foundClass.id, foundClass.type);
+        auto hasExternalValues = false;
         std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
             [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
                 auto recordId = RecordId { foundClass.id, positionId };
+                hasExternalValues = hasExternalValues
+                    || RecordParser::hasExternalValues(result, foundClass.type, _txnCtx->isVersionEnabled());
                 if (foundClass.type == ClassType::EDGE) {
                     auto vertices = RecordParser::parseEdgeRawDataVertexSrcDst(result, _txnCtx->isVersionEnabled());
                     _graph->removeRelFromEdge(recordId, vertices.first, vertices.second);
@@ -132,9 +138,8 @@ void Transaction::dropClass(const std::string& className)
                             auto srcVertexDataRecord = DataRecord(_txnBase, vertices.first.first, ClassType::VERTEX);
                             auto srcVertexRecordResult = srcVertexDataRecord.getResult(vertices.first.second);
                             auto versionId = RecordParser::parseRawDataVersionId(srcVertexRecordResult);
-                            auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(
-                                srcVertexRecordResult, versionId + 1);
-                            srcVertexDataRecord.update(vertices.first.second, updateRecordBlob);
+                            srcVertexDataRecord.updateVersion(
+                                vertices.first.second, srcVertexRecordResult, versionId + 1);
                             _updatedRecords.insert(vertices.first);
                         }
                         // update version of dst vertex
@@ -142,9 +147,8 @@ void Transaction::dropClass(const std::string& className)
                             auto dstVertexDataRecord = DataRecord(_txnBase, vertices.second.first, ClassType::VERTEX);
                             auto dstVertexRecordResult = dstVertexDataRecord.getResult(vertices.second.second);
                             auto versionId = RecordParser::parseRawDataVersionId(dstVertexRecordResult);
-                            auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(
-                                dstVertexRecordResult, versionId + 1);
-                            dstVertexDataRecord.update(vertices.second.second, updateRecordBlob);
+                            dstVertexDataRecord.updateVersion(
+                                vertices.second.second, dstVertexRecordResult, versionId + 1);
                             _updatedRecords.insert(vertices.second);
                         }
                     }
@@ -156,9 +160,8 @@ void Transaction::dropClass(const std::string& className)
                                 auto neighbourDataRecord = DataRecord(_txnBase, neighbour.first, ClassType::VERTEX);
                                 auto neighbourRecordResult = neighbourDataRecord.getResult(neighbour.second);
                                 auto versionId = RecordParser::parseRawDataVersionId(neighbourRecordResult);
-                                auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(
-                                    neighbourRecordResult, versionId + 1);
-                                neighbourDataRecord.update(neighbour.second, updateRecordBlob);
+                                neighbourDataRecord.updateVersion(
+                                    neighbour.second, neighbourRecordResult, versionId + 1);
                                 _updatedRecords.insert(neighbour);
                             }
                         }
@@ -168,6 +171,11 @@ void Transaction::dropClass(const std::string& className)
         table.resultSetIter(callback);
         // drop the actual table
         table.destroy();
+        if (hasExternalValues) {
+            DataValue(_txnBase, foundClass.id).destroy();
+        }
+        DictionaryAccess(_txnBase).remove(foundClass.id);
+        RecordFormatAccess(_txnBase).remove(foundClass.id);
         // update a superclass of subclasses if existing
         for (const auto& subClassInfo : _adapter->dbClass()->getSubClassInfos(foundClass.id)) {
             _adapter->dbClass()->update(
@@ -183,10 +191,10 @@ void Transaction::dropClass(const std::string& className)
             _adapter->dbInfo()->getNumPropertyId() - PropertyId { static_cast<uint16_t>(propertyInfos.size()) });
         SchemaUtils::invalidateCache(this);
     } catch (const Error& err) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(err);
     } catch (...) {
-        rollback();
+        rollbackOnError();
         std::rethrow_exception(std::current_exception());
     }
 }
@@ -205,11 +213,131 @@ void Transaction::renameClass(const std::string& oldClassName, const std::string
         _adapter->dbClass()->alterClassName(oldClassName, newClassName);
         SchemaUtils::invalidateCache(this);
     } catch (const Error& err) {
-        rollback();
+        rollbackOnError();
+        throw NOGDB_FATAL_ERROR(err);
+    } catch (...) {
+        rollbackOnError();
+        std::rethrow_exception(std::current_exception());
+    }
+}
+
+CompressionStats Transaction::enableCompression(const std::string& className, size_t maxDictionarySize)
+{
+    BEGIN_VALIDATION(this)
+        .isTxnValid()
+        .isTxnCompleted()
+        .isClassNameValid(className);
+
+    auto foundClass = SchemaUtils::getExistingClass(this, className);
+    try {
+        auto stats = CompressionStats { className, 0, 0, 0, 0 };
+        // the records are read with the current dictionary, if any, and rewritten with the new one
+        auto dataRecord = DataRecord(_txnBase, foundClass.id, foundClass.type);
+        auto stride = std::max(dataRecord.size() / COMPRESSION_MAX_SAMPLES, size_t { 1 });
+        auto samples = std::vector<std::string> {};
+        auto positionIds = std::vector<PositionId> {};
+        dataRecord.resultSetIter([&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
+            if (positionIds.size() % stride == 0 && samples.size() < COMPRESSION_MAX_SAMPLES) {
+                samples.emplace_back(result.data.data(), result.data.size());
+            }
+            positionIds.emplace_back(positionId);
+        });
+        auto dictionary = compression::trainDictionary(samples, maxDictionarySize);
+        DictionaryAccess(_txnBase).set(foundClass.id, dictionary);
+        auto compressedDataRecord = DataRecord(_txnBase, foundClass.id, foundClass.type);
+        for (const auto& positionId : positionIds) {
+            auto blob = dataRecord.getBlob(positionId);
+            compressedDataRecord.update(positionId, blob);
+            stats.rawBytes += blob.size();
+            stats.compressedBytes += compressedDataRecord.getStoredSize(positionId);
+        }
+        stats.records = positionIds.size();
+        stats.dictionarySize = dictionary.size();
+        _graph->clearCache();
+        return stats;
+    } catch (const Error& err) {
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(err);
     } catch (...) {
-        rollback();
+        rollbackOnError();
         std::rethrow_exception(std::current_exception());
     }
 }
+
+void Transaction::disableCompression(const std::string& className)
+{
+    BEGIN_VALIDATION(this)
+        .isTxnValid()
+        .isTxnCompleted()
+        .isClassNameValid(className);
+
+    auto foundClass = SchemaUtils::getExistingClass(this, className);
+    try {
+        auto dataRecord = DataRecord(_txnBase, foundClass.id, foundClass.type);
+        if (!dataRecord.isCompressed()) {
+            return;
+        }
+        auto positionIds = std::vector<PositionId> {};
+        dataRecord.resultSetIter([&](const PositionId& positionId, const storage_engine::lmdb::Result&) {
+            positionIds.emplace_back(positionId);
+        });
+        DictionaryAccess(_txnBase).remove(foundClass.id);
+        auto rawDataRecord = DataRecord(_txnBase, foundClass.id, foundClass.type);
+        for (const auto& positionId : positionIds) {
+            rawDataRecord.update(positionId, dataRecord.getBlob(positionId));
+        }
+        _graph->clearCache();
+    } catch (const Error& err) {
+        rollbackOnError();
+        throw NOGDB_FATAL_ERROR(err);
+    } catch (...) {
+        rollbackOnError();
+        std::rethrow_exception(std::current_exception());
+    }
+}
+
+size_t Transaction::rewriteRecords(const std::string& className, RecordFormat recordFormat)
+{
+    BEGIN_VALIDATION(this)
+        .isTxnValid()
+        .isTxnCompleted()
+        .isClassNameValid(className);
+
+    auto foundClass = SchemaUtils::getExistingClass(this, className);
+    try {
+        auto dataRecord = DataRecord(_txnBase, foundClass.id, foundClass.type);
+        auto headerSize = RecordParser::getHeaderSize(foundClass.type == ClassType::EDGE, _txnCtx->isVersionEnabled());
+        auto positionIds = std::vector<PositionId> {};
+        dataRecord.resultSetIter([&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
+            // a record without any property is the same in both formats
+            auto data = result.data.data<unsigned char>();
+            if (result.data.size() > headerSize + parser::SIZE_OF_EMPTY_STRING
+                && RecordParser::getRecordFormat(data, result.data.size(), headerSize) != recordFormat) {
+                positionIds.emplace_back(positionId);
+            }
+        });
+        RecordFormatAccess(_txnBase).set(foundClass.id, recordFormat);
+        // the blocks of each record are copied as they are, behind an offset table or not
+        auto patches = parser::PropertyPatches {};
+        auto previous = std::vector<unsigned char> {};
+        for (const auto& positionId : positionIds) {
+            auto result = dataRecord.getResult(positionId);
+            auto data = result.data.data<unsigned char>();
+            previous.assign(data, data + result.data.size());
+            auto size = RecordParser::getPatchedRawDataSize(
+                previous.data(), previous.size(), headerSize, patches, recordFormat);
+            dataRecord.update(positionId, size, [&](unsigned char* data) {
+                RecordParser::writePatchedRawData(data, previous.data(), previous.size(), headerSize, patches, recordFormat);
+            });
+        }
+        return positionIds.size();
+    } catch (const Error& err) {
+        rollbackOnError();
+        throw NOGDB_FATAL_ERROR(err);
+    } catch (...) {
+        rollbackOnError();
+        std::rethrow_exception(std::current_exception());
+    }
+}
+
 }
@@ -36,6 +36,7 @@ namespace compare {
     using namespace schema;
     using namespace index;
     using compare::RecordCompare;
+    using parser::RecordParser;
   
     bool RecordCompare::compareBytesValue(const Bytes& value, PropertyType type, const Condition& condition)
     {
@@ -119,6 +120,78 @@ namespace compare {
         return multiCondition.execute(record, propertyTypes);
     }
 
+    bool RecordCompare::compareRawDataByCondition(const storage_engine::lmdb::Result& rawData,
+        size_t offset,
+        const PropertyId& propertyId,
+        const PropertyType& propertyType,
+        const Condition& condition,
+        const storage_engine::LMDBTxn* txn,
+        const RecordId& rid)
+    {
+        auto data = static_cast<const unsigned char*>(nullptr);
+        auto size = size_t { 0 };
+        auto external = false;
+        auto found = !rawData.empty
+            && RecordParser::findRawProperty(
+                rawData.data.data<unsigned char>(), rawData.data.size(), offset, propertyId, data, size, external);
+        auto externalValue = storage_engine::lmdb::Result {};
+        if (found && external) {
+            if (txn == nullptr) {
+                found = false;
+            } else {
+                externalValue = RecordParser::getExternalValue(txn, rid, propertyId);
+                data = externalValue.data.data<unsigned char>();
+                size = externalValue.data.size();
+            }
+        }
+        auto isNull = !found || size == 0;
+        switch (condition.comp) {
+        case Condition::Comparator::IS_NULL:
+            return isNull;
+        case Condition::Comparator::NOT_NULL:
+            return !isNull;
+        default:
+            return !isNull && compareBytesValue(Bytes { data, size }, propertyType, condition);
+        }
+    }
+
+    bool RecordCompare::getConditionPropertyId(const PropertyIdMapInfo& propertyIdMapInfo,
+        const Condition& condition,
+        PropertyId& propertyId)
+    {
+        if (condition.propName.empty() || condition.propName.at(0) == '@') {
+            return false;
+        }
+        for (const auto& propertyInfo : propertyIdMapInfo) {
+            if (propertyInfo.second.name == condition.propName) {
+                propertyId = propertyInfo.first;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<const PropertyIdMapInfo> RecordCompare::getConditionPropertyInfos(
+        const PropertyIdMapInfo& propertyIdMapInfo,
+        const MultiCondition& multiCondition)
+    {
+        if (!multiCondition.cmpFunctions.empty()) {
+            return nullptr;
+        }
+        auto conditionPropertyInfos = std::make_shared<PropertyIdMapInfo>();
+        for (const auto& conditionNode : multiCondition.conditions) {
+            auto conditionNodePtr = conditionNode.lock();
+            require(conditionNodePtr != nullptr);
+            auto propertyId = PropertyId {};
+            if (!getConditionPropertyId(propertyIdMapInfo, conditionNodePtr->getCondition(), propertyId)) {
+                return nullptr;
+            }
+            conditionPropertyInfos->emplace(propertyId, propertyIdMapInfo.at(propertyId));
+        }
+        conditionPropertyInfos->indexNames();
+        return conditionPropertyInfos;
+    }
+
     ClassFilter RecordCompare::getFilterClasses(const Transaction& txn, const GraphFilter& filter)
     {
         auto classFilter = ClassFilter {};
@@ -179,19 +252,19 @@ namespace compare {
             auto condition = filter._condition.get();
             auto propertyNameMapInfo = SchemaUtils::getPropertyNameMapInfo(&txn, classInfo.id, classInfo.superClassId);
             auto cmpResult = RecordCompare::compareRecordByCondition(record, propertyNameMapInfo, *condition);
-            return cmpResult ? Result { recordDescriptor, record } : Result {};
+            return cmpResult ? Result { recordDescriptor, std::move(record) } : Result {};
         } else if (filter._mode == GraphFilter::FilterMode::MULTI_CONDITION) {
             auto multiCondition = filter._multiCondition.get();
             auto propertyNameMapInfo = SchemaUtils::getPropertyNameMapInfo(&txn, classInfo.id, classInfo.superClassId);
             auto cmpResult = RecordCompare::compareRecordByMultiCondition(
                 record, propertyNameMapInfo, *multiCondition);
-            return cmpResult ? Result { recordDescriptor, record } : Result {};
+            return cmpResult ? Result { recordDescriptor, std::move(record) } : Result {};
         } else {
             if (filter._function) {
-                return filter._function(record) ? Result { recordDescriptor, record } : Result {};
+                return filter._function(record) ? Result { recordDescriptor, std::move(record) } : Result {};
             }
         }
-        return Result { recordDescriptor, record };
+        return Result { recordDescriptor, std::move(record) };
     }
 
     std::vector<std::pair<RecordDescriptor, RecordDescriptor>> RecordCompare::filterIncidentEdges(
@@ -444,7 +517,7 @@ namespace compare {
             auto edgeRecord =
                 DataRecordUtils::getRecordWithBasicInfo(&txn, edgeClassInfo, RecordDescriptor { edgeRecordId });
             if (compareRecordByCondition(edgeRecord, propertyType, condition)) {
-                resultSet.emplace_back(Result { RecordDescriptor { edgeRecordId }, edgeRecord });
+                resultSet.emplace_back(Result { RecordDescriptor { edgeRecordId }, std::move(edgeRecord) });
             }
         }
         return resultSet;
@@ -472,7 +545,7 @@ namespace compare {
             auto edgeRecord =
                 DataRecordUtils::getRecordWithBasicInfo(&txn, edgeClassInfo, RecordDescriptor { edgeRecordId });
             if (condition(edgeRecord)) {
-                resultSet.emplace_back(Result { RecordDescriptor { edgeRecordId }, edgeRecord });
+                resultSet.emplace_back(Result { RecordDescriptor { edgeRecordId }, std::move(edgeRecord) });
             }
         }
         return resultSet;
@@ -507,7 +580,7 @@ namespace compare {
             auto edgeRecord =
                 DataRecordUtils::getRecordWithBasicInfo(&txn, edgeClassInfo, RecordDescriptor { edgeRecordId });
             if (multiCondition.execute(edgeRecord, propertyTypes)) {
-                resultSet.emplace_back(Result { RecordDescriptor { edgeRecordId }, edgeRecord });
+                resultSet.emplace_back(Result { RecordDescriptor { edgeRecordId }, std::move(edgeRecord) });
             }
         }
         return resultSet;
@@ -63,6 +63,31 @@ namespace compare {
             const PropertyNameMapInfo& propertyNameMapInfo,
             const MultiCondition& multiCondition);
 
+        /**
+         * Check a condition on a raw record, starting at the offset, without decoding the record: only the value
+         * of the property is located, then fetched with the transaction if it is stored out of line.
+         */
+        static bool compareRawDataByCondition(const storage_engine::lmdb::Result& rawData,
+            size_t offset,
+            const PropertyId& propertyId,
+            const PropertyType& propertyType,
+            const Condition& condition,
+            const storage_engine::LMDBTxn* txn,
+            const RecordId& rid);
+
+        // false when the condition is on a basic info or an unknown property, which needs a decoded record
+        static bool getConditionPropertyId(const PropertyIdMapInfo& propertyIdMapInfo,
+            const Condition& condition,
+            PropertyId& propertyId);
+
+        /**
+         * The properties a multi-condition refers to, to decode only them from a record before checking it,
+         * or nullptr when it refers to a basic info or an unknown property, or has a comparison function.
+         */
+        static std::shared_ptr<const PropertyIdMapInfo> getConditionPropertyInfos(
+            const PropertyIdMapInfo& propertyIdMapInfo,
+            const MultiCondition& multiCondition);
+
         static ClassFilter getFilterClasses(const Transaction& txn, const GraphFilter& filter);
 
         static RecordDescriptor filterRecord(const Transaction& txn,
@@ -419,7 +444,7 @@ namespace compare {
             case PropertyType::BLOB:
                 switch (cmp) {
                 case Condition::Comparator::EQUAL:
-                    return memcmp(value.getRaw(), cmpValue1.getRaw(), value.size()) == 0;
+                    return memcmp(value.getConstRaw(), cmpValue1.getConstRaw(), value.size()) == 0;
                 default:
                     throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_INVALID_COMPARATOR);
                 }
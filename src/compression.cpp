@@ -0,0 +1,369 @@
+/*
+ *  Copyright (C) 2019, NogDB <https://nogdb.org>
+ *  <nogdb at throughwave dot co dot th>
+ *
+ *  This file is part of libnogdb, the NogDB core library in C++.
+ *
+ *  libnogdb is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "compression.hpp"
+
+namespace nogdb {
+namespace compression {
+
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr size_t HEADER_SIZE = sizeof(uint32_t);
+    constexpr unsigned int DICTIONARY_HASH_LOG = 14;
+    constexpr unsigned int MIN_HASH_LOG = 6;
+    constexpr unsigned int MAX_HASH_LOG = 12;
+    constexpr size_t MAX_CACHED_DICTIONARIES = 64;
+
+    // the whole dictionary must stay within reach of the offsets from the start of the data
+    constexpr size_t MAX_DICTIONARY_SIZE = 32 * 1024;
+    constexpr size_t DMER_SIZE = sizeof(uint64_t);
+    constexpr size_t SEGMENT_SIZE = 48;
+    constexpr size_t SEGMENT_STEP = 16;
+
+    static inline uint32_t read32(const unsigned char* p)
+    {
+        auto value = uint32_t {};
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static inline uint64_t read64(const unsigned char* p)
+    {
+        auto value = uint64_t {};
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static inline uint32_t hash(uint32_t sequence, unsigned int log)
+    {
+        return (sequence * 2654435761U) >> (32 - log);
+    }
+
+    static inline size_t matchLength(const unsigned char* match,
+        const unsigned char* matchEnd,
+        const unsigned char* current,
+        const unsigned char* currentEnd)
+    {
+        auto length = size_t { 0 };
+        while (match + length < matchEnd && current + length < currentEnd && match[length] == current[length]) {
+            ++length;
+        }
+        return length;
+    }
+
+    static inline unsigned char* writeLength(unsigned char* op, size_t length)
+    {
+        while (length >= 255) {
+            *op++ = 255;
+            length -= 255;
+        }
+        *op++ = static_cast<unsigned char>(length);
+        return op;
+    }
+
+    static inline bool readLength(const unsigned char*& ip, const unsigned char* end, size_t& length)
+    {
+        auto byte = 255U;
+        while (byte == 255) {
+            if (ip >= end) {
+                return false;
+            }
+            byte = *ip++;
+            length += byte;
+        }
+        return true;
+    }
+
+    static unsigned char* writeSequence(unsigned char* op,
+        const unsigned char* literals,
+        size_t literalLength,
+        size_t offset,
+        size_t length)
+    {
+        auto token = op++;
+        auto matchLength = (length > 0) ? length - MIN_MATCH : 0;
+        *token = static_cast<unsigned char>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchLength, 15));
+        if (literalLength >= 15) {
+            op = writeLength(op, literalLength - 15);
+        }
+        memcpy(op, literals, literalLength);
+        op += literalLength;
+        if (length > 0) {
+            *op++ = static_cast<unsigned char>(offset & 0xff);
+            *op++ = static_cast<unsigned char>(offset >> 8);
+            if (matchLength >= 15) {
+                op = writeLength(op, matchLength - 15);
+            }
+        }
+        return op;
+    }
+
+    Dictionary::Dictionary(const unsigned char* data, size_t size)
+        : _data(reinterpret_cast<const char*>(data), size)
+        , _table(size_t { 1 } << DICTIONARY_HASH_LOG, -1)
+    {
+        for (auto i = size_t { 0 }; i + MIN_MATCH <= size; ++i) {
+            _table[hash(read32(data + i), DICTIONARY_HASH_LOG)] = static_cast<int32_t>(i);
+        }
+    }
+
+    std::shared_ptr<const Dictionary> Dictionary::load(uint64_t id, const unsigned char* data, size_t size)
+    {
+        static std::mutex cacheMutex {};
+        static std::unordered_map<uint64_t, std::shared_ptr<const Dictionary>> cache {};
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto found = cache.find(id);
+        if (found != cache.cend()
+            && found->second->size() == size
+            && memcmp(found->second->data(), data, size) == 0) {
+            return found->second;
+        }
+        if (cache.size() >= MAX_CACHED_DICTIONARIES) {
+            cache.clear();
+        }
+        auto dictionary = std::make_shared<const Dictionary>(data, size);
+        cache[id] = dictionary;
+        return dictionary;
+    }
+
+    size_t Codec::compressBound(size_t size)
+    {
+        return HEADER_SIZE + size + size / 255 + 16;
+    }
+
+    size_t Codec::compress(const Dictionary& dictionary,
+        const unsigned char* src,
+        size_t srcSize,
+        unsigned char* dst)
+    {
+        auto rawSize = static_cast<uint32_t>(srcSize);
+        memcpy(dst, &rawSize, sizeof(rawSize));
+        auto op = dst + HEADER_SIZE;
+        auto hashLog = MIN_HASH_LOG;
+        while (hashLog < MAX_HASH_LOG && (size_t { 1 } << hashLog) < srcSize) {
+            ++hashLog;
+        }
+        thread_local auto table = std::vector<int32_t> {};
+        table.assign(size_t { 1 } << hashLog, -1);
+        const auto dictionaryData = dictionary.data();
+        const auto dictionarySize = dictionary.size();
+        const auto& dictionaryTable = dictionary.table();
+        const auto srcEnd = src + srcSize;
+        auto anchor = size_t { 0 };
+        auto i = size_t { 0 };
+        while (i + MIN_MATCH <= srcSize) {
+            auto sequence = read32(src + i);
+            auto bestLength = size_t { 0 };
+            auto bestOffset = size_t { 0 };
+            // a previous occurrence in the data
+            auto& slot = table[hash(sequence, hashLog)];
+            auto candidate = slot;
+            slot = static_cast<int32_t>(i);
+            if (candidate >= 0 && i - candidate <= MAX_OFFSET && read32(src + candidate) == sequence) {
+                bestLength = MIN_MATCH + matchLength(src + candidate + MIN_MATCH, srcEnd, src + i + MIN_MATCH, srcEnd);
+                bestOffset = i - candidate;
+            }
+            // an occurrence in the dictionary
+            auto dictionaryCandidate = dictionaryTable[hash(sequence, DICTIONARY_HASH_LOG)];
+            if (dictionaryCandidate >= 0
+                && dictionarySize - dictionaryCandidate + i <= MAX_OFFSET
+                && read32(dictionaryData + dictionaryCandidate) == sequence) {
+                auto length = MIN_MATCH + matchLength(dictionaryData + dictionaryCandidate + MIN_MATCH,
+                                  dictionaryData + dictionarySize, src + i + MIN_MATCH, srcEnd);
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestOffset = dictionarySize - dictionaryCandidate + i;
+                }
+            }
+            if (bestLength == 0) {
+                ++i;
+                continue;
+            }
+            op = writeSequence(op, src + anchor, i - anchor, bestOffset, bestLength);
+            i += bestLength;
+            anchor = i;
+            if (i >= 2 && i - 2 + MIN_MATCH <= srcSize) {
+                table[hash(read32(src + i - 2), hashLog)] = static_cast<int32_t>(i - 2);
+            }
+        }
+        op = writeSequence(op, src + anchor, srcSize - anchor, 0, 0);
+        return static_cast<size_t>(op - dst);
+    }
+
+    size_t Codec::decompressedSize(const unsigned char* src, size_t srcSize)
+    {
+        return (srcSize >= HEADER_SIZE) ? read32(src) : 0;
+    }
+
+    bool Codec::decompress(const unsigned char* dictionary,
+        size_t dictionarySize,
+        const unsigned char* src,
+        size_t srcSize,
+        unsigned char* dst)
+    {
+        if (srcSize < HEADER_SIZE) {
+            return false;
+        }
+        const auto rawSize = static_cast<size_t>(read32(src));
+        auto ip = src + HEADER_SIZE;
+        const auto end = src + srcSize;
+        auto op = size_t { 0 };
+        while (ip < end) {
+            auto token = *ip++;
+            auto literalLength = static_cast<size_t>(token >> 4);
+            if (literalLength == 15 && !readLength(ip, end, literalLength)) {
+                return false;
+            }
+            if (literalLength > static_cast<size_t>(end - ip) || literalLength > rawSize - op) {
+                return false;
+            }
+            if (literalLength > 0) {
+                memcpy(dst + op, ip, literalLength);
+                ip += literalLength;
+                op += literalLength;
+            }
+            if (ip == end) {
+                break;
+            }
+            if (end - ip < 2) {
+                return false;
+            }
+            auto offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            auto length = static_cast<size_t>(token & 0x0f);
+            if (length == 15 && !readLength(ip, end, length)) {
+                return false;
+            }
+            length += MIN_MATCH;
+            if (offset == 0 || offset > op + dictionarySize || length > rawSize - op) {
+                return false;
+            }
+            if (offset > op) {
+                // the match starts in the dictionary and may run on into the data
+                auto fromDictionary = std::min(offset - op, length);
+                memcpy(dst + op, dictionary + dictionarySize - (offset - op), fromDictionary);
+                op += fromDictionary;
+                length -= fromDictionary;
+            }
+            if (offset >= length) {
+                memcpy(dst + op, dst + op - offset, length);
+                op += length;
+            } else {
+                for (; length > 0; --length, ++op) {
+                    dst[op] = dst[op - offset];
+                }
+            }
+        }
+        return op == rawSize;
+    }
+
+    std::string trainDictionary(const std::vector<std::string>& samples, size_t maxSize)
+    {
+        maxSize = std::min(maxSize, MAX_DICTIONARY_SIZE);
+        if (maxSize == 0) {
+            return std::string {};
+        }
+        auto dmersOf = [](const unsigned char* data, size_t size) {
+            auto dmers = std::vector<uint64_t> {};
+            for (auto i = size_t { 0 }; i + DMER_SIZE <= size; ++i) {
+                dmers.push_back(read64(data + i));
+            }
+            std::sort(dmers.begin(), dmers.end());
+            dmers.erase(std::unique(dmers.begin(), dmers.end()), dmers.end());
+            return dmers;
+        };
+        // the number of samples each sequence appears in
+        auto frequencies = std::unordered_map<uint64_t, uint32_t> {};
+        for (const auto& sample : samples) {
+            for (const auto& dmer : dmersOf(reinterpret_cast<const unsigned char*>(sample.data()), sample.size())) {
+                ++frequencies[dmer];
+            }
+        }
+        struct Segment {
+            size_t sample;
+            size_t offset;
+            size_t size;
+        };
+        auto segments = std::vector<Segment> {};
+        for (auto i = size_t { 0 }; i < samples.size(); ++i) {
+            for (auto offset = size_t { 0 }; offset + DMER_SIZE <= samples[i].size(); offset += SEGMENT_STEP) {
+                segments.push_back(Segment { i, offset, std::min(SEGMENT_SIZE, samples[i].size() - offset) });
+            }
+        }
+        auto covered = std::unordered_set<uint64_t> {};
+        auto score = [&](const Segment& segment) {
+            auto total = uint64_t { 0 };
+            auto data = reinterpret_cast<const unsigned char*>(samples[segment.sample].data()) + segment.offset;
+            for (const auto& dmer : dmersOf(data, segment.size)) {
+                auto frequency = frequencies[dmer];
+                if (frequency > 1 && covered.find(dmer) == covered.cend()) {
+                    total += frequency;
+                }
+            }
+            return total;
+        };
+        // lazy greedy selection, the score of a segment only decreases as more sequences are covered
+        auto candidates = std::priority_queue<std::pair<uint64_t, size_t>> {};
+        for (auto i = size_t { 0 }; i < segments.size(); ++i) {
+            auto initialScore = score(segments[i]);
+            if (initialScore > 0) {
+                candidates.emplace(initialScore, i);
+            }
+        }
+        auto selected = std::vector<std::string> {};
+        auto totalSize = size_t { 0 };
+        while (!candidates.empty() && totalSize < maxSize) {
+            auto candidate = candidates.top();
+            candidates.pop();
+            auto currentScore = score(segments[candidate.second]);
+            if (currentScore == 0) {
+                continue;
+            }
+            if (!candidates.empty() && currentScore < candidates.top().first) {
+                candidates.emplace(currentScore, candidate.second);
+                continue;
+            }
+            const auto& segment = segments[candidate.second];
+            auto size = std::min(segment.size, maxSize - totalSize);
+            auto data = samples[segment.sample].substr(segment.offset, size);
+            for (const auto& dmer : dmersOf(reinterpret_cast<const unsigned char*>(data.data()), data.size())) {
+                covered.insert(dmer);
+            }
+            totalSize += size;
+            selected.emplace_back(std::move(data));
+        }
+        auto dictionary = std::string {};
+        dictionary.reserve(totalSize);
+        for (auto it = selected.rbegin(); it != selected.rend(); ++it) {
+            dictionary += *it;
+        }
+        return dictionary;
+    }
+
+}
+}
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2019, NogDB <https://nogdb.org>
+ *  <nogdb at throughwave dot co dot th>
+ *
+ *  This file is part of libnogdb, the NogDB core library in C++.
+ *
+ *  libnogdb is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nogdb {
+namespace compression {
+
+    /**
+     * A dictionary of byte sequences which are frequent in the records of a class, along with a hash table
+     * of its positions to find matches in it when compressing.
+     * Dictionaries are cached by an id chosen by the caller and shared by every transaction which
+     * compresses with the same content under that id.
+     */
+    class Dictionary {
+    public:
+        Dictionary(const unsigned char* data, size_t size);
+
+        static std::shared_ptr<const Dictionary> load(uint64_t id, const unsigned char* data, size_t size);
+
+        const unsigned char* data() const { return reinterpret_cast<const unsigned char*>(_data.data()); }
+
+        size_t size() const { return _data.size(); }
+
+        const std::vector<int32_t>& table() const { return _table; }
+
+    private:
+        std::string _data;
+        std::vector<int32_t> _table;
+    };
+
+    /**
+     * A byte-oriented LZ77 codec writing sequences in the format of LZ4 blocks, whose matches may also
+     * refer to a dictionary which virtually precedes the data, so that a record of a few hundred bytes
+     * compresses well on its own.
+     * The compressed value starts with the size of the raw data in 32 bits.
+     */
+    struct Codec {
+        static size_t compressBound(size_t size);
+
+        // returns the compressed size, dst must hold at least compressBound(srcSize) bytes
+        static size_t compress(const Dictionary& dictionary,
+            const unsigned char* src,
+            size_t srcSize,
+            unsigned char* dst);
+
+        static size_t decompressedSize(const unsigned char* src, size_t srcSize);
+
+        // dst must hold decompressedSize(src, srcSize) bytes, returns false on malformed input
+        static bool decompress(const unsigned char* dictionary,
+            size_t dictionarySize,
+            const unsigned char* src,
+            size_t srcSize,
+            unsigned char* dst);
+    };
+
+    /**
+     * Pick the segments of the samples covering the most frequent 8-byte sequences, until the
+     * dictionary is full. The most useful segments are placed at its end, closest to the data.
+     */
+    std::string trainDictionary(const std::vector<std::string>& samples, size_t maxSize);
+
+}
+}
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <regex>
 #include <string>
 
@@ -28,14 +29,23 @@ namespace nogdb {
 
 constexpr uint16_t INIT_NUM_CLASSES = 6;
 const std::string DB_SETTING_NAME = "/.settings.nogdb";
+const std::string DB_DATA_NAME = "/data.mdb";
+const std::string DB_SHARD_SETTING_NAME = "/.shards.nogdb";
+const std::string DB_SHARD_PREFIX = "/shard-";
+const std::string DB_SHARD_COMMIT_NAME = "/.commit.nogdb";
+// the vertices standing for a vertex of another shard at the ends of the edges between shards
+const std::string DB_SHARD_PROXY_CLASS = "_nogdb_shard_proxy";
 const std::string TB_DBINFO = ".dbinfo";
 const std::string TB_CLASSES = ".classes";
 const std::string TB_PROPERTIES = ".properties";
 const std::string TB_RELATIONS_IN = ".relations#in";
 const std::string TB_RELATIONS_OUT = ".relations#out";
 const std::string TB_INDEXES = ".indexes";
+const std::string TB_DICTIONARIES = ".dictionaries";
+const std::string TB_RECORD_FORMATS = ".record_formats";
 
 const std::string TB_INDEXING_PREFIX = ".index_";
+const std::string TB_VALUES_SUFFIX = "#values";
 
 constexpr uint16_t INIT_NUM_PROPERTIES = 4;
 constexpr uint16_t CLASS_NAME_PROPERTY_ID = 0;
@@ -46,9 +56,16 @@ constexpr uint16_t DEPTH_PROPERTY_ID = 2;
 const std::string DEPTH_PROPERTY = "@depth";
 constexpr uint16_t VERSION_PROPERTY_ID = 3;
 const std::string VERSION_PROPERTY = "@version";
+// never given to a property, as it marks a record which starts with a table of its properties
+constexpr uint16_t OFFSET_TABLE_PROPERTY_ID = UINT16_MAX;
 
 constexpr uint32_t MAX_RECORD_NUM_EM = 0;
 
+// records sampled to train the compression dictionary of a class
+constexpr size_t COMPRESSION_MAX_SAMPLES = 1024;
+// size of the buffers compressed records are decoded into while scanning a class
+constexpr size_t COMPRESSION_DECODE_CHUNK_SIZE = 64 * 1024;
+
 constexpr size_t MAX_CLASS_NAME_LEN = 128;
 constexpr size_t MAX_PROPERTY_NAME_LEN = 128;
 const std::string MAX_CLASS_ID_KEY = "?max_class_id";
@@ -57,6 +74,12 @@ const std::string MAX_PROPERTY_ID_KEY = "?max_property_id";
 const std::string NUM_PROPERTY_KEY = "?num_property_id";
 const std::string MAX_INDEX_ID_KEY = "?max_index_id";
 const std::string NUM_INDEX_KEY = "?num_index_id";
+const std::string RELATION_FORMAT_KEY = "?relation_format";
+// the sequence number of the last write over several shards committed by a shard
+const std::string SHARDED_COMMIT_KEY = "?sharded_commit";
+
+// 0: "classId:positionId" string keys, 1: fixed-width big-endian binary keys
+constexpr uint8_t RELATION_FORMAT_VERSION = 1;
 
 const std::regex GLOBAL_VALID_NAME_PATTERN = std::regex("^[A-Za-z_][A-Za-z0-9_]*$");
 
@@ -19,11 +19,20 @@
  *
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "constant.hpp"
+#include "datarecord_adapter.hpp"
+#include "dbinfo_adapter.hpp"
+#include "index.hpp"
+#include "relation_adapter.hpp"
 #include "schema.hpp"
+#include "schema_adapter.hpp"
 #include "storage_engine.hpp"
 #include "utils.hpp"
 #include "validate.hpp"
@@ -38,17 +47,227 @@ struct ContextSetting {
     unsigned int maxDB {};
     unsigned long maxDBSize {};
     bool versionEnabled {};
+    DurabilityMode durabilityMode { DurabilityMode::FULL };
+    unsigned int flushInterval { DEFAULT_NOGDB_FLUSH_INTERVAL };
+    unsigned long growthStep { 0 };
+    double growthFactor { 0.0 };
+    unsigned long growthLimit { 0 };
+    unsigned int batchSize { DEFAULT_NOGDB_BATCH_SIZE };
+    unsigned int batchLatency { DEFAULT_NOGDB_BATCH_LATENCY };
+    StorageEngine storageEngine { StorageEngine::LMDB };
+    unsigned int largeValueThreshold { 0 };
+    unsigned int readerCheckInterval { 0 };
+    unsigned int maxReaderAge { 0 };
+    MapAdvice mapAdvice { MapAdvice::NORMAL };
+    RecordFormat recordFormat { RecordFormat::V1 };
 };
 
+// settings written by versions without the durability options
+struct LegacyContextSetting {
+    unsigned int maxDB {};
+    unsigned long maxDBSize {};
+    bool versionEnabled {};
+};
+
+static ContextSetting readContextSetting(const std::string& settingFilePath)
+{
+    auto setting = ContextSetting {};
+    if (fileSize(settingFilePath) == sizeof(LegacyContextSetting)) {
+        auto legacySetting = LegacyContextSetting {};
+        auto binary = readBinaryFile(settingFilePath.c_str(), sizeof(legacySetting));
+        memcpy(&legacySetting, binary, sizeof(legacySetting));
+        delete[] binary;
+        setting.maxDB = legacySetting.maxDB;
+        setting.maxDBSize = legacySetting.maxDBSize;
+        setting.versionEnabled = legacySetting.versionEnabled;
+    } else {
+        // settings written by older versions are a prefix of the current ones
+        auto size = std::min(fileSize(settingFilePath), sizeof(setting));
+        auto binary = readBinaryFile(settingFilePath.c_str(), size);
+        memcpy(&setting, binary, size);
+        delete[] binary;
+    }
+    return setting;
+}
+
+static storage_engine::lmdb::Flag getEnvFlags(DurabilityMode durabilityMode, MapAdvice mapAdvice, OpenMode openMode)
+{
+    auto flags = storage_engine::lmdb::DEFAULT_ENV_FLAG;
+    switch (durabilityMode) {
+    case DurabilityMode::NO_META_SYNC:
+        flags |= MDB_NOMETASYNC;
+        break;
+    case DurabilityMode::ASYNC:
+        flags |= MDB_NOSYNC;
+        break;
+    default:
+        break;
+    }
+    // lmdb advises the kernel against read-ahead by itself, also whenever the map is resized
+    if (mapAdvice == MapAdvice::RANDOM) {
+        flags |= MDB_NORDAHEAD;
+    }
+    switch (openMode) {
+    case OpenMode::READ_ONLY:
+        flags |= MDB_RDONLY;
+        break;
+    case OpenMode::READ_ONLY_NO_LOCK:
+        flags |= MDB_RDONLY | MDB_NOLOCK;
+        break;
+    default:
+        break;
+    }
+    return flags;
+}
+
 std::unordered_map<std::string, Context::LMDBInstance> Context::_underlying =
     std::unordered_map<std::string, Context::LMDBInstance> {};
 
+// guards Context::_underlying and the reference counts of its instances, since contexts
+// are opened, copied and destroyed from any thread
+static std::mutex underlyingMutex {};
+
+// the settings of the in-memory databases of the process, which are not written to any file,
+// kept as long as their environments and guarded by the same mutex
+static std::unordered_map<std::string, ContextSetting> inMemorySettings {};
+
+static void openIndexTables(const storage_engine::LMDBTxn& txn, const adapter::schema::IndexAccessInfo& indexInfo,
+    const PropertyType& propertyType)
+{
+    auto uniqueFlag = indexInfo.isUnique ? INDEX_TYPE_UNIQUE : INDEX_TYPE_NON_UNIQUE;
+    switch (propertyType) {
+    case PropertyType::UNSIGNED_TINYINT:
+    case PropertyType::UNSIGNED_SMALLINT:
+    case PropertyType::UNSIGNED_INTEGER:
+    case PropertyType::UNSIGNED_BIGINT:
+        adapter::index::IndexRecord(&txn, indexInfo.id, INDEX_TYPE_POSITIVE | INDEX_TYPE_NUMERIC | uniqueFlag);
+        break;
+    case PropertyType::TINYINT:
+    case PropertyType::SMALLINT:
+    case PropertyType::INTEGER:
+    case PropertyType::BIGINT:
+    case PropertyType::REAL:
+        adapter::index::IndexRecord(&txn, indexInfo.id, INDEX_TYPE_POSITIVE | INDEX_TYPE_NUMERIC | uniqueFlag);
+        adapter::index::IndexRecord(&txn, indexInfo.id, INDEX_TYPE_NEGATIVE | INDEX_TYPE_NUMERIC | uniqueFlag);
+        break;
+    case PropertyType::TEXT:
+        adapter::index::IndexRecord(&txn, indexInfo.id, INDEX_TYPE_POSITIVE | INDEX_TYPE_STRING | uniqueFlag);
+        break;
+    default:
+        break;
+    }
+}
+
+static void openValueTable(const storage_engine::LMDBTxn& txn, const ClassId& classId, bool readOnly)
+{
+    try {
+        auto dataValue = adapter::datarecord::DataValue(&txn, classId);
+    } catch (const Error& error) {
+        // the values of a class are only stored once one of them is large, and a read-only
+        // transaction cannot create the table, which is then never looked up by readers
+        if (!readOnly || error.code() != EACCES) {
+            throw;
+        }
+    }
+}
+
+static storage_engine::LMDBEnv* openEnv(const std::string& dbPath, const ContextSetting& setting, OpenMode openMode)
+{
+    // an in-memory database is private to the process, so only its contexts are read-only
+    if (setting.storageEngine != StorageEngine::LMDB) {
+        openMode = OpenMode::READ_WRITE;
+    }
+    auto readOnly = openMode != OpenMode::READ_WRITE;
+    auto growthPolicy = storage_engine::MapGrowthPolicy {};
+    growthPolicy.step = setting.growthStep;
+    growthPolicy.factor = setting.growthFactor;
+    growthPolicy.limit = setting.growthLimit;
+    auto env = new storage_engine::LMDBEnv(dbPath,
+        setting.maxDB,
+        setting.maxDBSize,
+        DEFAULT_NOGDB_MAX_READERS,
+        getEnvFlags(setting.durabilityMode, setting.mapAdvice, openMode),
+        growthPolicy,
+        setting.storageEngine,
+        setting.mapAdvice);
+    try {
+        auto txn = storage_engine::LMDBTxn(env, readOnly ? storage_engine::lmdb::TXN_RO : storage_engine::lmdb::TXN_RW);
+        auto dbInfo = adapter::metadata::DBInfoAccess(&txn);
+        if (readOnly && dbInfo.getRelationFormat() < RELATION_FORMAT_VERSION) {
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_READ_ONLY);
+        }
+        adapter::relation::RelationAccess inRel { &txn, adapter::relation::Direction::IN };
+        adapter::relation::RelationAccess outRel { &txn, adapter::relation::Direction::OUT };
+        // convert relation tables written by older versions to the current key format
+        if (dbInfo.getRelationFormat() < RELATION_FORMAT_VERSION) {
+            inRel.migrateLegacyKeys();
+            outRel.migrateLegacyKeys();
+            dbInfo.setRelationFormat(RELATION_FORMAT_VERSION);
+        }
+        // open every existing table in a committed transaction so that its handle is shared
+        // by the whole environment; handles opened by a read-only transaction are closed when
+        // it is reset for reuse, and would otherwise be looked up again on every renewal
+        auto classAccess = adapter::schema::ClassAccess(&txn);
+        auto propertyAccess = adapter::schema::PropertyAccess(&txn);
+        auto indexAccess = adapter::schema::IndexAccess(&txn);
+        auto dictionaryAccess = adapter::schema::DictionaryAccess(&txn);
+        // only looked up by writers, and missing from databases written by older versions
+        if (!readOnly) {
+            auto recordFormatAccess = adapter::schema::RecordFormatAccess(&txn);
+        }
+        auto classInfos = classAccess.getAllInfos();
+        auto propertyTypes = std::unordered_map<PropertyId, PropertyType> {};
+        for (const auto& classInfo : classInfos) {
+            auto dataRecord = adapter::datarecord::DataRecord(&txn, classInfo.id, classInfo.type);
+            openValueTable(txn, classInfo.id, readOnly);
+            for (const auto& propertyInfo : propertyAccess.getInfos(classInfo.id)) {
+                propertyTypes.emplace(propertyInfo.id, propertyInfo.type);
+            }
+        }
+        // an index may be on a property inherited from a super class
+        for (const auto& classInfo : classInfos) {
+            for (const auto& indexInfo : indexAccess.getInfos(classInfo.id)) {
+                auto propertyType = propertyTypes.find(indexInfo.propertyId);
+                if (propertyType != propertyTypes.cend()) {
+                    openIndexTables(txn, indexInfo, propertyType->second);
+                }
+            }
+        }
+        txn.commit();
+        if (setting.durabilityMode == DurabilityMode::ASYNC && setting.storageEngine == StorageEngine::LMDB && !readOnly) {
+            env->startFlusher(std::chrono::milliseconds(setting.flushInterval));
+        }
+        // without the lock file there is no reader table to monitor
+        if (setting.readerCheckInterval > 0 && openMode != OpenMode::READ_ONLY_NO_LOCK) {
+            env->startReaderMonitor(std::chrono::milliseconds(setting.readerCheckInterval),
+                std::chrono::milliseconds(setting.maxReaderAge));
+        }
+    } catch (...) {
+        delete env;
+        throw;
+    }
+    return env;
+}
+
 ContextInitializer::ContextInitializer(const std::string& dbPath)
     : _dbPath { dbPath }
 {
     _maxDB = DEFAULT_NOGDB_MAX_DATABASE_NUMBER;
     _maxDBSize = DEFAULT_NOGDB_MAX_DATABASE_SIZE;
     _versionEnabled = false;
+    _durabilityMode = DurabilityMode::FULL;
+    _flushInterval = DEFAULT_NOGDB_FLUSH_INTERVAL;
+    _growthStep = 0;
+    _growthFactor = 0.0;
+    _maxDBSizeLimit = 0;
+    _batchSize = DEFAULT_NOGDB_BATCH_SIZE;
+    _batchLatency = DEFAULT_NOGDB_BATCH_LATENCY;
+    _storageEngine = StorageEngine::LMDB;
+    _largeValueThreshold = 0;
+    _readerCheckInterval = 0;
+    _maxReaderAge = 0;
+    _mapAdvice = MapAdvice::NORMAL;
+    _recordFormat = RecordFormat::V1;
 }
 
 ContextInitializer& ContextInitializer::setMaxDB(unsigned int maxDBNum) noexcept
@@ -69,27 +288,128 @@ ContextInitializer& ContextInitializer::enableVersion() noexcept
     return *this;
 }
 
+ContextInitializer& ContextInitializer::setDurability(DurabilityMode mode, unsigned int flushIntervalMs) noexcept
+{
+    _durabilityMode = mode;
+    _flushInterval = flushIntervalMs;
+    return *this;
+}
+
+ContextInitializer& ContextInitializer::setMapGrowth(unsigned long growthStep, unsigned long maxDBSizeLimit) noexcept
+{
+    _growthStep = growthStep;
+    _growthFactor = 0.0;
+    _maxDBSizeLimit = maxDBSizeLimit;
+    return *this;
+}
+
+ContextInitializer& ContextInitializer::setMapGrowthFactor(double growthFactor, unsigned long maxDBSizeLimit) noexcept
+{
+    _growthStep = 0;
+    _growthFactor = growthFactor;
+    _maxDBSizeLimit = maxDBSizeLimit;
+    return *this;
+}
+
+ContextInitializer& ContextInitializer::setBatchCommit(unsigned int maxBatchSize, unsigned int maxLatencyMs) noexcept
+{
+    _batchSize = maxBatchSize;
+    _batchLatency = maxLatencyMs;
+    return *this;
+}
+
+ContextInitializer& ContextInitializer::setStorageEngine(StorageEngine storageEngine) noexcept
+{
+    _storageEngine = storageEngine;
+    return *this;
+}
+
+ContextInitializer& ContextInitializer::setLargeValueThreshold(unsigned int largeValueThreshold) noexcept
+{
+    _largeValueThreshold = largeValueThreshold;
+    return *this;
+}
+
+ContextInitializer& ContextInitializer::setReaderMonitor(unsigned int checkIntervalMs, unsigned int maxReaderAgeMs) noexcept
+{
+    _readerCheckInterval = checkIntervalMs;
+    _maxReaderAge = maxReaderAgeMs;
+    return *this;
+}
+
+ContextInitializer& ContextInitializer::setMapAdvice(MapAdvice mapAdvice) noexcept
+{
+    _mapAdvice = mapAdvice;
+    return *this;
+}
+
+ContextInitializer& ContextInitializer::setRecordFormat(RecordFormat recordFormat) noexcept
+{
+    _recordFormat = recordFormat;
+    return *this;
+}
+
 Context ContextInitializer::init()
 {
+    auto setting = ContextSetting {};
+    setting.maxDB = _maxDB;
+    setting.maxDBSize = _maxDBSize;
+    setting.versionEnabled = _versionEnabled;
+    setting.durabilityMode = _durabilityMode;
+    setting.flushInterval = _flushInterval;
+    setting.growthStep = _growthStep;
+    setting.growthFactor = _growthFactor;
+    setting.growthLimit = _maxDBSizeLimit;
+    setting.batchSize = _batchSize;
+    setting.batchLatency = _batchLatency;
+    setting.storageEngine = _storageEngine;
+    setting.largeValueThreshold = _largeValueThreshold;
+    setting.readerCheckInterval = _readerCheckInterval;
+    setting.maxReaderAge = _maxReaderAge;
+    setting.mapAdvice = _mapAdvice;
+    setting.recordFormat = _recordFormat;
+    // an in-memory database does not leave anything on disk
+    if (_storageEngine == StorageEngine::MEMORY) {
+        auto context = Context {};
+        context._dbPath = _dbPath;
+        context._openMode = OpenMode::READ_WRITE;
+        std::lock_guard<std::mutex> lock(underlyingMutex);
+        if (Context::_underlying.find(_dbPath) != Context::_underlying.cend()) {
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_ALREADY_INITIALIZED);
+        }
+        inMemorySettings.emplace(_dbPath, setting);
+        try {
+            context.openInstance(setting);
+        } catch (...) {
+            inMemorySettings.erase(_dbPath);
+            throw;
+        }
+        return context;
+    }
     // create a database folder if not exist
     if (!fileExists(_dbPath)) {
         mkdir(_dbPath.c_str(), 0755);
         auto settingFilePath = _dbPath + DB_SETTING_NAME;
         // write database settings to disk
-        auto setting = ContextSetting{};
-        setting.maxDB = _maxDB;
-        setting.maxDBSize = _maxDBSize;
-        setting.versionEnabled = _versionEnabled;
         writeBinaryFile(settingFilePath.c_str(), static_cast<const char*>((void*)&setting), sizeof(setting));
-        return Context(_dbPath, _maxDB, _maxDBSize, _versionEnabled);
+        return Context(_dbPath);
     } else {
         throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_ALREADY_INITIALIZED);
     }
 }
 
-Context::Context(const std::string& dbPath)
+Context::Context(const std::string& dbPath, OpenMode openMode)
     : _dbPath { dbPath }
+    , _openMode { openMode }
 {
+    {
+        std::lock_guard<std::mutex> lock(underlyingMutex);
+        auto inMemory = inMemorySettings.find(dbPath);
+        if (inMemory != inMemorySettings.cend()) {
+            openInstance(inMemory->second);
+            return;
+        }
+    }
     if (!fileExists(_dbPath)) {
         throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
     } else {
@@ -98,58 +418,93 @@ Context::Context(const std::string& dbPath)
             throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNKNOWN_ERR);
         } else {
             // read database settings from disk
-            auto setting = ContextSetting{};
-            auto binary = readBinaryFile(settingFilePath.c_str(), sizeof(setting));
-            memcpy(&setting, binary, sizeof(setting));
-            delete [] binary;
-            _maxDB = setting.maxDB;
-            _maxDBSize = setting.maxDBSize;
-            _versionEnabled = setting.versionEnabled;
-            auto foundContext = _underlying.find(dbPath);
-            if (foundContext == _underlying.cend()) {
-                auto instance = LMDBInstance {};
-                instance._handler = new storage_engine::LMDBEnv(
-                    _dbPath, setting.maxDB, setting.maxDBSize, DEFAULT_NOGDB_MAX_READERS);
-                instance._refCount = 1;
-                _underlying.emplace(dbPath, instance);
-                _envHandler = instance._handler;
-            } else {
-                _envHandler = foundContext->second._handler;
-                ++foundContext->second._refCount;
-            }
+            auto setting = readContextSetting(settingFilePath);
+            std::lock_guard<std::mutex> lock(underlyingMutex);
+            openInstance(setting);
         }
     }
 }
 
-Context::Context(const std::string& dbPath, unsigned int maxDB, unsigned long maxDBSize, bool versionEnabled)
-    : _dbPath { dbPath }, _maxDB { maxDB }, _maxDBSize { maxDBSize }, _versionEnabled { versionEnabled }
+void Context::openInstance(const ContextSetting& setting)
 {
-    auto foundContext = _underlying.find(dbPath);
+    _maxDB = setting.maxDB;
+    _maxDBSize = setting.maxDBSize;
+    _versionEnabled = setting.versionEnabled;
+    _durabilityMode = setting.durabilityMode;
+    _flushInterval = setting.flushInterval;
+    _growthStep = setting.growthStep;
+    _growthFactor = setting.growthFactor;
+    _maxDBSizeLimit = setting.growthLimit;
+    _batchSize = setting.batchSize;
+    _batchLatency = setting.batchLatency;
+    _storageEngine = setting.storageEngine;
+    _largeValueThreshold = setting.largeValueThreshold;
+    _readerCheckInterval = setting.readerCheckInterval;
+    _maxReaderAge = setting.maxReaderAge;
+    _mapAdvice = setting.mapAdvice;
+    _recordFormat = setting.recordFormat;
+    auto foundContext = _underlying.find(_dbPath);
     if (foundContext == _underlying.cend()) {
+        // opened while holding the lock as an environment must be opened only once per process
         auto instance = LMDBInstance {};
-        instance._handler = new storage_engine::LMDBEnv(_dbPath, _maxDB, _maxDBSize, DEFAULT_NOGDB_MAX_READERS);
+        instance._handler = openEnv(_dbPath, setting, _openMode);
+        instance._readTxnPool = Transaction::createReadTxnPool();
+        instance._batchWriter = nullptr;
         instance._refCount = 1;
-        _underlying.emplace(dbPath, instance);
+        instance._readOnly = instance._handler->isReadOnly();
+        _underlying.emplace(_dbPath, instance);
         _envHandler = instance._handler;
+        _readTxnPool = instance._readTxnPool;
     } else {
+        if (foundContext->second._readOnly && !isReadOnly()) {
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_READ_ONLY);
+        }
         _envHandler = foundContext->second._handler;
+        _readTxnPool = foundContext->second._readTxnPool;
         ++foundContext->second._refCount;
     }
 }
 
 Context::~Context() noexcept
 {
+    releaseInstance();
+}
+
+void Context::retainInstance()
+{
+    if (_envHandler == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(underlyingMutex);
     auto foundContext = _underlying.find(_dbPath);
-    if (foundContext != _underlying.cend()) {
-        if (foundContext->second._refCount <= 1) {
-            delete foundContext->second._handler;
-            foundContext->second._handler = nullptr;
-            _underlying.erase(_dbPath);
-        } else {
-            --foundContext->second._refCount;
+    if (foundContext != _underlying.end()) {
+        ++foundContext->second._refCount;
+    }
+}
+
+void Context::releaseInstance() noexcept
+{
+    if (_envHandler != nullptr) {
+        std::lock_guard<std::mutex> lock(underlyingMutex);
+        auto foundContext = _underlying.find(_dbPath);
+        if (foundContext != _underlying.end()) {
+            if (foundContext->second._refCount <= 1) {
+                // pending batches are committed, and pooled read transactions aborted, before the environment is closed
+                BatchTxn::destroyWriter(foundContext->second._batchWriter);
+                foundContext->second._batchWriter = nullptr;
+                Transaction::destroyReadTxnPool(foundContext->second._readTxnPool);
+                foundContext->second._readTxnPool = nullptr;
+                delete foundContext->second._handler;
+                foundContext->second._handler = nullptr;
+                _underlying.erase(foundContext);
+                inMemorySettings.erase(_dbPath);
+            } else {
+                --foundContext->second._refCount;
+            }
         }
     }
     _envHandler = nullptr;
+    _readTxnPool = nullptr;
 }
 
 Context::Context(const Context& ctx)
@@ -157,58 +512,259 @@ Context::Context(const Context& ctx)
     , _maxDB { ctx._maxDB }
     , _maxDBSize { ctx._maxDBSize }
     , _versionEnabled { ctx._versionEnabled }
+    , _durabilityMode { ctx._durabilityMode }
+    , _flushInterval { ctx._flushInterval }
+    , _growthStep { ctx._growthStep }
+    , _growthFactor { ctx._growthFactor }
+    , _maxDBSizeLimit { ctx._maxDBSizeLimit }
+    , _batchSize { ctx._batchSize }
+    , _batchLatency { ctx._batchLatency }
+    , _storageEngine { ctx._storageEngine }
+    , _largeValueThreshold { ctx._largeValueThreshold }
+    , _readerCheckInterval { ctx._readerCheckInterval }
+    , _maxReaderAge { ctx._maxReaderAge }
+    , _mapAdvice { ctx._mapAdvice }
+    , _recordFormat { ctx._recordFormat }
+    , _openMode { ctx._openMode }
     , _envHandler { ctx._envHandler }
+    , _readTxnPool { ctx._readTxnPool }
 {
-    ++_underlying.find(_dbPath)->second._refCount;
+    retainInstance();
 }
 
 Context& Context::operator=(const Context& ctx)
 {
     if (this != &ctx) {
-        _dbPath = ctx._dbPath;
-        _maxDB = ctx._maxDB;
-        _maxDBSize = ctx._maxDBSize;
-        _versionEnabled = ctx._versionEnabled;
-        _envHandler = ctx._envHandler;
-        ++_underlying.find(_dbPath)->second._refCount;
+        // take the new reference before dropping the old one in case both share an environment
+        auto other = Context { ctx };
+        *this = std::move(other);
     }
     return *this;
 }
 
+void Context::copySettings(const Context& ctx)
+{
+    _dbPath = ctx._dbPath;
+    _maxDB = ctx._maxDB;
+    _maxDBSize = ctx._maxDBSize;
+    _versionEnabled = ctx._versionEnabled;
+    _durabilityMode = ctx._durabilityMode;
+    _flushInterval = ctx._flushInterval;
+    _growthStep = ctx._growthStep;
+    _growthFactor = ctx._growthFactor;
+    _maxDBSizeLimit = ctx._maxDBSizeLimit;
+    _batchSize = ctx._batchSize;
+    _batchLatency = ctx._batchLatency;
+    _storageEngine = ctx._storageEngine;
+    _largeValueThreshold = ctx._largeValueThreshold;
+    _readerCheckInterval = ctx._readerCheckInterval;
+    _maxReaderAge = ctx._maxReaderAge;
+    _mapAdvice = ctx._mapAdvice;
+    _recordFormat = ctx._recordFormat;
+    _openMode = ctx._openMode;
+}
+
 Context::Context(Context&& ctx) noexcept
     : _dbPath { ctx._dbPath }
     , _maxDB { ctx._maxDB }
     , _maxDBSize { ctx._maxDBSize }
     , _versionEnabled { ctx._versionEnabled }
+    , _durabilityMode { ctx._durabilityMode }
+    , _flushInterval { ctx._flushInterval }
+    , _growthStep { ctx._growthStep }
+    , _growthFactor { ctx._growthFactor }
+    , _maxDBSizeLimit { ctx._maxDBSizeLimit }
+    , _batchSize { ctx._batchSize }
+    , _batchLatency { ctx._batchLatency }
+    , _storageEngine { ctx._storageEngine }
+    , _largeValueThreshold { ctx._largeValueThreshold }
+    , _readerCheckInterval { ctx._readerCheckInterval }
+    , _maxReaderAge { ctx._maxReaderAge }
+    , _mapAdvice { ctx._mapAdvice }
+    , _recordFormat { ctx._recordFormat }
+    , _openMode { ctx._openMode }
     , _envHandler { ctx._envHandler }
+    , _readTxnPool { ctx._readTxnPool }
 {
+    ctx._dbPath = std::string {};
+    ctx._envHandler = nullptr;
+    ctx._readTxnPool = nullptr;
 }
 
 Context& Context::operator=(Context&& ctx) noexcept
 {
     if (this != &ctx) {
+        releaseInstance();
         _envHandler = ctx._envHandler;
-        _dbPath = ctx._dbPath;
-        _maxDB = ctx._maxDB;
-        _maxDBSize = ctx._maxDBSize;
-        _versionEnabled = ctx._versionEnabled;
+        _readTxnPool = ctx._readTxnPool;
+        copySettings(ctx);
         ctx._dbPath = std::string {};
         ctx._maxDB = 0;
         ctx._maxDBSize = 0;
         ctx._versionEnabled = false;
+        ctx._durabilityMode = DurabilityMode::FULL;
+        ctx._flushInterval = 0;
+        ctx._growthStep = 0;
+        ctx._growthFactor = 0.0;
+        ctx._maxDBSizeLimit = 0;
+        ctx._batchSize = 0;
+        ctx._batchLatency = 0;
+        ctx._storageEngine = StorageEngine::LMDB;
+        ctx._largeValueThreshold = 0;
+        ctx._readerCheckInterval = 0;
+        ctx._maxReaderAge = 0;
+        ctx._mapAdvice = MapAdvice::NORMAL;
+        ctx._recordFormat = RecordFormat::V1;
+        ctx._openMode = OpenMode::READ_WRITE;
         ctx._envHandler = nullptr;
+        ctx._readTxnPool = nullptr;
     }
     return *this;
 }
 
+unsigned long Context::getMapResizeCount() const
+{
+    return _envHandler ? _envHandler->getResizeCount() : 0;
+}
+
+ReaderStats Context::getReaderStats() const
+{
+    if (_envHandler == nullptr) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    return _envHandler->readerStats();
+}
+
+void Context::setLongReaderHandler(std::function<void(const ReaderStats&)> handler)
+{
+    if (_envHandler == nullptr) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    _envHandler->setLongReaderHandler(std::move(handler));
+}
+
+WarmupStats Context::warmup(const std::vector<std::string>& classNames, bool withIndexes, bool withRelations)
+{
+    if (_envHandler == nullptr) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto result = WarmupStats {};
+    result.residentPagesBefore = _envHandler->residentPages(result.totalPages);
+    auto txn = beginTxn(TxnMode::READ_ONLY);
+    auto classInfos = std::vector<adapter::schema::ClassAccessInfo> {};
+    if (classNames.empty()) {
+        classInfos = txn._adapter->dbClass()->getAllInfos();
+    } else {
+        for (const auto& className : classNames) {
+            classInfos.emplace_back(schema::SchemaUtils::getExistingClass(&txn, className));
+        }
+    }
+    // values stored out of line are left out, as they are only read when their records are fetched
+    for (const auto& classInfo : classInfos) {
+        result.entries += adapter::datarecord::DataRecord(txn._txnBase, classInfo.id, classInfo.type).warmup();
+        ++result.tables;
+        if (!withIndexes) {
+            continue;
+        }
+        auto indexInfos = txn._adapter->dbIndex()->getInfos(classInfo.id);
+        if (indexInfos.empty()) {
+            continue;
+        }
+        auto propertyIdMapInfo = schema::SchemaUtils::getPropertyIdMapInfo(&txn, classInfo.id, classInfo.superClassId);
+        for (const auto& indexInfo : indexInfos) {
+            auto propertyInfo = propertyIdMapInfo.find(indexInfo.propertyId);
+            if (propertyInfo != propertyIdMapInfo.cend()) {
+                auto warmed = index::IndexUtils::warmup(&txn, propertyInfo->second, indexInfo);
+                result.tables += warmed.first;
+                result.entries += warmed.second;
+            }
+        }
+    }
+    if (withRelations) {
+        result.entries += adapter::relation::RelationAccess(txn._txnBase, adapter::relation::Direction::IN).warmup();
+        result.entries += adapter::relation::RelationAccess(txn._txnBase, adapter::relation::Direction::OUT).warmup();
+        result.tables += 2;
+    }
+    txn.rollback();
+    result.residentPages = _envHandler->residentPages(result.totalPages);
+    result.durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+BackupStats Context::backup(const std::string& path, bool compact) const
+{
+    if (_envHandler == nullptr) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    // there is neither a data file nor a settings file to copy
+    if (_storageEngine == StorageEngine::MEMORY) {
+        throw NOGDB_STORAGE_ERROR(ENOTSUP);
+    }
+    auto start = std::chrono::steady_clock::now();
+    if (!fileExists(path) && mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw NOGDB_STORAGE_ERROR(errno);
+    }
+    _envHandler->copy(path, compact);
+    // the settings are never modified once the database has been initialized
+    auto settingSize = fileSize(_dbPath + DB_SETTING_NAME);
+    auto binary = readBinaryFile((_dbPath + DB_SETTING_NAME).c_str(), settingSize);
+    writeBinaryFile((path + DB_SETTING_NAME).c_str(), binary, settingSize);
+    delete[] binary;
+    auto result = BackupStats {};
+    result.path = path;
+    result.compacted = compact;
+    result.bytesWritten = fileSize(path + DB_DATA_NAME) + settingSize;
+    result.durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+BackupStats Context::backup(int fd, bool compact) const
+{
+    if (_envHandler == nullptr) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    // there is no data file to stream
+    if (_storageEngine == StorageEngine::MEMORY) {
+        throw NOGDB_STORAGE_ERROR(ENOTSUP);
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto result = BackupStats {};
+    result.compacted = compact;
+    result.bytesWritten = _envHandler->copy(fd, compact);
+    result.durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
 Transaction Context::beginTxn(const TxnMode& txnMode)
 {
     return Transaction(*this, txnMode);
 }
 
-Transaction Context::beginBatchTxn()
+BatchTxn Context::beginBatchTxn()
 {
-    return Transaction(*this, TxnMode::READ_WRITE);
+    if (_envHandler == nullptr) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    if (isReadOnly()) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_READ_ONLY);
+    }
+    std::lock_guard<std::mutex> lock(underlyingMutex);
+    auto foundContext = _underlying.find(_dbPath);
+    require(foundContext != _underlying.end());
+    // the writer thread is only started once a batch is used on the environment
+    if (foundContext->second._batchWriter == nullptr) {
+        foundContext->second._batchWriter = BatchTxn::createWriter(*this);
+    }
+    return BatchTxn(foundContext->second._batchWriter);
+}
+
+BulkLoader Context::beginBulkLoad()
+{
+    if (isReadOnly()) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_READ_ONLY);
+    }
+    return BulkLoader(*this);
 }
 
 }
@@ -51,6 +51,7 @@ ResultSetCursor& ResultSetCursor::operator=(ResultSetCursor&& rc) noexcept
         txn = rc.txn;
         metadata = std::move(rc.metadata);
         currentIndex = rc.currentIndex;
+        resultLoaded = false;
     }
     return *this;
 }
@@ -72,44 +73,28 @@ bool ResultSetCursor::hasAt(unsigned long index) const
 
 bool ResultSetCursor::next()
 {
-    BEGIN_VALIDATION(txn)
-        .isTxnCompleted();
-
     if (!metadata.empty() && (currentIndex == -1)) {
-        currentIndex = 0;
+        return moveTo(0);
     } else if (hasNext()) {
-        ++currentIndex;
+        return moveTo(currentIndex + 1);
     } else {
+        BEGIN_VALIDATION(txn)
+            .isTxnCompleted();
         return false;
     }
-    auto cursor = metadata.begin() + currentIndex;
-    auto recordDescriptor = *(cursor);
-    auto classInfo = SchemaUtils::getExistingClass(txn, recordDescriptor.rid.first);
-    auto record = DataRecordUtils::getRecordWithBasicInfo(txn, classInfo, recordDescriptor);
-    record.setBasicInfo(DEPTH_PROPERTY, recordDescriptor._depth);
-    result = Result { recordDescriptor, record };
-    return true;
 }
 
 bool ResultSetCursor::previous()
 {
-    BEGIN_VALIDATION(txn)
-        .isTxnCompleted();
-
     if (!metadata.empty() && (currentIndex >= static_cast<long long>(metadata.size()))) {
-        currentIndex = static_cast<long long>(metadata.size() - 1);
+        return moveTo(static_cast<long long>(metadata.size() - 1));
     } else if (hasPrevious()) {
-        --currentIndex;
+        return moveTo(currentIndex - 1);
     } else {
+        BEGIN_VALIDATION(txn)
+            .isTxnCompleted();
         return false;
     }
-    auto cursor = metadata.begin() + currentIndex;
-    auto recordDescriptor = *(cursor);
-    auto classInfo = SchemaUtils::getExistingClass(txn, recordDescriptor.rid.first);
-    auto record = DataRecordUtils::getRecordWithBasicInfo(txn, classInfo, recordDescriptor);
-    record.setBasicInfo(DEPTH_PROPERTY, recordDescriptor._depth);
-    result = Result { recordDescriptor, record };
-    return true;
 }
 
 bool ResultSetCursor::empty() const
@@ -129,33 +114,21 @@ size_t ResultSetCursor::count() const
 
 void ResultSetCursor::first()
 {
-    BEGIN_VALIDATION(txn)
-        .isTxnCompleted();
-
     if (!metadata.empty()) {
-        currentIndex = 0;
-        auto cursor = metadata.begin();
-        auto recordDescriptor = *(cursor);
-        auto classInfo = SchemaUtils::getExistingClass(txn, recordDescriptor.rid.first);
-        auto record = DataRecordUtils::getRecordWithBasicInfo(txn, classInfo, recordDescriptor);
-        record.setBasicInfo(DEPTH_PROPERTY, recordDescriptor._depth);
-        result = Result { recordDescriptor, record };
+        moveTo(0);
+    } else {
+        BEGIN_VALIDATION(txn)
+            .isTxnCompleted();
     }
 }
 
 void ResultSetCursor::last()
 {
-    BEGIN_VALIDATION(txn)
-        .isTxnCompleted();
-
     if (!metadata.empty()) {
-        currentIndex = static_cast<long long>(metadata.size() - 1);
-        auto cursor = metadata.end() - 1;
-        auto recordDescriptor = *(cursor);
-        auto classInfo = SchemaUtils::getExistingClass(txn, recordDescriptor.rid.first);
-        auto record = DataRecordUtils::getRecordWithBasicInfo(txn, classInfo, recordDescriptor);
-        record.setBasicInfo(DEPTH_PROPERTY, recordDescriptor._depth);
-        result = Result { recordDescriptor, record };
+        moveTo(static_cast<long long>(metadata.size() - 1));
+    } else {
+        BEGIN_VALIDATION(txn)
+            .isTxnCompleted();
     }
 }
 
@@ -167,18 +140,22 @@ bool ResultSetCursor::to(unsigned long index)
     if (index >= metadata.size()) {
         return false;
     }
-    currentIndex = index;
-    auto cursor = metadata.begin() + currentIndex;
-    auto recordDescriptor = *(cursor);
-    auto classInfo = SchemaUtils::getExistingClass(txn, recordDescriptor.rid.first);
-    auto record = DataRecordUtils::getRecordWithBasicInfo(txn, classInfo, recordDescriptor);
-    record.setBasicInfo(DEPTH_PROPERTY, recordDescriptor._depth);
-    result = Result { recordDescriptor, record };
-    return true;
+    return moveTo(static_cast<long long>(index));
 }
 
 const Result& ResultSetCursor::operator*() const
 {
+    if (!resultLoaded && currentIndex >= 0 && currentIndex < static_cast<long long>(metadata.size())) {
+        BEGIN_VALIDATION(txn)
+            .isTxnCompleted();
+
+        auto& recordDescriptor = metadata[currentIndex];
+        auto classInfo = SchemaUtils::getExistingClass(txn, recordDescriptor.rid.first);
+        auto record = DataRecordUtils::getRecordWithBasicInfo(txn, classInfo, recordDescriptor);
+        record.setBasicInfo(DEPTH_PROPERTY, recordDescriptor._depth);
+        result = Result { recordDescriptor, std::move(record) };
+        resultLoaded = true;
+    }
     return result;
 }
 
@@ -187,4 +164,29 @@ const Result* ResultSetCursor::operator->() const
     return &(operator*());
 }
 
-}
\ No newline at end of file
+ResultView ResultSetCursor::getView() const
+{
+    if (currentIndex < 0 || currentIndex >= static_cast<long long>(metadata.size())) {
+        return ResultView {};
+    }
+    BEGIN_VALIDATION(txn)
+        .isTxnCompleted();
+
+    auto& recordDescriptor = metadata[currentIndex];
+    auto classInfo = SchemaUtils::getExistingClass(txn, recordDescriptor.rid.first);
+    auto record = DataRecordUtils::getRecordViewWithBasicInfo(txn, classInfo, recordDescriptor);
+    record._depth = recordDescriptor._depth;
+    return ResultView { recordDescriptor, record };
+}
+
+bool ResultSetCursor::moveTo(long long index)
+{
+    BEGIN_VALIDATION(txn)
+        .isTxnCompleted();
+
+    currentIndex = index;
+    resultLoaded = false;
+    return true;
+}
+
+}
@@ -31,20 +31,22 @@ namespace datarecord {
         const ClassAccessInfo& classInfo,
         const RecordDescriptor& recordDescriptor)
     {
-        auto propertyInfos = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto propertyInfos = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
         auto result = DataRecord(txn->_txnBase, classInfo.id, classInfo.type).getResult(recordDescriptor.rid.second);
-        return RecordParser::parseRawData(result, propertyInfos, classInfo.type, txn->_txnCtx->isVersionEnabled());
+        return RecordParser::parseRawData(result, propertyInfos, classInfo.type, txn->_txnCtx->isVersionEnabled(),
+            txn->_txnBase, recordDescriptor.rid);
     }
 
     Record DataRecordUtils::getRecordWithBasicInfo(const Transaction *txn,
         const ClassAccessInfo& classInfo,
         const RecordDescriptor& recordDescriptor)
     {
-        auto propertyInfos = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto propertyInfos = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
         auto result = DataRecord(txn->_txnBase, classInfo.id, classInfo.type).getResult(recordDescriptor.rid.second);
         return RecordParser::parseRawDataWithBasicInfo(
-            classInfo.name, recordDescriptor.rid, result, propertyInfos, classInfo.type,
-            txn->_txnCtx->isVersionEnabled());
+            className, recordDescriptor.rid, result, propertyInfos, classInfo.type,
+            txn->_txnCtx->isVersionEnabled(), txn->_txnBase);
     }
 
     ResultSet DataRecordUtils::getResultSet(const Transaction *txn,
@@ -52,14 +54,15 @@ namespace datarecord {
         const std::vector<RecordDescriptor>& recordDescriptors)
     {
         auto resultSet = ResultSet {};
-        auto propertyInfos = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto propertyInfos = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
         auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
         for (const auto& recordDescriptor : recordDescriptors) {
             auto result = dataRecord.getResult(recordDescriptor.rid.second);
             auto record = RecordParser::parseRawDataWithBasicInfo(
-                classInfo.name, recordDescriptor.rid, result, propertyInfos, classInfo.type,
-                txn->_txnCtx->isVersionEnabled());
-            resultSet.emplace_back(Result { recordDescriptor, record });
+                className, recordDescriptor.rid, result, propertyInfos, classInfo.type,
+                txn->_txnCtx->isVersionEnabled(), txn->_txnBase);
+            resultSet.emplace_back(Result { recordDescriptor, std::move(record) });
         }
         return resultSet;
     }
@@ -67,19 +70,50 @@ namespace datarecord {
     ResultSet DataRecordUtils::getResultSet(const Transaction *txn, const ClassAccessInfo& classInfo)
     {
         auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
         auto resultSet = ResultSet {};
         std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
             [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
-                auto const record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, RecordId { classInfo.id, positionId },
-                    result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
-                resultSet.emplace_back(Result { RecordDescriptor { classInfo.id, positionId }, record });
+                auto record = RecordParser::parseRawDataWithBasicInfo(
+                    className, RecordId { classInfo.id, positionId },
+                    result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled(), txn->_txnBase);
+                resultSet.emplace_back(Result { RecordDescriptor { classInfo.id, positionId }, std::move(record) });
             };
         dataRecord.resultSetIter(callback);
         return resultSet;
     }
 
+    RecordView DataRecordUtils::getRecordViewWithBasicInfo(const Transaction *txn,
+        const ClassAccessInfo& classInfo,
+        const RecordDescriptor& recordDescriptor)
+    {
+        auto propertyInfos = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
+        auto result = DataRecord(txn->_txnBase, classInfo.id, classInfo.type).getResult(recordDescriptor.rid.second);
+        return RecordParser::parseRawDataViewWithBasicInfo(
+            className, recordDescriptor.rid, result, propertyInfos, classInfo.type,
+            txn->_txnCtx->isVersionEnabled(), txn->_txnBase);
+    }
+
+    ResultViewSet DataRecordUtils::getResultViewSet(const Transaction *txn, const ClassAccessInfo& classInfo)
+    {
+        auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
+        auto propertyInfos = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
+        auto resultViewSet = ResultViewSet {};
+        std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
+            [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
+                auto rid = RecordId { classInfo.id, positionId };
+                auto record = RecordParser::parseRawDataViewWithBasicInfo(
+                    className, rid, result, propertyInfos, classInfo.type,
+                    txn->_txnCtx->isVersionEnabled(), txn->_txnBase);
+                resultViewSet.emplace_back(ResultView { RecordDescriptor { rid }, record });
+            };
+        dataRecord.resultSetIter(callback);
+        return resultViewSet;
+    }
+
     ResultSetCursor DataRecordUtils::getResultSetCursor(const Transaction *txn, const ClassAccessInfo& classInfo)
     {
         auto vertexDataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
@@ -94,34 +128,70 @@ namespace datarecord {
 
     size_t DataRecordUtils::getCountRecord(const Transaction *txn, const ClassAccessInfo& classInfo)
     {
-        auto vertexDataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto count = size_t {0};
-        std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
-            [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
-                ++count;
-            };
-        vertexDataRecord.resultSetIter(callback);
-        return count;
+        return DataRecord(txn->_txnBase, classInfo.id, classInfo.type).size();
     }
 
-    ResultSet DataRecordUtils::getResultSetByCondition(const Transaction *txn,
+    template <typename Match>
+    void DataRecordUtils::forEachByCondition(const Transaction *txn,
         const ClassAccessInfo& classInfo,
         const PropertyType& propertyType,
-        const Condition& condition)
+        const Condition& condition,
+        bool decodeMatches,
+        Match match)
     {
         auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
-        auto resultSet = ResultSet {};
+        auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
+        auto isVersionEnabled = txn->_txnCtx->isVersionEnabled();
+        // values stored out of line are only fetched for a condition on a TEXT or BLOB property
+        auto conditionTxn = (propertyType == PropertyType::TEXT || propertyType == PropertyType::BLOB)
+            ? txn->_txnBase
+            : nullptr;
+        // a condition on a property is checked on the raw record, so that only a matching record is decoded
+        auto propertyId = PropertyId {};
+        auto isRawCondition = RecordCompare::getConditionPropertyId(*propertyIdMapInfo, condition, propertyId);
         std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
             [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
                 auto rid = RecordId { classInfo.id, positionId };
+                if (isRawCondition) {
+                    auto offset = RecordParser::getRawDataOffset(result, classInfo.type, isVersionEnabled);
+                    if (!RecordCompare::compareRawDataByCondition(
+                            result, offset, propertyId, propertyType, condition, conditionTxn, rid)) {
+                        return;
+                    }
+                    if (!decodeMatches) {
+                        match(rid, nullptr);
+                        return;
+                    }
+                    auto record = RecordParser::parseRawDataWithBasicInfo(
+                        className, rid, result, propertyIdMapInfo, classInfo.type, isVersionEnabled, txn->_txnBase);
+                    match(rid, &record);
+                    return;
+                }
                 auto record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, rid, result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
-                if (RecordCompare::compareRecordByCondition(record, propertyType, condition)) {
-                    resultSet.emplace_back(Result { RecordDescriptor { rid }, record });
+                    className, rid, result, propertyIdMapInfo, classInfo.type, isVersionEnabled, conditionTxn);
+                if (!RecordCompare::compareRecordByCondition(record, propertyType, condition)) {
+                    return;
                 }
+                if (decodeMatches && conditionTxn == nullptr
+                    && RecordParser::hasExternalValues(result, classInfo.type, isVersionEnabled)) {
+                    record = RecordParser::parseRawDataWithBasicInfo(
+                        className, rid, result, propertyIdMapInfo, classInfo.type, isVersionEnabled, txn->_txnBase);
+                }
+                match(rid, &record);
             };
         dataRecord.resultSetIter(callback);
+    }
+
+    ResultSet DataRecordUtils::getResultSetByCondition(const Transaction *txn,
+        const ClassAccessInfo& classInfo,
+        const PropertyType& propertyType,
+        const Condition& condition)
+    {
+        auto resultSet = ResultSet {};
+        forEachByCondition(txn, classInfo, propertyType, condition, true, [&](const RecordId& rid, Record* record) {
+            resultSet.emplace_back(Result { RecordDescriptor { rid }, std::move(*record) });
+        });
         return resultSet;
     }
 
@@ -130,19 +200,10 @@ namespace datarecord {
         const PropertyType& propertyType,
         const Condition& condition)
     {
-        auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
         auto recordDescriptors = std::vector<RecordDescriptor> {};
-        std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
-            [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
-                auto rid = RecordId { classInfo.id, positionId };
-                auto record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, rid, result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
-                if (RecordCompare::compareRecordByCondition(record, propertyType, condition)) {
-                    recordDescriptors.emplace_back(RecordDescriptor { rid });
-                }
-            };
-        dataRecord.resultSetIter(callback);
+        forEachByCondition(txn, classInfo, propertyType, condition, false, [&](const RecordId& rid, Record*) {
+            recordDescriptors.emplace_back(RecordDescriptor { rid });
+        });
         return recordDescriptors;
     }
 
@@ -151,44 +212,67 @@ namespace datarecord {
         const PropertyType& propertyType,
         const Condition& condition)
     {
-        auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
         auto count = size_t {0};
-        std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
-            [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
-                auto rid = RecordId { classInfo.id, positionId };
-                auto record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, rid, result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
-                if (RecordCompare::compareRecordByCondition(record, propertyType, condition)) {
-                    ++count;
-                }
-            };
-        dataRecord.resultSetIter(callback);
+        forEachByCondition(txn, classInfo, propertyType, condition, false, [&](const RecordId&, Record*) {
+            ++count;
+        });
         return count;
     }
 
-    ResultSet DataRecordUtils::getResultSetByMultiCondition(const Transaction *txn,
+    template <typename Match>
+    void DataRecordUtils::forEachByMultiCondition(const Transaction *txn,
         const ClassAccessInfo& classInfo,
         const PropertyNameMapInfo& propertyInfos,
-        const MultiCondition& multiCondition)
+        const MultiCondition& multiCondition,
+        bool decodeMatches,
+        Match match)
     {
         auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
+        auto isVersionEnabled = txn->_txnCtx->isVersionEnabled();
         auto propertyTypes = PropertyMapType {};
         for (const auto& property : propertyInfos) {
             propertyTypes.emplace(property.first, property.second.type);
         }
-        auto resultSet = ResultSet {};
+        // only the properties the conditions are on are decoded to check a record, then a matching record entirely
+        auto conditionPropertyInfos = RecordCompare::getConditionPropertyInfos(*propertyIdMapInfo, multiCondition);
         std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
             [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
                 auto rid = RecordId { classInfo.id, positionId };
+                if (conditionPropertyInfos) {
+                    auto offset = RecordParser::getRawDataOffset(result, classInfo.type, isVersionEnabled);
+                    auto conditionRecord = RecordParser::parseRawData(result, offset, conditionPropertyInfos, txn->_txnBase, rid);
+                    if (!multiCondition.execute(conditionRecord, propertyTypes)) {
+                        return;
+                    }
+                    if (!decodeMatches) {
+                        match(rid, nullptr);
+                        return;
+                    }
+                    auto record = RecordParser::parseRawDataWithBasicInfo(
+                        className, rid, result, propertyIdMapInfo, classInfo.type, isVersionEnabled, txn->_txnBase);
+                    match(rid, &record);
+                    return;
+                }
                 auto record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, rid, result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
+                    className, rid, result, propertyIdMapInfo, classInfo.type, isVersionEnabled, txn->_txnBase);
                 if (multiCondition.execute(record, propertyTypes)) {
-                    resultSet.emplace_back(Result { RecordDescriptor { rid }, record });
+                    match(rid, &record);
                 }
             };
         dataRecord.resultSetIter(callback);
+    }
+
+    ResultSet DataRecordUtils::getResultSetByMultiCondition(const Transaction *txn,
+        const ClassAccessInfo& classInfo,
+        const PropertyNameMapInfo& propertyInfos,
+        const MultiCondition& multiCondition)
+    {
+        auto resultSet = ResultSet {};
+        forEachByMultiCondition(txn, classInfo, propertyInfos, multiCondition, true, [&](const RecordId& rid, Record* record) {
+            resultSet.emplace_back(Result { RecordDescriptor { rid }, std::move(*record) });
+        });
         return resultSet;
     }
 
@@ -197,23 +281,10 @@ namespace datarecord {
         const PropertyNameMapInfo& propertyInfos,
         const MultiCondition& multiCondition)
     {
-        auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
-        auto propertyTypes = PropertyMapType {};
-        for (const auto& property : propertyInfos) {
-            propertyTypes.emplace(property.first, property.second.type);
-        }
         auto recordDescriptors = std::vector<RecordDescriptor> {};
-        std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
-            [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
-                auto rid = RecordId { classInfo.id, positionId };
-                auto record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, rid, result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
-                if (multiCondition.execute(record, propertyTypes)) {
-                    recordDescriptors.emplace_back(RecordDescriptor { rid });
-                }
-            };
-        dataRecord.resultSetIter(callback);
+        forEachByMultiCondition(txn, classInfo, propertyInfos, multiCondition, false, [&](const RecordId& rid, Record*) {
+            recordDescriptors.emplace_back(RecordDescriptor { rid });
+        });
         return recordDescriptors;
     }
 
@@ -222,23 +293,10 @@ namespace datarecord {
         const PropertyNameMapInfo& propertyInfos,
         const MultiCondition& multiCondition)
     {
-        auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
-        auto propertyTypes = PropertyMapType {};
-        for (const auto& property : propertyInfos) {
-            propertyTypes.emplace(property.first, property.second.type);
-        }
         auto count = size_t {0};
-        std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
-            [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
-                auto rid = RecordId { classInfo.id, positionId };
-                auto record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, rid, result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
-                if (multiCondition.execute(record, propertyTypes)) {
-                    ++count;
-                }
-            };
-        dataRecord.resultSetIter(callback);
+        forEachByMultiCondition(txn, classInfo, propertyInfos, multiCondition, false, [&](const RecordId&, Record*) {
+            ++count;
+        });
         return count;
     }
 
@@ -247,15 +305,17 @@ namespace datarecord {
         std::function<bool(const Record&)> condition)
     {
         auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
         auto resultSet = ResultSet {};
         std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
             [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
                 auto rid = RecordId { classInfo.id, positionId };
                 auto record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, rid, result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
+                    className, rid, result, propertyIdMapInfo, classInfo.type,
+                    txn->_txnCtx->isVersionEnabled(), txn->_txnBase);
                 if (condition(record)) {
-                    resultSet.emplace_back(Result { RecordDescriptor { rid }, record });
+                    resultSet.emplace_back(Result { RecordDescriptor { rid }, std::move(record) });
                 }
             };
         dataRecord.resultSetIter(callback);
@@ -267,13 +327,15 @@ namespace datarecord {
         std::function<bool(const Record&)> condition)
     {
         auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
         auto recordDescriptors = std::vector<RecordDescriptor> {};
         std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
             [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
                 auto rid = RecordId { classInfo.id, positionId };
                 auto record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, rid, result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
+                    className, rid, result, propertyIdMapInfo, classInfo.type,
+                    txn->_txnCtx->isVersionEnabled(), txn->_txnBase);
                 if (condition(record)) {
                     recordDescriptors.emplace_back(RecordDescriptor { rid });
                 }
@@ -287,13 +349,15 @@ namespace datarecord {
         std::function<bool(const Record&)> condition)
     {
         auto dataRecord = DataRecord(txn->_txnBase, classInfo.id, classInfo.type);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(txn, classInfo.id, classInfo.superClassId);
+        auto className = SchemaUtils::getSharedClassName(txn, classInfo);
         auto count = size_t {0};
         std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
             [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
                 auto rid = RecordId { classInfo.id, positionId };
                 auto record = RecordParser::parseRawDataWithBasicInfo(
-                    classInfo.name, rid, result, propertyIdMapInfo, classInfo.type, txn->_txnCtx->isVersionEnabled());
+                    className, rid, result, propertyIdMapInfo, classInfo.type,
+                    txn->_txnCtx->isVersionEnabled(), txn->_txnBase);
                 if (condition(record)) {
                     ++count;
                 }
@@ -47,6 +47,12 @@ namespace datarecord {
 
         static ResultSet getResultSet(const Transaction *txn, const ClassAccessInfo& classInfo);
 
+        static RecordView getRecordViewWithBasicInfo(const Transaction *txn,
+            const ClassAccessInfo& classInfo,
+            const RecordDescriptor& recordDescriptor);
+
+        static ResultViewSet getResultViewSet(const Transaction *txn, const ClassAccessInfo& classInfo);
+
         static ResultSetCursor getResultSetCursor(const Transaction *txn, const ClassAccessInfo& classInfo);
 
         static size_t getCountRecord(const Transaction *txn, const ClassAccessInfo& classInfo);
@@ -94,6 +100,24 @@ namespace datarecord {
             const ClassAccessInfo& classInfo,
             std::function<bool(const Record&)> condition);
 
+        // calls match with the id of each record of the class satisfying the condition, and with the record
+        // entirely decoded if decodeMatches is set, nullptr otherwise
+        template <typename Match>
+        static void forEachByCondition(const Transaction *txn,
+            const ClassAccessInfo& classInfo,
+            const PropertyType& propertyType,
+            const Condition& condition,
+            bool decodeMatches,
+            Match match);
+
+        template <typename Match>
+        static void forEachByMultiCondition(const Transaction *txn,
+            const ClassAccessInfo& classInfo,
+            const PropertyNameMapInfo& propertyInfos,
+            const MultiCondition& multiCondition,
+            bool decodeMatches,
+            Match match);
+
     };
 
 }
@@ -21,6 +21,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "compression.hpp"
 #include "parser.hpp"
 #include "schema.hpp"
 #include "schema_adapter.hpp"
@@ -32,12 +39,19 @@ namespace datarecord {
     using namespace internal_data_type;
     using namespace utils::assertion;
 
+    /**
+     * Records of a class keyed by their position ids. When the class is compressed, each record is
+     * encoded with the dictionary of the class on write and decoded on read, so that callers always
+     * see raw records.
+     */
     class DataRecord : public storage_engine::adapter::LMDBKeyValAccess {
     public:
+
         DataRecord(const storage_engine::LMDBTxn* const txn,
             const ClassId& classId,
             const ClassType& classType = ClassType::UNDEFINED)
             : LMDBKeyValAccess(txn, std::to_string(classId), true, true, false, true)
+            , _txn { txn }
             , _classId { classId }
             , _classType { classType }
         {
@@ -47,8 +61,14 @@ namespace datarecord {
 
         DataRecord(DataRecord&& other) noexcept
             : LMDBKeyValAccess(std::move(other))
+            , _txn { other._txn }
             , _classId { other._classId }
             , _classType { other._classType }
+            , _dictionaryLoaded { other._dictionaryLoaded }
+            , _dictionary { std::move(other._dictionary) }
+            , _recordFormatLoaded { other._recordFormatLoaded }
+            , _recordFormatSet { other._recordFormatSet }
+            , _recordFormat { other._recordFormat }
         {
         }
 
@@ -71,21 +91,84 @@ namespace datarecord {
             auto result = get(MAX_RECORD_NUM_EM);
             require(!result.empty);
             auto posid = result.data.numeric<PositionId>();
-            put(posid, blob);
+            write(posid, blob, false);
             put(MAX_RECORD_NUM_EM, posid + PositionId { 1 });
             return posid;
         }
 
+        PositionId getNextPositionId() const
+        {
+            auto result = get(MAX_RECORD_NUM_EM);
+            require(!result.empty);
+            return result.data.numeric<PositionId>();
+        }
+
+        void setNextPositionId(const PositionId& posid)
+        {
+            put(MAX_RECORD_NUM_EM, posid);
+        }
+
+        /**
+         * Write a record whose position id has been allocated by the caller from getNextPositionId(),
+         * which is greater than every position id in the table so the record is appended at its end.
+         */
+        void append(const PositionId& posid, const Blob& blob)
+        {
+            write(posid, blob, true);
+        }
+
         void update(const PositionId& posid, const Blob& blob)
         {
             auto result = get(posid);
             if (!result.empty) {
-                put(posid, blob);
+                write(posid, blob, false);
             } else {
                 throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_RECORD);
             }
         }
 
+        /**
+         * Update a record whose new raw value of the given size is written by the writer straight into the
+         * space reserved in the table, rather than into a blob which is copied again when it is put.
+         * The reserved space may overlap the previous record, which the writer must not read from the table.
+         */
+        template <typename Writer>
+        void update(const PositionId& posid, size_t size, Writer&& writer)
+        {
+            if (!isCompressed()) {
+                writer(reserve(posid, size));
+                return;
+            }
+            thread_local auto raw = std::vector<unsigned char> {};
+            raw.resize(size);
+            writer(raw.data());
+            put(storage_engine::lmdb::Key { &posid, sizeof(posid) }, encode(raw.data(), size));
+        }
+
+        /**
+         * Update a record to its previous raw value of the same size with a few bytes overwritten by the
+         * writer, e.g. the version id or the vertices of an edge.
+         */
+        template <typename Writer>
+        void rewrite(const PositionId& posid, const storage_engine::lmdb::Result& rawData, Writer&& writer)
+        {
+            require(!rawData.empty);
+            thread_local auto previous = std::vector<unsigned char> {};
+            auto data = rawData.data.data<unsigned char>();
+            previous.assign(data, data + rawData.data.size());
+            update(posid, previous.size(), [&](unsigned char* data) {
+                memcpy(data, previous.data(), previous.size());
+                writer(data);
+            });
+        }
+
+        void updateVersion(const PositionId& posid, const storage_engine::lmdb::Result& rawData, VersionId versionId)
+        {
+            rewrite(posid, rawData, [&](unsigned char* data) {
+                parser::RecordParser::writeVersionId(data, versionId);
+            });
+        }
+
         void remove(const PositionId& posid)
         {
             auto result = get(posid);
@@ -103,18 +186,16 @@ namespace datarecord {
 
         Blob getBlob(const PositionId& posid)
         {
-            auto result = get(posid);
-            if (!result.empty) {
-                return result.data.blob();
-            } else {
-                throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_RECORD);
-            }
+            return getResult(posid).data.blob();
         }
 
         storage_engine::lmdb::Result getResult(const PositionId& posid)
         {
             auto result = get(posid);
             if (!result.empty) {
+                if (isCompressed()) {
+                    decode(result);
+                }
                 return result;
             } else {
                 throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_RECORD);
@@ -128,6 +209,10 @@ namespace datarecord {
 
         void resultSetIter(std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback)
         {
+            auto compressed = isCompressed();
+            // records are decoded one after another into chunks, which stay alive as long as a view of
+            // one of their records does, and are reused otherwise
+            auto chunk = std::shared_ptr<std::vector<unsigned char>> {};
             auto cursorHandler = getCursor();
             for (auto keyValue = cursorHandler.getNext();
                  !keyValue.empty();
@@ -135,10 +220,74 @@ namespace datarecord {
                 auto key = keyValue.key.data.numeric<PositionId>();
                 if (key == MAX_RECORD_NUM_EM)
                     continue;
+                if (compressed) {
+                    auto rawSize = compression::Codec::decompressedSize(
+                        keyValue.val.data.data<unsigned char>(), keyValue.val.data.size());
+                    if (chunk && chunk.use_count() == 1) {
+                        chunk->clear();
+                    }
+                    if (!chunk || chunk->size() + rawSize > chunk->capacity()) {
+                        chunk = std::make_shared<std::vector<unsigned char>>();
+                        chunk->reserve(std::max(rawSize, COMPRESSION_DECODE_CHUNK_SIZE));
+                    }
+                    decode(keyValue.val, chunk);
+                }
                 callback(key, keyValue.val);
             }
         }
 
+        /**
+         * Number of records without iterating over them, the next position id is not counted.
+         */
+        size_t size() const
+        {
+            auto entries = stat().ms_entries;
+            return (!get(MAX_RECORD_NUM_EM).empty) ? entries - 1 : entries;
+        }
+
+        bool isCompressed() const
+        {
+            if (!_dictionaryLoaded) {
+                auto result = schema::DictionaryAccess(_txn).getResult(_classId);
+                if (!result.empty) {
+                    _dictionary = compression::Dictionary::load(
+                        _classId, result.data.data<unsigned char>(), result.data.size());
+                }
+                _dictionaryLoaded = true;
+            }
+            return _dictionary != nullptr;
+        }
+
+        /**
+         * Format records of the class are written in, which is the one given unless they have been rewritten
+         * to another format.
+         */
+        RecordFormat getRecordFormat(RecordFormat defaultFormat) const
+        {
+            if (!_recordFormatLoaded) {
+                auto result = schema::RecordFormatAccess(_txn).getResult(_classId);
+                if (!result.empty) {
+                    _recordFormat = static_cast<RecordFormat>(result.data.numeric<uint8_t>());
+                    _recordFormatSet = true;
+                }
+                _recordFormatLoaded = true;
+            }
+            return (_recordFormatSet) ? _recordFormat : defaultFormat;
+        }
+
+        /**
+         * Size of a record as it is stored, which is smaller than its raw size when the class is compressed.
+         */
+        size_t getStoredSize(const PositionId& posid) const
+        {
+            auto result = get(posid);
+            if (!result.empty) {
+                return result.data.size();
+            } else {
+                throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_RECORD);
+            }
+        }
+
         const ClassId& getClassId() const
         {
             return _classId;
@@ -150,8 +299,130 @@ namespace datarecord {
         }
 
     private:
+        const storage_engine::LMDBTxn* _txn { nullptr };
         ClassId _classId {};
         ClassType _classType { ClassType::UNDEFINED };
+        mutable bool _dictionaryLoaded { false };
+        mutable std::shared_ptr<const compression::Dictionary> _dictionary {};
+        mutable bool _recordFormatLoaded { false };
+        mutable bool _recordFormatSet { false };
+        mutable RecordFormat _recordFormat { RecordFormat::V1 };
+
+        void write(const PositionId& posid, const Blob& blob, bool append)
+        {
+            if (!isCompressed()) {
+                if (append) {
+                    LMDBKeyValAccess::append(posid, blob);
+                } else {
+                    put(posid, blob);
+                }
+                return;
+            }
+            auto key = storage_engine::lmdb::Key { &posid, sizeof(posid) };
+            auto value = encode(blob.bytes(), blob.size());
+            if (append) {
+                LMDBKeyValAccess::append(key, value);
+            } else {
+                put(key, value);
+            }
+        }
+
+        // the value is valid until the next record is encoded by the thread
+        storage_engine::lmdb::Value encode(const unsigned char* data, size_t size) const
+        {
+            thread_local auto encoded = std::vector<unsigned char> {};
+            encoded.resize(compression::Codec::compressBound(size));
+            auto encodedSize = compression::Codec::compress(*_dictionary, data, size, encoded.data());
+            return storage_engine::lmdb::Value { encoded.data(), encodedSize };
+        }
+
+        // appends the raw record to the buffer, which must have enough capacity not to be reallocated
+        void decode(storage_engine::lmdb::Result& result,
+            std::shared_ptr<std::vector<unsigned char>> buffer = nullptr) const
+        {
+            auto encoded = result.data.data<unsigned char>();
+            auto encodedSize = result.data.size();
+            auto rawSize = compression::Codec::decompressedSize(encoded, encodedSize);
+            if (!buffer) {
+                buffer = std::make_shared<std::vector<unsigned char>>();
+            }
+            auto offset = buffer->size();
+            buffer->resize(offset + rawSize);
+            require(compression::Codec::decompress(
+                _dictionary->data(), _dictionary->size(), encoded, encodedSize, buffer->data() + offset));
+            result.data = storage_engine::lmdb::Value { buffer->data() + offset, rawSize };
+            result.buffer = buffer;
+        }
+    };
+
+    /**
+     * Property values of a class which are too large to be kept in their records, so that scanning
+     * the records does not read them. Each value is keyed by the position id of its record in the high
+     * bits and the property id in the low bits, so that the values of a record are adjacent.
+     */
+    class DataValue : public storage_engine::adapter::LMDBKeyValAccess {
+    public:
+        DataValue(const storage_engine::LMDBTxn* const txn, const ClassId& classId)
+            : LMDBKeyValAccess(txn, std::to_string(classId) + TB_VALUES_SUFFIX, true, true, false, true)
+        {
+        }
+
+        virtual ~DataValue() noexcept = default;
+
+        DataValue(DataValue&& other) noexcept
+            : LMDBKeyValAccess(std::move(other))
+        {
+        }
+
+        DataValue& operator=(DataValue&& other) noexcept
+        {
+            if (this != &other) {
+                using std::swap;
+                swap(*this, other);
+            }
+            return *this;
+        }
+
+        void insert(const PositionId& posid, const parser::ExternalValues& values)
+        {
+            for (const auto& value : values) {
+                auto key = toKey(posid, value.first);
+                put(storage_engine::lmdb::Key { &key, sizeof(key) },
+                    storage_engine::lmdb::Value { value.second.getConstRaw(), value.second.size() });
+            }
+        }
+
+        storage_engine::lmdb::Result getResult(const PositionId& posid, const PropertyId& propertyId) const
+        {
+            return get(toKey(posid, propertyId));
+        }
+
+        void remove(const PositionId& posid, const PropertyId& propertyId)
+        {
+            del(toKey(posid, propertyId));
+        }
+
+        void remove(const PositionId& posid)
+        {
+            auto cursorHandler = cursor();
+            auto lastKey = toKey(posid, std::numeric_limits<PropertyId>::max());
+            for (auto keyValue = cursorHandler.findRange(toKey(posid, PropertyId { 0 }));
+                 !keyValue.empty() && keyValue.key.data.numeric<uint64_t>() <= lastKey;
+                 keyValue = cursorHandler.getNext()) {
+                cursorHandler.del();
+            }
+        }
+
+        void destroy()
+        {
+            drop(true);
+        }
+
+    private:
+        inline static uint64_t toKey(const PositionId& posid, const PropertyId& propertyId)
+        {
+            return (static_cast<uint64_t>(posid) << (8 * sizeof(PropertyId))) | propertyId;
+        }
     };
 
 }
@@ -22,7 +22,9 @@
 #include <vector>
 
 #include "datarecord.hpp"
+#include "index.hpp"
 #include "lmdb_engine.hpp"
+#include "relation_adapter.hpp"
 #include "schema.hpp"
 
 #include "nogdb/nogdb.h"
@@ -31,6 +33,23 @@ namespace nogdb {
 using namespace adapter::schema;
 using namespace schema;
 using namespace datarecord;
+using namespace index;
+using adapter::relation::Direction;
+using adapter::relation::RelationAccess;
+
+namespace {
+    TableStat toTableStat(const std::string& name, const MDB_stat& stat)
+    {
+        return TableStat {
+            name,
+            stat.ms_depth,
+            stat.ms_branch_pages,
+            stat.ms_leaf_pages,
+            stat.ms_overflow_pages,
+            stat.ms_entries
+        };
+    }
+}
 
 const DBInfo Transaction::getDBInfo() const
 {
@@ -47,6 +66,48 @@ const DBInfo Transaction::getDBInfo() const
     return dbInfo;
 }
 
+const StorageStats Transaction::getStorageStats() const
+{
+    BEGIN_VALIDATION(this)
+        .isTxnCompleted();
+
+    auto envInfo = _txnCtx->_envHandler->info();
+    auto envStat = _txnCtx->_envHandler->stat();
+    auto storageStats = StorageStats {};
+    storageStats.dbPath = _txnCtx->_dbPath;
+    storageStats.pageSize = envStat.ms_psize;
+    storageStats.mapSize = envInfo.me_mapsize;
+    storageStats.usedSize = (envInfo.me_last_pgno + 1) * static_cast<size_t>(envStat.ms_psize);
+    storageStats.lastPageId = envInfo.me_last_pgno;
+    storageStats.maxReaders = envInfo.me_maxreaders;
+    storageStats.numReaders = envInfo.me_numreaders;
+    for (const auto& classInfo : _adapter->dbClass()->getAllInfos()) {
+        auto dataRecord = DataRecord(_txnBase, classInfo.id, classInfo.type);
+        storageStats.classes.emplace_back(toTableStat(classInfo.name, dataRecord.stat()));
+        auto indexInfos = _adapter->dbIndex()->getInfos(classInfo.id);
+        if (indexInfos.empty()) {
+            continue;
+        }
+        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(this, classInfo.id, classInfo.superClassId);
+        for (const auto& indexInfo : indexInfos) {
+            auto propertyInfo = propertyIdMapInfo.find(indexInfo.propertyId);
+            if (propertyInfo == propertyIdMapInfo.cend()) {
+                continue;
+            }
+            auto name = classInfo.name + "." + propertyInfo->second.name;
+            auto stats = IndexUtils::getStats(this, propertyInfo->second, indexInfo);
+            for (auto i = 0U; i < stats.size(); ++i) {
+                storageStats.indexes.emplace_back(toTableStat((i == 0) ? name : name + "#negative", stats[i]));
+            }
+        }
+    }
+    storageStats.relations.emplace_back(
+        toTableStat("relations#in", RelationAccess(_txnBase, Direction::IN).stat()));
+    storageStats.relations.emplace_back(
+        toTableStat("relations#out", RelationAccess(_txnBase, Direction::OUT).stat()));
+    return storageStats;
+}
+
 const std::vector<ClassDescriptor> Transaction::getClasses() const
 {
     BEGIN_VALIDATION(this)
@@ -180,6 +180,33 @@ namespace metadata {
             return _cache.numIndex;
         }
 
+        void setRelationFormat(uint8_t version)
+        {
+            put(RELATION_FORMAT_KEY, version);
+        }
+
+        uint8_t getRelationFormat() const
+        {
+            auto result = get(RELATION_FORMAT_KEY);
+            return result.empty ? uint8_t { 0 } : result.data.numeric<uint8_t>();
+        }
+
+        void setShardedCommit(uint64_t sequence)
+        {
+            put(SHARDED_COMMIT_KEY, sequence);
+        }
+
+        uint64_t getShardedCommit() const
+        {
+            auto result = get(SHARDED_COMMIT_KEY);
+            return result.empty ? uint64_t { 0 } : result.data.numeric<uint64_t>();
+        }
+
+        void clearCache() noexcept
+        {
+            _cache = DBInfoAccessCache {};
+        }
+
     protected:
         struct DBInfoAccessCache {
             PropertyId maxPropertyId { 0 };
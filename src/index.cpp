@@ -129,6 +129,56 @@ namespace index {
         }
     }
 
+    std::vector<MDB_stat> IndexUtils::getStats(const Transaction *txn,
+        const PropertyAccessInfo& propertyInfo,
+        const IndexAccessInfo& indexInfo)
+    {
+        switch (propertyInfo.type) {
+        case PropertyType::UNSIGNED_TINYINT:
+        case PropertyType::UNSIGNED_SMALLINT:
+        case PropertyType::UNSIGNED_INTEGER:
+        case PropertyType::UNSIGNED_BIGINT:
+            return std::vector<MDB_stat> { openIndexRecordPositive(txn, indexInfo).stat() };
+        case PropertyType::TINYINT:
+        case PropertyType::SMALLINT:
+        case PropertyType::INTEGER:
+        case PropertyType::BIGINT:
+        case PropertyType::REAL:
+            return std::vector<MDB_stat> {
+                openIndexRecordPositive(txn, indexInfo).stat(),
+                openIndexRecordNegative(txn, indexInfo).stat()
+            };
+        case PropertyType::TEXT:
+            return std::vector<MDB_stat> { openIndexRecordString(txn, indexInfo).stat() };
+        default:
+            return std::vector<MDB_stat> {};
+        }
+    }
+
+    std::pair<size_t, size_t> IndexUtils::warmup(const Transaction *txn,
+        const PropertyAccessInfo& propertyInfo,
+        const IndexAccessInfo& indexInfo)
+    {
+        switch (propertyInfo.type) {
+        case PropertyType::UNSIGNED_TINYINT:
+        case PropertyType::UNSIGNED_SMALLINT:
+        case PropertyType::UNSIGNED_INTEGER:
+        case PropertyType::UNSIGNED_BIGINT:
+            return std::make_pair(size_t { 1 }, openIndexRecordPositive(txn, indexInfo).warmup());
+        case PropertyType::TINYINT:
+        case PropertyType::SMALLINT:
+        case PropertyType::INTEGER:
+        case PropertyType::BIGINT:
+        case PropertyType::REAL:
+            return std::make_pair(size_t { 2 },
+                openIndexRecordPositive(txn, indexInfo).warmup() + openIndexRecordNegative(txn, indexInfo).warmup());
+        case PropertyType::TEXT:
+            return std::make_pair(size_t { 1 }, openIndexRecordString(txn, indexInfo).warmup());
+        default:
+            return std::make_pair(size_t { 0 }, size_t { 0 });
+        }
+    }
+
     void IndexUtils::drop(const Transaction *txn,
         const ClassId& classId,
         const PropertyNameMapInfo& propertyNameMapInfo)
@@ -612,14 +662,15 @@ namespace index {
         const ClassId& superClassId,
         const ClassType& classType)
     {
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, indexInfo.classId, superClassId);
-        require(!propertyIdMapInfo.empty());
+        auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(txn, indexInfo.classId, superClassId);
+        require(!propertyIdMapInfo->empty());
         auto indexAccess = openIndexRecordString(txn, indexInfo);
         auto dataRecord = DataRecord(txn->_txnBase, indexInfo.classId, classType);
         std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
             [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
                 auto const record = RecordParser::parseRawData(
-                    result, propertyIdMapInfo, classType == ClassType::EDGE, txn->_txnCtx->isVersionEnabled());
+                    result, propertyIdMapInfo, classType == ClassType::EDGE, txn->_txnCtx->isVersionEnabled(),
+                    txn->_txnBase, RecordId { indexInfo.classId, positionId });
                 auto value = record.get(propertyInfo.name).toText();
                 if (!value.empty()) {
                     auto indexRecord = Blob(sizeof(PositionId)).append(&positionId, sizeof(PositionId));
@@ -25,6 +25,7 @@
 #include <functional>
 #include <type_traits>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "datarecord_adapter.hpp"
@@ -121,6 +122,20 @@ namespace index {
             const PropertyIdMapIndex& propertyIndexInfo,
             const MultiCondition& conditions);
 
+        /**
+         * Statistics of the tables of an index, a signed numeric index has its negative table second.
+         */
+        static std::vector<MDB_stat> getStats(const Transaction *txn,
+            const PropertyAccessInfo& propertyInfo,
+            const IndexAccessInfo& indexInfo);
+
+        /**
+         * Fault the tables of an index into memory, returns the number of tables and entries read.
+         */
+        static std::pair<size_t, size_t> warmup(const Transaction *txn,
+            const PropertyAccessInfo& propertyInfo,
+            const IndexAccessInfo& indexInfo);
+
     protected:
         static const std::vector<Condition::Comparator> validComparators;
 
@@ -143,14 +158,16 @@ namespace index {
             const ClassType& classType,
             T (*valueRetrieve)(const Bytes&))
         {
-            auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, indexInfo.classId, superClassId);
-            require(!propertyIdMapInfo.empty());
+            auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(txn, indexInfo.classId, superClassId);
+            require(!propertyIdMapInfo->empty());
             auto indexAccess = openIndexRecordPositive(txn, indexInfo);
             auto dataRecord = DataRecord(txn->_txnBase, indexInfo.classId, classType);
             std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
                 [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
+                    // numeric values are never stored out of line
                     auto const record = RecordParser::parseRawData(
-                        result, propertyIdMapInfo, classType == ClassType::EDGE, txn->_txnCtx->isVersionEnabled());
+                        result, propertyIdMapInfo, classType == ClassType::EDGE, txn->_txnCtx->isVersionEnabled(),
+                        nullptr, RecordId { indexInfo.classId, positionId });
                     auto bytesValue = record.get(propertyInfo.name);
                     if (!bytesValue.empty()) {
                         auto indexRecord = Blob(sizeof(PositionId)).append(&positionId, sizeof(PositionId));
@@ -168,15 +185,17 @@ namespace index {
             const ClassType& classType,
             T (*valueRetrieve)(const Bytes&))
         {
-            auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(txn, indexInfo.classId, superClassId);
-            require(!propertyIdMapInfo.empty());
+            auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(txn, indexInfo.classId, superClassId);
+            require(!propertyIdMapInfo->empty());
             auto indexPositiveAccess = openIndexRecordPositive(txn, indexInfo);
             auto indexNegativeAccess = openIndexRecordNegative(txn, indexInfo);
             auto dataRecord = DataRecord(txn->_txnBase, indexInfo.classId, classType);
             std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
                 [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
+                    // numeric values are never stored out of line
                     auto const record = RecordParser::parseRawData(
-                        result, propertyIdMapInfo, classType == ClassType::EDGE, txn->_txnCtx->isVersionEnabled());
+                        result, propertyIdMapInfo, classType == ClassType::EDGE, txn->_txnCtx->isVersionEnabled(),
+                        nullptr, RecordId { indexInfo.classId, positionId });
                     auto bytesValue = record.get(propertyInfo.name);
                     if (!bytesValue.empty()) {
                         auto indexRecord = Blob(sizeof(PositionId)).append(&positionId, sizeof(PositionId));
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2019, NogDB <https://nogdb.org>
+ *  <nogdb at throughwave dot co dot th>
+ *
+ *  This file is part of libnogdb, the NogDB core library in C++.
+ *
+ *  libnogdb is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "lmdb/lmdb.h"
+
+namespace nogdb {
+namespace storage_engine {
+namespace kv {
+
+    /**
+     * The key-value contract of a storage engine: ordered named tables with numeric or binary keys
+     * and optionally sorted duplicates, transactions and cursors.
+     * It follows the semantics of the lmdb C API, whose value, stat, flag and error code types
+     * are shared by every engine; every function returns 0 on success or an lmdb error code.
+     * The lmdb engine itself does not go through this contract, see the handlers of lmdb_engine.hpp.
+     */
+    class EnvHandler;
+    class TransactionHandler;
+
+    class CursorHandler {
+    public:
+        virtual ~CursorHandler() noexcept = default;
+
+        virtual int get(MDB_val* key, MDB_val* data, MDB_cursor_op op) = 0;
+
+        virtual int del(unsigned int flags) = 0;
+
+        virtual int renew(TransactionHandler* txn) = 0;
+
+        virtual TransactionHandler* txn() const noexcept = 0;
+
+        virtual MDB_dbi dbi() const noexcept = 0;
+    };
+
+    class TransactionHandler {
+    public:
+        virtual ~TransactionHandler() noexcept = default;
+
+        virtual EnvHandler* env() const noexcept = 0;
+
+        // the handler is still owned by the caller after commit() or abort()
+        virtual int commit() = 0;
+
+        virtual void abort() noexcept = 0;
+
+        virtual void reset() noexcept = 0;
+
+        virtual int renew() = 0;
+
+        virtual int open(const char* name, unsigned int flags, MDB_dbi* dbi) = 0;
+
+        virtual int flags(MDB_dbi dbi, unsigned int* flags) = 0;
+
+        virtual int stat(MDB_dbi dbi, MDB_stat* stat) = 0;
+
+        virtual int drop(MDB_dbi dbi, int del) = 0;
+
+        virtual int setCompare(MDB_dbi dbi, MDB_cmp_func* cmp) = 0;
+
+        virtual int setDupSort(MDB_dbi dbi, MDB_cmp_func* cmp) = 0;
+
+        virtual int get(MDB_dbi dbi, MDB_val* key, MDB_val* data) = 0;
+
+        // with MDB_RESERVE, data->mv_data is set to the space of the new value for the caller to fill
+        virtual int put(MDB_dbi dbi, MDB_val* key, MDB_val* data, unsigned int flags) = 0;
+
+        virtual int del(MDB_dbi dbi, MDB_val* key, MDB_val* data) = 0;
+
+        virtual int openCursor(MDB_dbi dbi, CursorHandler** cursor) = 0;
+    };
+
+    class EnvHandler {
+    public:
+        virtual ~EnvHandler() noexcept = default;
+
+        virtual int begin(TransactionHandler* parent, unsigned int flags, TransactionHandler** txn) = 0;
+
+        virtual int sync(int force) = 0;
+
+        virtual int setMapSize(size_t size) = 0;
+
+        virtual int info(MDB_envinfo* info) = 0;
+
+        virtual int stat(MDB_stat* stat) = 0;
+
+        virtual int copy(const char* path, unsigned int flags) = 0;
+
+        virtual int copyfd(mdb_filehandle_t fd, unsigned int flags) = 0;
+
+        virtual int readerList(MDB_msg_func* func, void* ctx) = 0;
+
+        virtual int readerCheck(int* dead) = 0;
+    };
+
+}
+}
+}
@@ -21,10 +21,14 @@
 
 #pragma once
 
+#include <cstdio>
 #include <cstring>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "datatype.hpp"
+#include "kv_engine.hpp"
 #include "lmdb/lmdb.h"
 
 #include "nogdb/nogdb_errors.h"
@@ -38,6 +42,7 @@ namespace lmdb {
     constexpr static unsigned int DEFAULT_ENV_MODE = 0664;
     constexpr static unsigned int TXN_RW = 0;
     constexpr static unsigned int TXN_RO = MDB_RDONLY;
+    constexpr static MDB_dbi FREE_DBI = 0; // the freelist, readable like any other table
 
     class Value {
     public:
@@ -150,14 +155,13 @@ namespace lmdb {
     typedef Value Key;
     typedef unsigned int Flag;
     typedef mdb_mode_t Mode;
-    typedef MDB_env EnvHandler;
-    typedef MDB_txn TransactionHandler;
     typedef MDB_dbi DBHandler;
-    typedef MDB_cursor CursorHandler;
 
     struct Result {
         Value data {};
         bool empty { false };
+        // owns the bytes of data when they have been decoded instead of pointing into the storage
+        std::shared_ptr<const std::vector<unsigned char>> buffer {};
     };
 
     struct CursorResult {
@@ -170,13 +174,327 @@ namespace lmdb {
         }
     };
 
+    /**
+     * The handles of an environment, a transaction and a cursor of either storage engine.
+     * They are plain values, which call lmdb directly through its own handles, so that beginning
+     * a transaction or opening a cursor does not allocate anything besides lmdb itself.
+     * Any other engine implements the key-value contract of kv_engine.hpp instead.
+     */
+    class TransactionHandler;
+    class CursorHandler;
+
+    class EnvHandler {
+    public:
+        EnvHandler(std::nullptr_t = nullptr) noexcept
+        {
+        }
+
+        EnvHandler(MDB_env* const lmdb) noexcept
+            : _lmdb { lmdb }
+        {
+        }
+
+        EnvHandler(kv::EnvHandler* const kv) noexcept
+            : _kv { kv }
+        {
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return _lmdb != nullptr || _kv != nullptr;
+        }
+
+        int begin(const TransactionHandler& parent, unsigned int flags, TransactionHandler& txn) const;
+
+        int sync(const int force) const
+        {
+            return (_lmdb) ? mdb_env_sync(_lmdb, force) : _kv->sync(force);
+        }
+
+        int setMapSize(const size_t size) const
+        {
+            return (_lmdb) ? mdb_env_set_mapsize(_lmdb, size) : _kv->setMapSize(size);
+        }
+
+        int info(MDB_envinfo* const info) const
+        {
+            return (_lmdb) ? mdb_env_info(_lmdb, info) : _kv->info(info);
+        }
+
+        int stat(MDB_stat* const stat) const
+        {
+            return (_lmdb) ? mdb_env_stat(_lmdb, stat) : _kv->stat(stat);
+        }
+
+        int copy(const char* const path, const unsigned int flags) const
+        {
+            return (_lmdb) ? mdb_env_copy2(_lmdb, path, flags) : _kv->copy(path, flags);
+        }
+
+        int copyfd(const mdb_filehandle_t fd, const unsigned int flags) const
+        {
+            return (_lmdb) ? mdb_env_copyfd2(_lmdb, fd, flags) : _kv->copyfd(fd, flags);
+        }
+
+        int readerList(MDB_msg_func* const func, void* const ctx) const
+        {
+            return (_lmdb) ? mdb_reader_list(_lmdb, func, ctx) : _kv->readerList(func, ctx);
+        }
+
+        int readerCheck(int* const dead) const
+        {
+            return (_lmdb) ? mdb_reader_check(_lmdb, dead) : _kv->readerCheck(dead);
+        }
+
+        void close() noexcept
+        {
+            if (_lmdb) {
+                mdb_env_close(_lmdb);
+            }
+            delete _kv;
+            _lmdb = nullptr;
+            _kv = nullptr;
+        }
+
+    private:
+        MDB_env* _lmdb { nullptr };
+        kv::EnvHandler* _kv { nullptr };
+    };
+
+    class TransactionHandler {
+    public:
+        TransactionHandler(std::nullptr_t = nullptr) noexcept
+        {
+        }
+
+        TransactionHandler(MDB_txn* const lmdb) noexcept
+            : _lmdb { lmdb }
+        {
+        }
+
+        TransactionHandler(kv::TransactionHandler* const kv) noexcept
+            : _kv { kv }
+        {
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return _lmdb != nullptr || _kv != nullptr;
+        }
+
+        bool operator==(const TransactionHandler& other) const noexcept
+        {
+            return _lmdb == other._lmdb && _kv == other._kv;
+        }
+
+        bool operator!=(const TransactionHandler& other) const noexcept
+        {
+            return !operator==(other);
+        }
+
+        EnvHandler env() const noexcept
+        {
+            return (_lmdb) ? EnvHandler { mdb_txn_env(_lmdb) } : EnvHandler { _kv->env() };
+        }
+
+        // the transaction is over and its handle is freed even if the commit fails
+        int commit()
+        {
+            auto error = 0;
+            if (_lmdb) {
+                error = mdb_txn_commit(_lmdb);
+            } else {
+                error = _kv->commit();
+                delete _kv;
+            }
+            _lmdb = nullptr;
+            _kv = nullptr;
+            return error;
+        }
+
+        void abort() noexcept
+        {
+            if (_lmdb) {
+                mdb_txn_abort(_lmdb);
+            } else if (_kv) {
+                _kv->abort();
+                delete _kv;
+            }
+            _lmdb = nullptr;
+            _kv = nullptr;
+        }
+
+        void reset() const noexcept
+        {
+            (_lmdb) ? mdb_txn_reset(_lmdb) : _kv->reset();
+        }
+
+        int renew() const
+        {
+            return (_lmdb) ? mdb_txn_renew(_lmdb) : _kv->renew();
+        }
+
+        int open(const char* const name, const unsigned int flags, MDB_dbi* const dbi) const
+        {
+            return (_lmdb) ? mdb_dbi_open(_lmdb, name, flags, dbi) : _kv->open(name, flags, dbi);
+        }
+
+        int flags(const MDB_dbi dbi, unsigned int* const flags) const
+        {
+            return (_lmdb) ? mdb_dbi_flags(_lmdb, dbi, flags) : _kv->flags(dbi, flags);
+        }
+
+        int stat(const MDB_dbi dbi, MDB_stat* const stat) const
+        {
+            return (_lmdb) ? mdb_stat(_lmdb, dbi, stat) : _kv->stat(dbi, stat);
+        }
+
+        int drop(const MDB_dbi dbi, const int del) const
+        {
+            return (_lmdb) ? mdb_drop(_lmdb, dbi, del) : _kv->drop(dbi, del);
+        }
+
+        int setCompare(const MDB_dbi dbi, MDB_cmp_func* const cmp) const
+        {
+            return (_lmdb) ? mdb_set_compare(_lmdb, dbi, cmp) : _kv->setCompare(dbi, cmp);
+        }
+
+        int setDupSort(const MDB_dbi dbi, MDB_cmp_func* const cmp) const
+        {
+            return (_lmdb) ? mdb_set_dupsort(_lmdb, dbi, cmp) : _kv->setDupSort(dbi, cmp);
+        }
+
+        int get(const MDB_dbi dbi, MDB_val* const key, MDB_val* const data) const
+        {
+            return (_lmdb) ? mdb_get(_lmdb, dbi, key, data) : _kv->get(dbi, key, data);
+        }
+
+        // with MDB_RESERVE, data->mv_data is set to the space of the new value for the caller to fill
+        int put(const MDB_dbi dbi, MDB_val* const key, MDB_val* const data, const unsigned int flags) const
+        {
+            return (_lmdb) ? mdb_put(_lmdb, dbi, key, data, flags) : _kv->put(dbi, key, data, flags);
+        }
+
+        int del(const MDB_dbi dbi, MDB_val* const key, MDB_val* const data) const
+        {
+            return (_lmdb) ? mdb_del(_lmdb, dbi, key, data) : _kv->del(dbi, key, data);
+        }
+
+        int openCursor(MDB_dbi dbi, CursorHandler& cursor) const;
+
+    private:
+        friend class EnvHandler;
+        friend class CursorHandler;
+
+        MDB_txn* _lmdb { nullptr };
+        kv::TransactionHandler* _kv { nullptr };
+    };
+
+    class CursorHandler {
+    public:
+        CursorHandler(std::nullptr_t = nullptr) noexcept
+        {
+        }
+
+        CursorHandler(MDB_cursor* const lmdb) noexcept
+            : _lmdb { lmdb }
+        {
+        }
+
+        CursorHandler(kv::CursorHandler* const kv) noexcept
+            : _kv { kv }
+        {
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return _lmdb != nullptr || _kv != nullptr;
+        }
+
+        int get(MDB_val* const key, MDB_val* const data, const MDB_cursor_op op) const
+        {
+            return (_lmdb) ? mdb_cursor_get(_lmdb, key, data, op) : _kv->get(key, data, op);
+        }
+
+        int del(const unsigned int flags) const
+        {
+            return (_lmdb) ? mdb_cursor_del(_lmdb, flags) : _kv->del(flags);
+        }
+
+        int renew(const TransactionHandler& txn) const
+        {
+            return (_lmdb) ? mdb_cursor_renew(txn._lmdb, _lmdb) : _kv->renew(txn._kv);
+        }
+
+        TransactionHandler txn() const noexcept
+        {
+            return (_lmdb) ? TransactionHandler { mdb_cursor_txn(_lmdb) } : TransactionHandler { _kv->txn() };
+        }
+
+        MDB_dbi dbi() const noexcept
+        {
+            return (_lmdb) ? mdb_cursor_dbi(_lmdb) : _kv->dbi();
+        }
+
+        void close() noexcept
+        {
+            if (_lmdb) {
+                mdb_cursor_close(_lmdb);
+            }
+            delete _kv;
+            _lmdb = nullptr;
+            _kv = nullptr;
+        }
+
+    private:
+        MDB_cursor* _lmdb { nullptr };
+        kv::CursorHandler* _kv { nullptr };
+    };
+
+    inline int EnvHandler::begin(const TransactionHandler& parent, const unsigned int flags, TransactionHandler& txn) const
+    {
+        if (_lmdb) {
+            MDB_txn* handle = nullptr;
+            auto error = mdb_txn_begin(_lmdb, parent._lmdb, flags, &handle);
+            txn = TransactionHandler { handle };
+            return error;
+        }
+        kv::TransactionHandler* handle = nullptr;
+        auto error = _kv->begin(parent._kv, flags, &handle);
+        txn = TransactionHandler { handle };
+        return error;
+    }
+
+    inline int TransactionHandler::openCursor(const MDB_dbi dbi, CursorHandler& cursor) const
+    {
+        if (_lmdb) {
+            MDB_cursor* handle = nullptr;
+            auto error = mdb_cursor_open(_lmdb, dbi, &handle);
+            cursor = CursorHandler { handle };
+            return error;
+        }
+        kv::CursorHandler* handle = nullptr;
+        auto error = _kv->openCursor(dbi, &handle);
+        cursor = CursorHandler { handle };
+        return error;
+    }
+
+    struct ReaderSlot {
+        int pid;
+        size_t thread;
+        size_t txnId;
+    };
+
     class Env {
     public:
-        static Env create(unsigned int dbNum,
+        static Env open(const std::string& dbPath,
+            unsigned int dbNum,
             unsigned long dbSize,
-            unsigned int dbMaxReaders)
+            unsigned int dbMaxReaders,
+            const Flag flag = DEFAULT_ENV_FLAG,
+            const Mode mode = DEFAULT_ENV_MODE)
         {
-            EnvHandler* handler = nullptr;
+            MDB_env* handler = nullptr;
             if (auto error = mdb_env_create(&handler)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
@@ -192,14 +510,17 @@ namespace lmdb {
                         throw NOGDB_STORAGE_ERROR(error);
                     }
                 }
+                if (auto error = mdb_env_open(handler, dbPath.c_str(), flag, mode)) {
+                    throw NOGDB_STORAGE_ERROR(error);
+                }
             } catch (const Error&) {
                 mdb_env_close(handler);
                 throw;
             }
-            return Env { handler };
+            return Env { EnvHandler { handler } };
         }
 
-        Env(EnvHandler* const handle) noexcept
+        Env(const EnvHandler handle) noexcept
             : _handle { handle }
         {
         }
@@ -227,59 +548,112 @@ namespace lmdb {
             return *this;
         }
 
-        explicit operator EnvHandler*() const noexcept
+        EnvHandler handle() const noexcept
         {
             return _handle;
         }
 
-        MDB_env* handle() const noexcept
+        void sync(const bool force = true)
         {
-            return _handle;
+            if (auto error = _handle.sync(force)) {
+                throw NOGDB_STORAGE_ERROR(error);
+            }
         }
 
-        void sync(const bool force = true)
+        void setMapSize(const size_t size)
         {
-            if (auto error = mdb_env_sync(_handle, force)) {
-                throw error;
+            if (auto error = _handle.setMapSize(size)) {
+                throw NOGDB_STORAGE_ERROR(error);
             }
         }
 
-        void close() noexcept
+        MDB_envinfo info() const
         {
-            if (_handle) {
-                mdb_env_close(_handle);
-                _handle = nullptr;
+            MDB_envinfo result;
+            if (auto error = _handle.info(&result)) {
+                throw NOGDB_STORAGE_ERROR(error);
             }
+            return result;
         }
 
-        Env& open(const std::string dbPath,
-            const Flag flag = DEFAULT_ENV_FLAG,
-            const Mode mode = DEFAULT_ENV_MODE)
+        MDB_stat stat() const
         {
-            if (auto error = mdb_env_open(handle(), dbPath.c_str(), flag, mode)) {
+            MDB_stat result;
+            if (auto error = _handle.stat(&result)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
-            return *this;
+            return result;
+        }
+
+        void copy(const std::string& path, const bool compact) const
+        {
+            if (auto error = _handle.copy(path.c_str(), (compact) ? MDB_CP_COMPACT : 0)) {
+                throw NOGDB_STORAGE_ERROR(error);
+            }
+        }
+
+        void copy(const mdb_filehandle_t fd, const bool compact) const
+        {
+            if (auto error = _handle.copyfd(fd, (compact) ? MDB_CP_COMPACT : 0)) {
+                throw NOGDB_STORAGE_ERROR(error);
+            }
+        }
+
+        // the slots of the open read transactions, a reset one is not listed
+        std::vector<ReaderSlot> readers() const
+        {
+            auto result = std::vector<ReaderSlot> {};
+            auto collect = [](const char* const msg, void* const ctx) -> int {
+                auto slot = ReaderSlot {};
+                if (sscanf(msg, "%d %zx %zu", &slot.pid, &slot.thread, &slot.txnId) == 3) {
+                    static_cast<std::vector<ReaderSlot>*>(ctx)->emplace_back(slot);
+                }
+                return 0;
+            };
+            auto error = _handle.readerList(collect, &result);
+            if (error < 0) {
+                throw NOGDB_STORAGE_ERROR(error);
+            }
+            return result;
+        }
+
+        // clear the slots of the processes which are no longer alive, returns the number of slots cleared
+        int readerCheck()
+        {
+            auto dead = 0;
+            if (auto error = _handle.readerCheck(&dead)) {
+                throw NOGDB_STORAGE_ERROR(error);
+            }
+            return dead;
+        }
+
+        void close() noexcept
+        {
+            _handle.close();
         }
 
     protected:
-        EnvHandler* _handle { nullptr };
+        EnvHandler _handle {};
     };
 
     class Transaction {
     public:
-        static Transaction begin(EnvHandler* const env,
+        static Transaction begin(const EnvHandler env,
             const unsigned int flag,
-            TransactionHandler* const parent = nullptr)
+            const TransactionHandler parent = nullptr)
         {
-            TransactionHandler* handle = nullptr;
-            if (auto error = mdb_txn_begin(env, parent, flag, &handle)) {
+            auto handle = TransactionHandler {};
+            if (auto error = env.begin(parent, flag, handle)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
             return Transaction { handle };
         }
 
-        Transaction(TransactionHandler* const handle) noexcept
+        Transaction(std::nullptr_t = nullptr) noexcept
+        {
+        }
+
+        Transaction(const TransactionHandler handle) noexcept
             : _handle { handle }
         {
         }
@@ -310,61 +684,56 @@ namespace lmdb {
             return *this;
         }
 
-        operator TransactionHandler*() const noexcept
+        TransactionHandler handle() const noexcept
         {
             return _handle;
         }
 
-        TransactionHandler* handle() const noexcept
+        EnvHandler env() const noexcept
         {
-            return _handle;
-        }
-
-        EnvHandler* env() const noexcept
-        {
-            return mdb_txn_env(_handle);
+            return _handle.env();
         }
 
         void commit()
         {
-            if (auto error = mdb_txn_commit(_handle)) {
+            // the transaction is over even if the commit fails
+            auto error = _handle.commit();
+            if (error) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
-            _handle = nullptr;
         }
 
         void abort() noexcept
         {
-            mdb_txn_abort(_handle);
-            _handle = nullptr;
+            _handle.abort();
         }
 
         void reset() noexcept
         {
-            mdb_txn_reset(_handle);
+            _handle.reset();
         }
 
         void renew()
         {
-            if (auto error = mdb_txn_renew(_handle)) {
+            if (auto error = _handle.renew()) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
         }
 
     protected:
-        TransactionHandler* _handle { nullptr };
+        TransactionHandler _handle {};
     };
 
     class DBi {
     public:
-        static DBi open(TransactionHandler* const txnHandler,
+        static DBi open(const TransactionHandler txnHandler,
             const std::string& dbName,
             bool numericKey = false,
             bool unique = true)
         {
             DBHandler dbHandler = 0;
             auto flags = ((numericKey) ? MDB_INTEGERKEY : 0U) | ((!unique) ? MDB_DUPSORT : 0U);
-            if (auto error = mdb_open(txnHandler, dbName.c_str(), MDB_CREATE | flags, &dbHandler)) {
+            if (auto error = txnHandler.open(dbName.c_str(), MDB_CREATE | flags, &dbHandler)) {
                 throw NOGDB_STORAGE_ERROR(error);
             } else {
                 return DBi { txnHandler, dbHandler };
@@ -373,7 +742,7 @@ namespace lmdb {
 
         DBi() = default;
 
-        DBi(TransactionHandler* const txnHandler, const DBHandler handle) noexcept
+        DBi(const TransactionHandler txnHandler, const DBHandler handle) noexcept
             : _handle { handle }
             , _txn { txnHandler }
         {
@@ -410,7 +779,7 @@ namespace lmdb {
             return _handle;
         }
 
-        TransactionHandler* txn() const noexcept
+        TransactionHandler txn() const noexcept
         {
             return _txn;
         }
@@ -418,7 +787,7 @@ namespace lmdb {
         unsigned int flags() const
         {
             unsigned int result {};
-            if (auto error = mdb_dbi_flags(_txn, _handle, &result)) {
+            if (auto error = _txn.flags(_handle, &result)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
             return result;
@@ -429,16 +798,25 @@ namespace lmdb {
             return stat().ms_entries;
         }
 
+        MDB_stat stat() const
+        {
+            MDB_stat result;
+            if (auto error = _txn.stat(_handle, &result)) {
+                throw NOGDB_STORAGE_ERROR(error);
+            }
+            return result;
+        }
+
         void drop(const bool del = false)
         {
-            if (auto error = mdb_drop(_txn, _handle, del)) {
+            if (auto error = _txn.drop(_handle, del)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
         }
 
         DBi& setCompareFunc(MDB_cmp_func* const cmp = nullptr)
         {
-            if (auto error = mdb_set_compare(_txn, _handle, cmp)) {
+            if (auto error = _txn.setCompare(_handle, cmp)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
             return *this;
@@ -446,7 +824,7 @@ namespace lmdb {
 
         DBi& setDupSortFunc(MDB_cmp_func* const cmp = nullptr)
         {
-            if (auto error = mdb_set_dupsort(_txn, _handle, cmp)) {
+            if (auto error = _txn.setDupSort(_handle, cmp)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
             return *this;
@@ -578,6 +956,18 @@ namespace lmdb {
             dbPut(Key { key }, Value { val }, LMDB_PUT_FLAGS_GENERATE(append, overwrite));
         }
 
+        /**
+         * Make room for a value of the given size with MDB_RESERVE, which the caller fills through the
+         * returned pointer before the next write in the transaction. Its content is unspecified.
+         */
+        template <typename K>
+        unsigned char* reserve(const K& key, size_t size)
+        {
+            auto data = Value { nullptr, size };
+            dbPut(Key { &key, sizeof(K) }, data, MDB_RESERVE);
+            return static_cast<unsigned char*>(static_cast<MDB_val*>(data)->mv_data);
+        }
+
         template <typename K>
         void del(const K& key)
         {
@@ -634,22 +1024,13 @@ namespace lmdb {
 
     protected:
         DBHandler _handle { 0 };
-        TransactionHandler* _txn { nullptr };
+        TransactionHandler _txn {};
 
     private:
-        MDB_stat stat() const
-        {
-            MDB_stat result;
-            if (auto error = mdb_stat(_txn, _handle, &result)) {
-                throw NOGDB_STORAGE_ERROR(error);
-            }
-            return result;
-        }
-
         inline bool dbGet(const MDB_val* const key,
             MDB_val* const data) const
         {
-            if (auto error = mdb_get(_txn, _handle, const_cast<MDB_val*>(key), data)) {
+            if (auto error = _txn.get(_handle, const_cast<MDB_val*>(key), data)) {
                 if (error != MDB_NOTFOUND) {
                     throw NOGDB_STORAGE_ERROR(error);
                 }
@@ -662,7 +1043,7 @@ namespace lmdb {
             const MDB_val* const data,
             const unsigned int flags = 0)
         {
-            if (auto error = mdb_put(_txn, _handle, const_cast<MDB_val*>(key), const_cast<MDB_val*>(data), flags)) {
+            if (auto error = _txn.put(_handle, const_cast<MDB_val*>(key), const_cast<MDB_val*>(data), flags)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
         }
@@ -670,7 +1051,7 @@ namespace lmdb {
         inline void dbDel(const MDB_val* const key,
             const MDB_val* const data = nullptr)
         {
-            if (auto error = mdb_del(_txn, _handle, const_cast<MDB_val*>(key), const_cast<MDB_val*>(data))) {
+            if (auto error = _txn.del(_handle, const_cast<MDB_val*>(key), const_cast<MDB_val*>(data))) {
                 if (error != MDB_NOTFOUND) {
                     throw NOGDB_STORAGE_ERROR(error);
                 }
@@ -680,16 +1061,16 @@ namespace lmdb {
 
     class Cursor {
     public:
-        static Cursor open(TransactionHandler* const txn, const DBHandler dbi)
+        static Cursor open(const TransactionHandler txn, const DBHandler dbi)
         {
-            CursorHandler* handle = nullptr;
-            if (auto error = mdb_cursor_open(txn, dbi, &handle)) {
+            auto handle = CursorHandler {};
+            if (auto error = txn.openCursor(dbi, handle)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
             return Cursor { txn, handle };
         }
 
-        Cursor(TransactionHandler* const txn, CursorHandler* const handle) noexcept
+        Cursor(const TransactionHandler txn, const CursorHandler handle) noexcept
             : _handle { handle }
             , _txn { txn }
         {
@@ -723,44 +1104,36 @@ namespace lmdb {
             _txn = nullptr;
         }
 
-        operator CursorHandler*() const noexcept
-        {
-            return _handle;
-        }
-
-        CursorHandler* handle() const noexcept
+        CursorHandler handle() const noexcept
         {
             return _handle;
         }
 
         void close() noexcept
         {
-            if (_handle) {
-                mdb_cursor_close(_handle);
-                _handle = nullptr;
-            }
+            _handle.close();
         }
 
         void renew()
         {
-            if (auto error = mdb_cursor_renew(_txn, _handle)) {
+            if (auto error = _handle.renew(_txn)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
         }
 
-        TransactionHandler* txn() const noexcept
+        TransactionHandler txn() const noexcept
         {
-            return mdb_cursor_txn(_handle);
+            return _handle.txn();
         }
 
         DBHandler dbi() const noexcept
         {
-            return mdb_cursor_dbi(_handle);
+            return _handle.dbi();
         }
 
         void del(bool duplicate = false) const
         {
-            if (auto error = mdb_cursor_del(_handle, duplicate)) {
+            if (auto error = _handle.del(duplicate)) {
                 throw NOGDB_STORAGE_ERROR(error);
             }
         }
@@ -798,14 +1171,14 @@ namespace lmdb {
         }
 
     protected:
-        CursorHandler* _handle { nullptr };
-        TransactionHandler* _txn { nullptr };
+        CursorHandler _handle {};
+        TransactionHandler _txn {};
 
     private:
         CursorResult get(const MDB_cursor_op op) const
         {
             CursorResult result {};
-            if (auto error = mdb_cursor_get(_handle, result.key.data, result.val.data, op)) {
+            if (auto error = _handle.get(result.key.data, result.val.data, op)) {
                 if (error != MDB_NOTFOUND) {
                     throw NOGDB_STORAGE_ERROR(error);
                 }
@@ -820,7 +1193,7 @@ namespace lmdb {
         {
             CursorResult result {};
             result.key.data = Key { &key, sizeof(K) };
-            if (auto error = mdb_cursor_get(_handle, result.key.data, result.val.data, op)) {
+            if (auto error = _handle.get(result.key.data, result.val.data, op)) {
                 if (error != MDB_NOTFOUND) {
                     throw NOGDB_STORAGE_ERROR(error);
                 }
@@ -834,7 +1207,7 @@ namespace lmdb {
         {
             CursorResult result {};
             result.key.data = Key { key };
-            if (auto error = mdb_cursor_get(_handle, result.key.data, result.val.data, op)) {
+            if (auto error = _handle.get(result.key.data, result.val.data, op)) {
                 if (error != MDB_NOTFOUND) {
                     throw NOGDB_STORAGE_ERROR(error);
                 }
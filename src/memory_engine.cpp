@@ -0,0 +1,1148 @@
+/*
+ *  Copyright (C) 2019, NogDB <https://nogdb.org>
+ *  <nogdb at throughwave dot co dot th>
+ *
+ *  This file is part of libnogdb, the NogDB core library in C++.
+ *
+ *  libnogdb is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "memory_engine.hpp"
+
+namespace nogdb {
+namespace storage_engine {
+namespace memory {
+
+    namespace {
+
+        // a page is split once it holds more entries
+        constexpr size_t MAX_PAGE_ENTRIES = 128;
+        // reported as the page size of the environment
+        constexpr unsigned int PAGE_SIZE = 4096;
+        // the handles 0 and 1 are reserved by lmdb for its free and main databases
+        constexpr MDB_dbi FIRST_DBI = 2;
+
+        // the key and the value of an entry are stored one after the other in the bytes of its page
+        struct Entry {
+            size_t offset;
+            size_t keySize;
+            size_t dataSize;
+        };
+
+        // pages and tables are only modified in place by the write transaction which has copied them
+        struct Page {
+            std::vector<Entry> entries {};
+            std::vector<char> bytes {};
+            // the bytes of replaced or erased entries, until the page is compacted
+            size_t garbage { 0 };
+            uint64_t owner { 0 };
+
+            Page() = default;
+
+            // a copy leaves the bytes of replaced or erased entries behind
+            Page(const Page& other)
+                : entries { other.entries }
+                , owner { other.owner }
+            {
+                bytes.reserve(other.bytes.size() - other.garbage);
+                for (auto& entry : entries) {
+                    auto offset = bytes.size();
+                    bytes.insert(bytes.end(), other.bytes.cbegin() + entry.offset,
+                        other.bytes.cbegin() + entry.offset + entry.keySize + entry.dataSize);
+                    entry.offset = offset;
+                }
+            }
+
+            Page& operator=(const Page& other) = delete;
+
+            size_t size() const noexcept
+            {
+                return entries.size();
+            }
+
+            MDB_val key(const size_t index) const noexcept
+            {
+                const auto& entry = entries[index];
+                return MDB_val { entry.keySize, const_cast<char*>(bytes.data() + entry.offset) };
+            }
+
+            MDB_val data(const size_t index) const noexcept
+            {
+                const auto& entry = entries[index];
+                return MDB_val { entry.dataSize, const_cast<char*>(bytes.data() + entry.offset + entry.keySize) };
+            }
+
+            // insert an entry before the given index, returning the space of its value
+            // to be filled by the caller if no value is given
+            char* insert(const size_t index, const MDB_val& key, const MDB_val* const data, const size_t dataSize)
+            {
+                auto offset = append(key, data, dataSize);
+                entries.insert(entries.begin() + index, Entry { offset, key.mv_size, dataSize });
+                return value(index);
+            }
+
+            char* assign(const size_t index, const MDB_val* const data, const size_t dataSize)
+            {
+                auto& entry = entries[index];
+                garbage += entry.keySize + entry.dataSize;
+                entry.offset = append(key(index), data, dataSize);
+                entry.dataSize = dataSize;
+                return value(index);
+            }
+
+            void erase(const size_t index)
+            {
+                garbage += entries[index].keySize + entries[index].dataSize;
+                entries.erase(entries.begin() + index);
+                compact();
+            }
+
+            // move the entries from the given index on to an empty page
+            void split(const size_t index, Page& page)
+            {
+                for (auto i = index; i < entries.size(); ++i) {
+                    auto key = this->key(i);
+                    auto data = this->data(i);
+                    page.entries.emplace_back(Entry { page.append(key, &data, data.mv_size), key.mv_size, data.mv_size });
+                    garbage += key.mv_size + data.mv_size;
+                }
+                entries.erase(entries.begin() + index, entries.end());
+                compact();
+            }
+
+        private:
+            // the key or the value may be one of this page, which stays readable until they have been copied
+            size_t append(const MDB_val& key, const MDB_val* const data, const size_t dataSize)
+            {
+                auto offset = bytes.size();
+                auto size = key.mv_size + dataSize;
+                if (bytes.capacity() < offset + size) {
+                    auto grown = std::vector<char> {};
+                    grown.reserve(std::max(bytes.capacity() * 2, offset + size));
+                    grown.resize(offset + size);
+                    std::copy(bytes.cbegin(), bytes.cend(), grown.begin());
+                    copyEntry(grown.data() + offset, key, data, dataSize);
+                    bytes.swap(grown);
+                } else {
+                    bytes.resize(offset + size);
+                    copyEntry(bytes.data() + offset, key, data, dataSize);
+                }
+                return offset;
+            }
+
+            static void copyEntry(char* const destination, const MDB_val& key, const MDB_val* const data, const size_t dataSize)
+            {
+                memcpy(destination, key.mv_data, key.mv_size);
+                if (data != nullptr && dataSize > 0) {
+                    memcpy(destination + key.mv_size, data->mv_data, dataSize);
+                }
+            }
+
+            // the space of the value of an entry, after reclaiming the garbage if it takes up half of the page
+            char* value(const size_t index)
+            {
+                compact();
+                return bytes.data() + entries[index].offset + entries[index].keySize;
+            }
+
+            void compact()
+            {
+                if (garbage == 0 || garbage < bytes.size() / 2) {
+                    return;
+                }
+                auto compacted = std::vector<char> {};
+                compacted.reserve(bytes.size() - garbage);
+                for (auto& entry : entries) {
+                    auto offset = compacted.size();
+                    compacted.insert(compacted.end(), bytes.cbegin() + entry.offset,
+                        bytes.cbegin() + entry.offset + entry.keySize + entry.dataSize);
+                    entry.offset = offset;
+                }
+                bytes.swap(compacted);
+                garbage = 0;
+            }
+        };
+
+        typedef std::shared_ptr<Page> PagePtr;
+
+        struct Table {
+            unsigned int flags { 0 };
+            std::vector<PagePtr> pages {};
+            size_t entries { 0 };
+            size_t bytes { 0 };
+            uint64_t owner { 0 };
+        };
+
+        typedef std::shared_ptr<Table> TablePtr;
+
+        // tables indexed by their handles, nullptr if a table does not exist
+        typedef std::vector<TablePtr> Tables;
+
+        struct Position {
+            size_t page;
+            size_t index;
+        };
+
+        MDB_val toVal(const std::string& value) noexcept
+        {
+            return MDB_val { value.size(), const_cast<char*>(value.data()) };
+        }
+
+        // the default comparator of lmdb
+        int compareBytes(const MDB_val* lhs, const MDB_val* rhs)
+        {
+            auto size = std::min(lhs->mv_size, rhs->mv_size);
+            auto diff = (size > 0) ? memcmp(lhs->mv_data, rhs->mv_data, size) : 0;
+            if (diff != 0) {
+                return diff;
+            }
+            return (lhs->mv_size < rhs->mv_size) ? -1 : (lhs->mv_size > rhs->mv_size) ? 1 : 0;
+        }
+
+        template <typename T>
+        int compareNumeric(const MDB_val* lhs, const MDB_val* rhs)
+        {
+            T lhsValue, rhsValue;
+            memcpy(&lhsValue, lhs->mv_data, sizeof(T));
+            memcpy(&rhsValue, rhs->mv_data, sizeof(T));
+            return (lhsValue < rhsValue) ? -1 : (lhsValue > rhsValue) ? 1 : 0;
+        }
+
+        // MDB_INTEGERKEY keys are native unsigned ints or size_ts
+        int compareIntegers(const MDB_val* lhs, const MDB_val* rhs)
+        {
+            if (lhs->mv_size == rhs->mv_size) {
+                if (lhs->mv_size == sizeof(unsigned int)) {
+                    return compareNumeric<unsigned int>(lhs, rhs);
+                } else if (lhs->mv_size == sizeof(size_t)) {
+                    return compareNumeric<size_t>(lhs, rhs);
+                }
+            }
+            return compareBytes(lhs, rhs);
+        }
+
+        struct Order {
+            MDB_cmp_func* keyCmp;
+            MDB_cmp_func* dataCmp;
+            bool dupSort;
+
+            // duplicates are ordered by their data, a null data compares equal to every duplicate of the key
+            int compare(const Page& page, const size_t index, const MDB_val* const key, const MDB_val* const data) const
+            {
+                auto entryKey = page.key(index);
+                auto diff = keyCmp(&entryKey, key);
+                if (diff != 0 || !dupSort || data == nullptr) {
+                    return diff;
+                }
+                auto entryData = page.data(index);
+                return dataCmp(&entryData, data);
+            }
+        };
+
+        // the page of an entry, or nullptr if the position is past the end of the table
+        const Page* pageAt(const Table& table, const Position& position) noexcept
+        {
+            return (position.page < table.pages.size()) ? table.pages[position.page].get() : nullptr;
+        }
+
+        Position lowerBound(const Table& table, const Order& order, const MDB_val* const key, const MDB_val* const data)
+        {
+            auto page = std::lower_bound(table.pages.cbegin(), table.pages.cend(), 0,
+                [&](const PagePtr& value, int) { return order.compare(*value, value->size() - 1, key, data) < 0; });
+            if (page == table.pages.cend()) {
+                return Position { table.pages.size(), 0 };
+            }
+            auto first = size_t { 0 }, count = (*page)->size();
+            while (count > 0) {
+                auto step = count / 2;
+                if (order.compare(**page, first + step, key, data) < 0) {
+                    first += step + 1;
+                    count -= step + 1;
+                } else {
+                    count = step;
+                }
+            }
+            return Position { static_cast<size_t>(page - table.pages.cbegin()), first };
+        }
+
+        // move a position past the end of a page to the beginning of the next one
+        Position normalize(const Table& table, Position position) noexcept
+        {
+            if (position.page < table.pages.size() && position.index >= table.pages[position.page]->size()) {
+                ++position.page;
+                position.index = 0;
+            }
+            return position;
+        }
+
+        Position next(const Table& table, const Position& position) noexcept
+        {
+            return normalize(table, Position { position.page, position.index + 1 });
+        }
+
+        bool prev(const Table& table, const Position& position, Position& result) noexcept
+        {
+            if (position.index > 0) {
+                result = Position { position.page, position.index - 1 };
+            } else if (position.page > 0) {
+                result = Position { position.page - 1, table.pages[position.page - 1]->size() - 1 };
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        class MemoryEnv;
+
+        class MemoryTxn : public kv::TransactionHandler {
+        public:
+            MemoryTxn(MemoryEnv* env, MemoryTxn* parent, unsigned int flags);
+
+            ~MemoryTxn() noexcept override
+            {
+                abort();
+            }
+
+            kv::EnvHandler* env() const noexcept override;
+
+            int commit() override;
+
+            void abort() noexcept override;
+
+            void reset() noexcept override;
+
+            int renew() override;
+
+            int open(const char* name, unsigned int flags, MDB_dbi* dbi) override;
+
+            int flags(MDB_dbi dbi, unsigned int* flags) override;
+
+            int stat(MDB_dbi dbi, MDB_stat* stat) override;
+
+            int drop(MDB_dbi dbi, int del) override;
+
+            int setCompare(MDB_dbi dbi, MDB_cmp_func* cmp) override;
+
+            int setDupSort(MDB_dbi dbi, MDB_cmp_func* cmp) override;
+
+            int get(MDB_dbi dbi, MDB_val* key, MDB_val* data) override;
+
+            int put(MDB_dbi dbi, MDB_val* key, MDB_val* data, unsigned int flags) override;
+
+            int del(MDB_dbi dbi, MDB_val* key, MDB_val* data) override;
+
+            int openCursor(MDB_dbi dbi, kv::CursorHandler** cursor) override;
+
+            bool isReadOnly() const noexcept
+            {
+                return _readOnly;
+            }
+
+            // bumped on every modification, so that cursors know when to look up their position again
+            uint64_t modifications() const noexcept
+            {
+                return _modifications;
+            }
+
+            const Table* find(MDB_dbi dbi) const noexcept
+            {
+                const auto& tables = (_readOnly) ? *_snapshot : _tables;
+                return (dbi < tables.size()) ? tables[dbi].get() : nullptr;
+            }
+
+            Order order(MDB_dbi dbi, const Table& table) const noexcept;
+
+            Table* writable(MDB_dbi dbi)
+            {
+                if (_readOnly || dbi >= _tables.size() || !_tables[dbi]) {
+                    return nullptr;
+                }
+                auto& table = _tables[dbi];
+                if (table->owner != _id) {
+                    table = std::make_shared<Table>(*table);
+                    table->owner = _id;
+                }
+                return table.get();
+            }
+
+            // insert an entry at a position, returning the space of its value to be filled by the caller
+            // if no value is given
+            char* insert(Table& table, Position position, const MDB_val* const key, const MDB_val* const data, const size_t dataSize)
+            {
+                if (table.pages.empty()) {
+                    auto page = std::make_shared<Page>();
+                    page->owner = _id;
+                    table.pages.push_back(page);
+                    position = Position { 0, 0 };
+                } else if (position.page == table.pages.size()) {
+                    position = Position { table.pages.size() - 1, table.pages.back()->size() };
+                }
+                auto& page = writablePage(table, position.page);
+                auto appended = position.page + 1 == table.pages.size() && position.index == page.size();
+                auto value = page.insert(position.index, *key, data, dataSize);
+                if (page.size() > MAX_PAGE_ENTRIES) {
+                    // keep the pages full when the table is filled in key order
+                    auto splitIndex = (appended) ? page.size() - 1 : page.size() / 2;
+                    auto splitPage = std::make_shared<Page>();
+                    splitPage->owner = _id;
+                    page.split(splitIndex, *splitPage);
+                    table.pages.insert(table.pages.begin() + position.page + 1, splitPage);
+                    value = static_cast<char*>((position.index < splitIndex)
+                            ? page.data(position.index).mv_data
+                            : splitPage->data(position.index - splitIndex).mv_data);
+                }
+                ++table.entries;
+                table.bytes += key->mv_size + dataSize;
+                ++_modifications;
+                return value;
+            }
+
+            char* replace(Table& table, const Position& position, const MDB_val* const data, const size_t dataSize)
+            {
+                auto& page = writablePage(table, position.page);
+                table.bytes = table.bytes - page.entries[position.index].dataSize + dataSize;
+                ++_modifications;
+                return page.assign(position.index, data, dataSize);
+            }
+
+            Position erase(Table& table, const Position& position)
+            {
+                auto& page = writablePage(table, position.page);
+                const auto& current = page.entries[position.index];
+                table.bytes -= current.keySize + current.dataSize;
+                page.erase(position.index);
+                --table.entries;
+                ++_modifications;
+                if (page.size() == 0) {
+                    table.pages.erase(table.pages.begin() + position.page);
+                    return Position { position.page, 0 };
+                }
+                return normalize(table, position);
+            }
+
+        private:
+            friend class MemoryEnv;
+
+            MemoryEnv* _env;
+            MemoryTxn* _parent;
+            const bool _readOnly;
+            bool _active { false };
+            uint64_t _id { 0 };
+            uint64_t _modifications { 0 };
+            // a read-only transaction shares the committed tables, a write transaction has its own copy
+            std::shared_ptr<const Tables> _snapshot {};
+            Tables _tables {};
+
+            Page& writablePage(Table& table, size_t index)
+            {
+                auto& page = table.pages[index];
+                if (page->owner != _id) {
+                    page = std::make_shared<Page>(*page);
+                    page->owner = _id;
+                }
+                return *page;
+            }
+        };
+
+        class MemoryCursor : public kv::CursorHandler {
+        public:
+            MemoryCursor(MemoryTxn* const txn, const MDB_dbi dbi) noexcept
+                : _txn { txn }
+                , _dbi { dbi }
+            {
+            }
+
+            ~MemoryCursor() noexcept override = default;
+
+            int get(MDB_val* const key, MDB_val* const data, const MDB_cursor_op op) override
+            {
+                auto table = refresh();
+                if (table == nullptr) {
+                    return EINVAL;
+                }
+                auto order = _txn->order(_dbi, *table);
+                switch (op) {
+                case MDB_FIRST:
+                    return moveTo(*table, order, Position { 0, 0 }, key, data);
+                case MDB_LAST:
+                    if (table->pages.empty()) {
+                        return MDB_NOTFOUND;
+                    }
+                    return moveTo(*table, order, Position { table->pages.size() - 1, table->pages.back()->size() - 1 }, key, data);
+                case MDB_GET_CURRENT:
+                    if (!_positioned || _deleted) {
+                        return MDB_NOTFOUND;
+                    }
+                    return moveTo(*table, order, _position, key, data);
+                case MDB_NEXT:
+                    if (!_positioned) {
+                        return moveTo(*table, order, Position { 0, 0 }, key, data);
+                    }
+                    return moveTo(*table, order, (_deleted) ? _position : next(*table, _position), key, data);
+                case MDB_PREV: {
+                    if (!_positioned) {
+                        return get(key, data, MDB_LAST);
+                    }
+                    auto position = Position {};
+                    if (!prev(*table, _position, position)) {
+                        return MDB_NOTFOUND;
+                    }
+                    return moveTo(*table, order, position, key, data);
+                }
+                case MDB_NEXT_DUP: {
+                    if (!_positioned || !order.dupSort) {
+                        return MDB_NOTFOUND;
+                    }
+                    auto position = (_deleted) ? _position : next(*table, _position);
+                    return moveToDup(*table, order, position, key, data);
+                }
+                case MDB_PREV_DUP: {
+                    auto position = Position {};
+                    if (!_positioned || !order.dupSort || !prev(*table, _position, position)) {
+                        return MDB_NOTFOUND;
+                    }
+                    return moveToDup(*table, order, position, key, data);
+                }
+                case MDB_SET:
+                case MDB_SET_KEY:
+                case MDB_SET_RANGE: {
+                    auto position = lowerBound(*table, order, key, nullptr);
+                    auto page = pageAt(*table, position);
+                    if (page == nullptr || (op != MDB_SET_RANGE && order.compare(*page, position.index, key, nullptr) != 0)) {
+                        _positioned = false;
+                        return MDB_NOTFOUND;
+                    }
+                    return moveTo(*table, order, position, (op == MDB_SET) ? nullptr : key, data);
+                }
+                default:
+                    return EINVAL;
+                }
+            }
+
+            int del(const unsigned int flags) override
+            {
+                if (_txn->isReadOnly()) {
+                    return EACCES;
+                }
+                if (refresh() == nullptr) {
+                    return EINVAL;
+                }
+                if (!_positioned || _deleted) {
+                    return MDB_NOTFOUND;
+                }
+                // the cursor stays at the successor of the deleted entry, which is returned by the next MDB_NEXT
+                _position = _txn->erase(*_txn->writable(_dbi), _position);
+                _deleted = true;
+                _modifications = _txn->modifications();
+                return 0;
+            }
+
+            int renew(kv::TransactionHandler* const txn) override
+            {
+                _txn = static_cast<MemoryTxn*>(txn);
+                _positioned = false;
+                return 0;
+            }
+
+            kv::TransactionHandler* txn() const noexcept override
+            {
+                return _txn;
+            }
+
+            MDB_dbi dbi() const noexcept override
+            {
+                return _dbi;
+            }
+
+        private:
+            MemoryTxn* _txn;
+            const MDB_dbi _dbi;
+            bool _positioned { false };
+            // the current entry has been deleted, the position is then at its successor
+            bool _deleted { false };
+            Position _position { 0, 0 };
+            uint64_t _modifications { 0 };
+            // a copy of the key of the current entry, and of its value in a table of sorted duplicates,
+            // to look up its position again once its page has been modified
+            std::string _key {};
+            std::string _data {};
+
+            // look up the position of the current entry again if the table has been modified
+            const Table* refresh()
+            {
+                auto table = _txn->find(_dbi);
+                if (table != nullptr && _positioned && _modifications != _txn->modifications()) {
+                    auto order = _txn->order(_dbi, *table);
+                    auto key = toVal(_key);
+                    auto data = toVal(_data);
+                    auto exact = (order.dupSort) ? &data : nullptr;
+                    _position = lowerBound(*table, order, &key, exact);
+                    auto page = pageAt(*table, _position);
+                    _deleted = (page == nullptr || order.compare(*page, _position.index, &key, exact) != 0);
+                }
+                _modifications = _txn->modifications();
+                return table;
+            }
+
+            int moveTo(const Table& table, const Order& order, const Position& position, MDB_val* const key, MDB_val* const data)
+            {
+                auto page = pageAt(table, position);
+                if (page == nullptr) {
+                    return MDB_NOTFOUND;
+                }
+                auto entryKey = page->key(position.index);
+                auto entryData = page->data(position.index);
+                _key.assign(static_cast<const char*>(entryKey.mv_data), entryKey.mv_size);
+                if (order.dupSort) {
+                    _data.assign(static_cast<const char*>(entryData.mv_data), entryData.mv_size);
+                }
+                _positioned = true;
+                _position = position;
+                _deleted = false;
+                if (key != nullptr) {
+                    *key = entryKey;
+                }
+                if (data != nullptr) {
+                    *data = entryData;
+                }
+                return 0;
+            }
+
+            int moveToDup(const Table& table, const Order& order, const Position& position, MDB_val* const key, MDB_val* const data)
+            {
+                auto page = pageAt(table, position);
+                auto currentKey = toVal(_key);
+                if (page == nullptr || order.compare(*page, position.index, &currentKey, nullptr) != 0) {
+                    return MDB_NOTFOUND;
+                }
+                return moveTo(table, order, position, key, data);
+            }
+        };
+
+        class MemoryEnv : public kv::EnvHandler {
+        public:
+            MemoryEnv(unsigned int dbNum, unsigned long dbSize, unsigned int dbMaxReaders)
+                : _maxDBs { dbNum }
+                , _mapSize { dbSize }
+                , _maxReaders { dbMaxReaders }
+                , _keyCmps(FIRST_DBI + dbNum)
+                , _dataCmps(FIRST_DBI + dbNum)
+                , _committed { std::make_shared<const Tables>() }
+            {
+                for (auto i = size_t { 0 }; i < _keyCmps.size(); ++i) {
+                    _keyCmps[i] = nullptr;
+                    _dataCmps[i] = nullptr;
+                }
+            }
+
+            ~MemoryEnv() noexcept override = default;
+
+            int begin(kv::TransactionHandler* const parent, const unsigned int flags, kv::TransactionHandler** const txn) override
+            {
+                auto parentTxn = static_cast<MemoryTxn*>(parent);
+                auto readOnly = (flags & MDB_RDONLY) != 0;
+                if (parentTxn != nullptr && (readOnly || parentTxn->isReadOnly())) {
+                    return EINVAL;
+                }
+                auto result = std::unique_ptr<MemoryTxn>(new MemoryTxn(this, parentTxn, flags));
+                if (readOnly) {
+                    acquireReader(result.get());
+                } else if (parentTxn != nullptr) {
+                    result->_tables = parentTxn->_tables;
+                } else {
+                    // a single write transaction at a time
+                    auto lock = std::unique_lock<std::mutex>(_writerMutex);
+                    _writerCond.wait(lock, [this]() { return !_writerActive; });
+                    _writerActive = true;
+                    lock.unlock();
+                    result->_tables = *snapshot();
+                }
+                result->_id = ++_txnIds;
+                result->_active = true;
+                *txn = result.release();
+                return 0;
+            }
+
+            int sync(int) override
+            {
+                return 0;
+            }
+
+            int setMapSize(const size_t size) override
+            {
+                if (size != 0) {
+                    _mapSize = size;
+                }
+                return 0;
+            }
+
+            int info(MDB_envinfo* const info) override
+            {
+                memset(info, 0, sizeof(MDB_envinfo));
+                auto bytes = size_t { 0 };
+                for (const auto& table : *snapshot()) {
+                    if (table) {
+                        bytes += table->bytes;
+                    }
+                }
+                info->me_mapsize = _mapSize;
+                info->me_last_pgno = bytes / PAGE_SIZE;
+                info->me_last_txnid = _committedId;
+                info->me_maxreaders = _maxReaders;
+                info->me_numreaders = _readers;
+                return 0;
+            }
+
+            int stat(MDB_stat* const stat) override
+            {
+                memset(stat, 0, sizeof(MDB_stat));
+                stat->ms_psize = PAGE_SIZE;
+                for (const auto& table : *snapshot()) {
+                    if (table) {
+                        ++stat->ms_entries;
+                    }
+                }
+                stat->ms_depth = (stat->ms_entries > 0) ? 1 : 0;
+                stat->ms_leaf_pages = (stat->ms_entries > 0) ? 1 : 0;
+                return 0;
+            }
+
+            // there is no file to copy
+            int copy(const char*, unsigned int) override
+            {
+                return ENOTSUP;
+            }
+
+            int copyfd(mdb_filehandle_t, unsigned int) override
+            {
+                return ENOTSUP;
+            }
+
+            // in the format of mdb_reader_list(), where the thread is the address of the transaction
+            int readerList(MDB_msg_func* const func, void* const ctx) override
+            {
+                auto lines = std::vector<std::string> {};
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    for (const auto& reader : _activeReaders) {
+                        char line[64];
+                        snprintf(line, sizeof(line), "%10d %zx %" PRIu64 "\n",
+                            static_cast<int>(getpid()), reinterpret_cast<size_t>(reader.first), reader.second);
+                        lines.emplace_back(line);
+                    }
+                }
+                if (lines.empty()) {
+                    return func("(no active readers)\n", ctx);
+                }
+                auto rc = func("    pid     thread     txnid\n", ctx);
+                for (auto it = lines.cbegin(); rc >= 0 && it != lines.cend(); ++it) {
+                    rc = func(it->c_str(), ctx);
+                }
+                return rc;
+            }
+
+            // the readers of other processes cannot be seen, nor left behind
+            int readerCheck(int* const dead) override
+            {
+                if (dead != nullptr) {
+                    *dead = 0;
+                }
+                return 0;
+            }
+
+            std::shared_ptr<const Tables> snapshot() const
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _committed;
+            }
+
+            void publish(std::shared_ptr<const Tables> tables, uint64_t txnId)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _committed = std::move(tables);
+                    _committedId = txnId;
+                }
+                releaseWriter();
+            }
+
+            void releaseWriter() noexcept
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_writerMutex);
+                    _writerActive = false;
+                }
+                _writerCond.notify_one();
+            }
+
+            // a reader holds the tables committed by the last write transaction, whose id it is reported with
+            void acquireReader(MemoryTxn* const txn)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                txn->_snapshot = _committed;
+                _activeReaders[txn] = _committedId;
+                ++_readers;
+            }
+
+            void releaseReader(MemoryTxn* const txn) noexcept
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _activeReaders.erase(txn);
+                --_readers;
+            }
+
+            MDB_dbi findDBi(const std::string& name) const
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto found = _dbis.find(name);
+                return (found != _dbis.cend()) ? found->second : 0;
+            }
+
+            MDB_dbi addDBi(const std::string& name)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto found = _dbis.find(name);
+                if (found != _dbis.cend()) {
+                    return found->second;
+                }
+                if (_dbis.size() >= _maxDBs) {
+                    return 0;
+                }
+                auto dbi = static_cast<MDB_dbi>(FIRST_DBI + _dbis.size());
+                _dbis.emplace(name, dbi);
+                return dbi;
+            }
+
+            Order order(const MDB_dbi dbi, const Table& table) const noexcept
+            {
+                auto keyCmp = (dbi < _keyCmps.size()) ? _keyCmps[dbi].load() : nullptr;
+                auto dataCmp = (dbi < _dataCmps.size()) ? _dataCmps[dbi].load() : nullptr;
+                if (keyCmp == nullptr) {
+                    keyCmp = (table.flags & MDB_INTEGERKEY) ? compareIntegers : compareBytes;
+                }
+                return Order { keyCmp, (dataCmp != nullptr) ? dataCmp : compareBytes, (table.flags & MDB_DUPSORT) != 0 };
+            }
+
+            int setCompare(const MDB_dbi dbi, MDB_cmp_func* const cmp, bool data) noexcept
+            {
+                auto& cmps = (data) ? _dataCmps : _keyCmps;
+                if (dbi >= cmps.size()) {
+                    return EINVAL;
+                }
+                cmps[dbi] = cmp;
+                return 0;
+            }
+
+        private:
+            const unsigned int _maxDBs;
+            std::atomic<size_t> _mapSize;
+            const unsigned int _maxReaders;
+            std::vector<std::atomic<MDB_cmp_func*>> _keyCmps;
+            std::vector<std::atomic<MDB_cmp_func*>> _dataCmps;
+
+            mutable std::mutex _mutex {};
+            std::map<std::string, MDB_dbi> _dbis {};
+            std::shared_ptr<const Tables> _committed;
+            uint64_t _committedId { 0 };
+            std::map<const MemoryTxn*, uint64_t> _activeReaders {};
+
+            std::mutex _writerMutex {};
+            std::condition_variable _writerCond {};
+            bool _writerActive { false };
+
+            std::atomic<uint64_t> _txnIds { 0 };
+            std::atomic<unsigned int> _readers { 0 };
+        };
+
+        MemoryTxn::MemoryTxn(MemoryEnv* const env, MemoryTxn* const parent, const unsigned int flags)
+            : _env { env }
+            , _parent { parent }
+            , _readOnly { (flags & MDB_RDONLY) != 0 }
+        {
+        }
+
+        kv::EnvHandler* MemoryTxn::env() const noexcept
+        {
+            return _env;
+        }
+
+        int MemoryTxn::commit()
+        {
+            if (!_active) {
+                return MDB_BAD_TXN;
+            }
+            _active = false;
+            if (_readOnly) {
+                _snapshot.reset();
+                _env->releaseReader(this);
+            } else if (_parent != nullptr) {
+                _parent->_tables = std::move(_tables);
+                ++_parent->_modifications;
+            } else {
+                _env->publish(std::make_shared<const Tables>(std::move(_tables)), _id);
+            }
+            return 0;
+        }
+
+        void MemoryTxn::abort() noexcept
+        {
+            if (!_active) {
+                return;
+            }
+            _active = false;
+            if (_readOnly) {
+                _snapshot.reset();
+                _env->releaseReader(this);
+            } else {
+                _tables.clear();
+                if (_parent == nullptr) {
+                    _env->releaseWriter();
+                }
+            }
+        }
+
+        void MemoryTxn::reset() noexcept
+        {
+            if (_readOnly) {
+                abort();
+            }
+        }
+
+        int MemoryTxn::renew()
+        {
+            if (!_readOnly || _active) {
+                return EINVAL;
+            }
+            _env->acquireReader(this);
+            _active = true;
+            ++_modifications;
+            return 0;
+        }
+
+        Order MemoryTxn::order(const MDB_dbi dbi, const Table& table) const noexcept
+        {
+            return _env->order(dbi, table);
+        }
+
+        int MemoryTxn::open(const char* const name, const unsigned int flags, MDB_dbi* const dbi)
+        {
+            if (!_active) {
+                return MDB_BAD_TXN;
+            }
+            if (name == nullptr) {
+                return EINVAL;
+            }
+            auto handle = _env->findDBi(name);
+            if (find(handle) == nullptr) {
+                if ((flags & MDB_CREATE) == 0) {
+                    return MDB_NOTFOUND;
+                }
+                if (_readOnly) {
+                    return EACCES;
+                }
+                if (handle == 0 && (handle = _env->addDBi(name)) == 0) {
+                    return MDB_DBS_FULL;
+                }
+                if (_tables.size() <= handle) {
+                    _tables.resize(handle + 1);
+                }
+                auto table = std::make_shared<Table>();
+                table->flags = flags & (MDB_INTEGERKEY | MDB_DUPSORT);
+                table->owner = _id;
+                _tables[handle] = table;
+                ++_modifications;
+            }
+            *dbi = handle;
+            return 0;
+        }
+
+        int MemoryTxn::flags(const MDB_dbi dbi, unsigned int* const flags)
+        {
+            auto table = find(dbi);
+            if (table == nullptr) {
+                return EINVAL;
+            }
+            *flags = table->flags;
+            return 0;
+        }
+
+        int MemoryTxn::stat(const MDB_dbi dbi, MDB_stat* const stat)
+        {
+            auto table = find(dbi);
+            if (table == nullptr) {
+                return EINVAL;
+            }
+            memset(stat, 0, sizeof(MDB_stat));
+            stat->ms_psize = PAGE_SIZE;
+            stat->ms_depth = (table->pages.empty()) ? 0 : (table->pages.size() == 1) ? 1 : 2;
+            stat->ms_branch_pages = (table->pages.size() > 1) ? 1 : 0;
+            stat->ms_leaf_pages = table->pages.size();
+            stat->ms_entries = table->entries;
+            return 0;
+        }
+
+        int MemoryTxn::drop(const MDB_dbi dbi, const int del)
+        {
+            if (_readOnly) {
+                return EACCES;
+            }
+            if (find(dbi) == nullptr) {
+                return EINVAL;
+            }
+            if (del) {
+                _tables[dbi] = nullptr;
+            } else {
+                auto table = std::make_shared<Table>();
+                table->flags = _tables[dbi]->flags;
+                table->owner = _id;
+                _tables[dbi] = table;
+            }
+            ++_modifications;
+            return 0;
+        }
+
+        int MemoryTxn::setCompare(const MDB_dbi dbi, MDB_cmp_func* const cmp)
+        {
+            return _env->setCompare(dbi, cmp, false);
+        }
+
+        int MemoryTxn::setDupSort(const MDB_dbi dbi, MDB_cmp_func* const cmp)
+        {
+            return _env->setCompare(dbi, cmp, true);
+        }
+
+        int MemoryTxn::get(const MDB_dbi dbi, MDB_val* const key, MDB_val* const data)
+        {
+            auto table = find(dbi);
+            if (table == nullptr) {
+                return EINVAL;
+            }
+            auto order = this->order(dbi, *table);
+            auto position = lowerBound(*table, order, key, nullptr);
+            auto page = pageAt(*table, position);
+            if (page == nullptr || order.compare(*page, position.index, key, nullptr) != 0) {
+                return MDB_NOTFOUND;
+            }
+            *data = page->data(position.index);
+            return 0;
+        }
+
+        int MemoryTxn::put(const MDB_dbi dbi, MDB_val* const key, MDB_val* const data, const unsigned int flags)
+        {
+            if (_readOnly) {
+                return EACCES;
+            }
+            auto table = writable(dbi);
+            if (table == nullptr) {
+                return EINVAL;
+            }
+            if (key->mv_size == 0) {
+                return MDB_BAD_VALSIZE;
+            }
+            auto order = this->order(dbi, *table);
+            auto position = lowerBound(*table, order, key, nullptr);
+            auto page = pageAt(*table, position);
+            auto found = page != nullptr && order.compare(*page, position.index, key, nullptr) == 0;
+            if (found && (flags & MDB_NOOVERWRITE)) {
+                *data = page->data(position.index);
+                return MDB_KEYEXIST;
+            }
+            if (!order.dupSort) {
+                // an appended key must be greater than every key in the table
+                if (!found && (flags & MDB_APPEND) && page != nullptr) {
+                    return MDB_KEYEXIST;
+                }
+                // the value of a reserved entry is filled by the caller before anything else reads it
+                auto value = (flags & MDB_RESERVE) ? nullptr : data;
+                auto space = (found) ? replace(*table, position, value, data->mv_size)
+                                     : insert(*table, position, key, value, data->mv_size);
+                if (flags & MDB_RESERVE) {
+                    data->mv_data = space;
+                }
+                return 0;
+            } else if (found) {
+                position = lowerBound(*table, order, key, data);
+                page = pageAt(*table, position);
+                if (page != nullptr && order.compare(*page, position.index, key, data) == 0) {
+                    return (flags & MDB_NODUPDATA) ? MDB_KEYEXIST : 0;
+                }
+            }
+            insert(*table, position, key, data, data->mv_size);
+            return 0;
+        }
+
+        int MemoryTxn::del(const MDB_dbi dbi, MDB_val* const key, MDB_val* const data)
+        {
+            if (_readOnly) {
+                return EACCES;
+            }
+            auto table = writable(dbi);
+            if (table == nullptr) {
+                return EINVAL;
+            }
+            auto order = this->order(dbi, *table);
+            auto exact = (order.dupSort) ? data : nullptr;
+            auto position = lowerBound(*table, order, key, exact);
+            auto page = pageAt(*table, position);
+            if (page == nullptr || order.compare(*page, position.index, key, exact) != 0) {
+                return MDB_NOTFOUND;
+            }
+            if (!order.dupSort || data != nullptr) {
+                erase(*table, position);
+                return 0;
+            }
+            // without a data every duplicate of the key is deleted, the key may be the one
+            // of an erased entry, whose page is compacted along the way
+            auto erasedKey = std::string { static_cast<const char*>(key->mv_data), key->mv_size };
+            auto erasedKeyVal = toVal(erasedKey);
+            do {
+                position = erase(*table, position);
+            } while ((page = pageAt(*table, position)) != nullptr && order.compare(*page, position.index, &erasedKeyVal, nullptr) == 0);
+            return 0;
+        }
+
+        int MemoryTxn::openCursor(const MDB_dbi dbi, kv::CursorHandler** const cursor)
+        {
+            if (find(dbi) == nullptr) {
+                return EINVAL;
+            }
+            *cursor = new MemoryCursor(this, dbi);
+            return 0;
+        }
+    }
+
+    kv::EnvHandler* createEnv(unsigned int dbNum, unsigned long dbSize, unsigned int dbMaxReaders)
+    {
+        return new MemoryEnv(dbNum, dbSize, dbMaxReaders);
+    }
+
+}
+}
+}
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (C) 2019, NogDB <https://nogdb.org>
+ *  <nogdb at throughwave dot co dot th>
+ *
+ *  This file is part of libnogdb, the NogDB core library in C++.
+ *
+ *  libnogdb is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "kv_engine.hpp"
+
+namespace nogdb {
+namespace storage_engine {
+namespace memory {
+
+    /**
+     * Create an environment keeping its tables in memory only, nothing is ever written to disk.
+     * Tables are ordered arrays of small sorted pages which are copied on write, so that a write
+     * transaction only copies the pages it modifies and readers keep the snapshot they have begun with.
+     * A page stores the keys and values of its entries inline, in a single buffer.
+     * As in lmdb, there is a single write transaction at a time, and values returned by a transaction
+     * stay valid until it ends or modifies them.
+     */
+    kv::EnvHandler* createEnv(unsigned int dbNum, unsigned long dbSize, unsigned int dbMaxReaders);
+
+}
+}
+}
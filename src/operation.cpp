@@ -53,9 +53,11 @@ const RecordDescriptor Transaction::addVertex(const std::string& className, cons
     auto vertexClassInfo = SchemaUtils::getValidClassInfo(this, className, ClassType::VERTEX);
     auto propertyNameMapInfo = SchemaUtils::getPropertyNameMapInfo(
         this, vertexClassInfo.id, vertexClassInfo.superClassId);
-    auto recordBlob = RecordParser::parseRecord(record, propertyNameMapInfo);
+    auto vertexDataRecord = DataRecord(_txnBase, vertexClassInfo.id, ClassType::VERTEX);
+    auto externalValues = parser::ExternalValues {};
+    auto recordBlob = RecordParser::parseRecord(record, propertyNameMapInfo, _txnCtx->getLargeValueThreshold(),
+        externalValues, vertexDataRecord.getRecordFormat(_txnCtx->getRecordFormat()));
     try {
-        auto vertexDataRecord = DataRecord(_txnBase, vertexClassInfo.id, ClassType::VERTEX);
         auto positionId = PositionId { 0 };
         if (_txnCtx->isVersionEnabled()) {
             auto newRecordBlob = RecordParser::parseVertexRecordWithVersion(recordBlob, VersionId { 1 });
@@ -64,12 +66,15 @@ const RecordDescriptor Transaction::addVertex(const std::string& className, cons
         } else {
             positionId = vertexDataRecord.insert(recordBlob);
         }
+        if (!externalValues.empty()) {
+            DataValue(_txnBase, vertexClassInfo.id).insert(positionId, externalValues);
+        }
         auto recordDescriptor = RecordDescriptor { vertexClassInfo.id, positionId };
         auto indexInfos = IndexUtils::getIndexInfos(this, recordDescriptor, record, propertyNameMapInfo);
         IndexUtils::insert(this, recordDescriptor, record, indexInfos);
         return recordDescriptor;
     } catch (const Error& error) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(error);
     }
 }
@@ -89,9 +94,11 @@ const RecordDescriptor Transaction::addEdge(const std::string& className,
     auto edgeClassInfo = SchemaUtils::getValidClassInfo(this, className, ClassType::EDGE);
     auto propertyNameMapInfo = SchemaUtils::getPropertyNameMapInfo(
         this, edgeClassInfo.id, edgeClassInfo.superClassId);
-    auto recordBlob = RecordParser::parseRecord(record, propertyNameMapInfo);
+    auto edgeDataRecord = DataRecord(_txnBase, edgeClassInfo.id, ClassType::EDGE);
+    auto externalValues = parser::ExternalValues {};
+    auto recordBlob = RecordParser::parseRecord(record, propertyNameMapInfo, _txnCtx->getLargeValueThreshold(),
+        externalValues, edgeDataRecord.getRecordFormat(_txnCtx->getRecordFormat()));
     try {
-        auto edgeDataRecord = DataRecord(_txnBase, edgeClassInfo.id, ClassType::EDGE);
         auto vertexBlob = RecordParser::parseEdgeVertexSrcDst(
             srcVertexRecordDescriptor.rid, dstVertexRecordDescriptor.rid);
         auto positionId = PositionId { 0 };
@@ -102,18 +109,21 @@ const RecordDescriptor Transaction::addEdge(const std::string& className,
         } else {
             positionId = edgeDataRecord.insert(vertexBlob + recordBlob);
         }
+        if (!externalValues.empty()) {
+            DataValue(_txnBase, edgeClassInfo.id).insert(positionId, externalValues);
+        }
         auto recordDescriptor = RecordDescriptor { edgeClassInfo.id, positionId };
         _graph->addRel(recordDescriptor.rid, srcVertexRecordDescriptor.rid, dstVertexRecordDescriptor.rid);
         auto indexInfos = IndexUtils::getIndexInfos(this, recordDescriptor, record, propertyNameMapInfo);
         IndexUtils::insert(this, recordDescriptor, record, indexInfos);
         return recordDescriptor;
     } catch (const Error& error) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(error);
     }
 }
 
-void Transaction::update(const RecordDescriptor& recordDescriptor, const Record& record)
+void Transaction::update(const RecordDescriptor& recordDescriptor, const Record& record, UpdateMode mode)
 {
     BEGIN_VALIDATION(this)
         .isTxnValid()
@@ -123,43 +133,69 @@ void Transaction::update(const RecordDescriptor& recordDescriptor, const Record&
     auto dataRecord = DataRecord(_txnBase, classInfo.id, classInfo.type);
     auto recordResult = dataRecord.getResult(recordDescriptor.rid.second);
     auto propertyNameMapInfo = SchemaUtils::getPropertyNameMapInfo(this, classInfo.id, classInfo.superClassId);
-    auto newRecordBlob = RecordParser::parseRecord(record, propertyNameMapInfo);
+    auto externalValues = parser::ExternalValues {};
+    auto patches = RecordParser::parsePatches(
+        record, propertyNameMapInfo, _txnCtx->getLargeValueThreshold(), externalValues);
     try {
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(this, classInfo.id, classInfo.superClassId);
-        auto existingRecord = RecordParser::parseRawData(
-            recordResult, propertyIdMapInfo, classInfo.type == ClassType::EDGE, _txnCtx->isVersionEnabled());
+        auto isEdge = classInfo.type == ClassType::EDGE;
+        auto enableVersion = _txnCtx->isVersionEnabled();
+        auto indexInfos = IndexUtils::getIndexInfos(this, recordDescriptor, record, propertyNameMapInfo);
+        auto existingRecord = Record {};
+        if (!indexInfos.empty()) {
+            auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(this, classInfo.id, classInfo.superClassId);
+            existingRecord = RecordParser::parseRawData(
+                recordResult, propertyIdMapInfo, isEdge, enableVersion, _txnBase, recordDescriptor.rid);
+        }
 
-        // insert an updated record
-        auto updateRecordBlob = Blob {};
-        if (_txnCtx->isVersionEnabled()) {
-            if (_updatedRecords.find(recordDescriptor.rid) == _updatedRecords.cend()) {
-                auto versionId = RecordParser::parseRawDataVersionId(recordResult);
-                if (classInfo.type == ClassType::EDGE) {
-                    auto vertexBlob = RecordParser::parseEdgeRawDataVertexSrcDstAsBlob(
-                        recordResult, _txnCtx->isVersionEnabled());
-                    updateRecordBlob = RecordParser::parseEdgeRecordWithVersion(
-                        vertexBlob, newRecordBlob, versionId + 1);
-                } else {
-                    updateRecordBlob = RecordParser::parseVertexRecordWithVersion(newRecordBlob, versionId + 1);
+        // the previous record is only needed up to its header, unless its other properties are kept
+        auto headerSize = RecordParser::getHeaderSize(isEdge, enableVersion);
+        auto previousData = recordResult.data.data<unsigned char>();
+        auto previousSize = (mode == UpdateMode::PATCH) ? recordResult.data.size() : headerSize;
+        require(recordResult.data.size() >= headerSize);
+        auto replacedExternalValues = std::vector<PropertyId> {};
+        RecordParser::visitRawProperties(previousData, recordResult.data.size(), headerSize,
+            [&](const PropertyId& propertyId, const unsigned char*, size_t, bool external) {
+                auto replaced = mode == UpdateMode::REPLACE
+                    || std::any_of(patches.cbegin(), patches.cend(),
+                        [&](const parser::PropertyPatch& patch) { return patch.propertyId == propertyId; });
+                if (external && replaced) {
+                    replacedExternalValues.push_back(propertyId);
                 }
-                _updatedRecords.insert(recordDescriptor.rid);
-            } else {
-                updateRecordBlob = RecordParser::parseOnlyUpdateRecord(
-                    recordResult, newRecordBlob, classInfo.type == ClassType::EDGE, true);
+                return true;
+            });
+        auto versionId = VersionId { 0 };
+        if (enableVersion && _updatedRecords.find(recordDescriptor.rid) == _updatedRecords.cend()) {
+            versionId = RecordParser::parseRawDataVersionId(recordResult) + 1;
+        }
+        // the record is written into the space reserved in the table, which may overlap the previous one
+        thread_local auto previous = std::vector<unsigned char> {};
+        previous.assign(previousData, previousData + previousSize);
+        auto recordFormat = dataRecord.getRecordFormat(_txnCtx->getRecordFormat());
+        auto size = RecordParser::getPatchedRawDataSize(
+            previous.data(), previous.size(), headerSize, patches, recordFormat);
+        dataRecord.update(recordDescriptor.rid.second, size, [&](unsigned char* data) {
+            RecordParser::writePatchedRawData(data, previous.data(), previous.size(), headerSize, patches, recordFormat);
+            if (versionId > 0) {
+                RecordParser::writeVersionId(data, versionId);
             }
-        } else {
-            updateRecordBlob = RecordParser::parseOnlyUpdateRecord(
-                recordResult, newRecordBlob, classInfo.type == ClassType::EDGE, false);
+        });
+        if (versionId > 0) {
+            _updatedRecords.insert(recordDescriptor.rid);
+        }
+        if (!replacedExternalValues.empty() || !externalValues.empty()) {
+            auto dataValue = DataValue(_txnBase, classInfo.id);
+            for (const auto& propertyId : replacedExternalValues) {
+                dataValue.remove(recordDescriptor.rid.second, propertyId);
+            }
+            dataValue.insert(recordDescriptor.rid.second, externalValues);
         }
-        dataRecord.update(recordDescriptor.rid.second, updateRecordBlob);
 
         // remove index if applied in existing record
-        auto indexInfos = IndexUtils::getIndexInfos(this, recordDescriptor, record, propertyNameMapInfo);
         IndexUtils::remove(this, recordDescriptor, existingRecord, indexInfos);
         // add index if applied in new record
         IndexUtils::insert(this, recordDescriptor, record, indexInfos);
     } catch (const Error& error) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(error);
     }
 }
@@ -177,20 +213,28 @@ void Transaction::updateSrc(const RecordDescriptor& recordDescriptor,
     auto recordResult = edgeDataRecord.getResult(recordDescriptor.rid.second);
     try {
         auto srcDstVertex = RecordParser::parseEdgeRawDataVertexSrcDst(recordResult, _txnCtx->isVersionEnabled());
+        // update vertices and version of edge
+        auto edgeVersionId = VersionId { 0 };
+        if (_txnCtx->isVersionEnabled() && _updatedRecords.find(recordDescriptor.rid) == _updatedRecords.cend()) {
+            edgeVersionId = RecordParser::parseRawDataVersionId(recordResult) + 1;
+            _updatedRecords.insert(recordDescriptor.rid);
+        }
+        edgeDataRecord.rewrite(recordDescriptor.rid.second, recordResult, [&](unsigned char* data) {
+            RecordParser::writeEdgeVertexSrc(data, newSrcVertexRecordDescriptor.rid, _txnCtx->isVersionEnabled());
+            if (edgeVersionId > 0) {
+                RecordParser::writeVersionId(data, edgeVersionId);
+            }
+        });
         _graph->updateSrcRel(
             recordDescriptor.rid, newSrcVertexRecordDescriptor.rid, srcDstVertex.first, srcDstVertex.second);
-        auto newVertexBlob = RecordParser::parseEdgeVertexSrcDst(
-            newSrcVertexRecordDescriptor.rid, srcDstVertex.second);
-        auto updateEdgeRecordBlob = RecordParser::parseOnlyUpdateSrcVertex(
-            recordResult, newSrcVertexRecordDescriptor.rid, _txnCtx->isVersionEnabled());
         if (_txnCtx->isVersionEnabled()) {
             // update version of old src vertex
             if (_updatedRecords.find(srcDstVertex.first) == _updatedRecords.cend()) {
                 auto oldSrcVertexDataRecord = DataRecord(_txnBase, srcDstVertex.first.first, ClassType::VERTEX);
                 auto oldSrcVertexRecordResult = oldSrcVertexDataRecord.getResult(srcDstVertex.first.second);
                 auto versionId = RecordParser::parseRawDataVersionId(oldSrcVertexRecordResult);
-                auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(oldSrcVertexRecordResult, versionId + 1);
-                oldSrcVertexDataRecord.update(srcDstVertex.first.second, updateRecordBlob);
+                oldSrcVertexDataRecord.updateVersion(
+                    srcDstVertex.first.second, oldSrcVertexRecordResult, versionId + 1);
                 _updatedRecords.insert(srcDstVertex.first);
             }
             // update version of new src vertex
@@ -199,20 +243,13 @@ void Transaction::updateSrc(const RecordDescriptor& recordDescriptor,
                     _txnBase, newSrcVertexRecordDescriptor.rid.first, ClassType::VERTEX);
                 auto newSrcVertexRecordResult = newSrcVertexDataRecord.getResult(newSrcVertexRecordDescriptor.rid.second);
                 auto versionId = RecordParser::parseRawDataVersionId(newSrcVertexRecordResult);
-                auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(newSrcVertexRecordResult, versionId + 1);
-                newSrcVertexDataRecord.update(newSrcVertexRecordDescriptor.rid.second, updateRecordBlob);
+                newSrcVertexDataRecord.updateVersion(
+                    newSrcVertexRecordDescriptor.rid.second, newSrcVertexRecordResult, versionId + 1);
                 _updatedRecords.insert(newSrcVertexRecordDescriptor.rid);
             }
-            // update version of edge
-            if (_updatedRecords.find(recordDescriptor.rid) == _updatedRecords.cend()) {
-                auto edgeVersionId = RecordParser::parseRawDataVersionId(recordResult);
-                RecordParser::parseOnlyUpdateVersion(updateEdgeRecordBlob, edgeVersionId + 1);
-                _updatedRecords.insert(recordDescriptor.rid);
-            }
         }
-        edgeDataRecord.update(recordDescriptor.rid.second, updateEdgeRecordBlob);
     } catch (const Error& error) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(error);
     }
 }
@@ -230,20 +267,28 @@ void Transaction::updateDst(const RecordDescriptor& recordDescriptor,
     auto recordResult = edgeDataRecord.getResult(recordDescriptor.rid.second);
     try {
         auto srcDstVertex = RecordParser::parseEdgeRawDataVertexSrcDst(recordResult, _txnCtx->isVersionEnabled());
+        // update vertices and version of edge
+        auto edgeVersionId = VersionId { 0 };
+        if (_txnCtx->isVersionEnabled() && _updatedRecords.find(recordDescriptor.rid) == _updatedRecords.cend()) {
+            edgeVersionId = RecordParser::parseRawDataVersionId(recordResult) + 1;
+            _updatedRecords.insert(recordDescriptor.rid);
+        }
+        edgeDataRecord.rewrite(recordDescriptor.rid.second, recordResult, [&](unsigned char* data) {
+            RecordParser::writeEdgeVertexDst(data, newDstVertexRecordDescriptor.rid, _txnCtx->isVersionEnabled());
+            if (edgeVersionId > 0) {
+                RecordParser::writeVersionId(data, edgeVersionId);
+            }
+        });
         _graph->updateDstRel(
             recordDescriptor.rid, newDstVertexRecordDescriptor.rid, srcDstVertex.first, srcDstVertex.second);
-        auto newVertexBlob = RecordParser::parseEdgeVertexSrcDst(
-            srcDstVertex.first, newDstVertexRecordDescriptor.rid);
-        auto updateEdgeRecordBlob = RecordParser::parseOnlyUpdateDstVertex(
-            recordResult, newDstVertexRecordDescriptor.rid, _txnCtx->isVersionEnabled());
         if (_txnCtx->isVersionEnabled()) {
             // update version of old dst vertex
             if (_updatedRecords.find(srcDstVertex.second) == _updatedRecords.cend()) {
                 auto oldDstVertexDataRecord = DataRecord(_txnBase, srcDstVertex.second.first, ClassType::VERTEX);
                 auto oldDstVertexRecordResult = oldDstVertexDataRecord.getResult(srcDstVertex.second.second);
                 auto versionId = RecordParser::parseRawDataVersionId(oldDstVertexRecordResult);
-                auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(oldDstVertexRecordResult, versionId + 1);
-                oldDstVertexDataRecord.update(srcDstVertex.second.second, updateRecordBlob);
+                oldDstVertexDataRecord.updateVersion(
+                    srcDstVertex.second.second, oldDstVertexRecordResult, versionId + 1);
                 _updatedRecords.insert(srcDstVertex.second);
             }
             // update version of new dst vertex
@@ -252,20 +297,13 @@ void Transaction::updateDst(const RecordDescriptor& recordDescriptor,
                     _txnBase, newDstVertexRecordDescriptor.rid.first, ClassType::VERTEX);
                 auto newDstVertexRecordResult = newDstVertexDataRecord.getResult(newDstVertexRecordDescriptor.rid.second);
                 auto versionId = RecordParser::parseRawDataVersionId(newDstVertexRecordResult);
-                auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(newDstVertexRecordResult, versionId + 1);
-                newDstVertexDataRecord.update(newDstVertexRecordDescriptor.rid.second, updateRecordBlob);
+                newDstVertexDataRecord.updateVersion(
+                    newDstVertexRecordDescriptor.rid.second, newDstVertexRecordResult, versionId + 1);
                 _updatedRecords.insert(newDstVertexRecordDescriptor.rid);
             }
-            // update version of edge
-            if (_updatedRecords.find(recordDescriptor.rid) == _updatedRecords.cend()) {
-                auto edgeVersionId = RecordParser::parseRawDataVersionId(recordResult);
-                RecordParser::parseOnlyUpdateVersion(updateEdgeRecordBlob, edgeVersionId + 1);
-                _updatedRecords.insert(recordDescriptor.rid);
-            }
         }
-        edgeDataRecord.update(recordDescriptor.rid.second, updateEdgeRecordBlob);
     } catch (const Error& error) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(error);
     }
 }
@@ -281,9 +319,12 @@ void Transaction::remove(const RecordDescriptor& recordDescriptor)
     auto recordResult = dataRecord.getResult(recordDescriptor.rid.second);
     try {
         auto propertyNameMapInfo = SchemaUtils::getPropertyNameMapInfo(this, classInfo.id, classInfo.superClassId);
-        auto propertyIdMapInfo = SchemaUtils::getPropertyIdMapInfo(this, classInfo.id, classInfo.superClassId);
+        auto propertyIdMapInfo = SchemaUtils::getSharedPropertyIdMapInfo(this, classInfo.id, classInfo.superClassId);
         auto record = RecordParser::parseRawData(
-            recordResult, propertyIdMapInfo, classInfo.type == ClassType::EDGE, _txnCtx->isVersionEnabled());
+            recordResult, propertyIdMapInfo, classInfo.type == ClassType::EDGE, _txnCtx->isVersionEnabled(),
+            _txnBase, recordDescriptor.rid);
+        auto hasExternalValues = RecordParser::hasExternalValues(
+            recordResult, classInfo.type, _txnCtx->isVersionEnabled());
 
         if (classInfo.type == ClassType::EDGE) {
             auto srcDstVertex = RecordParser::parseEdgeRawDataVertexSrcDst(
@@ -296,8 +337,7 @@ void Transaction::remove(const RecordDescriptor& recordDescriptor)
                         _txnBase, srcDstVertex.first.first, ClassType::VERTEX);
                     auto srcVertexRecordResult = srcVertexDataRecord.getResult(srcDstVertex.first.second);
                     auto versionId = RecordParser::parseRawDataVersionId(srcVertexRecordResult);
-                    auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(srcVertexRecordResult, versionId + 1);
-                    srcVertexDataRecord.update(srcDstVertex.first.second, updateRecordBlob);
+                    srcVertexDataRecord.updateVersion(srcDstVertex.first.second, srcVertexRecordResult, versionId + 1);
                     _updatedRecords.insert(srcDstVertex.first);
                 }
                 // update version of dst vertex
@@ -306,8 +346,7 @@ void Transaction::remove(const RecordDescriptor& recordDescriptor)
                         _txnBase, srcDstVertex.second.first, ClassType::VERTEX);
                     auto dstVertexRecordResult = dstVertexDataRecord.getResult(srcDstVertex.second.second);
                     auto versionId = RecordParser::parseRawDataVersionId(dstVertexRecordResult);
-                    auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(dstVertexRecordResult, versionId + 1);
-                    dstVertexDataRecord.update(srcDstVertex.second.second, updateRecordBlob);
+                    dstVertexDataRecord.updateVersion(srcDstVertex.second.second, dstVertexRecordResult, versionId + 1);
                     _updatedRecords.insert(srcDstVertex.second);
                 }
             }
@@ -319,20 +358,22 @@ void Transaction::remove(const RecordDescriptor& recordDescriptor)
                         auto neighbourDataRecord = DataRecord(_txnBase, neighbour.first, ClassType::VERTEX);
                         auto neighbourRecordResult = neighbourDataRecord.getResult(neighbour.second);
                         auto versionId = RecordParser::parseRawDataVersionId(neighbourRecordResult);
-                        auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(neighbourRecordResult, versionId + 1);
-                        neighbourDataRecord.update(neighbour.second, updateRecordBlob);
+                        neighbourDataRecord.updateVersion(neighbour.second, neighbourRecordResult, versionId + 1);
                         _updatedRecords.insert(neighbour);
                     }
                 }
             }
         }
         dataRecord.remove(recordDescriptor.rid.second);
+        if (hasExternalValues) {
+            DataValue(_txnBase, classInfo.id).remove(recordDescriptor.rid.second);
+        }
 
         // remove index if applied in the record
         auto indexInfos = IndexUtils::getIndexInfos(this, recordDescriptor, record, propertyNameMapInfo);
         IndexUtils::remove(this, recordDescriptor, record, indexInfos);
     } catch (const Error& error) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(error);
     }
 }
@@ -349,9 +390,12 @@ void Transaction::removeAll(const std::string& className)
         auto dataRecord = DataRecord(_txnBase, classInfo.id, classInfo.type);
         auto propertyNameMapInfo = SchemaUtils::getPropertyNameMapInfo(this, classInfo.id, classInfo.superClassId);
         auto result = std::map<RecordId, std::pair<RecordId, RecordId>> {};
+        auto hasExternalValues = false;
         std::function<void(const PositionId&, const storage_engine::lmdb::Result&)> callback =
             [&](const PositionId& positionId, const storage_engine::lmdb::Result& result) {
                 auto recordId = RecordId { classInfo.id, positionId };
+                hasExternalValues = hasExternalValues
+                    || RecordParser::hasExternalValues(result, classInfo.type, _txnCtx->isVersionEnabled());
                 if (classInfo.type == ClassType::EDGE) {
                     auto srcDstVertex = RecordParser::parseEdgeRawDataVertexSrcDst(
                         result, _txnCtx->isVersionEnabled());
@@ -363,9 +407,8 @@ void Transaction::removeAll(const std::string& className)
                                 _txnBase, srcDstVertex.first.first, ClassType::VERTEX);
                             auto srcVertexRecordResult = srcVertexDataRecord.getResult(srcDstVertex.first.second);
                             auto versionId = RecordParser::parseRawDataVersionId(srcVertexRecordResult);
-                            auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(
-                                srcVertexRecordResult, versionId + 1);
-                            srcVertexDataRecord.update(srcDstVertex.first.second, updateRecordBlob);
+                            srcVertexDataRecord.updateVersion(
+                                srcDstVertex.first.second, srcVertexRecordResult, versionId + 1);
                             _updatedRecords.insert(srcDstVertex.first);
                         }
                         // update version of dst vertex
@@ -374,9 +417,8 @@ void Transaction::removeAll(const std::string& className)
                                 _txnBase, srcDstVertex.second.first, ClassType::VERTEX);
                             auto dstVertexRecordResult = dstVertexDataRecord.getResult(srcDstVertex.second.second);
                             auto versionId = RecordParser::parseRawDataVersionId(dstVertexRecordResult);
-                            auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(
-                                dstVertexRecordResult, versionId + 1);
-                            dstVertexDataRecord.update(srcDstVertex.second.second, updateRecordBlob);
+                            dstVertexDataRecord.updateVersion(
+                                srcDstVertex.second.second, dstVertexRecordResult, versionId + 1);
                             _updatedRecords.insert(srcDstVertex.second);
                         }
                     }
@@ -389,9 +431,8 @@ void Transaction::removeAll(const std::string& className)
                                     _txnBase, neighbour.first, ClassType::VERTEX);
                                 auto neighbourRecordResult = neighbourDataRecord.getResult(neighbour.second);
                                 auto versionId = RecordParser::parseRawDataVersionId(neighbourRecordResult);
-                                auto updateRecordBlob = RecordParser::parseOnlyUpdateVersion(
-                                    neighbourRecordResult, versionId + 1);
-                                neighbourDataRecord.update(neighbour.second, updateRecordBlob);
+                                neighbourDataRecord.updateVersion(
+                                    neighbour.second, neighbourRecordResult, versionId + 1);
                                 _updatedRecords.insert(neighbour);
                             }
                         }
@@ -400,11 +441,14 @@ void Transaction::removeAll(const std::string& className)
             };
         dataRecord.resultSetIter(callback);
         dataRecord.destroy();
+        if (hasExternalValues) {
+            DataValue(_txnBase, classInfo.id).destroy();
+        }
 
         // drop indexes
         IndexUtils::drop(this, classInfo.id, propertyNameMapInfo);
     } catch (const Error& error) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(error);
     }
 }
@@ -654,6 +698,33 @@ ResultSetCursor FindOperationBuilder::getCursor() const
     }
 }
 
+ResultViewSet FindOperationBuilder::getView() const
+{
+    if (_conditionType != ConditionType::UNDEFINED) {
+        auto cursor = getCursor();
+        auto resultViewSet = ResultViewSet {};
+        resultViewSet.reserve(cursor.size());
+        while (cursor.next()) {
+            resultViewSet.emplace_back(cursor.getView());
+        }
+        return resultViewSet;
+    }
+
+    BEGIN_VALIDATION(_txn)
+        .isTxnCompleted()
+        .isClassNameValid(_className);
+
+    auto classInfo = SchemaUtils::getExistingClass(_txn, _className);
+    auto resultViewSet = DataRecordUtils::getResultViewSet(_txn, classInfo);
+    if (_includeSubClassOf) {
+        for (const auto& classNameMapInfo : SchemaUtils::getSubClassInfos(_txn, classInfo.id)) {
+            auto resultViewSetExtend = DataRecordUtils::getResultViewSet(_txn, classNameMapInfo.second);
+            resultViewSet.insert(resultViewSet.cend(), resultViewSetExtend.cbegin(), resultViewSetExtend.cend());
+        }
+    }
+    return resultViewSet;
+}
+
 unsigned long FindOperationBuilder::count() const
 {
     BEGIN_VALIDATION(_txn)
@@ -787,6 +858,17 @@ ResultSetCursor FindEdgeOperationBuilder::getCursor() const
     return result;
 }
 
+ResultViewSet FindEdgeOperationBuilder::getView() const
+{
+    auto cursor = getCursor();
+    auto resultViewSet = ResultViewSet {};
+    resultViewSet.reserve(cursor.size());
+    while (cursor.next()) {
+        resultViewSet.emplace_back(cursor.getView());
+    }
+    return resultViewSet;
+}
+
 unsigned long FindEdgeOperationBuilder::count() const
 {
     BEGIN_VALIDATION(_txn)
@@ -879,6 +961,17 @@ ResultSetCursor TraverseOperationBuilder::getCursor() const
     return std::move(ResultSetCursor { *_txn }.addMetadata(result));
 }
 
+ResultViewSet TraverseOperationBuilder::getView() const
+{
+    auto cursor = getCursor();
+    auto resultViewSet = ResultViewSet {};
+    resultViewSet.reserve(cursor.size());
+    while (cursor.next()) {
+        resultViewSet.emplace_back(cursor.getView());
+    }
+    return resultViewSet;
+}
+
 unsigned long TraverseOperationBuilder::count() const
 {
     return static_cast<unsigned long>(getCursor().count());
@@ -941,6 +1034,17 @@ ResultSetCursor ShortestPathOperationBuilder::getCursor() const
     return std::move(ResultSetCursor { *_txn }.addMetadata(result));
 }
 
+ResultViewSet ShortestPathOperationBuilder::getView() const
+{
+    auto cursor = getCursor();
+    auto resultViewSet = ResultViewSet {};
+    resultViewSet.reserve(cursor.size());
+    while (cursor.next()) {
+        resultViewSet.emplace_back(cursor.getView());
+    }
+    return resultViewSet;
+}
+
 unsigned long ShortestPathOperationBuilder::count() const
 {
     return static_cast<unsigned long>(getCursor().count());
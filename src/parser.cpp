@@ -19,6 +19,7 @@
  *
  */
 
+#include "datarecord_adapter.hpp"
 #include "parser.hpp"
 #include "utils.hpp"
 
@@ -27,6 +28,7 @@ namespace parser {
     using namespace internal_data_type;
     using namespace adapter::schema;
     using namespace utils::assertion;
+    using adapter::datarecord::DataValue;
 
     Blob RecordParser::parseRecord(const Record& record, const PropertyNameMapInfo& properties)
     {
@@ -39,7 +41,27 @@ namespace parser {
             }
             dataSize += getRawDataSize(property.second.size());
         }
-        return parseRecord(record, dataSize, properties);
+        return parseRecord(record, dataSize, properties, 0, nullptr, RecordFormat::V1);
+    }
+
+    Blob RecordParser::parseRecord(const Record& record,
+        const PropertyNameMapInfo& properties,
+        size_t largeValueThreshold,
+        ExternalValues& externalValues,
+        RecordFormat recordFormat)
+    {
+        auto dataSize = size_t { 0 };
+        // calculate a raw data size of properties in a record, without the values stored out of line
+        for (const auto& property : record.getAll()) {
+            auto foundProperty = properties.find(property.first);
+            if (foundProperty == properties.cend()) {
+                throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
+            }
+            dataSize += isExternal(foundProperty->second, property.second, largeValueThreshold)
+                ? sizeof(PropertyId) + sizeof(uint32_t)
+                : getRawDataSize(property.second.size());
+        }
+        return parseRecord(record, dataSize, properties, largeValueThreshold, &externalValues, recordFormat);
     }
 
     Blob RecordParser::parseVertexRecordWithVersion(const Blob& recordBlob, VersionId versionId)
@@ -64,149 +86,362 @@ namespace parser {
         }
     }
 
-    Blob& RecordParser::parseOnlyUpdateVersion(Blob& blob, VersionId versionId)
+    PropertyPatches RecordParser::parsePatches(const Record& record,
+        const PropertyNameMapInfo& properties,
+        size_t largeValueThreshold,
+        ExternalValues& externalValues)
     {
-        blob.update(&versionId, 0, sizeof(VersionId));
-        return blob;
+        auto patches = PropertyPatches {};
+        for (const auto& property : record.getAll()) {
+            auto foundProperty = properties.find(property.first);
+            if (foundProperty == properties.cend()) {
+                throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
+            }
+            // basic info properties, e.g. @className, belong to no class and are never stored
+            if (property.second.empty() || foundProperty->second.classId == ClassId {})
+                continue;
+            auto propertyId = foundProperty->second.id;
+            auto external = isExternal(foundProperty->second, property.second, largeValueThreshold);
+            if (external) {
+                externalValues.emplace_back(propertyId, property.second);
+            } else {
+                require(property.second.size() < std::pow(2, UINT32_BITS_COUNT - 2));
+            }
+            patches.push_back(PropertyPatch { propertyId, &property.second, external });
+        }
+        std::sort(patches.begin(), patches.end(), [](const PropertyPatch& lhs, const PropertyPatch& rhs) {
+            return lhs.propertyId < rhs.propertyId;
+        });
+        return patches;
     }
 
-    Blob RecordParser::parseOnlyUpdateVersion(const storage_engine::lmdb::Result& rawData, VersionId versionId)
+    size_t RecordParser::getPatchedRawDataSize(const unsigned char* data,
+        size_t size,
+        size_t offset,
+        const PropertyPatches& patches,
+        RecordFormat recordFormat)
     {
-        require(!rawData.empty);
-        auto blob = rawData.data.blob();
-        blob.update(&versionId, 0, sizeof(VersionId));
-        return blob;
+        auto dataSize = size_t { 0 };
+        auto count = patches.size();
+        visitUnpatchedBlocks(data, size, offset, patches, [&](const unsigned char*, size_t blockSize) {
+            dataSize += blockSize;
+            ++count;
+        });
+        for (const auto& patch : patches) {
+            dataSize += (patch.external)
+                ? sizeof(PropertyId) + sizeof(uint32_t)
+                : getRawDataSize(patch.value->size());
+        }
+        if (dataSize == 0) {
+            return offset + SIZE_OF_EMPTY_STRING;
+        }
+        if (recordFormat == RecordFormat::V2) {
+            require(count < OFFSET_TABLE_PROPERTY_ID);
+            dataSize += OFFSET_TABLE_HEADER_LENGTH + count * OFFSET_TABLE_ENTRY_LENGTH;
+        }
+        return offset + dataSize;
     }
 
-    Blob RecordParser::parseOnlyUpdateSrcVertex(const storage_engine::lmdb::Result& rawData,
-        const RecordId& srcVertex,
-        bool enableVersion)
+    void RecordParser::writePatchedRawData(unsigned char* dst,
+        const unsigned char* data,
+        size_t size,
+        size_t offset,
+        const PropertyPatches& patches,
+        RecordFormat recordFormat)
     {
-        require(!rawData.empty);
-        auto blob = rawData.data.blob();
-        auto offset = (enableVersion) ? RECORD_VERSION_DATA_LENGTH : size_t { 0 };
-        blob.update(&srcVertex.first, offset, sizeof(ClassId));
-        blob.update(&srcVertex.second, offset + sizeof(ClassId), sizeof(PositionId));
-        return blob;
+        if (offset > 0) {
+            memcpy(dst, data, offset);
+        }
+        // the offset table is written once the blocks are, as it is sorted by property id
+        thread_local auto entries = std::vector<std::pair<PropertyId, uint32_t>> {};
+        entries.clear();
+        auto addEntry = [&](const unsigned char* block, size_t position) {
+            if (recordFormat == RecordFormat::V2) {
+                auto propertyId = PropertyId {};
+                memcpy(&propertyId, block, sizeof(PropertyId));
+                entries.emplace_back(propertyId, static_cast<uint32_t>(position - offset));
+            }
+        };
+        auto position = offset;
+        if (recordFormat == RecordFormat::V2) {
+            auto count = patches.size();
+            visitUnpatchedBlocks(data, size, offset, patches, [&](const unsigned char*, size_t) { ++count; });
+            position += OFFSET_TABLE_HEADER_LENGTH + count * OFFSET_TABLE_ENTRY_LENGTH;
+        }
+        auto blocksOffset = position;
+        visitUnpatchedBlocks(data, size, offset, patches, [&](const unsigned char* block, size_t blockSize) {
+            memcpy(dst + position, block, blockSize);
+            addEntry(dst + position, position);
+            position += blockSize;
+        });
+        for (const auto& patch : patches) {
+            auto blockSize = (patch.external)
+                ? writeExternalRawData(dst + position, patch.propertyId)
+                : writeRawData(dst + position, patch.propertyId, *patch.value);
+            addEntry(dst + position, position);
+            position += blockSize;
+        }
+        if (position == blocksOffset) {
+            // create an empty property as a raw data for a class
+            memcpy(dst + offset, EMPTY_STRING.c_str(), SIZE_OF_EMPTY_STRING);
+        } else if (recordFormat == RecordFormat::V2) {
+            std::sort(entries.begin(), entries.end());
+            auto marker = OFFSET_TABLE_PROPERTY_ID;
+            auto entryCount = static_cast<uint16_t>(entries.size());
+            memcpy(dst + offset, &marker, sizeof(PropertyId));
+            memcpy(dst + offset + sizeof(PropertyId), &entryCount, sizeof(uint16_t));
+            auto entryOffset = offset + OFFSET_TABLE_HEADER_LENGTH;
+            for (const auto& entry : entries) {
+                memcpy(dst + entryOffset, &entry.first, sizeof(PropertyId));
+                memcpy(dst + entryOffset + sizeof(PropertyId), &entry.second, sizeof(uint32_t));
+                entryOffset += OFFSET_TABLE_ENTRY_LENGTH;
+            }
+        }
     }
 
-    Blob RecordParser::parseOnlyUpdateDstVertex(const storage_engine::lmdb::Result& rawData,
-        const RecordId& dstVertex,
-        bool enableVersion)
+    RecordFormat RecordParser::getRecordFormat(const unsigned char* data, size_t size, size_t offset)
     {
-        require(!rawData.empty);
-        auto blob = rawData.data.blob();
-        auto offset = (enableVersion) ? RECORD_VERSION_DATA_LENGTH : size_t { 0 };
-        offset += sizeof(ClassId) + sizeof(PositionId);
-        blob.update(&dstVertex.first, offset, sizeof(ClassId));
-        blob.update(&dstVertex.second, offset + sizeof(ClassId), sizeof(PositionId));
-        return blob;
+        return (getBlocksOffset(data, size, offset) != offset) ? RecordFormat::V2 : RecordFormat::V1;
     }
 
-    Blob RecordParser::parseOnlyUpdateRecord(const storage_engine::lmdb::Result& rawData,
-        const Blob& newRecordBlob,
-        bool isEdge,
-        bool enableVersion)
+    size_t RecordParser::getBlocksOffset(const unsigned char* data, size_t size, size_t offset)
+    {
+        if (size < offset + OFFSET_TABLE_HEADER_LENGTH) {
+            return offset;
+        }
+        auto marker = PropertyId {};
+        memcpy(&marker, data + offset, sizeof(PropertyId));
+        if (marker != OFFSET_TABLE_PROPERTY_ID) {
+            return offset;
+        }
+        auto count = uint16_t {};
+        memcpy(&count, data + offset + sizeof(PropertyId), sizeof(uint16_t));
+        auto blocksOffset = offset + OFFSET_TABLE_HEADER_LENGTH + count * OFFSET_TABLE_ENTRY_LENGTH;
+        require(blocksOffset <= size);
+        return blocksOffset;
+    }
+
+    bool RecordParser::findRawProperty(const unsigned char* data,
+        size_t size,
+        size_t offset,
+        const PropertyId& propertyId,
+        const unsigned char*& value,
+        size_t& valueSize,
+        bool& external)
+    {
+        if (size == 0 || size - offset == 1 || size < 2 * sizeof(uint16_t)) {
+            return false;
+        }
+        auto blocksOffset = getBlocksOffset(data, size, offset);
+        if (blocksOffset == offset) {
+            auto found = false;
+            visitRawProperties(data, size, offset,
+                [&](const PropertyId& id, const unsigned char* blockValue, size_t blockValueSize, bool blockExternal) {
+                    if (id != propertyId) {
+                        return true;
+                    }
+                    value = blockValue;
+                    valueSize = blockValueSize;
+                    external = blockExternal;
+                    found = true;
+                    return false;
+                });
+            return found;
+        }
+        auto table = data + offset + OFFSET_TABLE_HEADER_LENGTH;
+        auto low = size_t { 0 };
+        auto high = (blocksOffset - offset - OFFSET_TABLE_HEADER_LENGTH) / OFFSET_TABLE_ENTRY_LENGTH;
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            auto id = PropertyId {};
+            memcpy(&id, table + middle * OFFSET_TABLE_ENTRY_LENGTH, sizeof(PropertyId));
+            if (id < propertyId) {
+                low = middle + 1;
+            } else if (propertyId < id) {
+                high = middle;
+            } else {
+                auto blockOffset = uint32_t {};
+                memcpy(&blockOffset, table + middle * OFFSET_TABLE_ENTRY_LENGTH + sizeof(PropertyId), sizeof(uint32_t));
+                require(offset + blockOffset + sizeof(PropertyId) < size);
+                auto blockId = PropertyId {};
+                auto valueOffset = readBlockHeader(data, size, offset + blockOffset, blockId, valueSize, external);
+                require(blockId == propertyId);
+                value = data + valueOffset;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t RecordParser::getHeaderSize(bool isEdge, bool enableVersion)
     {
-        require(!(rawData.empty && (isEdge || enableVersion)));
-        auto blob = (rawData.empty) ? Blob {} : rawData.data.blob();
         auto offset = size_t { 0 };
         offset += (isEdge) ? VERTEX_SRC_DST_RAW_DATA_LENGTH : size_t { 0 };
         offset += (enableVersion) ? RECORD_VERSION_DATA_LENGTH : size_t { 0 };
-        return blob.overwrite(newRecordBlob.bytes(), offset, newRecordBlob.size());
+        return offset;
+    }
+
+    void RecordParser::writeVersionId(unsigned char* data, VersionId versionId)
+    {
+        memcpy(data, &versionId, sizeof(VersionId));
+    }
+
+    void RecordParser::writeEdgeVertexSrc(unsigned char* data, const RecordId& srcVertex, bool enableVersion)
+    {
+        auto offset = (enableVersion) ? RECORD_VERSION_DATA_LENGTH : size_t { 0 };
+        memcpy(data + offset, &srcVertex.first, sizeof(ClassId));
+        memcpy(data + offset + sizeof(ClassId), &srcVertex.second, sizeof(PositionId));
+    }
+
+    void RecordParser::writeEdgeVertexDst(unsigned char* data, const RecordId& dstVertex, bool enableVersion)
+    {
+        auto offset = (enableVersion) ? RECORD_VERSION_DATA_LENGTH : size_t { 0 };
+        offset += sizeof(ClassId) + sizeof(PositionId);
+        memcpy(data + offset, &dstVertex.first, sizeof(ClassId));
+        memcpy(data + offset + sizeof(ClassId), &dstVertex.second, sizeof(PositionId));
     }
 
     Record RecordParser::parseRawData(const storage_engine::lmdb::Result& rawData,
-        const PropertyIdMapInfo& propertyInfos,
+        const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
         bool isEdge,
-        bool enableVersion)
+        bool enableVersion,
+        const storage_engine::LMDBTxn* txn,
+        const RecordId& rid)
+    {
+        return parseRawData(rawData, getHeaderSize(isEdge, enableVersion), propertyInfos, txn, rid);
+    }
+
+    Record RecordParser::parseRawData(const storage_engine::lmdb::Result& rawData,
+        size_t offset,
+        const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
+        const storage_engine::LMDBTxn* txn,
+        const RecordId& rid)
     {
         if (rawData.empty) {
             return Record {};
         }
-        Record::PropertyToBytesMap properties {};
-        auto rawDataBlob = rawData.data.blob();
-        auto offset = size_t { 0 };
-        offset += (isEdge) ? VERTEX_SRC_DST_RAW_DATA_LENGTH : size_t { 0 };
-        offset += (enableVersion) ? RECORD_VERSION_DATA_LENGTH : size_t { 0 };
-        if (rawDataBlob.capacity() == 0 || rawDataBlob.size() - offset == 1) {
-            return Record {};
-        } else if (rawDataBlob.capacity() >= 2 * sizeof(uint16_t)) {
-            /**
-             * NOTE: each property block consists of property id, flag, size, and value
-             * when option flag = 0
-             * +----------------------+--------------------+-----------------------+-----------+
-             * | propertyId (16bits)  | option flag (1bit) | propertySize (7bits)  |   value   | (next block) ...
-             * +----------------------+--------------------+-----------------------+-----------+
-             * when option flag = 1 (for extra large size of value)
-             * +----------------------+--------------------+------------------------+-----------+
-             * | propertyId (16bits)  | option flag (1bit) | propertySize (31bits)  |   value   | (next block) ...
-             * +----------------------+--------------------+------------------------+-----------+
-             */
-            while (offset < rawDataBlob.size()) {
-                auto propertyId = PropertyId {};
-                auto optionFlag = uint8_t {};
-                offset = rawDataBlob.retrieve(&propertyId, offset, sizeof(PropertyId));
-                rawDataBlob.retrieve(&optionFlag, offset, sizeof(optionFlag));
-                auto propertySize = size_t {};
-                if ((optionFlag & 0x1) == 1) {
-                    //extra large size of value (exceed 127 bytes)
-                    auto tmpSize = uint32_t {};
-                    offset = rawDataBlob.retrieve(&tmpSize, offset, sizeof(uint32_t));
-                    propertySize = static_cast<size_t>(tmpSize >> 1);
-                } else {
-                    //normal size of value (not exceed 127 bytes)
-                    auto tmpSize = uint8_t {};
-                    offset = rawDataBlob.retrieve(&tmpSize, offset, sizeof(uint8_t));
-                    propertySize = static_cast<size_t>(tmpSize >> 1);
+        auto data = rawData.data.data<unsigned char>();
+        auto size = rawData.data.size();
+        // locate each value in the property blocks, then copy the blocks once
+        auto blocksOffset = getBlocksOffset(data, size, offset);
+        auto flatProperties = std::vector<Record::FlatProperty> {};
+        auto externalIds = std::vector<PropertyId> {};
+        flatProperties.reserve(propertyInfos->size());
+        visitRawProperties(data, size, offset,
+            [&](const PropertyId& propertyId, const unsigned char* value, size_t valueSize, bool external) {
+                if (propertyInfos->find(propertyId) == propertyInfos->cend()) {
+                    return true;
                 }
-                auto foundInfo = propertyInfos.find(propertyId);
-                if (foundInfo != propertyInfos.cend()) {
-                    if (propertySize > 0) {
-                        Blob::Byte byteData[propertySize];
-                        offset = rawDataBlob.retrieve(byteData, offset, propertySize);
-                        properties[foundInfo->second.name] = Bytes { byteData, propertySize };
-                    } else {
-                        properties[foundInfo->second.name] = Bytes {};
+                if (external) {
+                    if (txn != nullptr) {
+                        externalIds.emplace_back(propertyId);
                     }
                 } else {
-                    offset += propertySize;
+                    flatProperties.push_back(Record::FlatProperty {
+                        propertyId, static_cast<uint32_t>(value - data - blocksOffset), static_cast<uint32_t>(valueSize) });
                 }
-            }
+                return true;
+            });
+        auto flatValues = std::vector<unsigned char> {};
+        if (!flatProperties.empty()) {
+            flatValues.assign(data + blocksOffset, data + size);
+        }
+        for (const auto& propertyId : externalIds) {
+            auto externalValue = getExternalValue(txn, rid, propertyId);
+            auto externalData = externalValue.data.data<unsigned char>();
+            flatProperties.push_back(Record::FlatProperty {
+                propertyId, static_cast<uint32_t>(flatValues.size()), static_cast<uint32_t>(externalValue.data.size()) });
+            flatValues.insert(flatValues.end(), externalData, externalData + externalValue.data.size());
         }
-        return Record(properties);
+        return Record(std::move(flatValues), std::move(flatProperties), propertyInfos);
     }
 
     Record RecordParser::parseRawData(const storage_engine::lmdb::Result& rawData,
-        const PropertyIdMapInfo& propertyInfos,
+        const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
+        const ClassType& classType,
+        bool enableVersion,
+        const storage_engine::LMDBTxn* txn,
+        const RecordId& rid)
+    {
+        return parseRawData(rawData, propertyInfos, classType == ClassType::EDGE, enableVersion, txn, rid);
+    }
+
+    bool RecordParser::hasExternalValues(const storage_engine::lmdb::Result& rawData,
         const ClassType& classType,
         bool enableVersion)
     {
-        return parseRawData(rawData, propertyInfos, classType == ClassType::EDGE, enableVersion);
+        if (rawData.empty) {
+            return false;
+        }
+        auto found = false;
+        visitRawProperties(rawData.data.data<unsigned char>(), rawData.data.size(),
+            getRawDataOffset(rawData, classType, enableVersion),
+            [&](const PropertyId&, const unsigned char*, size_t, bool external) {
+                found = external;
+                return !found;
+            });
+        return found;
+    }
+
+    storage_engine::lmdb::Result RecordParser::getExternalValue(const storage_engine::LMDBTxn* txn,
+        const RecordId& rid,
+        const PropertyId& propertyId)
+    {
+        auto result = DataValue(txn, rid.first).getResult(rid.second, propertyId);
+        require(!result.empty);
+        return result;
     }
 
-    Record RecordParser::parseRawDataWithBasicInfo(const std::string& className,
+    Record RecordParser::parseRawDataWithBasicInfo(const std::shared_ptr<const std::string>& className,
         const RecordId& rid,
         const storage_engine::lmdb::Result& rawData,
-        const PropertyIdMapInfo& propertyInfos,
+        const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
+        const ClassType& classType,
+        bool enableVersion,
+        const storage_engine::LMDBTxn* txn)
+    {
+        auto versionId = (enableVersion) ? parseRawDataVersionId(rawData) : VersionId { 0 };
+        auto record = parseRawData(rawData, propertyInfos, classType == ClassType::EDGE, versionId > 0, txn, rid);
+        // the basic info is only turned into bytes once it is read
+        record.setLazyBasicInfo(className, rid, 0U, versionId);
+        return record;
+    }
+
+    RecordView RecordParser::parseRawDataViewWithBasicInfo(const std::shared_ptr<const std::string>& className,
+        const RecordId& rid,
+        const storage_engine::lmdb::Result& rawData,
+        const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
+        const ClassType& classType,
+        bool enableVersion,
+        const storage_engine::LMDBTxn* txn)
+    {
+        if (rawData.empty) {
+            return RecordView { nullptr, 0, 0, propertyInfos, className, rid, VersionId { 0 }, txn };
+        }
+        auto versionId = (enableVersion) ? parseRawDataVersionId(rawData) : VersionId { 0 };
+        return RecordView {
+            rawData.data.data<unsigned char>(), rawData.data.size(), getRawDataOffset(rawData, classType, enableVersion),
+            propertyInfos, className, rid, versionId, txn,
+            rawData.buffer
+        };
+    }
+
+    size_t RecordParser::getRawDataOffset(const storage_engine::lmdb::Result& rawData,
         const ClassType& classType,
         bool enableVersion)
     {
+        if (rawData.empty) {
+            return size_t { 0 };
+        }
+        // a record written before versioning was enabled has no version id
         auto versionId = (enableVersion) ? parseRawDataVersionId(rawData) : VersionId { 0 };
-        return parseRawData(rawData, propertyInfos, classType == ClassType::EDGE, versionId > 0)
-            .setBasicInfoIfNotExists(CLASS_NAME_PROPERTY, className)
-            .setBasicInfoIfNotExists(RECORD_ID_PROPERTY, rid2str(rid))
-            .setBasicInfoIfNotExists(DEPTH_PROPERTY, 0U)
-            .setBasicInfoIfNotExists(VERSION_PROPERTY, versionId);
+        return getHeaderSize(classType == ClassType::EDGE, versionId > 0);
     }
 
     VersionId RecordParser::parseRawDataVersionId(const storage_engine::lmdb::Result& rawData)
     {
-        require(!rawData.data.empty());
-        auto blob = rawData.data.blob();
-        auto versionId = VersionId { 0 };
-        blob.retrieve(&versionId, 0, RECORD_VERSION_DATA_LENGTH);
-        return versionId;
+        require(rawData.data.size() >= RECORD_VERSION_DATA_LENGTH);
+        return rawData.data.numeric<VersionId>();
     }
 
     Blob RecordParser::parseEdgeVertexSrcDst(const RecordId& srcRid, const RecordId& dstRid)
@@ -267,18 +502,54 @@ namespace parser {
             auto size = static_cast<uint8_t>(rawData.size()) << 1;
             blob.append(&propertyId, sizeof(PropertyId));
             blob.append(&size, sizeof(uint8_t));
-            blob.append(static_cast<void*>(rawData.getRaw()), rawData.size());
+            blob.append(static_cast<const void*>(rawData.getConstRaw()), rawData.size());
         } else {
             auto size = (static_cast<uint32_t>(rawData.size()) << 1) + 0x1;
             blob.append(&propertyId, sizeof(PropertyId));
             blob.append(&size, sizeof(uint32_t));
-            blob.append(static_cast<void*>(rawData.getRaw()), rawData.size());
+            blob.append(static_cast<const void*>(rawData.getConstRaw()), rawData.size());
+        }
+    }
+
+    void RecordParser::buildExternalRawData(Blob& blob, const PropertyId& propertyId)
+    {
+        // an empty value in the extra large size form, flagged as stored out of line
+        auto size = EXTERNAL_VALUE_FLAG + 0x1;
+        blob.append(&propertyId, sizeof(PropertyId));
+        blob.append(&size, sizeof(uint32_t));
+    }
+
+    size_t RecordParser::writeRawData(unsigned char* dst, const PropertyId& propertyId, const Bytes& rawData)
+    {
+        auto offset = sizeof(PropertyId);
+        memcpy(dst, &propertyId, sizeof(PropertyId));
+        if (rawData.size() < std::pow(2, UINT8_BITS_COUNT - 1)) {
+            auto size = static_cast<uint8_t>(rawData.size() << 1);
+            memcpy(dst + offset, &size, sizeof(uint8_t));
+            offset += sizeof(uint8_t);
+        } else {
+            auto size = (static_cast<uint32_t>(rawData.size()) << 1) + 0x1;
+            memcpy(dst + offset, &size, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
         }
+        memcpy(dst + offset, rawData.getConstRaw(), rawData.size());
+        return offset + rawData.size();
+    }
+
+    size_t RecordParser::writeExternalRawData(unsigned char* dst, const PropertyId& propertyId)
+    {
+        auto size = EXTERNAL_VALUE_FLAG + 0x1;
+        memcpy(dst, &propertyId, sizeof(PropertyId));
+        memcpy(dst + sizeof(PropertyId), &size, sizeof(uint32_t));
+        return sizeof(PropertyId) + sizeof(uint32_t);
     }
 
     Blob RecordParser::parseRecord(const Record& record,
         const size_t dataSize,
-        const PropertyNameMapInfo& properties)
+        const PropertyNameMapInfo& properties,
+        size_t largeValueThreshold,
+        ExternalValues* externalValues,
+        RecordFormat recordFormat)
     {
         if (dataSize <= 0) {
             // create an empty property as a raw data for a class
@@ -286,8 +557,31 @@ namespace parser {
             value.append(EMPTY_STRING.c_str(), SIZE_OF_EMPTY_STRING);
             return value;
         } else {
-            // create properties as a raw data for a class
-            auto value = Blob(dataSize);
+            // create properties as a raw data for a class, behind the offset table of the v2 format
+            auto blockCount = size_t { 0 };
+            if (recordFormat == RecordFormat::V2) {
+                for (const auto& property : record.getAll()) {
+                    blockCount += (property.second.empty()) ? 0 : 1;
+                }
+                require(blockCount < OFFSET_TABLE_PROPERTY_ID);
+            }
+            auto tableSize = (recordFormat == RecordFormat::V2)
+                ? OFFSET_TABLE_HEADER_LENGTH + blockCount * OFFSET_TABLE_ENTRY_LENGTH
+                : size_t { 0 };
+            auto value = Blob(tableSize + dataSize);
+            // the entries are only known once the blocks are written, as they are sorted by property id
+            thread_local auto entries = std::vector<std::pair<PropertyId, uint32_t>> {};
+            entries.clear();
+            if (recordFormat == RecordFormat::V2) {
+                auto marker = OFFSET_TABLE_PROPERTY_ID;
+                auto entryCount = static_cast<uint16_t>(blockCount);
+                const unsigned char emptyEntry[OFFSET_TABLE_ENTRY_LENGTH] {};
+                value.append(&marker, sizeof(PropertyId));
+                value.append(&entryCount, sizeof(uint16_t));
+                for (auto i = size_t { 0 }; i < blockCount; ++i) {
+                    value.append(emptyEntry, OFFSET_TABLE_ENTRY_LENGTH);
+                }
+            }
             for (const auto& property : properties) {
                 if (!isNameValid(property.first))
                     continue;
@@ -296,9 +590,27 @@ namespace parser {
                 if (rawData.empty())
                     continue;
                 require(propertyId < std::pow(2, UINT16_BITS_COUNT));
-                require(rawData.size() < std::pow(2, UINT32_BITS_COUNT - 1));
+                if (recordFormat == RecordFormat::V2) {
+                    entries.emplace_back(propertyId, static_cast<uint32_t>(value.size()));
+                }
+                if (externalValues != nullptr && isExternal(property.second, rawData, largeValueThreshold)) {
+                    buildExternalRawData(value, propertyId);
+                    externalValues->emplace_back(propertyId, std::move(rawData));
+                    continue;
+                }
+                require(rawData.size() < std::pow(2, UINT32_BITS_COUNT - 2));
                 buildRawData(value, propertyId, rawData);
             }
+            if (recordFormat == RecordFormat::V2) {
+                require(entries.size() == blockCount);
+                std::sort(entries.begin(), entries.end());
+                auto entryOffset = OFFSET_TABLE_HEADER_LENGTH;
+                for (const auto& entry : entries) {
+                    value.update(&entry.first, entryOffset, sizeof(PropertyId));
+                    value.update(&entry.second, entryOffset + sizeof(PropertyId), sizeof(uint32_t));
+                    entryOffset += OFFSET_TABLE_ENTRY_LENGTH;
+                }
+            }
             return value;
         }
     }
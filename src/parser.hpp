@@ -21,8 +21,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -46,6 +49,27 @@ namespace parser {
 
     constexpr size_t VERTEX_SRC_DST_RAW_DATA_LENGTH = 2 * (sizeof(ClassId) + sizeof(PositionId));
     constexpr size_t RECORD_VERSION_DATA_LENGTH = sizeof(uint64_t);
+    constexpr uint32_t EXTERNAL_VALUE_FLAG = 0x80000000;
+    constexpr size_t OFFSET_TABLE_HEADER_LENGTH = sizeof(PropertyId) + sizeof(uint16_t);
+    constexpr size_t OFFSET_TABLE_ENTRY_LENGTH = sizeof(PropertyId) + sizeof(uint32_t);
+
+    /**
+     * Values of a record to be stored out of line, by property id.
+     */
+    typedef std::vector<std::pair<PropertyId, Bytes>> ExternalValues;
+
+    /**
+     * A new value of a property of an existing record, which is only referred to by its block in the
+     * record when the value is stored out of line.
+     */
+    struct PropertyPatch {
+        PropertyId propertyId;
+        const Bytes* value;
+        bool external;
+    };
+
+    // sorted by property id
+    typedef std::vector<PropertyPatch> PropertyPatches;
 
     class RecordParser {
     public:
@@ -58,39 +82,170 @@ namespace parser {
         //-------------------------
         static Blob parseRecord(const Record& record, const PropertyNameMapInfo& properties);
 
+        /**
+         * Same as above, but a TEXT or BLOB value larger than the threshold is moved to the external values,
+         * and only a reference to it is written in the record. A threshold of 0 keeps every value in the record.
+         */
+        static Blob parseRecord(const Record& record,
+            const PropertyNameMapInfo& properties,
+            size_t largeValueThreshold,
+            ExternalValues& externalValues,
+            RecordFormat recordFormat = RecordFormat::V1);
+
+        /**
+         * The record keeps its values flat in a single buffer, and shares the property table of its class.
+         * Values stored out of line are fetched with the transaction from the values of the class of
+         * the record, or left out of the result when the transaction is nullptr. They are all fetched here,
+         * since the record may outlive the transaction; only a RecordView fetches them as they are read.
+         */
         static Record parseRawData(const storage_engine::lmdb::Result& rawData,
-            const PropertyIdMapInfo& propertyInfos,
+            const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
             bool isEdge,
-            bool enableVersion);
+            bool enableVersion,
+            const storage_engine::LMDBTxn* txn,
+            const RecordId& rid);
 
+        // only the properties of the table are decoded from the blocks, starting at the offset
         static Record parseRawData(const storage_engine::lmdb::Result& rawData,
-            const PropertyIdMapInfo& propertyInfos,
-            const ClassType& classType,
-            bool enableVersion);
-
-        static Blob& parseOnlyUpdateVersion(Blob& blob, VersionId versionId);
+            size_t offset,
+            const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
+            const storage_engine::LMDBTxn* txn,
+            const RecordId& rid);
 
-        static Blob parseOnlyUpdateVersion(const storage_engine::lmdb::Result& rawData, VersionId versionId);
+        static Record parseRawData(const storage_engine::lmdb::Result& rawData,
+            const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
+            const ClassType& classType,
+            bool enableVersion,
+            const storage_engine::LMDBTxn* txn,
+            const RecordId& rid);
 
-        static Blob parseOnlyUpdateSrcVertex(const storage_engine::lmdb::Result& rawData,
-            const RecordId& srcVertex,
+        static bool hasExternalValues(const storage_engine::lmdb::Result& rawData,
+            const ClassType& classType,
             bool enableVersion);
 
-        static Blob parseOnlyUpdateDstVertex(const storage_engine::lmdb::Result& rawData,
-            const RecordId& dstVertex,
-            bool enableVersion);
+        static storage_engine::lmdb::Result getExternalValue(const storage_engine::LMDBTxn* txn,
+            const RecordId& rid,
+            const PropertyId& propertyId);
 
-        static Blob parseOnlyUpdateRecord(const storage_engine::lmdb::Result& rawData,
-            const Blob& newRecordBlob,
-            bool isEdge,
-            bool enableVersion);
+        static Record parseRawDataWithBasicInfo(const std::shared_ptr<const std::string>& className,
+            const RecordId& rid,
+            const storage_engine::lmdb::Result& rawData,
+            const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
+            const ClassType& classType,
+            bool enableVersion,
+            const storage_engine::LMDBTxn* txn);
 
-        static Record parseRawDataWithBasicInfo(const std::string& className,
+        static RecordView parseRawDataViewWithBasicInfo(const std::shared_ptr<const std::string>& className,
             const RecordId& rid,
             const storage_engine::lmdb::Result& rawData,
-            const PropertyIdMapInfo& propertyInfos,
+            const std::shared_ptr<const PropertyIdMapInfo>& propertyInfos,
+            const ClassType& classType,
+            bool enableVersion,
+            const storage_engine::LMDBTxn* txn);
+
+        /**
+         * Visit each property block of a raw record, starting at the offset, without copying its value.
+         * The visitor is called with a property id, a pointer to its value, its size and whether the value
+         * is stored out of line, in which case the block has no value, and returns false to stop visiting.
+         * NOTE: each property block consists of property id, flag, size, and value
+         * when option flag = 0
+         * +----------------------+--------------------+-----------------------+-----------+
+         * | propertyId (16bits)  | option flag (1bit) | propertySize (7bits)  |   value   | (next block) ...
+         * +----------------------+--------------------+-----------------------+-----------+
+         * when option flag = 1 (for extra large size of value)
+         * +----------------------+--------------------+------------------------+-----------+
+         * | propertyId (16bits)  | option flag (1bit) | propertySize (31bits)  |   value   | (next block) ...
+         * +----------------------+--------------------+------------------------+-----------+
+         * where the highest bit of propertySize marks a value stored out of line, see DataValue.
+         * A record in the V2 format has an offset table ahead of its blocks, see getBlocksOffset().
+         */
+        template <typename Visitor>
+        static void visitRawProperties(const unsigned char* data, size_t size, size_t offset, Visitor&& visitor)
+        {
+            // a record without any property is stored as a single byte after its header
+            if (size == 0 || size - offset == 1 || size < 2 * sizeof(uint16_t)) {
+                return;
+            }
+            offset = getBlocksOffset(data, size, offset);
+            while (offset + sizeof(PropertyId) < size) {
+                auto propertyId = PropertyId {};
+                auto propertySize = size_t {};
+                auto external = false;
+                offset = readBlockHeader(data, size, offset, propertyId, propertySize, external);
+                if (!visitor(propertyId, data + offset, propertySize, external)) {
+                    return;
+                }
+                offset += propertySize;
+            }
+        }
+
+        /**
+         * Locate the block of a property in a raw record, starting at the offset, by a binary search of
+         * the offset table of a record in the V2 format, or by visiting its blocks otherwise.
+         */
+        static bool findRawProperty(const unsigned char* data,
+            size_t size,
+            size_t offset,
+            const PropertyId& propertyId,
+            const unsigned char*& value,
+            size_t& valueSize,
+            bool& external);
+
+        static RecordFormat getRecordFormat(const unsigned char* data, size_t size, size_t offset);
+
+        /**
+         * Offset of the first property block of a raw record, starting at the offset, which skips the offset
+         * table of a record in the V2 format:
+         * +---------------------+---------------+----------------------+----------------+-----+-----------+
+         * | marker id (16bits)  | count (16bits) | propertyId (16bits) | offset (32bits) | ... |  blocks   |
+         * +---------------------+---------------+----------------------+----------------+-----+-----------+
+         * where the marker is a property id never given to a property, the entries are sorted by property id,
+         * and each offset is that of the block of the property from the offset of the record.
+         */
+        static size_t getBlocksOffset(const unsigned char* data, size_t size, size_t offset);
+        //-------------------------
+        // In place writers
+        //-------------------------
+        /**
+         * Non-empty values of a record as patches of its properties, where a TEXT or BLOB value larger than
+         * the threshold is also moved to the external values, as in parseRecord().
+         */
+        static PropertyPatches parsePatches(const Record& record,
+            const PropertyNameMapInfo& properties,
+            size_t largeValueThreshold,
+            ExternalValues& externalValues);
+
+        /**
+         * Size of a raw record made of the header and the property blocks of the previous one, starting
+         * at the offset, except those of the patched properties, which are written with their new values.
+         */
+        static size_t getPatchedRawDataSize(const unsigned char* data,
+            size_t size,
+            size_t offset,
+            const PropertyPatches& patches,
+            RecordFormat recordFormat = RecordFormat::V1);
+
+        // dst must hold getPatchedRawDataSize() bytes and must not overlap the previous record
+        static void writePatchedRawData(unsigned char* dst,
+            const unsigned char* data,
+            size_t size,
+            size_t offset,
+            const PropertyPatches& patches,
+            RecordFormat recordFormat = RecordFormat::V1);
+
+        static size_t getHeaderSize(bool isEdge, bool enableVersion);
+
+        // size of the header of a raw record, which has a version id only once versioning is enabled
+        static size_t getRawDataOffset(const storage_engine::lmdb::Result& rawData,
             const ClassType& classType,
             bool enableVersion);
+
+        static void writeVersionId(unsigned char* data, VersionId versionId);
+
+        static void writeEdgeVertexSrc(unsigned char* data, const RecordId& srcVertex, bool enableVersion);
+
+        static void writeEdgeVertexDst(unsigned char* data, const RecordId& dstVertex, bool enableVersion);
+
         //-------------------------
         // Version Id parsers
         //-------------------------
@@ -115,9 +270,74 @@ namespace parser {
     private:
         static void buildRawData(Blob& blob, const PropertyId& propertyId, const Bytes& rawData);
 
+        static void buildExternalRawData(Blob& blob, const PropertyId& propertyId);
+
+        static size_t writeRawData(unsigned char* dst, const PropertyId& propertyId, const Bytes& rawData);
+
+        static size_t writeExternalRawData(unsigned char* dst, const PropertyId& propertyId);
+
+        // reads the property id and the size of the value of a block, and returns the offset of the value
+        inline static size_t readBlockHeader(const unsigned char* data,
+            size_t size,
+            size_t offset,
+            PropertyId& propertyId,
+            size_t& propertySize,
+            bool& external)
+        {
+            memcpy(&propertyId, data + offset, sizeof(PropertyId));
+            offset += sizeof(PropertyId);
+            if ((data[offset] & 0x1) == 1) {
+                //extra large size of value (exceed 127 bytes)
+                auto tmpSize = uint32_t {};
+                memcpy(&tmpSize, data + offset, sizeof(uint32_t));
+                offset += sizeof(uint32_t);
+                external = (tmpSize & EXTERNAL_VALUE_FLAG) != 0;
+                propertySize = static_cast<size_t>((tmpSize & ~EXTERNAL_VALUE_FLAG) >> 1);
+            } else {
+                //normal size of value (not exceed 127 bytes)
+                external = false;
+                propertySize = static_cast<size_t>(data[offset] >> 1);
+                offset += sizeof(uint8_t);
+            }
+            utils::assertion::require(offset + propertySize <= size);
+            return offset;
+        }
+
+        // calls the visitor with each property block of a raw record which is not patched and its size
+        template <typename Visitor>
+        static void visitUnpatchedBlocks(const unsigned char* data,
+            size_t size,
+            size_t offset,
+            const PropertyPatches& patches,
+            Visitor&& visitor)
+        {
+            auto begin = getBlocksOffset(data, size, offset);
+            visitRawProperties(data, size, offset,
+                [&](const PropertyId& propertyId, const unsigned char* value, size_t valueSize, bool) {
+                    auto end = static_cast<size_t>(value - data) + valueSize;
+                    auto patch = std::lower_bound(patches.cbegin(), patches.cend(), propertyId,
+                        [](const PropertyPatch& patch, const PropertyId& id) { return patch.propertyId < id; });
+                    if (patch == patches.cend() || patch->propertyId != propertyId) {
+                        visitor(data + begin, end - begin);
+                    }
+                    begin = end;
+                    return true;
+                });
+        }
+
         static Blob parseRecord(const Record& record,
             const size_t dataSize,
-            const PropertyNameMapInfo& properties);
+            const PropertyNameMapInfo& properties,
+            size_t largeValueThreshold,
+            ExternalValues* externalValues,
+            RecordFormat recordFormat);
+
+        inline static bool isExternal(const PropertyAccessInfo& propertyInfo, const Bytes& value, size_t largeValueThreshold)
+        {
+            return largeValueThreshold > 0
+                && value.size() > largeValueThreshold
+                && (propertyInfo.type == PropertyType::TEXT || propertyInfo.type == PropertyType::BLOB);
+        }
 
         inline static size_t getRawDataSize(size_t size)
         {
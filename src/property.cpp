@@ -58,10 +58,10 @@ const PropertyDescriptor Transaction::addProperty(const std::string& className,
         SchemaUtils::invalidateCache(this);
         return PropertyDescriptor { propertyProps.id, propertyName, type, false };
     } catch (const Error& err) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(err);
     } catch (...) {
-        rollback();
+        rollbackOnError();
         std::rethrow_exception(std::current_exception());
     }
 }
@@ -86,10 +86,10 @@ void Transaction::renameProperty(const std::string& className,
         _adapter->dbProperty()->alterPropertyName(foundClass.id, oldPropertyName, newPropertyName);
         SchemaUtils::invalidateCache(this);
     } catch (const Error& err) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(err);
     } catch (...) {
-        rollback();
+        rollbackOnError();
         std::rethrow_exception(std::current_exception());
     }
 }
@@ -114,10 +114,10 @@ void Transaction::dropProperty(const std::string& className, const std::string&
         _adapter->dbInfo()->setNumPropertyId(_adapter->dbInfo()->getNumPropertyId() - PropertyId { 1 });
         SchemaUtils::invalidateCache(this);
     } catch (const Error& err) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(err);
     } catch (...) {
-        rollback();
+        rollbackOnError();
         std::rethrow_exception(std::current_exception());
     }
 }
@@ -162,11 +162,11 @@ const IndexDescriptor Transaction::addIndex(const std::string& className,
         if (err.code() == MDB_KEYEXIST) {
             throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_INVALID_INDEX_CONSTRAINT);
         } else {
-            rollback();
+            rollbackOnError();
             throw NOGDB_FATAL_ERROR(err);
         }
     } catch (...) {
-        rollback();
+        rollbackOnError();
         std::rethrow_exception(std::current_exception());
     }
 }
@@ -193,10 +193,10 @@ void Transaction::dropIndex(const std::string& className, const std::string& pro
         _adapter->dbInfo()->setNumIndexId(_adapter->dbInfo()->getNumIndexId() - IndexId { 1 });
         SchemaUtils::invalidateCache(this);
     } catch (const Error& err) {
-        rollback();
+        rollbackOnError();
         throw NOGDB_FATAL_ERROR(err);
     } catch (...) {
-        rollback();
+        rollbackOnError();
         std::rethrow_exception(std::current_exception());
     }
 }
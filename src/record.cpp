@@ -21,8 +21,10 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <mutex>
 
 #include "constant.hpp"
+#include "parser.hpp"
 #include "validate.hpp"
 #include "utils.hpp"
 
@@ -31,142 +33,281 @@
 
 namespace nogdb {
 
+namespace {
+    // the lazy fills of records are serialized by a lock picked from their address
+    std::mutex& fillMutex(const Record* record)
+    {
+        static std::mutex mutexes[64];
+        return mutexes[(reinterpret_cast<uintptr_t>(record) / sizeof(void*)) % 64];
+    }
+}
+
+Record::Record(const Record& other)
+{
+    // a const record may be filled by another thread while it is copied
+    auto lock = other.isPending() ? std::unique_lock<std::mutex>(fillMutex(&other)) : std::unique_lock<std::mutex> {};
+    properties = other.properties;
+    basicProperties = other.basicProperties;
+    lazyBasicInfo = other.lazyBasicInfo;
+    hasLazyBasicInfo.store(other.hasLazyBasicInfo.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    flatValues = other.flatValues;
+    flatProperties = other.flatProperties;
+    propertyInfos = other.propertyInfos;
+    mapped.store(other.mapped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+Record& Record::operator=(const Record& other)
+{
+    if (this != &other) {
+        auto copied = Record { other };
+        *this = std::move(copied);
+    }
+    return *this;
+}
+
+Record::Record(Record&& other) noexcept
+    : properties(std::move(other.properties))
+    , basicProperties(std::move(other.basicProperties))
+    , lazyBasicInfo(std::move(other.lazyBasicInfo))
+    , hasLazyBasicInfo { other.hasLazyBasicInfo.load(std::memory_order_relaxed) }
+    , flatValues(std::move(other.flatValues))
+    , flatProperties(std::move(other.flatProperties))
+    , propertyInfos(std::move(other.propertyInfos))
+    , mapped { other.mapped.load(std::memory_order_relaxed) }
+{
+    other.hasLazyBasicInfo.store(false, std::memory_order_relaxed);
+    other.mapped.store(false, std::memory_order_relaxed);
+}
+
+Record& Record::operator=(Record&& other) noexcept
+{
+    if (this != &other) {
+        properties = std::move(other.properties);
+        basicProperties = std::move(other.basicProperties);
+        lazyBasicInfo = std::move(other.lazyBasicInfo);
+        hasLazyBasicInfo.store(other.hasLazyBasicInfo.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        flatValues = std::move(other.flatValues);
+        flatProperties = std::move(other.flatProperties);
+        propertyInfos = std::move(other.propertyInfos);
+        mapped.store(other.mapped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.hasLazyBasicInfo.store(false, std::memory_order_relaxed);
+        other.mapped.store(false, std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+bool Record::isPending() const
+{
+    return hasLazyBasicInfo.load(std::memory_order_acquire) || (propertyInfos && !mapped.load(std::memory_order_acquire));
+}
+
 const Record::PropertyToBytesMap& Record::getAll() const
 {
-    return properties;
+    return map();
 }
 
 const Record::PropertyToBytesMap& Record::getBasicInfo() const
 {
+    return basicInfo();
+}
+
+const Record::PropertyToBytesMap& Record::basicInfo() const
+{
+    if (hasLazyBasicInfo.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(fillMutex(this));
+        if (hasLazyBasicInfo.load(std::memory_order_relaxed)) {
+            setBasicInfoIfNotExists(CLASS_NAME_PROPERTY, *lazyBasicInfo.className)
+                .setBasicInfoIfNotExists(RECORD_ID_PROPERTY, rid2str(lazyBasicInfo.rid))
+                .setBasicInfoIfNotExists(DEPTH_PROPERTY, lazyBasicInfo.depth)
+                .setBasicInfoIfNotExists(VERSION_PROPERTY, lazyBasicInfo.version);
+            hasLazyBasicInfo.store(false, std::memory_order_release);
+        }
+    }
     return basicProperties;
 }
 
+bool Record::isLazyBasicInfo(const std::string& propName) const
+{
+    if (!hasLazyBasicInfo.load(std::memory_order_acquire)) {
+        return false;
+    }
+    // the map of basic info may be being filled by another thread
+    std::lock_guard<std::mutex> lock(fillMutex(this));
+    return hasLazyBasicInfo.load(std::memory_order_relaxed) && basicProperties.find(propName) == basicProperties.cend();
+}
+
+Record& Record::setLazyBasicInfo(std::shared_ptr<const std::string> className, const RecordId& rid, uint32_t depth,
+    uint64_t version)
+{
+    lazyBasicInfo = LazyBasicInfo { std::move(className), rid, depth, version };
+    hasLazyBasicInfo.store(true, std::memory_order_relaxed);
+    return *this;
+}
+
+const Record::PropertyToBytesMap& Record::map() const
+{
+    if (propertyInfos && !mapped.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(fillMutex(this));
+        if (!mapped.load(std::memory_order_relaxed)) {
+            for (const auto& property : flatProperties) {
+                auto foundInfo = propertyInfos->find(property.id);
+                if (foundInfo != propertyInfos->cend()) {
+                    properties[foundInfo->second.name] = (property.size > 0)
+                        ? Bytes { flatValues.data() + property.offset, property.size }
+                        : Bytes {};
+                }
+            }
+            mapped.store(true, std::memory_order_release);
+        }
+    }
+    return properties;
+}
+
+void Record::unflatten()
+{
+    map();
+    flatValues = std::vector<unsigned char> {};
+    flatProperties = std::vector<FlatProperty> {};
+    propertyInfos = nullptr;
+    mapped.store(false, std::memory_order_relaxed);
+}
+
+bool Record::find(const std::string& propName, const unsigned char*& value, size_t& size) const
+{
+    if (propertyInfos && !isBasicInfo(propName)) {
+        auto foundId = propertyInfos->ids().find(propName);
+        if (foundId == propertyInfos->ids().cend()) {
+            return false;
+        }
+        for (const auto& property : flatProperties) {
+            if (property.id == foundId->second) {
+                value = flatValues.data() + property.offset;
+                size = property.size;
+                return true;
+            }
+        }
+        return false;
+    }
+    const auto& prop = (isBasicInfo(propName) ? basicInfo() : properties);
+    auto it = prop.find(propName);
+    if (it == prop.cend()) {
+        return false;
+    }
+    value = it->second.getConstRaw();
+    size = it->second.size();
+    return true;
+}
+
 Bytes Record::get(const std::string& propName) const
 {
-    const PropertyToBytesMap& prop = (isBasicInfo(propName) ? basicProperties : properties);
-    const PropertyToBytesMap::const_iterator it = prop.find(propName);
-    return it == prop.cend() ? Bytes {} : it->second;
+    auto value = static_cast<const unsigned char*>(nullptr);
+    auto size = size_t { 0 };
+    return (find(propName, value, size) && size > 0) ? Bytes { value, size } : Bytes {};
 }
 
 std::vector<std::string> Record::getProperties() const
 {
     auto propertyNames = std::vector<std::string> {};
+    if (propertyInfos) {
+        // the ids by name are already in the order of the names
+        for (const auto& propertyId : propertyInfos->ids()) {
+            if (std::any_of(flatProperties.cbegin(), flatProperties.cend(),
+                    [&](const FlatProperty& property) { return property.id == propertyId.second; })) {
+                propertyNames.emplace_back(propertyId.first);
+            }
+        }
+        return propertyNames;
+    }
     for (const auto& property : properties) {
         propertyNames.emplace_back(property.first);
     }
     return propertyNames;
 }
 
-uint8_t Record::getTinyIntU(const std::string& propName) const
+template <typename T>
+T Record::getNumeric(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
+    auto value = static_cast<const unsigned char*>(nullptr);
+    auto size = size_t { 0 };
+    if (!find(propName, value, size) || size == 0) {
         throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
-    } else {
-        return bytes.toTinyIntU();
     }
+    auto result = T {};
+    memcpy(&result, value, std::min(size, sizeof(T)));
+    return result;
+}
+
+uint8_t Record::getTinyIntU(const std::string& propName) const
+{
+    return getNumeric<uint8_t>(propName);
 }
 
 int8_t Record::getTinyInt(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
-        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
-    } else {
-        return bytes.toTinyInt();
-    }
+    return getNumeric<int8_t>(propName);
 }
 
 uint16_t Record::getSmallIntU(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
-        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
-    } else {
-        return bytes.toSmallIntU();
-    }
+    return getNumeric<uint16_t>(propName);
 }
 
 int16_t Record::getSmallInt(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
-        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
-    } else {
-        return bytes.toSmallInt();
-    }
+    return getNumeric<int16_t>(propName);
 }
 
 uint32_t Record::getIntU(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
-        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
-    } else {
-        return bytes.toIntU();
-    }
+    return getNumeric<uint32_t>(propName);
 }
 
 int32_t Record::getInt(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
-        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
-    } else {
-        return bytes.toInt();
-    }
+    return getNumeric<int32_t>(propName);
 }
 
 uint64_t Record::getBigIntU(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
-        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
-    } else {
-        return bytes.toBigIntU();
-    }
+    return getNumeric<uint64_t>(propName);
 }
 
 int64_t Record::getBigInt(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
-        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
-    } else {
-        return bytes.toBigInt();
-    }
+    return getNumeric<int64_t>(propName);
 }
 
 double Record::getReal(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
-        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
-    } else {
-        return bytes.toReal();
-    }
+    return getNumeric<double>(propName);
 }
 
 std::string Record::getText(const std::string& propName) const
 {
-    auto bytes = get(propName);
-    if (bytes.empty()) {
+    auto value = static_cast<const unsigned char*>(nullptr);
+    auto size = size_t { 0 };
+    if (!find(propName, value, size) || size == 0) {
         return "";
-    } else {
-        return bytes.toText();
     }
+    return std::string(reinterpret_cast<const char*>(value), size);
 }
 
 std::string Record::getClassName() const
 {
+    if (isLazyBasicInfo(CLASS_NAME_PROPERTY)) {
+        return *lazyBasicInfo.className;
+    }
     return getText(CLASS_NAME_PROPERTY);
 }
 
 RecordId Record::getRecordId() const
 {
+    if (isLazyBasicInfo(RECORD_ID_PROPERTY)) {
+        return lazyBasicInfo.rid;
+    }
     auto ridAsString = getText(RECORD_ID_PROPERTY);
     auto sp = utils::string::split(ridAsString, ':');
-    if (sp.size() != 2) {
+    if (sp.size() == 2) {
         try {
             auto classId = strtoul(sp[0].c_str(), nullptr, 0);
             auto positionId = strtoul(sp[1].c_str(), nullptr, 0);
@@ -182,31 +323,49 @@ RecordId Record::getRecordId() const
 
 uint32_t Record::getDepth() const
 {
+    if (isLazyBasicInfo(DEPTH_PROPERTY)) {
+        return lazyBasicInfo.depth;
+    }
     return getIntU(DEPTH_PROPERTY);
 }
 
 uint64_t Record::getVersion() const
 {
+    if (isLazyBasicInfo(VERSION_PROPERTY)) {
+        return lazyBasicInfo.version;
+    }
     return getBigIntU(VERSION_PROPERTY);
 }
 
 void Record::unset(const std::string& propName)
 {
-    (isBasicInfo(propName) ? basicProperties : properties).erase(propName);
+    if (isBasicInfo(propName)) {
+        basicInfo();
+        basicProperties.erase(propName);
+    } else {
+        unflatten();
+        properties.erase(propName);
+    }
 }
 
 size_t Record::size() const
 {
+    if (propertyInfos) {
+        return static_cast<size_t>(std::count_if(flatProperties.cbegin(), flatProperties.cend(),
+            [this](const FlatProperty& property) { return propertyInfos->find(property.id) != propertyInfos->cend(); }));
+    }
     return properties.size();
 }
 
 bool Record::empty() const
 {
-    return properties.empty();
+    return size() == 0;
 }
 
 void Record::clear()
 {
+    unflatten();
+    hasLazyBasicInfo.store(false, std::memory_order_relaxed);
     basicProperties.clear();
     properties.clear();
 }
@@ -224,4 +383,212 @@ Record::Record(PropertyToBytesMap properties)
     }
 }
 
-}
\ No newline at end of file
+Bytes RecordView::get(const std::string& propName) const
+{
+    if (!propName.empty() && propName.at(0) == '@') {
+        if (propName == CLASS_NAME_PROPERTY) {
+            return Bytes::toBytes(getClassName());
+        } else if (propName == RECORD_ID_PROPERTY) {
+            return Bytes::toBytes(rid2str(_rid));
+        } else if (propName == DEPTH_PROPERTY) {
+            return Bytes::toBytes(_depth);
+        } else if (propName == VERSION_PROPERTY) {
+            return Bytes::toBytes(_version);
+        }
+        return Bytes {};
+    }
+    auto value = static_cast<const unsigned char*>(nullptr);
+    auto size = size_t { 0 };
+    return (find(propName, value, size) && size > 0) ? Bytes { value, size } : Bytes {};
+}
+
+template <typename T>
+T RecordView::getNumeric(const std::string& propName) const
+{
+    if (!propName.empty() && propName.at(0) == '@') {
+        auto bytes = get(propName);
+        if (bytes.empty()) {
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
+        }
+        return bytes.convert<T>();
+    }
+    auto value = static_cast<const unsigned char*>(nullptr);
+    auto size = size_t { 0 };
+    if (!find(propName, value, size) || size == 0) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_PROPERTY);
+    }
+    auto result = T {};
+    memcpy(&result, value, std::min(size, sizeof(T)));
+    return result;
+}
+
+uint8_t RecordView::getTinyIntU(const std::string& propName) const
+{
+    return getNumeric<uint8_t>(propName);
+}
+
+int8_t RecordView::getTinyInt(const std::string& propName) const
+{
+    return getNumeric<int8_t>(propName);
+}
+
+uint16_t RecordView::getSmallIntU(const std::string& propName) const
+{
+    return getNumeric<uint16_t>(propName);
+}
+
+int16_t RecordView::getSmallInt(const std::string& propName) const
+{
+    return getNumeric<int16_t>(propName);
+}
+
+uint32_t RecordView::getIntU(const std::string& propName) const
+{
+    return getNumeric<uint32_t>(propName);
+}
+
+int32_t RecordView::getInt(const std::string& propName) const
+{
+    return getNumeric<int32_t>(propName);
+}
+
+uint64_t RecordView::getBigIntU(const std::string& propName) const
+{
+    return getNumeric<uint64_t>(propName);
+}
+
+int64_t RecordView::getBigInt(const std::string& propName) const
+{
+    return getNumeric<int64_t>(propName);
+}
+
+double RecordView::getReal(const std::string& propName) const
+{
+    return getNumeric<double>(propName);
+}
+
+std::string RecordView::getText(const std::string& propName) const
+{
+    if (!propName.empty() && propName.at(0) == '@') {
+        return get(propName).toText();
+    }
+    auto value = static_cast<const unsigned char*>(nullptr);
+    auto size = size_t { 0 };
+    if (!find(propName, value, size) || size == 0) {
+        return "";
+    }
+    return std::string(reinterpret_cast<const char*>(value), size);
+}
+
+std::vector<std::string> RecordView::getProperties() const
+{
+    auto propertyNames = std::vector<std::string> {};
+    if (_propertyInfos) {
+        auto propertyIds = std::vector<PropertyId> {};
+        parser::RecordParser::visitRawProperties(_data, _size, _offset,
+            [&](const PropertyId& propertyId, const unsigned char*, size_t, bool) {
+                propertyIds.emplace_back(propertyId);
+                return true;
+            });
+        // the ids by name are already in the order of the names
+        for (const auto& propertyId : _propertyInfos->ids()) {
+            if (std::find(propertyIds.cbegin(), propertyIds.cend(), propertyId.second) != propertyIds.cend()) {
+                propertyNames.emplace_back(propertyId.first);
+            }
+        }
+    }
+    return propertyNames;
+}
+
+std::string RecordView::getClassName() const
+{
+    return _className ? *_className : std::string {};
+}
+
+RecordId RecordView::getRecordId() const
+{
+    return _rid;
+}
+
+uint32_t RecordView::getDepth() const
+{
+    return _depth;
+}
+
+uint64_t RecordView::getVersion() const
+{
+    return _version;
+}
+
+size_t RecordView::size() const
+{
+    return getProperties().size();
+}
+
+bool RecordView::empty() const
+{
+    return size() == 0;
+}
+
+Record RecordView::toRecord() const
+{
+    auto properties = Record::PropertyToBytesMap {};
+    if (_propertyInfos) {
+        parser::RecordParser::visitRawProperties(_data, _size, _offset,
+            [&](const PropertyId& propertyId, const unsigned char* value, size_t size, bool external) {
+                auto foundInfo = _propertyInfos->find(propertyId);
+                if (foundInfo == _propertyInfos->cend()) {
+                    return true;
+                }
+                if (external) {
+                    if (_txn != nullptr) {
+                        auto externalValue = parser::RecordParser::getExternalValue(_txn, _rid, propertyId);
+                        properties[foundInfo->second.name] = Bytes {
+                            externalValue.data.data<unsigned char>(), externalValue.data.size()
+                        };
+                    }
+                } else {
+                    properties[foundInfo->second.name] = (size > 0) ? Bytes { value, size } : Bytes {};
+                }
+                return true;
+            });
+    }
+    auto record = Record(std::move(properties));
+    if (_className) {
+        record.setLazyBasicInfo(_className, _rid, _depth, _version);
+    }
+    return record;
+}
+
+bool RecordView::find(const std::string& propName, const unsigned char*& value, size_t& size) const
+{
+    if (_data == nullptr || !_propertyInfos) {
+        return false;
+    }
+    auto foundId = _propertyInfos->ids().find(propName);
+    if (foundId == _propertyInfos->ids().cend()) {
+        return false;
+    }
+    auto propertyId = foundId->second;
+    auto data = static_cast<const unsigned char*>(nullptr);
+    auto dataSize = size_t { 0 };
+    auto external = false;
+    if (!parser::RecordParser::findRawProperty(_data, _size, _offset, propertyId, data, dataSize, external)) {
+        return false;
+    }
+    if (external) {
+        if (_txn == nullptr) {
+            return false;
+        }
+        // the value stays in the memory of the database until the transaction is completed
+        auto externalValue = parser::RecordParser::getExternalValue(_txn, _rid, propertyId);
+        value = externalValue.data.data<unsigned char>();
+        size = externalValue.data.size();
+    } else {
+        value = data;
+        size = dataSize;
+    }
+    return true;
+}
+
+}
@@ -76,6 +76,11 @@ namespace relation {
 
         std::pair<RecordId, RecordId> getSrcDstVertices(const RecordId& recordId) const;
 
+        void clearCache() noexcept
+        {
+            _edgeDataRecordCache.clear();
+        }
+
     private:
         const storage_engine::LMDBTxn* _txn;
         std::unique_ptr<RelationAccess> _inRel;
@@ -22,9 +22,11 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "constant.hpp"
 #include "storage_adapter.hpp"
@@ -44,7 +46,7 @@ namespace relation {
 
     /**
      * Raw record format in lmdb data storage:
-     * {vertexId<string>} -> {edgeId<RecordId>}{neighborId<RecordId>}
+     * {vertexId<RelationKey>} -> {edgeId<RecordId>}{neighborId<RecordId>}
      */
     struct RelationAccessInfo {
         RelationAccessInfo() = default;
@@ -61,6 +63,34 @@ namespace relation {
         RecordId neighborId {};
     };
 
+    /**
+     * Fixed-width key of the relation tables, {classId<uint16>}{positionId<uint32>} in big-endian,
+     * so that the byte order of keys is the same as the order of record ids and the default
+     * lmdb key comparator can be used as is.
+     */
+    struct RelationKey {
+        RelationKey() = default;
+
+        explicit RelationKey(const RecordId& rid)
+        {
+            bytes[0] = static_cast<unsigned char>(rid.first >> 8);
+            bytes[1] = static_cast<unsigned char>(rid.first);
+            bytes[2] = static_cast<unsigned char>(rid.second >> 24);
+            bytes[3] = static_cast<unsigned char>(rid.second >> 16);
+            bytes[4] = static_cast<unsigned char>(rid.second >> 8);
+            bytes[5] = static_cast<unsigned char>(rid.second);
+        }
+
+        bool equals(const storage_engine::lmdb::Value& key) const
+        {
+            return key.size() == sizeof(bytes) && memcmp(key.data(), bytes, sizeof(bytes)) == 0;
+        }
+
+        unsigned char bytes[sizeof(ClassId) + sizeof(PositionId)] {};
+    };
+
+    static_assert(sizeof(RelationKey) == sizeof(ClassId) + sizeof(PositionId), "unexpected padding in RelationKey");
+
     constexpr char KEY_SEPARATOR = ':';
 
     class RelationAccess : public storage_engine::adapter::LMDBKeyValAccess {
@@ -78,28 +108,27 @@ namespace relation {
 
         void create(const RelationAccessInfo& props)
         {
-            put(rid2str(props.vertexId), convertToBlob(props));
+            put(RelationKey { props.vertexId }, convertToBlob(props));
         }
 
         void remove(const RecordId& vertexId)
         {
-            del(rid2str(vertexId));
+            del(RelationKey { vertexId });
         }
 
         void remove(const RelationAccessInfo& props)
         {
-            del(rid2str(props.vertexId), convertToBlob(props));
+            del(RelationKey { props.vertexId }, convertToBlob(props));
         }
 
         void removeByCursor(const RelationAccessInfo& props)
         {
-            auto result = std::vector<RecordId> {};
+            auto key = RelationKey { props.vertexId };
             auto cursorHandler = cursor();
-            for (auto keyValue = cursorHandler.find(rid2str(props.vertexId));
+            for (auto keyValue = cursorHandler.find(key);
                  !keyValue.empty();
                  keyValue = cursorHandler.getNext()) {
-                auto key = str2rid(keyValue.key.data.string());
-                if (key != props.vertexId)
+                if (!key.equals(keyValue.key.data))
                     break;
                 auto neighbor = parseNeighborId(keyValue.val.data.blob());
                 if (neighbor != props.neighborId)
@@ -115,12 +144,12 @@ namespace relation {
         std::vector<RelationAccessInfo> getInfos(const RecordId& vertexId) const
         {
             auto result = std::vector<RelationAccessInfo> {};
+            auto key = RelationKey { vertexId };
             auto cursorHandler = cursor();
-            for (auto keyValue = cursorHandler.find(rid2str(vertexId));
+            for (auto keyValue = cursorHandler.find(key);
                  !keyValue.empty();
                  keyValue = cursorHandler.getNext()) {
-                auto key = str2rid(keyValue.key.data.string());
-                if (key != vertexId)
+                if (!key.equals(keyValue.key.data))
                     break;
                 result.emplace_back(parse(vertexId, keyValue.val.data.blob()));
             }
@@ -130,12 +159,12 @@ namespace relation {
         std::vector<RecordId> getEdges(const RecordId& vertexId, const RecordId& neighborId) const
         {
             auto result = std::vector<RecordId> {};
+            auto key = RelationKey { vertexId };
             auto cursorHandler = cursor();
-            for (auto keyValue = cursorHandler.find(rid2str(vertexId));
+            for (auto keyValue = cursorHandler.find(key);
                  !keyValue.empty();
                  keyValue = cursorHandler.getNext()) {
-                auto key = str2rid(keyValue.key.data.string());
-                if (key != vertexId)
+                if (!key.equals(keyValue.key.data))
                     break;
                 auto neighbor = parseNeighborId(keyValue.val.data.blob());
                 if (neighbor != neighborId)
@@ -148,12 +177,12 @@ namespace relation {
         std::vector<RecordId> getEdges(const RecordId& vertexId) const
         {
             auto result = std::vector<RecordId> {};
+            auto key = RelationKey { vertexId };
             auto cursorHandler = cursor();
-            for (auto keyValue = cursorHandler.find(rid2str(vertexId));
+            for (auto keyValue = cursorHandler.find(key);
                  !keyValue.empty();
                  keyValue = cursorHandler.getNext()) {
-                auto key = str2rid(keyValue.key.data.string());
-                if (key != vertexId)
+                if (!key.equals(keyValue.key.data))
                     break;
                 result.emplace_back(parseEdgeId(keyValue.val.data.blob()));
             }
@@ -163,12 +192,12 @@ namespace relation {
         std::vector<std::pair<RecordId, RecordId>> getEdgeAndNeighbours(const RecordId& vertexId) const
         {
             auto result = std::vector<std::pair<RecordId, RecordId>> {};
+            auto key = RelationKey { vertexId };
             auto cursorHandler = cursor();
-            for (auto keyValue = cursorHandler.find(rid2str(vertexId));
+            for (auto keyValue = cursorHandler.find(key);
                  !keyValue.empty();
                  keyValue = cursorHandler.getNext()) {
-                auto key = str2rid(keyValue.key.data.string());
-                if (key != vertexId)
+                if (!key.equals(keyValue.key.data))
                     break;
                 auto blob = keyValue.val.data.blob();
                 result.emplace_back(std::make_pair(parseEdgeId(blob), parseNeighborId(blob)));
@@ -181,6 +210,28 @@ namespace relation {
             return _direction;
         };
 
+        /**
+         * Rewrite all entries stored with the legacy "classId:positionId" string keys
+         * into the fixed-width binary keys. Must be run in a read-write transaction.
+         */
+        void migrateLegacyKeys()
+        {
+            auto legacyInfos = std::vector<RelationAccessInfo> {};
+            {
+                auto cursorHandler = cursor();
+                for (auto keyValue = cursorHandler.getNext();
+                     !keyValue.empty();
+                     keyValue = cursorHandler.getNext()) {
+                    auto vertexId = str2rid(keyValue.key.data.string());
+                    legacyInfos.emplace_back(parse(vertexId, keyValue.val.data.blob()));
+                }
+            }
+            drop();
+            for (const auto& info : legacyInfos) {
+                create(info);
+            }
+        }
+
     protected:
         static Blob convertToBlob(const RelationAccessInfo& props)
         {
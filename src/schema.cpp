@@ -21,15 +21,6 @@
 
 #include "schema.hpp"
 
-namespace nogdb {
-struct TransactionSchemaCache {
-    std::unordered_map<std::string, adapter::schema::ClassAccessInfo> byName {};
-    std::unordered_map<ClassId, adapter::schema::ClassAccessInfo> byId {};
-    std::unordered_map<ClassId, adapter::schema::PropertyNameMapInfo> propertyNameMap {};
-    void invalidate() noexcept { byName.clear(); byId.clear(); propertyNameMap.clear(); }
-};
-}
-
 namespace nogdb {
 namespace schema {
 
@@ -177,15 +168,50 @@ namespace schema {
         const ClassId& classId,
         const ClassId& superClassId)
     {
-        auto result = PropertyIdMapInfo {};
+        return *getSharedPropertyIdMapInfo(txn, classId, superClassId);
+    }
+
+    std::shared_ptr<const std::string> SchemaUtils::getSharedClassName(const Transaction *txn,
+        const ClassAccessInfo& classInfo)
+    {
+        auto* sc = schemaCache(txn);
+        if (sc) {
+            auto it = sc->className.find(classInfo.id);
+            if (it != sc->className.cend()) {
+                return it->second;
+            }
+        }
+        auto result = std::make_shared<const std::string>(classInfo.name);
+        if (sc) {
+            sc->className[classInfo.id] = result;
+        }
+        return result;
+    }
+
+    std::shared_ptr<const PropertyIdMapInfo> SchemaUtils::getSharedPropertyIdMapInfo(const Transaction *txn,
+        const ClassId& classId,
+        const ClassId& superClassId)
+    {
+        auto* sc = schemaCache(txn);
+        if (sc) {
+            auto it = sc->propertyIdMap.find(classId);
+            if (it != sc->propertyIdMap.cend()) {
+                return it->second;
+            }
+        }
+        auto result = std::make_shared<PropertyIdMapInfo>();
         for (const auto& property : getNativePropertyInfo(txn, classId)) {
-            result[property.id] = property;
+            (*result)[property.id] = property;
         }
         auto inheritResult = getInheritPropertyInfo(txn, superClassId, std::vector<PropertyAccessInfo> {});
         for (const auto& property : inheritResult) {
-            result[property.id] = property;
+            (*result)[property.id] = property;
         }
-        return addBasicInfo(result);
+        addBasicInfo(*result).indexNames();
+        if (sc) {
+            sc->propertyIdMap[classId] = result;
+        }
+        return result;
     }
 
     IndexAccessInfo SchemaUtils::getIndexInfo(const Transaction *txn,
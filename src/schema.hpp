@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "schema_adapter.hpp"
@@ -30,6 +32,23 @@
 #include "nogdb/nogdb_types.h"
 
 namespace nogdb {
+struct TransactionSchemaCache {
+    std::unordered_map<std::string, adapter::schema::ClassAccessInfo> byName {};
+    std::unordered_map<ClassId, adapter::schema::ClassAccessInfo> byId {};
+    std::unordered_map<ClassId, adapter::schema::PropertyNameMapInfo> propertyNameMap {};
+    std::unordered_map<ClassId, std::shared_ptr<const adapter::schema::PropertyIdMapInfo>> propertyIdMap {};
+    std::unordered_map<ClassId, std::shared_ptr<const std::string>> className {};
+
+    void invalidate() noexcept
+    {
+        byName.clear();
+        byId.clear();
+        propertyNameMap.clear();
+        propertyIdMap.clear();
+        className.clear();
+    }
+};
+
 namespace schema {
     using namespace adapter::schema;
 
@@ -75,6 +94,14 @@ namespace schema {
             const ClassId& classId,
             const ClassId& superClassId);
 
+        static std::shared_ptr<const PropertyIdMapInfo> getSharedPropertyIdMapInfo(const Transaction *txn,
+            const ClassId& classId,
+            const ClassId& superClassId);
+
+        // the name of a class, shared by the records decoded from it
+        static std::shared_ptr<const std::string> getSharedClassName(const Transaction *txn,
+            const ClassAccessInfo& classInfo);
+
         static IndexAccessInfo getIndexInfo(const Transaction *txn,
             const ClassId& classId,
             const PropertyId& propertyId);
@@ -116,8 +116,9 @@ namespace schema {
         {
             auto result = get(className);
             if (!result.empty) {
-                del(className);
+                // the value of an entry is not readable any more once it has been deleted
                 auto classId = parseClassId(result.data.blob());
+                del(className);
                 _classCache.unset(classId);
             } else {
                 throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_NOEXST_CLASS);
@@ -171,6 +172,11 @@ namespace schema {
             return _classCache.get(classId, callback);
         }
 
+        void clearCache() noexcept
+        {
+            _classCache.clear();
+        }
+
         std::vector<ClassAccessInfo> getAllInfos() const
         {
             auto result = std::vector<ClassAccessInfo> {};
@@ -300,7 +306,30 @@ namespace schema {
     };
 
     typedef std::map<std::string, PropertyAccessInfo> PropertyNameMapInfo;
-    typedef std::map<PropertyId, PropertyAccessInfo> PropertyIdMapInfo;
+
+    /**
+     * The properties of a class by id, as shared by the records of the class, along with the ids of the
+     * properties by name so that a record looks a property up by its name once. The ids by name are built
+     * by indexNames() once the map is filled.
+     */
+    class PropertyIdMapInfo : public std::map<PropertyId, PropertyAccessInfo> {
+    public:
+        using std::map<PropertyId, PropertyAccessInfo>::map;
+
+        void indexNames()
+        {
+            _ids.clear();
+            for (const auto& property : *this) {
+                _ids.emplace(property.second.name, property.first);
+            }
+        }
+
+        // ordered by name
+        const std::map<std::string, PropertyId>& ids() const { return _ids; }
+
+    private:
+        std::map<std::string, PropertyId> _ids {};
+    };
 
     constexpr char KEY_SEPARATOR = ':';
     constexpr char KEY_PADDING = ' ';
@@ -627,6 +656,89 @@ namespace schema {
         }
     };
 
+    /**
+   * Raw record format in lmdb data storage:
+   * {classId<uint32>} -> {dictionary<bytes>}
+   * A class is compressed when it has an entry, its dictionary may be empty.
+   */
+    class DictionaryAccess : public storage_engine::adapter::LMDBKeyValAccess {
+    public:
+        DictionaryAccess() = default;
+
+        DictionaryAccess(const storage_engine::LMDBTxn* const txn)
+            : LMDBKeyValAccess(txn, TB_DICTIONARIES, true, true, false, true)
+        {
+        }
+
+        virtual ~DictionaryAccess() noexcept = default;
+
+        DictionaryAccess(DictionaryAccess&& other) noexcept = default;
+
+        DictionaryAccess& operator=(DictionaryAccess&& other) noexcept = default;
+
+        void set(const ClassId& classId, const std::string& dictionary)
+        {
+            put(DictionaryKey { classId }, dictionary);
+        }
+
+        storage_engine::lmdb::Result getResult(const ClassId& classId) const
+        {
+            return get(DictionaryKey { classId });
+        }
+
+        void remove(const ClassId& classId)
+        {
+            auto key = DictionaryKey { classId };
+            if (!get(key).empty) {
+                del(key);
+            }
+        }
+
+    protected:
+        using DictionaryKey = uint32_t;
+    };
+
+    /**
+     * Formats of the records of the classes whose records have been rewritten, which are written in the
+     * format of the database otherwise.
+     */
+    class RecordFormatAccess : public storage_engine::adapter::LMDBKeyValAccess {
+    public:
+        RecordFormatAccess() = default;
+
+        RecordFormatAccess(const storage_engine::LMDBTxn* const txn)
+            : LMDBKeyValAccess(txn, TB_RECORD_FORMATS, true, true, false, true)
+        {
+        }
+
+        virtual ~RecordFormatAccess() noexcept = default;
+
+        RecordFormatAccess(RecordFormatAccess&& other) noexcept = default;
+
+        RecordFormatAccess& operator=(RecordFormatAccess&& other) noexcept = default;
+
+        void set(const ClassId& classId, RecordFormat recordFormat)
+        {
+            put(RecordFormatKey { classId }, static_cast<uint8_t>(recordFormat));
+        }
+
+        storage_engine::lmdb::Result getResult(const ClassId& classId) const
+        {
+            return get(RecordFormatKey { classId });
+        }
+
+        void remove(const ClassId& classId)
+        {
+            auto key = RecordFormatKey { classId };
+            if (!get(key).empty) {
+                del(key);
+            }
+        }
+
+    protected:
+        using RecordFormatKey = uint32_t;
+    };
+
 }
 }
 }
\ No newline at end of file
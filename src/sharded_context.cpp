@@ -0,0 +1,721 @@
+/*
+ *  Copyright (C) 2019, NogDB <https://nogdb.org>
+ *  <nogdb at throughwave dot co dot th>
+ *
+ *  This file is part of libnogdb, the NogDB core library in C++.
+ *
+ *  libnogdb is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <utility>
+#include <vector>
+
+#include "constant.hpp"
+#include "dbinfo_adapter.hpp"
+#include "utils.hpp"
+
+#include "nogdb/nogdb.h"
+
+namespace nogdb {
+using namespace utils::io;
+
+namespace {
+    constexpr int PARTITIONED = -1;
+
+    // FNV-1a, which unlike std::hash is the same across processes, so that a class or a key
+    // is always found in the shard it has been written to
+    uint64_t hashOf(const void* data, size_t size)
+    {
+        auto hash = uint64_t { 14695981039346656037ULL };
+        for (auto byte = static_cast<const unsigned char*>(data); size > 0; ++byte, --size) {
+            hash = (hash ^ *byte) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    std::string shardPath(const std::string& rootPath, unsigned int shard)
+    {
+        return rootPath + DB_SHARD_PREFIX + std::to_string(shard);
+    }
+
+    // a line with the number of shards, then one line per placed class with its shard or * if partitioned
+    void writeShardSetting(const std::string& rootPath, unsigned int numShards, const std::map<std::string, int>& placements)
+    {
+        auto setting = std::ofstream(rootPath + DB_SHARD_SETTING_NAME, std::ios::trunc);
+        setting << numShards << "\n";
+        for (const auto& placement : placements) {
+            setting << placement.first << " ";
+            if (placement.second == PARTITIONED) {
+                setting << "*\n";
+            } else {
+                setting << placement.second << "\n";
+            }
+        }
+        if (!setting) {
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNKNOWN_ERR);
+        }
+    }
+
+    unsigned int readShardSetting(const std::string& rootPath, std::map<std::string, int>& placements)
+    {
+        auto setting = std::ifstream(rootPath + DB_SHARD_SETTING_NAME);
+        auto numShards = 0U;
+        if (!(setting >> numShards) || numShards == 0) {
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_DBSETTING_MISSING);
+        }
+        auto className = std::string {};
+        auto shard = std::string {};
+        while (setting >> className >> shard) {
+            placements[className] = (shard == "*") ? PARTITIONED : std::stoi(shard);
+        }
+        return numShards;
+    }
+
+    // the sequence number of the last write over several shards, whether it is still committing, then its shards
+    bool writeCommitJournal(const std::string& rootPath, uint64_t sequence, bool isPending, const std::vector<unsigned int>& shards)
+    {
+        auto journal = std::ofstream(rootPath + DB_SHARD_COMMIT_NAME, std::ios::trunc);
+        journal << sequence << " " << ((isPending) ? "pending" : "done");
+        for (auto shard : shards) {
+            journal << " " << shard;
+        }
+        journal << "\n";
+        journal.flush();
+        return static_cast<bool>(journal);
+    }
+
+    bool readCommitJournal(const std::string& rootPath, uint64_t& sequence, bool& isPending, std::vector<unsigned int>& shards)
+    {
+        auto journal = std::ifstream(rootPath + DB_SHARD_COMMIT_NAME);
+        auto state = std::string {};
+        if (!(journal >> sequence >> state)) {
+            return false;
+        }
+        isPending = (state == "pending");
+        auto shard = 0U;
+        while (journal >> shard) {
+            shards.emplace_back(shard);
+        }
+        return true;
+    }
+
+    // a proxy stands for a vertex of another shard and knows the copy of its edge in that shard
+    const std::string PROXY_SHARD = "shard";
+    const std::string PROXY_CLASS_ID = "class_id";
+    const std::string PROXY_POSITION_ID = "position_id";
+    const std::string PROXY_EDGE_CLASS_ID = "edge_class_id";
+    const std::string PROXY_EDGE_POSITION_ID = "edge_position_id";
+
+    Record proxyOf(unsigned int shard, const RecordId& vertex)
+    {
+        return Record {}
+            .set(PROXY_SHARD, shard)
+            .set(PROXY_CLASS_ID, vertex.first)
+            .set(PROXY_POSITION_ID, vertex.second);
+    }
+
+    RecordId remoteVertexOf(const Record& proxy)
+    {
+        return RecordId { proxy.getSmallIntU(PROXY_CLASS_ID), proxy.getIntU(PROXY_POSITION_ID) };
+    }
+
+    RecordId remoteEdgeOf(const Record& proxy)
+    {
+        return RecordId { proxy.getSmallIntU(PROXY_EDGE_CLASS_ID), proxy.getIntU(PROXY_EDGE_POSITION_ID) };
+    }
+}
+
+/**
+ * Writes over several shards of a root folder are committed one at a time, and readers of the root folder
+ * take the snapshots of its shards while none of them is committing.
+ */
+struct ShardedContext::Coordinator {
+    std::mutex commitMutex {};
+    // the sequence number of the last write over several shards
+    uint64_t lastCommit { 0 };
+    std::vector<unsigned int> partialCommit {};
+};
+
+ShardedContextInitializer::ShardedContextInitializer(const std::string& rootPath, unsigned int numShards)
+    : _rootPath { rootPath }
+    , _numShards { numShards }
+{
+}
+
+ShardedContextInitializer& ShardedContextInitializer::setShardSettings(std::function<void(ContextInitializer&)> settings)
+{
+    _shardSettings = std::move(settings);
+    return *this;
+}
+
+ShardedContextInitializer& ShardedContextInitializer::placeClass(const std::string& className, unsigned int shard)
+{
+    _placements[className] = static_cast<int>(shard);
+    return *this;
+}
+
+ShardedContextInitializer& ShardedContextInitializer::partitionClass(const std::string& className)
+{
+    _placements[className] = PARTITIONED;
+    return *this;
+}
+
+ShardedContext ShardedContextInitializer::init()
+{
+    if (_numShards == 0) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_INVALID_SHARD);
+    }
+    for (const auto& placement : _placements) {
+        if (placement.second != PARTITIONED && static_cast<unsigned int>(placement.second) >= _numShards) {
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_INVALID_SHARD);
+        }
+    }
+    if (fileExists(_rootPath)) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_ALREADY_INITIALIZED);
+    }
+    mkdir(_rootPath.c_str(), 0755);
+    for (auto shard = 0U; shard < _numShards; ++shard) {
+        auto initializer = ContextInitializer(shardPath(_rootPath, shard));
+        if (_shardSettings) {
+            _shardSettings(initializer);
+        }
+        initializer.init();
+    }
+    // written last, as a root folder without it is not a complete sharded database
+    writeShardSetting(_rootPath, _numShards, _placements);
+    return ShardedContext(_rootPath);
+}
+
+ShardedContext::ShardedContext(const std::string& rootPath)
+    : _rootPath { rootPath }
+{
+    if (!fileExists(_rootPath)) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    if (!fileExists(_rootPath + DB_SHARD_SETTING_NAME)) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_DBSETTING_MISSING);
+    }
+    auto numShards = readShardSetting(_rootPath, _placements);
+    _shards.reserve(numShards);
+    for (auto shard = 0U; shard < numShards; ++shard) {
+        _shards.emplace_back(shardPath(_rootPath, shard));
+    }
+    _coordinator = openCoordinator();
+}
+
+std::shared_ptr<ShardedContext::Coordinator> ShardedContext::openCoordinator()
+{
+    static std::mutex coordinatorsMutex {};
+    static std::map<std::string, std::weak_ptr<Coordinator>> coordinators {};
+    std::lock_guard<std::mutex> lock(coordinatorsMutex);
+    auto& opened = coordinators[_rootPath];
+    if (auto coordinator = opened.lock()) {
+        return coordinator;
+    }
+    auto coordinator = std::make_shared<Coordinator>();
+    auto isPending = false;
+    auto shards = std::vector<unsigned int> {};
+    if (readCommitJournal(_rootPath, coordinator->lastCommit, isPending, shards) && isPending) {
+        // the shards which have committed a write carry its sequence number
+        auto committed = std::vector<unsigned int> {};
+        for (auto shard : shards) {
+            auto txn = getShard(shard).beginTxn(TxnMode::READ_ONLY);
+            if (txn._adapter->dbInfo()->getShardedCommit() == coordinator->lastCommit) {
+                committed.emplace_back(shard);
+            }
+        }
+        if (!committed.empty() && committed.size() < shards.size()) {
+            coordinator->partialCommit = committed;
+        } else {
+            writeCommitJournal(_rootPath, coordinator->lastCommit, false, shards);
+        }
+    }
+    opened = coordinator;
+    return coordinator;
+}
+
+Context& ShardedContext::getShard(unsigned int shard)
+{
+    if (shard >= _shards.size()) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_INVALID_SHARD);
+    }
+    return _shards[shard];
+}
+
+bool ShardedContext::isPartitioned(const std::string& className) const
+{
+    auto placement = _placements.find(className);
+    return placement != _placements.cend() && placement->second == PARTITIONED;
+}
+
+unsigned int ShardedContext::getShardOf(const std::string& className) const
+{
+    if (_shards.empty()) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    auto placement = _placements.find(className);
+    if (placement == _placements.cend()) {
+        return static_cast<unsigned int>(hashOf(className.data(), className.size()) % _shards.size());
+    }
+    if (placement->second == PARTITIONED) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_INVALID_SHARD);
+    }
+    return static_cast<unsigned int>(placement->second);
+}
+
+unsigned int ShardedContext::getShardOf(const std::string& className, const Bytes& key) const
+{
+    if (!isPartitioned(className)) {
+        return getShardOf(className);
+    }
+    return static_cast<unsigned int>(hashOf(key.getConstRaw(), key.size()) % _shards.size());
+}
+
+std::vector<unsigned int> ShardedContext::getShardsOf(const std::string& className) const
+{
+    if (!isPartitioned(className)) {
+        return std::vector<unsigned int> { getShardOf(className) };
+    }
+    auto shards = std::vector<unsigned int> {};
+    for (auto shard = 0U; shard < _shards.size(); ++shard) {
+        shards.emplace_back(shard);
+    }
+    return shards;
+}
+
+ShardedTxn ShardedContext::beginTxn(const TxnMode& txnMode)
+{
+    if (_shards.empty()) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    return ShardedTxn(*this, txnMode);
+}
+
+ShardedTxn ShardedContext::beginTxn(const TxnMode& txnMode, const std::vector<unsigned int>& shards)
+{
+    auto txn = beginTxn(txnMode);
+    txn.beginShards(shards);
+    return txn;
+}
+
+std::vector<unsigned int> ShardedContext::getPartialCommit() const
+{
+    if (!_coordinator) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    std::lock_guard<std::mutex> lock(_coordinator->commitMutex);
+    return _coordinator->partialCommit;
+}
+
+void ShardedContext::clearPartialCommit()
+{
+    if (!_coordinator) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNINITIALIZED);
+    }
+    std::lock_guard<std::mutex> lock(_coordinator->commitMutex);
+    if (!_coordinator->partialCommit.empty()) {
+        if (!writeCommitJournal(_rootPath, _coordinator->lastCommit, false, _coordinator->partialCommit)) {
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNKNOWN_ERR);
+        }
+        _coordinator->partialCommit.clear();
+    }
+}
+
+ShardedTxn::ShardedTxn(ShardedContext& ctx, const TxnMode& txnMode)
+    : _ctx { &ctx }
+    , _txnMode { txnMode }
+    , _txns(ctx.getNumShards())
+    , _proxyClasses(ctx.getNumShards())
+{
+    if (_txnMode == TxnMode::READ_ONLY) {
+        // taken together, so that a write over several shards is seen in all of them or in none
+        std::lock_guard<std::mutex> lock(ctx._coordinator->commitMutex);
+        for (auto shard = 0U; shard < _txns.size(); ++shard) {
+            _txns[shard].reset(new Transaction(ctx.getShard(shard).beginTxn(_txnMode)));
+        }
+    }
+}
+
+ShardedTxn::~ShardedTxn() noexcept
+{
+    rollback();
+}
+
+Transaction& ShardedTxn::getShard(unsigned int shard)
+{
+    if (shard >= _txns.size()) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_INVALID_SHARD);
+    }
+    // the writer of a shard is only taken once the shard is used
+    if (!_txns[shard]) {
+        _txns[shard].reset(new Transaction(_ctx->getShard(shard).beginTxn(_txnMode)));
+    }
+    return *_txns[shard];
+}
+
+// writers are always taken in the order of their shards, so that two transactions writing the same shards
+// cannot each hold the writer the other one waits for
+void ShardedTxn::beginShards(std::vector<unsigned int> shards)
+{
+    std::sort(shards.begin(), shards.end());
+    for (auto shard : shards) {
+        getShard(shard);
+    }
+}
+
+Transaction& ShardedTxn::getShardOf(const std::string& className)
+{
+    return getShard(_ctx->getShardOf(className));
+}
+
+Transaction& ShardedTxn::getShardOf(const std::string& className, const Bytes& key)
+{
+    return getShard(_ctx->getShardOf(className, key));
+}
+
+void ShardedTxn::addClass(const std::string& className, ClassType type)
+{
+    for (auto shard : _ctx->getShardsOf(className)) {
+        getShard(shard).addClass(className, type);
+    }
+}
+
+void ShardedTxn::addProperty(const std::string& className, const std::string& propertyName, PropertyType type)
+{
+    for (auto shard : _ctx->getShardsOf(className)) {
+        getShard(shard).addProperty(className, propertyName, type);
+    }
+}
+
+void ShardedTxn::addIndex(const std::string& className, const std::string& propertyName, bool isUnique)
+{
+    for (auto shard : _ctx->getShardsOf(className)) {
+        getShard(shard).addIndex(className, propertyName, isUnique);
+    }
+}
+
+template <typename Find>
+ShardedResultSet ShardedTxn::findAll(const std::string& className, Find find)
+{
+    auto result = ShardedResultSet {};
+    for (auto shard : _ctx->getShardsOf(className)) {
+        for (auto& found : find(getShard(shard).find(className))) {
+            result.emplace_back(ShardedResult { shard, found.descriptor, std::move(found.record) });
+        }
+    }
+    return result;
+}
+
+ShardedResultSet ShardedTxn::find(const std::string& className)
+{
+    return findAll(className, [](FindOperationBuilder&& builder) { return builder.get(); });
+}
+
+ShardedResultSet ShardedTxn::find(const std::string& className, const Condition& condition)
+{
+    return findAll(className, [&](FindOperationBuilder&& builder) { return builder.where(condition).get(); });
+}
+
+ShardedResultSet ShardedTxn::find(const std::string& className, const MultiCondition& multiCondition)
+{
+    return findAll(className, [&](FindOperationBuilder&& builder) { return builder.where(multiCondition).get(); });
+}
+
+std::vector<ShardedRecordDescriptor> ShardedTxn::addEdge(const std::string& className,
+    const ShardedRecordDescriptor& srcVertex,
+    const ShardedRecordDescriptor& dstVertex,
+    const Record& record)
+{
+    if (srcVertex.shard == dstVertex.shard) {
+        auto edge = getShard(srcVertex.shard).addEdge(className, srcVertex.descriptor, dstVertex.descriptor, record);
+        return std::vector<ShardedRecordDescriptor> { ShardedRecordDescriptor { srcVertex.shard, edge } };
+    }
+    beginShards(std::vector<unsigned int> { srcVertex.shard, dstVertex.shard });
+    auto& srcTxn = getShard(srcVertex.shard);
+    auto& dstTxn = getShard(dstVertex.shard);
+    proxyClass(srcVertex.shard, true);
+    proxyClass(dstVertex.shard, true);
+    auto dstProxy = srcTxn.addVertex(DB_SHARD_PROXY_CLASS, proxyOf(dstVertex.shard, dstVertex.descriptor.rid));
+    auto srcEdge = srcTxn.addEdge(className, srcVertex.descriptor, dstProxy, record);
+    auto srcProxy = dstTxn.addVertex(DB_SHARD_PROXY_CLASS, proxyOf(srcVertex.shard, srcVertex.descriptor.rid)
+                                                               .set(PROXY_EDGE_CLASS_ID, srcEdge.rid.first)
+                                                               .set(PROXY_EDGE_POSITION_ID, srcEdge.rid.second));
+    auto dstEdge = dstTxn.addEdge(className, srcProxy, dstVertex.descriptor, record);
+    srcTxn.update(dstProxy, Record {}.set(PROXY_EDGE_CLASS_ID, dstEdge.rid.first).set(PROXY_EDGE_POSITION_ID, dstEdge.rid.second), UpdateMode::PATCH);
+    return std::vector<ShardedRecordDescriptor> {
+        ShardedRecordDescriptor { srcVertex.shard, srcEdge },
+        ShardedRecordDescriptor { dstVertex.shard, dstEdge }
+    };
+}
+
+void ShardedTxn::remove(const ShardedRecordDescriptor& recordDescriptor)
+{
+    if (recordDescriptor.shard < _txns.size() && !_txns[recordDescriptor.shard] && hasProxies(recordDescriptor.shard)) {
+        // the shards at the other ends of its edges are only known once the shard is read
+        auto shards = std::vector<unsigned int> {};
+        for (auto shard = 0U; shard < _txns.size(); ++shard) {
+            shards.emplace_back(shard);
+        }
+        beginShards(shards);
+    }
+    auto& txn = getShard(recordDescriptor.shard);
+    auto isEdge = txn.getClass(recordDescriptor.descriptor.rid.first).type == ClassType::EDGE;
+    auto proxies = std::vector<RecordDescriptor> {};
+    auto proxyClassId = proxyClass(recordDescriptor.shard);
+    if (proxyClassId != 0) {
+        auto isProxy = [&](const Result& end) {
+            if (end.descriptor.rid.first == proxyClassId) {
+                proxies.emplace_back(end.descriptor);
+            }
+        };
+        if (isEdge) {
+            for (const auto& end : txn.fetchSrcDst(recordDescriptor.descriptor)) {
+                isProxy(end);
+            }
+        } else {
+            for (const auto& edge : txn.findOutEdge(recordDescriptor.descriptor).get()) {
+                isProxy(txn.fetchDst(edge.descriptor));
+            }
+            for (const auto& edge : txn.findInEdge(recordDescriptor.descriptor).get()) {
+                isProxy(txn.fetchSrc(edge.descriptor));
+            }
+        }
+    }
+    // removing a proxy removes its edge as well
+    for (const auto& proxy : proxies) {
+        removeProxy(recordDescriptor.shard, proxy);
+    }
+    if (!isEdge || proxies.empty()) {
+        txn.remove(recordDescriptor.descriptor);
+    }
+}
+
+void ShardedTxn::removeProxy(unsigned int shard, const RecordDescriptor& proxy)
+{
+    auto& txn = getShard(shard);
+    auto record = txn.fetchRecord(proxy);
+    auto remoteShard = record.getIntU(PROXY_SHARD);
+    auto& remoteTxn = getShard(remoteShard);
+    auto remoteProxyClassId = proxyClass(remoteShard);
+    for (const auto& end : remoteTxn.fetchSrcDst(RecordDescriptor { remoteEdgeOf(record) })) {
+        if (end.descriptor.rid.first == remoteProxyClassId) {
+            remoteTxn.remove(end.descriptor);
+        }
+    }
+    txn.remove(proxy);
+}
+
+ShardedResultSet ShardedTxn::findInEdge(const ShardedRecordDescriptor& vertex)
+{
+    return findEdges(vertex, false);
+}
+
+ShardedResultSet ShardedTxn::findOutEdge(const ShardedRecordDescriptor& vertex)
+{
+    return findEdges(vertex, true);
+}
+
+// an edge between shards is found in the shard of either of its ends, as an edge to or from a proxy
+ShardedResultSet ShardedTxn::findEdges(const ShardedRecordDescriptor& vertex, bool isOut)
+{
+    auto& txn = getShard(vertex.shard);
+    auto result = ShardedResultSet {};
+    for (auto& found : (isOut) ? txn.findOutEdge(vertex.descriptor).get() : txn.findInEdge(vertex.descriptor).get()) {
+        result.emplace_back(ShardedResult { vertex.shard, found.descriptor, std::move(found.record) });
+    }
+    return result;
+}
+
+ShardedResult ShardedTxn::fetchSrc(const ShardedRecordDescriptor& edge)
+{
+    return fetchEnd(edge, false);
+}
+
+ShardedResult ShardedTxn::fetchDst(const ShardedRecordDescriptor& edge)
+{
+    return fetchEnd(edge, true);
+}
+
+ShardedResult ShardedTxn::fetchEnd(const ShardedRecordDescriptor& edge, bool isDst)
+{
+    auto& txn = getShard(edge.shard);
+    return resolve(edge.shard, (isDst) ? txn.fetchDst(edge.descriptor) : txn.fetchSrc(edge.descriptor));
+}
+
+ShardedResultSet ShardedTxn::traverseIn(const ShardedRecordDescriptor& vertex, unsigned int minDepth, unsigned int maxDepth)
+{
+    return traverseAll(vertex, minDepth, maxDepth, false);
+}
+
+ShardedResultSet ShardedTxn::traverseOut(const ShardedRecordDescriptor& vertex, unsigned int minDepth, unsigned int maxDepth)
+{
+    return traverseAll(vertex, minDepth, maxDepth, true);
+}
+
+// breadth first, visiting each vertex once in whichever shard it is reached from
+ShardedResultSet ShardedTxn::traverseAll(const ShardedRecordDescriptor& vertex, unsigned int minDepth, unsigned int maxDepth, bool isOut)
+{
+    auto result = ShardedResultSet {};
+    auto visited = std::set<std::pair<unsigned int, RecordId>> { std::make_pair(vertex.shard, vertex.descriptor.rid) };
+    if (minDepth == 0) {
+        result.emplace_back(ShardedResult { vertex.shard, vertex.descriptor, getShard(vertex.shard).fetchRecord(vertex.descriptor) });
+    }
+    auto frontier = std::vector<ShardedRecordDescriptor> { vertex };
+    for (auto depth = 1U; depth <= maxDepth && !frontier.empty(); ++depth) {
+        auto next = std::vector<ShardedRecordDescriptor> {};
+        for (const auto& current : frontier) {
+            for (const auto& edge : findEdges(current, isOut)) {
+                auto reached = fetchEnd(ShardedRecordDescriptor { edge.shard, edge.descriptor }, isOut);
+                if (!visited.insert(std::make_pair(reached.shard, reached.descriptor.rid)).second) {
+                    continue;
+                }
+                next.emplace_back(ShardedRecordDescriptor { reached.shard, reached.descriptor });
+                if (depth >= minDepth) {
+                    result.emplace_back(std::move(reached));
+                }
+            }
+        }
+        frontier = std::move(next);
+    }
+    return result;
+}
+
+bool ShardedTxn::hasProxies(unsigned int shard) const
+{
+    auto txn = _ctx->getShard(shard).beginTxn(TxnMode::READ_ONLY);
+    for (const auto& classDescriptor : txn.getClasses()) {
+        if (classDescriptor.name == DB_SHARD_PROXY_CLASS) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ClassId ShardedTxn::proxyClass(unsigned int shard, bool create)
+{
+    if (_proxyClasses[shard] == 0) {
+        auto& txn = getShard(shard);
+        for (const auto& classDescriptor : txn.getClasses()) {
+            if (classDescriptor.name == DB_SHARD_PROXY_CLASS) {
+                _proxyClasses[shard] = classDescriptor.id;
+                break;
+            }
+        }
+        if (_proxyClasses[shard] == 0 && create) {
+            _proxyClasses[shard] = txn.addClass(DB_SHARD_PROXY_CLASS, ClassType::VERTEX).id;
+            txn.addProperty(DB_SHARD_PROXY_CLASS, PROXY_SHARD, PropertyType::UNSIGNED_INTEGER);
+            txn.addProperty(DB_SHARD_PROXY_CLASS, PROXY_CLASS_ID, PropertyType::UNSIGNED_SMALLINT);
+            txn.addProperty(DB_SHARD_PROXY_CLASS, PROXY_POSITION_ID, PropertyType::UNSIGNED_INTEGER);
+            txn.addProperty(DB_SHARD_PROXY_CLASS, PROXY_EDGE_CLASS_ID, PropertyType::UNSIGNED_SMALLINT);
+            txn.addProperty(DB_SHARD_PROXY_CLASS, PROXY_EDGE_POSITION_ID, PropertyType::UNSIGNED_INTEGER);
+        }
+    }
+    return _proxyClasses[shard];
+}
+
+ShardedResult ShardedTxn::resolve(unsigned int shard, Result&& result)
+{
+    auto proxyClassId = proxyClass(shard);
+    if (proxyClassId == 0 || result.descriptor.rid.first != proxyClassId) {
+        return ShardedResult { shard, result.descriptor, std::move(result.record) };
+    }
+    auto remoteShard = result.record.getIntU(PROXY_SHARD);
+    auto vertex = RecordDescriptor { remoteVertexOf(result.record) };
+    return ShardedResult { remoteShard, vertex, getShard(remoteShard).fetchRecord(vertex) };
+}
+
+void ShardedTxn::commit()
+{
+    auto shards = std::vector<unsigned int> {};
+    for (auto shard = 0U; shard < _txns.size(); ++shard) {
+        if (_txns[shard]) {
+            shards.emplace_back(shard);
+        }
+    }
+    if (_txnMode == TxnMode::READ_WRITE && shards.size() > 1) {
+        commitShards(shards);
+        return;
+    }
+    for (auto shard : shards) {
+        try {
+            _txns[shard]->commit();
+        } catch (...) {
+            rollback();
+            throw;
+        }
+        _txns[shard].reset();
+    }
+}
+
+/**
+ * The sequence number of the write is recorded in every shard and in the journal of the root folder before
+ * the shards commit, so that the shards which have committed it are known after a failure or a restart.
+ */
+void ShardedTxn::commitShards(const std::vector<unsigned int>& shards)
+{
+    auto& coordinator = *_ctx->_coordinator;
+    std::lock_guard<std::mutex> lock(coordinator.commitMutex);
+    auto sequence = coordinator.lastCommit + 1;
+    try {
+        for (auto shard : shards) {
+            _txns[shard]->_adapter->dbInfo()->setShardedCommit(sequence);
+        }
+        if (!writeCommitJournal(_ctx->_rootPath, sequence, true, shards)) {
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_UNKNOWN_ERR);
+        }
+    } catch (...) {
+        rollback();
+        throw;
+    }
+    coordinator.lastCommit = sequence;
+    auto committed = std::vector<unsigned int> {};
+    for (auto shard : shards) {
+        try {
+            _txns[shard]->commit();
+        } catch (...) {
+            rollback();
+            if (committed.empty()) {
+                writeCommitJournal(_ctx->_rootPath, sequence, false, shards);
+                throw;
+            }
+            coordinator.partialCommit = committed;
+            throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_PARTIAL_COMMIT);
+        }
+        _txns[shard].reset();
+        committed.emplace_back(shard);
+    }
+    // once every shard has committed, a journal left pending is found complete on the next open anyway
+    writeCommitJournal(_ctx->_rootPath, sequence, false, shards);
+}
+void ShardedTxn::rollback() noexcept
+{
+    for (auto& txn : _txns) {
+        if (txn) {
+            txn->rollback();
+            txn.reset();
+        }
+    }
+}
+
+}
@@ -215,7 +215,7 @@ bool Bytes::operator<(const Bytes& other) const
     if (this->size() != other.size()) {
         return this->size() < other.size();
     } else {
-        return memcmp(this->getRaw(), other.getRaw(), this->size());
+        return memcmp(this->getConstRaw(), other.getConstRaw(), this->size());
     }
 }
 
@@ -724,6 +724,7 @@ static int keywordCode(const char* z, int n, int* pType)
             { "PROPERTY", TK_PROPERTY },
             { "SELECT", TK_SELECT },
             { "SET", TK_SET },
+            { "SHOW", TK_SHOW },
             { "SKIP", TK_SKIP },
             { "STRATEGY", TK_STRATEGY },
             { "TO", TK_TO },
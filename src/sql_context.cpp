@@ -465,6 +465,49 @@ void Context::dropIndex(const Token& tClassName, const Token& tPropName)
     }
 }
 
+void Context::show(const Token& tTarget)
+{
+    try {
+        if (stringcasecmp(tTarget.toString(), "STORAGE") != 0) {
+            throw NOGDB_SQL_ERROR(NOGDB_SQL_SYNTAX_ERROR);
+        }
+        auto stats = this->txn.getStorageStats();
+        nogdb::ResultSet* tmp = new nogdb::ResultSet();
+        auto env = nogdb::Record()
+            .set("type", string("environment"))
+            .set("name", stats.dbPath)
+            .set("page_size", stats.pageSize)
+            .set("map_size", uint64_t(stats.mapSize))
+            .set("used_size", uint64_t(stats.usedSize))
+            .set("last_page", uint64_t(stats.lastPageId))
+            .set("max_readers", stats.maxReaders)
+            .set("num_readers", stats.numReaders);
+        tmp->emplace_back(nogdb::RecordDescriptor(), env);
+        auto addTables = [&tmp](const string& type, const vector<TableStat>& tables) {
+            for (const auto& table : tables) {
+                auto record = nogdb::Record()
+                    .set("type", type)
+                    .set("name", table.name)
+                    .set("depth", table.depth)
+                    .set("branch_pages", uint64_t(table.branchPages))
+                    .set("leaf_pages", uint64_t(table.leafPages))
+                    .set("overflow_pages", uint64_t(table.overflowPages))
+                    .set("entries", uint64_t(table.entries));
+                tmp->emplace_back(nogdb::RecordDescriptor(), record);
+            }
+        };
+        addTables("class", stats.classes);
+        addTables("index", stats.indexes);
+        addTables("relation", stats.relations);
+
+        this->rc = SQL_OK;
+        this->result = SQL::Result(tmp);
+    } catch (const Error& e) {
+        this->rc = SQL_ERROR;
+        this->result = SQL::Result(new Error(e));
+    }
+}
+
 #pragma mark-- private
 
 ResultSet Context::selectPrivate(const SelectArgs& stmt)
@@ -757,7 +800,7 @@ Bytes Context::getProjectionItemProperty(Transaction& txn, const Result& input,
     if (b.empty() || b.type() != nogdb::PropertyType::UNDEFINED) {
         return b;
     } else {
-        return Bytes(b.getRaw(), b.size(), map.at(propName));
+        return Bytes(b.getConstRaw(), b.size(), map.at(propName));
     }
 }
 
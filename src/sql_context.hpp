@@ -102,6 +102,9 @@ namespace sql_parser {
 
         void dropIndex(const Token& tClassName, const Token& tPropName);
 
+        // SHOW operations
+        void show(const Token& tTarget);
+
     private:
         void newTxnIfRootStmt(bool isRoot, TxnMode mode);
 
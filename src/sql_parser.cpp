@@ -0,0 +1,3557 @@
+/*
+
+January, 2016.  Sample class-based version.
+#define LEMON_SUPER as the name of a class which overrides lemon_base<TokenType>.  
+The parser will be implemented in terms of that.
+add a %code section to instantiate it.
+ */
+
+/*
+** 2000-05-29
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+** Driver template for the LEMON parser generator.
+**
+** The "lemon" program processes an LALR(1) input grammar file, then uses
+** this template to construct a parser.  The "lemon" program inserts text
+** at each "%%" line.  Also, any "P-a-r-s-e" identifer prefix (without the
+** interstitial "-" characters) contained in this template is changed into
+** the value of the %name directive from the grammar.  Otherwise, the content
+** of this template is copied straight through into the generate parser
+** source file.
+**
+** The following is the concatenation of all %include directives from the
+** input grammar file:
+*/
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <type_traits>
+#include <new>
+#include <memory>
+#include <algorithm>
+
+namespace {
+
+  // use std::allocator etc?
+
+
+  // this is here so you can do something like Parse(void *, int, my_token &&) or (... const my_token &)
+  template<class T> struct yy_fix_type {
+    typedef typename std::remove_const<typename std::remove_reference<T>::type>::type type;
+  };
+
+  template<>
+  struct yy_fix_type<void> {
+    typedef struct {} type;
+  };
+
+  template<class T, class... Args>
+  typename yy_fix_type<T>::type &yy_constructor(void *vp, Args&&... args ) {
+    typedef typename yy_fix_type<T>::type TT;
+    TT *tmp = ::new(vp) TT(std::forward<Args>(args)...);
+    return *tmp;
+  }
+
+
+  template<class T>
+  typename yy_fix_type<T>::type &yy_cast(void *vp) {
+    typedef typename yy_fix_type<T>::type TT;
+    return *(TT *)vp;
+  }
+
+
+  template<class T>
+  void yy_destructor(void *vp) {
+    typedef typename yy_fix_type<T>::type TT;
+    ((TT *)vp)->~TT();
+  }
+
+
+  template<class T>
+  void yy_destructor(T &t) {
+    t.~T();
+  }
+
+
+
+  template<class T>
+  void yy_move(void *dest, void *src) {
+    typedef typename yy_fix_type<T>::type TT;
+
+    TT &tmp = yy_cast<TT>(src);
+    yy_constructor<TT>(dest, std::move(tmp));
+    yy_destructor(tmp);
+  }
+
+
+  // this is to destruct references in the event of an exception.
+  // only the LHS needs to be deleted -- other items remain on the 
+  // shift/reduce stack in a valid state 
+  // (as long as the destructor) doesn't throw!
+  template<class T>
+  struct yy_auto_deleter {
+
+    yy_auto_deleter(T &t) : ref(t), enaged(true)
+    {}
+    yy_auto_deleter(const yy_auto_deleter &) = delete;
+    yy_auto_deleter(yy_auto_deleter &&) = delete;
+    yy_auto_deleter &operator=(const yy_auto_deleter &) = delete;
+    yy_auto_deleter &operator=(yy_auto_deleter &&) = delete;
+
+    ~yy_auto_deleter() {
+      if (enaged) yy_destructor(ref);
+    }
+    void cancel() { enaged = false; }
+
+  private:
+    T& ref;
+    bool enaged=false;
+  };
+
+  template<class T>
+  class yy_storage {
+  private:
+    typedef typename yy_fix_type<T>::type TT;
+
+  public:
+    typedef typename std::conditional<
+      std::is_trivial<TT>::value,
+      TT,
+      typename std::aligned_storage<sizeof(TT),alignof(TT)>::type
+    >::type type;
+  };
+
+}
+
+/************ Begin %include sections from the grammar ************************/
+#line 38 "/root/repo/src/sql_parser.y"
+
+#include <stdio.h>
+#include <assert.h>
+#include <set>
+#include "sql.hpp"
+#include "sql_context.hpp"
+
+using namespace std;
+using namespace nogdb::sql_parser;
+
+using nogdb::RecordDescriptor;
+using nogdb::MultiCondition;
+
+#define LEMON_SUPER Context
+
+#line 152 "/root/repo/src/sql_parser.cpp"
+/**************** End of %include directives **********************************/
+/* These constants specify the various numeric values for terminal symbols
+** in a format understandable to "makeheaders".  This section is blank unless
+** "lemon" is run with the "-m" command-line option.
+***************** Begin makeheaders token definitions *************************/
+/**************** End makeheaders token definitions ***************************/
+
+/* The next sections is a series of control #defines.
+** various aspects of the generated parser.
+**    YYCODETYPE         is the data type used to store the integer codes
+**                       that represent terminal and non-terminal symbols.
+**                       "unsigned char" is used if there are fewer than
+**                       256 symbols.  Larger types otherwise.
+**    YYNOCODE           is a number of type YYCODETYPE that is not used for
+**                       any terminal or nonterminal symbol.
+**    YYFALLBACK         If defined, this indicates that one or more tokens
+**                       (also known as: "terminal symbols") have fall-back
+**                       values which should be used if the original symbol
+**                       would not parse.  This permits keywords to sometimes
+**                       be used as identifiers, for example.
+**    YYACTIONTYPE       is the data type used for "action codes" - numbers
+**                       that indicate what to do in response to the next
+**                       token.
+**    ParseTOKENTYPE     is the data type used for minor type for terminal
+**                       symbols.  Background: A "minor type" is a semantic
+**                       value associated with a terminal or non-terminal
+**                       symbols.  For example, for an "ID" terminal symbol,
+**                       the minor type might be the name of the identifier.
+**                       Each non-terminal can have a different minor type.
+**                       Terminal symbols all have the same minor type, though.
+**                       This macros defines the minor type for terminal 
+**                       symbols.
+**    YYMINORTYPE        is the data type used for all minor types.
+**                       This is typically a union of many types, one of
+**                       which is ParseTOKENTYPE.  The entry in the union
+**                       for terminal symbols is called "yy0".
+**    YYSTACKDEPTH       is the maximum depth of the parser's stack.  If
+**                       zero the stack is dynamically sized using realloc()
+**    YYERRORSYMBOL      is the code number of the error symbol.  If not
+**                       defined, then do no error processing.
+**    YYNSTATE           the combined number of states.
+**    YYNRULE            the number of rules in the grammar
+**    YY_MAX_SHIFT       Maximum value for shift actions
+**    YY_MIN_SHIFTREDUCE Minimum value for shift-reduce actions
+**    YY_MAX_SHIFTREDUCE Maximum value for shift-reduce actions
+**    YY_MIN_REDUCE      Maximum value for reduce actions
+**    YY_ERROR_ACTION    The yy_action[] code for syntax error
+**    YY_ACCEPT_ACTION   The yy_action[] code for accept
+**    YY_NO_ACTION       The yy_action[] code for no-op
+*/
+#ifndef INTERFACE
+# define INTERFACE 1
+#endif
+/************* Begin control #defines *****************************************/
+#define YYCODETYPE unsigned char
+#define YYNOCODE 112
+#define YYACTIONTYPE unsigned short int
+#define YYWILDCARD 1
+#define ParseTOKENTYPE  Token 
+typedef union {
+  int yyinit;
+  yy_storage<ParseTOKENTYPE>::type yy0;
+  yy_storage<RecordDescriptor>::type yy3;
+  yy_storage<DeleteEdgeArgs>::type yy18;
+  yy_storage<Target>::type yy22;
+  yy_storage<nogdb::Record>::type yy56;
+  yy_storage<RecordDescriptorSet>::type yy59;
+  yy_storage<string>::type yy62;
+  yy_storage<UpdateArgs>::type yy73;
+  yy_storage<Where>::type yy78;
+  yy_storage<int>::type yy82;
+  yy_storage<long long>::type yy87;
+  yy_storage<TraverseArgs>::type yy98;
+  yy_storage<vector<Bytes>>::type yy99;
+  yy_storage<CreateEdgeArgs>::type yy123;
+  yy_storage<Condition>::type yy132;
+  yy_storage<vector<Projection>>::type yy143;
+  yy_storage<void *>::type yy157;
+  yy_storage<Bytes>::type yy166;
+  yy_storage<set<string>>::type yy172;
+  yy_storage<Projection>::type yy174;
+  yy_storage<SelectArgs>::type yy186;
+  yy_storage<void>::type yy187;
+  yy_storage<shared_ptr<MultiCondition>>::type yy209;
+  yy_storage<DeleteVertexArgs>::type yy211;
+  yy_storage<bool>::type yy215;
+} YYMINORTYPE;
+#ifndef YYSTACKDEPTH
+#define YYSTACKDEPTH 100
+#endif
+#define ParseARG_SDECL
+#define ParseARG_PDECL
+#define ParseARG_FETCH
+#define ParseARG_STORE
+#define YYFALLBACK 1
+#define YYNSTATE             187
+#define YYNRULE              129
+#define YY_MAX_SHIFT         186
+#define YY_MIN_SHIFTREDUCE   286
+#define YY_MAX_SHIFTREDUCE   414
+#define YY_MIN_REDUCE        415
+#define YY_MAX_REDUCE        543
+#define YY_ERROR_ACTION      544
+#define YY_ACCEPT_ACTION     545
+#define YY_NO_ACTION         546
+/************* End control #defines *******************************************/
+namespace {
+
+/* Define the yytestcase() macro to be a no-op if is not already defined
+** otherwise.
+**
+** Applications can choose to define yytestcase() in the %include section
+** to a macro that can assist in verifying code coverage.  For production
+** code the yytestcase() macro should be turned off.  But it is useful
+** for testing.
+*/
+#ifndef yytestcase
+# define yytestcase(X)
+#endif
+
+
+/* Next are the tables used to determine what action to take based on the
+** current state and lookahead token.  These tables are used to implement
+** functions that take a state number and lookahead value and return an
+** action integer.  
+**
+** Suppose the action integer is N.  Then the action is determined as
+** follows
+**
+**   0 <= N <= YY_MAX_SHIFT             Shift N.  That is, push the lookahead
+**                                      token onto the stack and goto state N.
+**
+**   N between YY_MIN_SHIFTREDUCE       Shift to an arbitrary state then
+**     and YY_MAX_SHIFTREDUCE           reduce by rule N-YY_MIN_SHIFTREDUCE.
+**
+**   N between YY_MIN_REDUCE            Reduce by rule N-YY_MIN_REDUCE
+**     and YY_MAX_REDUCE
+**
+**   N == YY_ERROR_ACTION               A syntax error has occurred.
+**
+**   N == YY_ACCEPT_ACTION              The parser accepts its input.
+**
+**   N == YY_NO_ACTION                  No such action.  Denotes unused
+**                                      slots in the yy_action[] table.
+**
+** The action table is constructed as a single large table named yy_action[].
+** Given state S and lookahead X, the action is computed as either:
+**
+**    (A)   N = yy_action[ yy_shift_ofst[S] + X ]
+**    (B)   N = yy_default[S]
+**
+** The (A) formula is preferred.  The B formula is used instead if:
+**    (1)  The yy_shift_ofst[S]+X value is out of range, or
+**    (2)  yy_lookahead[yy_shift_ofst[S]+X] is not equal to X, or
+**    (3)  yy_shift_ofst[S] equal YY_SHIFT_USE_DFLT.
+** (Implementation note: YY_SHIFT_USE_DFLT is chosen so that
+** YY_SHIFT_USE_DFLT+X will be out of range for all possible lookaheads X.
+** Hence only tests (1) and (2) need to be evaluated.)
+**
+** The formulas above are for computing the action when the lookahead is
+** a terminal symbol.  If the lookahead is a non-terminal (as occurs after
+** a reduce action) then the yy_reduce_ofst[] array is used in place of
+** the yy_shift_ofst[] array and YY_REDUCE_USE_DFLT is used in place of
+** YY_SHIFT_USE_DFLT.
+**
+** The following are the tables generated in this section:
+**
+**  yy_action[]        A single table containing all actions.
+**  yy_lookahead[]     A table containing the lookahead for each entry in
+**                     yy_action.  Used to detect hash collisions.
+**  yy_shift_ofst[]    For each state, the offset into yy_action for
+**                     shifting terminals.
+**  yy_reduce_ofst[]   For each state, the offset into yy_action for
+**                     shifting non-terminals after a reduce.
+**  yy_default[]       Default action for each state.
+**
+*********** Begin parsing tables **********************************************/
+#define YY_ACTTAB_COUNT (459)
+static const YYACTIONTYPE yy_action[] = {
+ /*     0 */   162,  125,   83,  107,  108,  157,  104,  501,   97,   85,
+ /*    10 */   430,  111,  183,  183,   14,  364,  364,   54,  545,  186,
+ /*    20 */   184,  184,  299,  110,  131,   53,  130,  155,  406,  406,
+ /*    30 */   406,    2,   88,  150,  406,  406,  406,  109,  175,  126,
+ /*    40 */   406,  406,  406,  113,  534,   42,  129,  128,  127,  531,
+ /*    50 */    39,   40,   38,   37,   41,   25,   24,    4,  165,  437,
+ /*    60 */   164,   21,   20,   30,  364,  364,  160,  160,  406,  406,
+ /*    70 */   406,  406,  406,  406,  406,  406,  406,  406,  406,  406,
+ /*    80 */   315,  315,  104,   14,   31,   46,  534,  175,  364,  364,
+ /*    90 */    32,  406,  406,  406,  429,  111,   33,  406,  406,  406,
+ /*   100 */   174,    4,  150,  406,  406,  406,   45,  445,  529,   11,
+ /*   110 */   468,  175,  104,  177,  123,   36,  119,  118,  455,   64,
+ /*   120 */   446,  122,  449,  446,   34,  449,  104,   35,  497,  102,
+ /*   130 */     7,  406,  406,  406,  406,  406,  406,  406,  406,  406,
+ /*   140 */   406,  406,  406,  364,  364,  534,  445,  465,   99,  449,
+ /*   150 */   445,   63,   63,   72,  152,  108,  157,  527,   66,  446,
+ /*   160 */   539,  449,  443,  446,   46,  449,  175,  151,  497,  102,
+ /*   170 */   176,  100,   51,  513,  497,   58,   53,  166,  155,  511,
+ /*   180 */    82,  509,   60,  167,   82,   45,  168,  507,   82,  430,
+ /*   190 */   111,  525,  169,   82,  534,   86,  523,  104,  505,  470,
+ /*   200 */   112,   87,   82,   78,  503,   82,  114,   82,  172,  383,
+ /*   210 */    93,  373,  446,  159,  449,  115,  446,   92,  449,  520,
+ /*   220 */    82,  446,   77,  449,  138,  141,  412,  413,  534,  500,
+ /*   230 */   532,  163,  530,  534,   71,    8,    9,   10,   12,  528,
+ /*   240 */   526,  524,  522,  521,   90,    3,  519,  518,   13,   48,
+ /*   250 */   517,  516,  515,  514,  492,  491,  534,  370,  370,  132,
+ /*   260 */   132,  534,  534,    1,   47,  466,  534,  534,  534,  534,
+ /*   270 */   133,  133,   67,   67,  513,   96,  534,  534,  534,  534,
+ /*   280 */   534,   82,   95,  534,  534,   56,  158,  534,  534,  534,
+ /*   290 */   534,  534,  534,   82,   16,  145,  135,  135,   68,   68,
+ /*   300 */   139,  139,  148,  140,  140,  142,  142,   69,   69,  144,
+ /*   310 */   144,   61,  347,  347,  349,  349,  302,  302,   72,  366,
+ /*   320 */   366,  321,   62,  153,  153,  154,  154,   48,  156,  156,
+ /*   330 */   161,  463,    6,    8,    9,  105,   54,   28,   10,   12,
+ /*   340 */   369,  369,   15,  404,  303,  328,  328,  461,  330,  330,
+ /*   350 */    49,  173,  173,   65,   79,   79,  136,  179,  179,  134,
+ /*   360 */    80,   80,  354,  180,  180,  137,   81,   81,  143,  146,
+ /*   370 */   472,  101,  496,  116,   70,  117,  171,  426,  182,   73,
+ /*   380 */   170,   76,   74,  355,   75,  124,  424,  178,  342,  120,
+ /*   390 */   185,  335,  333,  331,  296,  359,  294,  353,   26,  292,
+ /*   400 */    27,  289,   89,  291,   91,  288,   94,  352,   98,  351,
+ /*   410 */   149,  103,  306,   43,   52,  115,   29,   22,   23,    9,
+ /*   420 */    12,  365,   44,  147,   50,  536,  319,  318,  417,  417,
+ /*   430 */   383,  310,  311,  293,  290,  106,   17,   18,  312,  309,
+ /*   440 */   121,   19,    5,   55,   57,  357,  287,   59,  286,   84,
+ /*   450 */   417,  417,  417,  417,  417,  417,  417,  417,  181,
+};
+static const YYCODETYPE yy_lookahead[] = {
+ /*     0 */     2,    6,    7,   79,    2,    3,   48,   73,   13,   14,
+ /*    10 */    86,   87,    2,    3,   19,    2,    3,   16,   70,   71,
+ /*    20 */    10,   11,   20,   22,   76,   23,   78,   25,    3,    4,
+ /*    30 */     5,   36,   37,   38,    3,    4,    5,   87,   25,   91,
+ /*    40 */     3,    4,    5,  109,  110,   47,   98,   99,  100,   73,
+ /*    50 */    52,   53,   54,   55,   56,   57,   58,   23,   60,   87,
+ /*    60 */    62,   63,   64,   65,    2,    3,    4,    5,    3,    4,
+ /*    70 */     5,    3,    4,    5,    3,    4,    5,    3,    4,    5,
+ /*    80 */     2,    3,   48,   19,   59,   23,  110,   25,    2,    3,
+ /*    90 */    59,   66,   67,   68,   86,   87,   59,   66,   67,   68,
+ /*   100 */    95,   23,   38,   66,   67,   68,   44,   77,   73,   23,
+ /*   110 */    77,   25,   48,  108,    8,   44,   10,   11,   95,   89,
+ /*   120 */    90,   15,   92,   90,   59,   92,   48,   59,   92,   93,
+ /*   130 */    44,   66,   67,   68,   66,   67,   68,   66,   67,   68,
+ /*   140 */    66,   67,   68,    2,    3,  110,   77,   90,   42,   92,
+ /*   150 */    77,    2,    3,   21,   78,    2,    3,   73,   89,   90,
+ /*   160 */    97,   92,   89,   90,   23,   92,   25,   91,   92,   93,
+ /*   170 */    95,   39,   23,   88,   92,   93,   23,   88,   25,   94,
+ /*   180 */    95,   88,   79,   94,   95,   44,   88,   94,   95,   86,
+ /*   190 */    87,   73,   94,   95,  110,   88,   73,   48,   88,   77,
+ /*   200 */    88,   94,   95,   77,   94,   95,   94,   95,   77,   24,
+ /*   210 */     8,   24,   90,   88,   92,   21,   90,   15,   92,   73,
+ /*   220 */    95,   90,   80,   92,   73,   73,   32,   33,  110,   73,
+ /*   230 */    73,   73,   73,  110,  104,   50,   51,   50,   51,   73,
+ /*   240 */    73,   73,   73,   73,   42,   17,   73,   73,   28,   21,
+ /*   250 */    73,   73,   73,   73,   73,   73,  110,    2,    3,    2,
+ /*   260 */     3,  110,  110,   10,   11,   81,  110,  110,  110,  110,
+ /*   270 */     2,    3,    2,    3,   88,    8,  110,  110,  110,  110,
+ /*   280 */   110,   95,   15,  110,  110,   96,   88,  110,  110,  110,
+ /*   290 */   110,  110,  110,   95,   18,   96,    2,    3,    2,    3,
+ /*   300 */     2,    3,  103,    2,    3,    2,    3,    2,    3,    2,
+ /*   310 */     3,  102,    4,    5,    4,    5,    2,    3,   21,    4,
+ /*   320 */     5,   24,  101,    4,    5,    4,    5,   21,    4,    5,
+ /*   330 */    24,   81,   23,   50,   51,   26,   16,   21,   50,   51,
+ /*   340 */     2,    3,   17,   27,   24,    4,    5,   81,    4,    5,
+ /*   350 */    46,    2,    3,   75,    2,    3,   43,    2,    3,   74,
+ /*   360 */     2,    3,    2,    2,    3,   74,    2,    3,  107,   41,
+ /*   370 */   106,   40,   92,   34,  105,   35,   31,   85,   43,   84,
+ /*   380 */    29,   81,   83,   12,   82,    2,   75,   75,   12,   72,
+ /*   390 */    72,   12,   12,   12,   12,   45,   12,   12,    2,   12,
+ /*   400 */     2,   12,   16,   12,   16,   12,   16,   12,   16,    2,
+ /*   410 */     2,   49,    2,   47,   17,   21,   51,   61,   61,   51,
+ /*   420 */    51,    2,   47,   24,   23,    0,   24,   24,  111,  111,
+ /*   430 */    24,   27,   27,   12,   12,   26,   18,   17,   27,   27,
+ /*   440 */    16,   26,   26,   30,   21,   45,   12,   30,   12,    9,
+ /*   450 */   111,  111,  111,  111,  111,  111,  111,  111,   44,
+};
+#define YY_SHIFT_USE_DFLT (459)
+#define YY_SHIFT_COUNT    (186)
+#define YY_SHIFT_MIN      (-42)
+#define YY_SHIFT_MAX      (440)
+static const short yy_shift_ofst[] = {
+ /*     0 */    -5,   78,   78,   78,   64,   74,    2,   86,   86,   86,
+ /*    10 */    86,   86,   86,   86,    2,   34,   34,   34,   34,   62,
+ /*    20 */    25,   31,   37,   65,   68,   71,   74,   74,   74,   74,
+ /*    30 */    74,   74,   74,   74,   74,   74,   74,   74,   74,   74,
+ /*    40 */    74,   74,   74,   74,   74,  141,  141,  149,  153,   13,
+ /*    50 */   255,  -42,  -42,  153,  153,   13,  194,   13,  132,  255,
+ /*    60 */   228,  220,  276,  325,  220,  220,  304,  313,  313,  360,
+ /*    70 */   328,  331,  -42,  340,  339,  345,  351,  220,  304,  304,
+ /*    80 */   335,  335,   -2,  106,   10,  202,  185,  187,  253,  257,
+ /*    90 */   268,  270,  294,  296,  298,  301,  303,  267,  305,  307,
+ /*   100 */   308,  310,  297,  315,  319,  321,  324,  306,  309,  320,
+ /*   110 */   314,    1,  283,  316,  288,  338,  341,  344,  349,  352,
+ /*   120 */   355,  358,  361,  364,  371,  383,  376,  379,  380,  381,
+ /*   130 */   382,  384,  385,  386,  387,  388,  350,  389,  391,  396,
+ /*   140 */   390,  393,  398,  395,  392,  394,  407,  397,  399,  401,
+ /*   150 */   408,  402,  403,  362,  404,  410,  405,  409,  406,  411,
+ /*   160 */   412,  415,  416,  365,  356,  357,  368,  369,  368,  369,
+ /*   170 */   413,  417,  418,  420,  366,  419,  375,  423,  421,  422,
+ /*   180 */   424,  400,  414,  434,  436,  440,  425,
+};
+#define YY_REDUCE_USE_DFLT (-77)
+#define YY_REDUCE_COUNT (81)
+#define YY_REDUCE_MIN   (-76)
+#define YY_REDUCE_MAX   (318)
+static const short yy_reduce_ofst[] = {
+ /*     0 */   -52,   30,   69,   73,   76,  -66,  -76,   85,   89,   93,
+ /*    10 */    98,  107,  110,  112,  103,   33,  122,  126,  131,  125,
+ /*    20 */   -24,   35,   84,  118,  123,  146,  151,  152,  156,  157,
+ /*    30 */   158,  159,  166,  167,  168,  169,  170,  173,  174,  177,
+ /*    40 */   178,  179,  180,  181,  182,  186,  198,   57,    8,    5,
+ /*    50 */   199,   36,   82,  -50,  -28,   23,   63,   75,  130,  189,
+ /*    60 */   142,  184,  209,  221,  250,  266,  278,  285,  291,  261,
+ /*    70 */   264,  269,  280,  292,  295,  299,  302,  300,  311,  312,
+ /*    80 */   317,  318,
+};
+static const YYACTIONTYPE yy_default[] = {
+ /*     0 */   544,  544,  544,  544,  544,  544,  427,  544,  544,  544,
+ /*    10 */   544,  544,  544,  544,  427,  544,  544,  544,  544,  544,
+ /*    20 */   544,  544,  544,  544,  544,  544,  544,  544,  544,  544,
+ /*    30 */   544,  544,  544,  544,  544,  544,  544,  544,  544,  544,
+ /*    40 */   544,  544,  544,  544,  544,  544,  544,  544,  544,  544,
+ /*    50 */   473,  544,  544,  544,  544,  544,  540,  544,  475,  544,
+ /*    60 */   442,  451,  469,  467,  451,  451,  489,  487,  487,  543,
+ /*    70 */   479,  477,  544,  458,  456,  538,  454,  451,  489,  489,
+ /*    80 */   485,  485,  544,  544,  544,  544,  544,  544,  544,  544,
+ /*    90 */   544,  544,  544,  544,  544,  544,  544,  544,  544,  544,
+ /*   100 */   544,  544,  544,  544,  544,  544,  544,  544,  433,  544,
+ /*   110 */   544,  537,  453,  544,  452,  544,  544,  544,  544,  544,
+ /*   120 */   544,  544,  544,  544,  544,  544,  544,  544,  544,  544,
+ /*   130 */   544,  544,  544,  544,  544,  544,  544,  544,  544,  544,
+ /*   140 */   544,  544,  544,  544,  544,  474,  544,  544,  544,  544,
+ /*   150 */   544,  544,  544,  544,  544,  544,  544,  434,  544,  544,
+ /*   160 */   544,  436,  544,  544,  544,  544,  510,  508,  506,  504,
+ /*   170 */   544,  544,  544,  544,  544,  544,  544,  490,  544,  544,
+ /*   180 */   544,  544,  544,  544,  544,  544,  544,
+};
+/********** End of lemon-generated parsing tables *****************************/
+
+/* The next table maps tokens (terminal symbols) into fallback tokens.  
+** If a construct like the following:
+** 
+**      %fallback ID X Y Z.
+**
+** appears in the grammar, then ID becomes a fallback token for X, Y,
+** and Z.  Whenever one of the tokens X, Y, or Z is input to the parser
+** but it does not parse, the type of the token is changed to ID and
+** the parse is retried before an error is thrown.
+**
+** This feature can be used, for example, to cause some keywords in a language
+** to revert to identifiers if they keyword does not apply in the context where
+** it appears.
+*/
+#ifdef YYFALLBACK
+const YYCODETYPE yyFallback[] = {
+    0,  /*          $ => nothing */
+    0,  /*        ANY => nothing */
+    0,  /*   IDENTITY => nothing */
+    0,  /*     STRING => nothing */
+    0,  /*     SIGNED => nothing */
+    0,  /*   UNSIGNED => nothing */
+    2,  /*       SHOW => IDENTITY */
+};
+#endif /* YYFALLBACK */
+
+/* The following structure represents a single element of the
+** parser's stack.  Information stored includes:
+**
+**   +  The state number for the parser at this level of the stack.
+**
+**   +  The value of the token stored at this level of the stack.
+**      (In other words, the "major" token.)
+**
+**   +  The semantic value stored at this level of the stack.  This is
+**      the information used by the action routines in the grammar.
+**      It is sometimes called the "minor" token.
+**
+** After the "shift" half of a SHIFTREDUCE action, the stateno field
+** actually contains the reduce action for the second half of the
+** SHIFTREDUCE.
+*/
+struct yyStackEntry {
+  YYACTIONTYPE stateno;  /* The state-number, or reduce action in SHIFTREDUCE */
+  YYCODETYPE major;      /* The major token value.  This is the code
+                         ** number for the token at this stack level */
+  YYMINORTYPE minor;     /* The user-supplied minor token value.  This
+                         ** is the value of the token  */
+};
+
+/* The state of the parser is completely contained in an instance of
+** the following structure */
+
+#ifndef LEMON_SUPER
+#error "LEMON_SUPER must be defined."
+#endif
+
+/* outside the class so the templates above are still accessible */
+void yy_destructor(YYCODETYPE yymajor, YYMINORTYPE *yypminor);
+void yy_move(YYCODETYPE yymajor, YYMINORTYPE *yyDest, YYMINORTYPE *yySource);
+
+class yypParser : public LEMON_SUPER {
+  public:
+    //using LEMON_SUPER::LEMON_SUPER;
+
+    template<class ...Args>
+    yypParser(Args&&... args);
+
+    virtual ~yypParser() override final;
+    virtual void parse(int, ParseTOKENTYPE &&) override final;
+
+#ifndef NDEBUG
+    virtual void trace(FILE *, const char *) final override;
+#endif
+
+    virtual void reset() final override;
+    virtual bool will_accept() const final override;
+
+    /*
+    ** Return the peak depth of the stack for a parser.
+    */
+    #ifdef YYTRACKMAXSTACKDEPTH
+    int yypParser::stack_peak(){
+      return yyhwm;
+    }
+    #endif
+
+    const yyStackEntry *begin() const { return yystack; }
+    const yyStackEntry *end() const { return yytos + 1; }
+
+  protected:
+  private:
+  yyStackEntry *yytos;          /* Pointer to top element of the stack */
+#ifdef YYTRACKMAXSTACKDEPTH
+  int yyhwm = 0;                 /* Maximum value of yyidx */
+#endif
+#ifndef YYNOERRORRECOVERY
+  int yyerrcnt = -1;                 /* Shifts left before out of the error */
+#endif
+#if YYSTACKDEPTH<=0
+  int yystksz = 0;                  /* Current side of the stack */
+  yyStackEntry *yystack = nullptr;        /* The parser's stack */
+  yyStackEntry yystk0;          /* First stack entry */
+  int yyGrowStack();
+#else
+  yyStackEntry yystack[YYSTACKDEPTH];  /* The parser's stack */
+  yyStackEntry *yystackEnd;            /* Last entry in the stack */
+#endif
+
+
+
+  void yy_accept();
+  void yy_parse_failed();
+  void yy_syntax_error(int yymajor, ParseTOKENTYPE &yyminor);
+
+  void yy_transfer(yyStackEntry *yySource, yyStackEntry *yyDest);
+
+  void yy_pop_parser_stack();
+  unsigned yy_find_shift_action(int stateno, YYCODETYPE iLookAhead) const;
+  int yy_find_reduce_action(int stateno, YYCODETYPE iLookAhead) const;
+
+  void yy_shift(int yyNewState, int yyMajor, ParseTOKENTYPE &&yypMinor);
+  void yy_reduce(unsigned int yyruleno);
+  void yyStackOverflow();
+
+#ifndef NDEBUG
+  void yyTraceShift(int yyNewState) const;
+#else
+# define yyTraceShift(X)
+#endif
+
+
+#ifndef NDEBUG
+  FILE *yyTraceFILE = 0;
+  const char *yyTracePrompt = 0;
+#endif /* NDEBUG */
+
+  int yyidx() const {
+    return (int)(yytos - yystack);    
+  }
+
+};
+
+
+
+
+#ifndef NDEBUG
+/* 
+** Turn parser tracing on by giving a stream to which to write the trace
+** and a prompt to preface each trace message.  Tracing is turned off
+** by making either argument NULL 
+**
+** Inputs:
+** <ul>
+** <li> A FILE* to which trace output should be written.
+**      If NULL, then tracing is turned off.
+** <li> A prefix string written at the beginning of every
+**      line of trace output.  If NULL, then tracing is
+**      turned off.
+** </ul>
+**
+** Outputs:
+** None.
+*/
+void yypParser::trace(FILE *TraceFILE, const char *zTracePrompt){
+  yyTraceFILE = TraceFILE;
+  yyTracePrompt = zTracePrompt;
+  if( yyTraceFILE==0 ) yyTracePrompt = 0;
+  else if( yyTracePrompt==0 ) yyTraceFILE = 0;
+}
+#endif /* NDEBUG */
+
+#ifndef NDEBUG
+/* For tracing shifts, the names of all terminals and nonterminals
+** are required.  The following table supplies these names */
+const char *const yyTokenName[] = { 
+  "$",             "ANY",           "IDENTITY",      "STRING",      
+  "SIGNED",        "UNSIGNED",      "SHOW",          "CREATE",      
+  "CLASS",         "EXTENDS",       "VERTEX",        "EDGE",        
+  "SEMI",          "ALTER",         "DROP",          "PROPERTY",    
+  "DOT",           "FROM",          "TO",            "SELECT",      
+  "STAR",          "COMMA",         "AS",            "LP",          
+  "RP",            "AT",            "LB",            "RB",          
+  "WHERE",         "GROUP",         "BY",            "ORDER",       
+  "ASC",           "DESC",          "SKIP",          "LIMIT",       
+  "UPDATE",        "DELETE",        "TRAVERSE",      "MINDEPTH",    
+  "MAXDEPTH",      "STRATEGY",      "INDEX",         "IF",          
+  "NOT",           "EXISTS",        "SET",           "EQ",          
+  "SHARP",         "COLON",         "OR",            "AND",         
+  "LT",            "GT",            "GE",            "LE",          
+  "NE",            "IS",            "CONTAIN",       "CASE",        
+  "BEGIN",         "WITH",          "END",           "LIKE",        
+  "REGEX",         "BETWEEN",       "NULL",          "FLOAT",       
+  "BLOB",          "error",         "input",         "cmd",         
+  "if_not_exists_opt",  "term",          "if_exists_opt",  "props_opt",   
+  "create_edge_stmt",  "select_target_without_class",  "select_stmt",   "projections", 
+  "from_opt",      "where_opt",     "group_by",      "order_by",    
+  "skip",          "limit",         "proj_alias",    "proj_item",   
+  "cond",          "select_target",  "select_target_rids",  "traverse_stmt",
+  "rid",           "rid_set",       "multi_cond",    "prop_name",   
+  "name_set",      "sort_order",    "update_stmt",   "delete_vertex_stmt",
+  "delete_edge_stmt",  "from_edge_opt",  "to_edge_opt",   "class_filter",
+  "min_depth_opt",  "max_depth_opt",  "strategy_opt",  "index_type",  
+  "props_list",    "term_list",     "term_token",  
+};
+#endif /* NDEBUG */
+
+#ifndef NDEBUG
+/* For tracing reduce actions, the names of all rules are required.
+*/
+const char *const yyRuleName[] = {
+ /*   0 */ "cmd ::= CREATE CLASS IDENTITY|STRING if_not_exists_opt EXTENDS VERTEX|EDGE SEMI",
+ /*   1 */ "cmd ::= CREATE CLASS IDENTITY|STRING if_not_exists_opt EXTENDS IDENTITY|STRING SEMI",
+ /*   2 */ "cmd ::= ALTER CLASS IDENTITY|STRING IDENTITY term SEMI",
+ /*   3 */ "cmd ::= DROP CLASS IDENTITY|STRING if_exists_opt SEMI",
+ /*   4 */ "cmd ::= CREATE PROPERTY IDENTITY|STRING DOT IDENTITY|STRING if_not_exists_opt IDENTITY|STRING SEMI",
+ /*   5 */ "cmd ::= ALTER PROPERTY IDENTITY|STRING DOT IDENTITY|STRING IDENTITY term SEMI",
+ /*   6 */ "cmd ::= DROP PROPERTY IDENTITY|STRING DOT IDENTITY|STRING if_exists_opt SEMI",
+ /*   7 */ "cmd ::= CREATE VERTEX IDENTITY|STRING props_opt SEMI",
+ /*   8 */ "cmd ::= create_edge_stmt SEMI",
+ /*   9 */ "create_edge_stmt ::= CREATE EDGE IDENTITY|STRING FROM select_target_without_class TO select_target_without_class props_opt",
+ /*  10 */ "cmd ::= select_stmt SEMI",
+ /*  11 */ "select_stmt ::= SELECT projections from_opt where_opt group_by order_by skip limit",
+ /*  12 */ "projections ::=",
+ /*  13 */ "projections ::= STAR",
+ /*  14 */ "projections ::= projections COMMA proj_alias",
+ /*  15 */ "projections ::= proj_alias",
+ /*  16 */ "proj_alias ::= proj_item AS IDENTITY|STRING",
+ /*  17 */ "proj_item ::= LP proj_item RP",
+ /*  18 */ "proj_item ::= IDENTITY",
+ /*  19 */ "proj_item ::= STRING",
+ /*  20 */ "proj_item ::= AT IDENTITY",
+ /*  21 */ "proj_item ::= IDENTITY LP projections RP",
+ /*  22 */ "proj_item ::= proj_item DOT proj_item",
+ /*  23 */ "proj_item ::= IDENTITY LP projections RP LB SIGNED|UNSIGNED RB",
+ /*  24 */ "proj_item ::= IDENTITY LB SIGNED|UNSIGNED RB",
+ /*  25 */ "proj_item ::= STRING LB SIGNED|UNSIGNED RB",
+ /*  26 */ "proj_item ::= IDENTITY LP projections RP LB cond RB",
+ /*  27 */ "from_opt ::=",
+ /*  28 */ "from_opt ::= FROM select_target",
+ /*  29 */ "select_target ::= IDENTITY|STRING",
+ /*  30 */ "select_target ::= select_target_without_class",
+ /*  31 */ "select_target_without_class ::= select_target_rids",
+ /*  32 */ "select_target_without_class ::= LP select_stmt RP",
+ /*  33 */ "select_target_without_class ::= LP traverse_stmt RP",
+ /*  34 */ "select_target_rids ::= rid",
+ /*  35 */ "select_target_rids ::= LP rid_set RP",
+ /*  36 */ "where_opt ::=",
+ /*  37 */ "where_opt ::= WHERE multi_cond",
+ /*  38 */ "where_opt ::= WHERE cond",
+ /*  39 */ "group_by ::=",
+ /*  40 */ "group_by ::= GROUP BY prop_name",
+ /*  41 */ "skip ::=",
+ /*  42 */ "skip ::= SKIP SIGNED|UNSIGNED",
+ /*  43 */ "limit ::=",
+ /*  44 */ "limit ::= LIMIT SIGNED|UNSIGNED",
+ /*  45 */ "cmd ::= update_stmt SEMI",
+ /*  46 */ "update_stmt ::= UPDATE select_target props_opt where_opt",
+ /*  47 */ "cmd ::= delete_vertex_stmt SEMI",
+ /*  48 */ "delete_vertex_stmt ::= DELETE VERTEX select_target where_opt",
+ /*  49 */ "cmd ::= delete_edge_stmt SEMI",
+ /*  50 */ "delete_edge_stmt ::= DELETE EDGE select_target_rids",
+ /*  51 */ "delete_edge_stmt ::= DELETE EDGE IDENTITY|STRING from_edge_opt to_edge_opt where_opt",
+ /*  52 */ "from_edge_opt ::=",
+ /*  53 */ "from_edge_opt ::= FROM select_target_without_class",
+ /*  54 */ "to_edge_opt ::=",
+ /*  55 */ "to_edge_opt ::= TO select_target_without_class",
+ /*  56 */ "cmd ::= traverse_stmt SEMI",
+ /*  57 */ "traverse_stmt ::= TRAVERSE IDENTITY LP class_filter RP FROM rid_set min_depth_opt max_depth_opt strategy_opt",
+ /*  58 */ "class_filter ::=",
+ /*  59 */ "class_filter ::= name_set",
+ /*  60 */ "min_depth_opt ::=",
+ /*  61 */ "min_depth_opt ::= MINDEPTH SIGNED|UNSIGNED",
+ /*  62 */ "max_depth_opt ::=",
+ /*  63 */ "max_depth_opt ::= MAXDEPTH SIGNED|UNSIGNED",
+ /*  64 */ "strategy_opt ::=",
+ /*  65 */ "strategy_opt ::= STRATEGY IDENTITY",
+ /*  66 */ "cmd ::= CREATE INDEX IDENTITY|STRING DOT IDENTITY|STRING index_type SEMI",
+ /*  67 */ "cmd ::= DROP INDEX IDENTITY|STRING DOT IDENTITY|STRING SEMI",
+ /*  68 */ "index_type ::= IDENTITY",
+ /*  69 */ "cmd ::= SHOW IDENTITY SEMI",
+ /*  70 */ "if_not_exists_opt ::=",
+ /*  71 */ "if_not_exists_opt ::= IF NOT EXISTS",
+ /*  72 */ "if_exists_opt ::=",
+ /*  73 */ "if_exists_opt ::= IF EXISTS",
+ /*  74 */ "props_opt ::=",
+ /*  75 */ "props_opt ::= SET props_list",
+ /*  76 */ "props_list ::= props_list COMMA prop_name EQ term",
+ /*  77 */ "props_list ::= prop_name EQ term",
+ /*  78 */ "prop_name ::= IDENTITY|STRING",
+ /*  79 */ "prop_name ::= AT IDENTITY",
+ /*  80 */ "rid ::= SHARP SIGNED|UNSIGNED COLON SIGNED|UNSIGNED",
+ /*  81 */ "rid_set ::= rid_set COMMA rid",
+ /*  82 */ "rid_set ::= rid",
+ /*  83 */ "name_set ::= name_set COMMA IDENTITY|STRING",
+ /*  84 */ "name_set ::= IDENTITY|STRING",
+ /*  85 */ "term_list ::= term_list COMMA term",
+ /*  86 */ "term_list ::= term",
+ /*  87 */ "multi_cond ::= LP multi_cond RP",
+ /*  88 */ "multi_cond ::= multi_cond AND multi_cond",
+ /*  89 */ "multi_cond ::= multi_cond OR multi_cond",
+ /*  90 */ "multi_cond ::= multi_cond AND cond",
+ /*  91 */ "multi_cond ::= multi_cond OR cond",
+ /*  92 */ "multi_cond ::= cond AND multi_cond",
+ /*  93 */ "multi_cond ::= cond OR multi_cond",
+ /*  94 */ "multi_cond ::= cond AND cond",
+ /*  95 */ "multi_cond ::= cond OR cond",
+ /*  96 */ "multi_cond ::= NOT multi_cond",
+ /*  97 */ "cond ::= LP cond RP",
+ /*  98 */ "cond ::= NOT cond",
+ /*  99 */ "cond ::= prop_name EQ term",
+ /* 100 */ "cond ::= prop_name NE term",
+ /* 101 */ "cond ::= prop_name GT term",
+ /* 102 */ "cond ::= prop_name LT term",
+ /* 103 */ "cond ::= prop_name GE term",
+ /* 104 */ "cond ::= prop_name LE term",
+ /* 105 */ "cond ::= prop_name IS term",
+ /* 106 */ "cond ::= prop_name IS NOT term",
+ /* 107 */ "cond ::= prop_name CONTAIN CASE term",
+ /* 108 */ "cond ::= prop_name CONTAIN term",
+ /* 109 */ "cond ::= prop_name BEGIN WITH CASE term",
+ /* 110 */ "cond ::= prop_name BEGIN WITH term",
+ /* 111 */ "cond ::= prop_name END WITH CASE term",
+ /* 112 */ "cond ::= prop_name END WITH term",
+ /* 113 */ "cond ::= prop_name LIKE CASE term",
+ /* 114 */ "cond ::= prop_name LIKE term",
+ /* 115 */ "cond ::= prop_name REGEX CASE term",
+ /* 116 */ "cond ::= prop_name REGEX term",
+ /* 117 */ "cond ::= prop_name BETWEEN term AND term",
+ /* 118 */ "cond ::= prop_name IDENTITY LB term_list RB",
+ /* 119 */ "term ::= term_token",
+ /* 120 */ "term_token ::= NULL|FLOAT|STRING|SIGNED|UNSIGNED|BLOB",
+ /* 121 */ "input ::= cmd",
+ /* 122 */ "proj_alias ::= proj_item",
+ /* 123 */ "order_by ::=",
+ /* 124 */ "order_by ::= ORDER BY name_set sort_order",
+ /* 125 */ "sort_order ::=",
+ /* 126 */ "sort_order ::= ASC",
+ /* 127 */ "sort_order ::= DESC",
+ /* 128 */ "index_type ::=",
+};
+#endif /* NDEBUG */
+
+
+#if YYSTACKDEPTH<=0
+/*
+** Try to increase the size of the parser stack.  Return the number
+** of errors.  Return 0 on success.
+*/
+int yypParser::yyGrowStack(){
+  int newSize;
+  yyStackEntry *pNew;
+  yyStackEntry *pOld = yystack;
+  int oldSize = yystksz;
+
+  newSize = oldSize*2 + 100;
+  pNew = (yyStackEntry *)calloc(newSize, sizeof(pNew[0]));
+  if( pNew ){
+    yystack = pNew;
+    for (int i = 0; i < oldSize; ++i) {
+      pNew[i].stateno = pOld[i].stateno;
+      pNew[i].major = pOld[i].major;
+      yy_move(pOld[i].major, &pNew[i].minor, &pOld[i].minor);
+    }
+    if (pOld != &yystk0) free(pOld);
+#ifndef NDEBUG
+    if( yyTraceFILE ){
+      fprintf(yyTraceFILE,"%sStack grows from %d to %d entries.\n",
+              yyTracePrompt, yystksz, newSize);
+    }
+#endif
+    yystksz = newSize;
+  }
+  return pNew==0; 
+}
+#endif
+
+
+/* The following function deletes the "minor type" or semantic value
+** associated with a symbol.  The symbol can be either a terminal
+** or nonterminal. "yymajor" is the symbol code, and "yypminor" is
+** a pointer to the value to be deleted.  The code used to do the 
+** deletions is derived from the %destructor and/or %token_destructor
+** directives of the input grammar.
+*/
+void yy_destructor(
+  YYCODETYPE yymajor,     /* Type code for object to destroy */
+  YYMINORTYPE *yypminor   /* The object to be destroyed */
+){
+  switch( yymajor ){
+    /* Here is inserted the actions which take place when a
+    ** terminal or non-terminal is destroyed.  This can happen
+    ** when the symbol is popped from the stack during a
+    ** reduce or during error processing or when a parser is 
+    ** being destroyed before it is finished parsing.
+    **
+    ** Note: during a reduce, the only symbols destroyed are those
+    ** which appear on the RHS of the rule, but which are *not* used
+    ** inside the C code.
+    */
+/********* Begin destructor definitions ***************************************/
+    case 1: /* ANY */
+    case 2: /* IDENTITY */
+    case 3: /* STRING */
+    case 4: /* SIGNED */
+    case 5: /* UNSIGNED */
+    case 6: /* SHOW */
+    case 7: /* CREATE */
+    case 8: /* CLASS */
+    case 9: /* EXTENDS */
+    case 10: /* VERTEX */
+    case 11: /* EDGE */
+    case 12: /* SEMI */
+    case 13: /* ALTER */
+    case 14: /* DROP */
+    case 15: /* PROPERTY */
+    case 16: /* DOT */
+    case 17: /* FROM */
+    case 18: /* TO */
+    case 19: /* SELECT */
+    case 20: /* STAR */
+    case 21: /* COMMA */
+    case 22: /* AS */
+    case 23: /* LP */
+    case 24: /* RP */
+    case 25: /* AT */
+    case 26: /* LB */
+    case 27: /* RB */
+    case 28: /* WHERE */
+    case 29: /* GROUP */
+    case 30: /* BY */
+    case 31: /* ORDER */
+    case 32: /* ASC */
+    case 33: /* DESC */
+    case 34: /* SKIP */
+    case 35: /* LIMIT */
+    case 36: /* UPDATE */
+    case 37: /* DELETE */
+    case 38: /* TRAVERSE */
+    case 39: /* MINDEPTH */
+    case 40: /* MAXDEPTH */
+    case 41: /* STRATEGY */
+    case 42: /* INDEX */
+    case 43: /* IF */
+    case 44: /* NOT */
+    case 45: /* EXISTS */
+    case 46: /* SET */
+    case 47: /* EQ */
+    case 48: /* SHARP */
+    case 49: /* COLON */
+    case 50: /* OR */
+    case 51: /* AND */
+    case 52: /* LT */
+    case 53: /* GT */
+    case 54: /* GE */
+    case 55: /* LE */
+    case 56: /* NE */
+    case 57: /* IS */
+    case 58: /* CONTAIN */
+    case 59: /* CASE */
+    case 60: /* BEGIN */
+    case 61: /* WITH */
+    case 62: /* END */
+    case 63: /* LIKE */
+    case 64: /* REGEX */
+    case 65: /* BETWEEN */
+    case 66: /* NULL */
+    case 67: /* FLOAT */
+    case 68: /* BLOB */
+    case 70: /* input */
+    case 71: /* cmd */
+    case 97: /* sort_order */
+    case 107: /* index_type */
+    case 110: /* term_token */
+      yy_destructor< Token >(std::addressof(yypminor->yy0));
+      break;
+    case 0: /* $ */
+      yy_destructor<void>(std::addressof(yypminor->yy187));
+      break;
+    case 72: /* if_not_exists_opt */
+    case 74: /* if_exists_opt */
+      yy_destructor< bool >(std::addressof(yypminor->yy215));
+      break;
+    case 73: /* term */
+      yy_destructor< Bytes >(std::addressof(yypminor->yy166));
+      break;
+    case 75: /* props_opt */
+    case 108: /* props_list */
+      yy_destructor< nogdb::Record >(std::addressof(yypminor->yy56));
+      break;
+    case 76: /* create_edge_stmt */
+      yy_destructor< CreateEdgeArgs >(std::addressof(yypminor->yy123));
+      break;
+    case 77: /* select_target_without_class */
+    case 80: /* from_opt */
+    case 89: /* select_target */
+    case 101: /* from_edge_opt */
+    case 102: /* to_edge_opt */
+      yy_destructor< Target >(std::addressof(yypminor->yy22));
+      break;
+    case 78: /* select_stmt */
+      yy_destructor< SelectArgs >(std::addressof(yypminor->yy186));
+      break;
+    case 79: /* projections */
+      yy_destructor< vector<Projection> >(std::addressof(yypminor->yy143));
+      break;
+    case 81: /* where_opt */
+      yy_destructor< Where >(std::addressof(yypminor->yy78));
+      break;
+    case 82: /* group_by */
+    case 95: /* prop_name */
+    case 106: /* strategy_opt */
+      yy_destructor< string >(std::addressof(yypminor->yy62));
+      break;
+    case 83: /* order_by */
+      yy_destructor< void * >(std::addressof(yypminor->yy157));
+      break;
+    case 84: /* skip */
+    case 85: /* limit */
+      yy_destructor< int >(std::addressof(yypminor->yy82));
+      break;
+    case 86: /* proj_alias */
+    case 87: /* proj_item */
+      yy_destructor< Projection >(std::addressof(yypminor->yy174));
+      break;
+    case 88: /* cond */
+      yy_destructor< Condition >(std::addressof(yypminor->yy132));
+      break;
+    case 90: /* select_target_rids */
+    case 93: /* rid_set */
+      yy_destructor< RecordDescriptorSet >(std::addressof(yypminor->yy59));
+      break;
+    case 91: /* traverse_stmt */
+      yy_destructor< TraverseArgs >(std::addressof(yypminor->yy98));
+      break;
+    case 92: /* rid */
+      yy_destructor< RecordDescriptor >(std::addressof(yypminor->yy3));
+      break;
+    case 94: /* multi_cond */
+      yy_destructor< shared_ptr<MultiCondition> >(std::addressof(yypminor->yy209));
+      break;
+    case 96: /* name_set */
+    case 103: /* class_filter */
+      yy_destructor< set<string> >(std::addressof(yypminor->yy172));
+      break;
+    case 98: /* update_stmt */
+      yy_destructor< UpdateArgs >(std::addressof(yypminor->yy73));
+      break;
+    case 99: /* delete_vertex_stmt */
+      yy_destructor< DeleteVertexArgs >(std::addressof(yypminor->yy211));
+      break;
+    case 100: /* delete_edge_stmt */
+      yy_destructor< DeleteEdgeArgs >(std::addressof(yypminor->yy18));
+      break;
+    case 104: /* min_depth_opt */
+    case 105: /* max_depth_opt */
+      yy_destructor< long long >(std::addressof(yypminor->yy87));
+      break;
+    case 109: /* term_list */
+      yy_destructor< vector<Bytes> >(std::addressof(yypminor->yy99));
+      break;
+/********* End destructor definitions *****************************************/
+    default:  break;   /* If no destructor action specified: do nothing */
+  }
+}
+
+
+/*
+ * moves an object (such as when growing the stack). 
+ * Source is constructed.
+ * Destination is also destructed.
+ * 
+ */
+void yy_move(
+  YYCODETYPE yymajor,     /* Type code for object to move */
+  YYMINORTYPE *yyDest,     /*  */
+  YYMINORTYPE *yySource     /*  */
+){
+  switch( yymajor ){
+
+/********* Begin move definitions ***************************************/
+    case 1: /* ANY */
+    case 2: /* IDENTITY */
+    case 3: /* STRING */
+    case 4: /* SIGNED */
+    case 5: /* UNSIGNED */
+    case 6: /* SHOW */
+    case 7: /* CREATE */
+    case 8: /* CLASS */
+    case 9: /* EXTENDS */
+    case 10: /* VERTEX */
+    case 11: /* EDGE */
+    case 12: /* SEMI */
+    case 13: /* ALTER */
+    case 14: /* DROP */
+    case 15: /* PROPERTY */
+    case 16: /* DOT */
+    case 17: /* FROM */
+    case 18: /* TO */
+    case 19: /* SELECT */
+    case 20: /* STAR */
+    case 21: /* COMMA */
+    case 22: /* AS */
+    case 23: /* LP */
+    case 24: /* RP */
+    case 25: /* AT */
+    case 26: /* LB */
+    case 27: /* RB */
+    case 28: /* WHERE */
+    case 29: /* GROUP */
+    case 30: /* BY */
+    case 31: /* ORDER */
+    case 32: /* ASC */
+    case 33: /* DESC */
+    case 34: /* SKIP */
+    case 35: /* LIMIT */
+    case 36: /* UPDATE */
+    case 37: /* DELETE */
+    case 38: /* TRAVERSE */
+    case 39: /* MINDEPTH */
+    case 40: /* MAXDEPTH */
+    case 41: /* STRATEGY */
+    case 42: /* INDEX */
+    case 43: /* IF */
+    case 44: /* NOT */
+    case 45: /* EXISTS */
+    case 46: /* SET */
+    case 47: /* EQ */
+    case 48: /* SHARP */
+    case 49: /* COLON */
+    case 50: /* OR */
+    case 51: /* AND */
+    case 52: /* LT */
+    case 53: /* GT */
+    case 54: /* GE */
+    case 55: /* LE */
+    case 56: /* NE */
+    case 57: /* IS */
+    case 58: /* CONTAIN */
+    case 59: /* CASE */
+    case 60: /* BEGIN */
+    case 61: /* WITH */
+    case 62: /* END */
+    case 63: /* LIKE */
+    case 64: /* REGEX */
+    case 65: /* BETWEEN */
+    case 66: /* NULL */
+    case 67: /* FLOAT */
+    case 68: /* BLOB */
+    case 70: /* input */
+    case 71: /* cmd */
+    case 97: /* sort_order */
+    case 107: /* index_type */
+    case 110: /* term_token */
+      yy_move< Token >(std::addressof(yyDest->yy0), std::addressof(yySource->yy0));
+      break;
+    case 0: /* $ */
+      yy_move<void>(std::addressof(yyDest->yy187), std::addressof(yySource->yy187));
+      break;
+    case 72: /* if_not_exists_opt */
+    case 74: /* if_exists_opt */
+      yy_move< bool >(std::addressof(yyDest->yy215), std::addressof(yySource->yy215));
+      break;
+    case 73: /* term */
+      yy_move< Bytes >(std::addressof(yyDest->yy166), std::addressof(yySource->yy166));
+      break;
+    case 75: /* props_opt */
+    case 108: /* props_list */
+      yy_move< nogdb::Record >(std::addressof(yyDest->yy56), std::addressof(yySource->yy56));
+      break;
+    case 76: /* create_edge_stmt */
+      yy_move< CreateEdgeArgs >(std::addressof(yyDest->yy123), std::addressof(yySource->yy123));
+      break;
+    case 77: /* select_target_without_class */
+    case 80: /* from_opt */
+    case 89: /* select_target */
+    case 101: /* from_edge_opt */
+    case 102: /* to_edge_opt */
+      yy_move< Target >(std::addressof(yyDest->yy22), std::addressof(yySource->yy22));
+      break;
+    case 78: /* select_stmt */
+      yy_move< SelectArgs >(std::addressof(yyDest->yy186), std::addressof(yySource->yy186));
+      break;
+    case 79: /* projections */
+      yy_move< vector<Projection> >(std::addressof(yyDest->yy143), std::addressof(yySource->yy143));
+      break;
+    case 81: /* where_opt */
+      yy_move< Where >(std::addressof(yyDest->yy78), std::addressof(yySource->yy78));
+      break;
+    case 82: /* group_by */
+    case 95: /* prop_name */
+    case 106: /* strategy_opt */
+      yy_move< string >(std::addressof(yyDest->yy62), std::addressof(yySource->yy62));
+      break;
+    case 83: /* order_by */
+      yy_move< void * >(std::addressof(yyDest->yy157), std::addressof(yySource->yy157));
+      break;
+    case 84: /* skip */
+    case 85: /* limit */
+      yy_move< int >(std::addressof(yyDest->yy82), std::addressof(yySource->yy82));
+      break;
+    case 86: /* proj_alias */
+    case 87: /* proj_item */
+      yy_move< Projection >(std::addressof(yyDest->yy174), std::addressof(yySource->yy174));
+      break;
+    case 88: /* cond */
+      yy_move< Condition >(std::addressof(yyDest->yy132), std::addressof(yySource->yy132));
+      break;
+    case 90: /* select_target_rids */
+    case 93: /* rid_set */
+      yy_move< RecordDescriptorSet >(std::addressof(yyDest->yy59), std::addressof(yySource->yy59));
+      break;
+    case 91: /* traverse_stmt */
+      yy_move< TraverseArgs >(std::addressof(yyDest->yy98), std::addressof(yySource->yy98));
+      break;
+    case 92: /* rid */
+      yy_move< RecordDescriptor >(std::addressof(yyDest->yy3), std::addressof(yySource->yy3));
+      break;
+    case 94: /* multi_cond */
+      yy_move< shared_ptr<MultiCondition> >(std::addressof(yyDest->yy209), std::addressof(yySource->yy209));
+      break;
+    case 96: /* name_set */
+    case 103: /* class_filter */
+      yy_move< set<string> >(std::addressof(yyDest->yy172), std::addressof(yySource->yy172));
+      break;
+    case 98: /* update_stmt */
+      yy_move< UpdateArgs >(std::addressof(yyDest->yy73), std::addressof(yySource->yy73));
+      break;
+    case 99: /* delete_vertex_stmt */
+      yy_move< DeleteVertexArgs >(std::addressof(yyDest->yy211), std::addressof(yySource->yy211));
+      break;
+    case 100: /* delete_edge_stmt */
+      yy_move< DeleteEdgeArgs >(std::addressof(yyDest->yy18), std::addressof(yySource->yy18));
+      break;
+    case 104: /* min_depth_opt */
+    case 105: /* max_depth_opt */
+      yy_move< long long >(std::addressof(yyDest->yy87), std::addressof(yySource->yy87));
+      break;
+    case 109: /* term_list */
+      yy_move< vector<Bytes> >(std::addressof(yyDest->yy99), std::addressof(yySource->yy99));
+      break;
+/********* End move definitions *****************************************/
+    default:  break;   /* If no move action specified: do nothing */
+      //yyDest.minor = yySource.minor;
+  }
+}
+
+
+/*
+** Pop the parser's stack once.
+**
+** If there is a destructor routine associated with the token which
+** is popped from the stack, then call it.
+*/
+void yypParser::yy_pop_parser_stack(){
+  yyStackEntry *yymsp;
+  assert( yytos!=0 );
+  assert( yytos > yystack );
+  yymsp = yytos--;
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    fprintf(yyTraceFILE,"%sPopping %s\n",
+      yyTracePrompt,
+      yyTokenName[yymsp->major]);
+  }
+#endif
+  yy_destructor(yymsp->major, &yymsp->minor);
+}
+
+
+template<class ...Args>
+yypParser::yypParser(Args&&... args) : LEMON_SUPER(std::forward<Args>(args)...)
+{
+#if YYSTACKDEPTH<=0
+  if( yyGrowStack() ){
+    yystack = &yystk0;
+    yystksz = 1;
+  }
+#else
+  std::memset(yystack, 0, sizeof(yystack));
+#endif
+
+  yytos = yystack;
+  yystack[0].stateno = 0;
+  yystack[0].major = 0;
+#if YYSTACKDEPTH>0
+  yystackEnd = &yystack[YYSTACKDEPTH-1];
+#endif
+}
+
+void yypParser::reset() {
+
+  while( yytos>yystack ) yy_pop_parser_stack();
+
+#ifndef YYNOERRORRECOVERY
+  yyerrcnt = -1;
+#endif
+
+  yytos = yystack;
+  yystack[0].stateno = 0;
+  yystack[0].major = 0;
+
+  LEMON_SUPER::reset();
+}
+
+
+/* 
+** Deallocate and destroy a parser.  Destructors are called for
+** all stack elements before shutting the parser down.
+**
+** If the YYPARSEFREENEVERNULL macro exists (for example because it
+** is defined in a %include section of the input grammar) then it is
+** assumed that the input pointer is never NULL.
+*/
+
+yypParser::~yypParser() {
+  while( yytos>yystack ) yy_pop_parser_stack();
+#if YYSTACKDEPTH<=0
+  if( yystack!=&yystk0 ) free(yystack);
+#endif
+}
+
+/*
+** Find the appropriate action for a parser given the terminal
+** look-ahead token iLookAhead.
+*/
+unsigned yypParser::yy_find_shift_action(
+  int stateno,              /* Current state number */
+  YYCODETYPE iLookAhead     /* The look-ahead token */
+) const {
+  int i;
+ 
+  if( stateno>=YY_MIN_REDUCE ) return stateno;
+  assert( stateno <= YY_SHIFT_COUNT );
+  do{
+    i = yy_shift_ofst[stateno];
+    assert( iLookAhead!=YYNOCODE );
+    i += iLookAhead;
+    if( i<0 || i>=YY_ACTTAB_COUNT || yy_lookahead[i]!=iLookAhead ){
+#ifdef YYFALLBACK
+      YYCODETYPE iFallback;            /* Fallback token */
+      if( iLookAhead<sizeof(yyFallback)/sizeof(yyFallback[0])
+             && (iFallback = yyFallback[iLookAhead])!=0 ){
+#ifndef NDEBUG
+        if( yyTraceFILE ){
+          fprintf(yyTraceFILE, "%sFALLBACK %s => %s\n",
+             yyTracePrompt, yyTokenName[iLookAhead], yyTokenName[iFallback]);
+        }
+#endif
+        assert( yyFallback[iFallback]==0 ); /* Fallback loop must terminate */
+        iLookAhead = iFallback;
+        continue;
+      }
+#endif
+#ifdef YYWILDCARD
+      {
+        int j = i - iLookAhead + YYWILDCARD;
+        if( 
+#if YY_SHIFT_MIN+YYWILDCARD<0
+          j>=0 &&
+#endif
+#if YY_SHIFT_MAX+YYWILDCARD>=YY_ACTTAB_COUNT
+          j<YY_ACTTAB_COUNT &&
+#endif
+          yy_lookahead[j]==YYWILDCARD && iLookAhead>0
+        ){
+#ifndef NDEBUG
+          if( yyTraceFILE ){
+            fprintf(yyTraceFILE, "%sWILDCARD %s => %s\n",
+               yyTracePrompt, yyTokenName[iLookAhead],
+               yyTokenName[YYWILDCARD]);
+          }
+#endif /* NDEBUG */
+          return yy_action[j];
+        }
+      }
+#endif /* YYWILDCARD */
+      return yy_default[stateno];
+    }else{
+      return yy_action[i];
+    }
+  }while(1);
+}
+
+/*
+** Find the appropriate action for a parser given the non-terminal
+** look-ahead token iLookAhead.
+*/
+int yypParser::yy_find_reduce_action(
+  int stateno,              /* Current state number */
+  YYCODETYPE iLookAhead     /* The look-ahead token */
+) const {
+  int i;
+#ifdef YYERRORSYMBOL
+  if( stateno>YY_REDUCE_COUNT ){
+    return yy_default[stateno];
+  }
+#else
+  assert( stateno<=YY_REDUCE_COUNT );
+#endif
+  i = yy_reduce_ofst[stateno];
+  assert( i!=YY_REDUCE_USE_DFLT );
+  assert( iLookAhead!=YYNOCODE );
+  i += iLookAhead;
+#ifdef YYERRORSYMBOL
+  if( i<0 || i>=YY_ACTTAB_COUNT || yy_lookahead[i]!=iLookAhead ){
+    return yy_default[stateno];
+  }
+#else
+  assert( i>=0 && i<YY_ACTTAB_COUNT );
+  assert( yy_lookahead[i]==iLookAhead );
+#endif
+  return yy_action[i];
+}
+
+/*
+** The following routine is called if the stack overflows.
+*/
+void yypParser::yyStackOverflow(){
+#ifndef NDEBUG
+   if( yyTraceFILE ){
+     fprintf(yyTraceFILE,"%sStack Overflow!\n",yyTracePrompt);
+   }
+#endif
+   while( yytos>yystack ) yy_pop_parser_stack();
+   /* Here code is inserted which will execute if the parser
+   ** stack every overflows */
+/******** Begin %stack_overflow code ******************************************/
+/******** End %stack_overflow code ********************************************/
+  LEMON_SUPER::stack_overflow();
+}
+
+/*
+** Print tracing information for a SHIFT action
+*/
+#ifndef NDEBUG
+void yypParser::yyTraceShift(int yyNewState) const {
+  if( yyTraceFILE ){
+    if( yyNewState<YYNSTATE ){
+      fprintf(yyTraceFILE,"%sShift '%s', go to state %d\n",
+         yyTracePrompt,yyTokenName[yytos->major],
+         yyNewState);
+    }else{
+      fprintf(yyTraceFILE,"%sShift '%s'\n",
+         yyTracePrompt,yyTokenName[yytos->major]);
+    }
+  }
+}
+#endif
+
+/*
+** Perform a shift action.
+*/
+void yypParser::yy_shift(
+  int yyNewState,               /* The new state to shift in */
+  int yyMajor,                  /* The major token to shift in */
+  ParseTOKENTYPE &&yyMinor      /* The minor token to shift in */
+){
+  yytos++;
+#ifdef YYTRACKMAXSTACKDEPTH
+  if( yyidx()>yyhwm ){
+    yyhwm++;
+    assert(yyhwm == yyidx());
+  }
+#endif
+#if YYSTACKDEPTH>0 
+  if( yytos>yystackEnd ){
+    yytos--;
+    yyStackOverflow();
+    return;
+  }
+#else
+  if( yytos>=&yystack[yystksz] ){
+    if( yyGrowStack() ){
+      yytos--;
+      yyStackOverflow();
+      return;
+    }
+  }
+#endif
+  if( yyNewState > YY_MAX_SHIFT ){
+    yyNewState += YY_MIN_REDUCE - YY_MIN_SHIFTREDUCE;
+  }
+  yytos->stateno = (YYACTIONTYPE)yyNewState;
+  yytos->major = (YYCODETYPE)yyMajor;
+  //yytos->minor.yy0 = yyMinor;
+  //yy_move also calls the destructor...
+  //yy_move<ParseTOKENTYPE>(std::addressof(yytos->minor.yy0), std::addressof(yyMinor));
+  yy_constructor<ParseTOKENTYPE>(std::addressof(yytos->minor.yy0), std::move(yyMinor));
+  yyTraceShift(yyNewState);
+}
+
+/* The following table contains information about every rule that
+** is used during the reduce.
+*/
+static const struct {
+  YYCODETYPE lhs;       /* Symbol on the left-hand side of the rule */
+  signed char nrhs;     /* Negative of the number of RHS symbols in the rule */
+} yyRuleInfo[] = {
+  { 71, -7 },
+  { 71, -7 },
+  { 71, -6 },
+  { 71, -5 },
+  { 71, -8 },
+  { 71, -8 },
+  { 71, -7 },
+  { 71, -5 },
+  { 71, -2 },
+  { 76, -8 },
+  { 71, -2 },
+  { 78, -8 },
+  { 79, 0 },
+  { 79, -1 },
+  { 79, -3 },
+  { 79, -1 },
+  { 86, -3 },
+  { 87, -3 },
+  { 87, -1 },
+  { 87, -1 },
+  { 87, -2 },
+  { 87, -4 },
+  { 87, -3 },
+  { 87, -7 },
+  { 87, -4 },
+  { 87, -4 },
+  { 87, -7 },
+  { 80, 0 },
+  { 80, -2 },
+  { 89, -1 },
+  { 89, -1 },
+  { 77, -1 },
+  { 77, -3 },
+  { 77, -3 },
+  { 90, -1 },
+  { 90, -3 },
+  { 81, 0 },
+  { 81, -2 },
+  { 81, -2 },
+  { 82, 0 },
+  { 82, -3 },
+  { 84, 0 },
+  { 84, -2 },
+  { 85, 0 },
+  { 85, -2 },
+  { 71, -2 },
+  { 98, -4 },
+  { 71, -2 },
+  { 99, -4 },
+  { 71, -2 },
+  { 100, -3 },
+  { 100, -6 },
+  { 101, 0 },
+  { 101, -2 },
+  { 102, 0 },
+  { 102, -2 },
+  { 71, -2 },
+  { 91, -10 },
+  { 103, 0 },
+  { 103, -1 },
+  { 104, 0 },
+  { 104, -2 },
+  { 105, 0 },
+  { 105, -2 },
+  { 106, 0 },
+  { 106, -2 },
+  { 71, -7 },
+  { 71, -6 },
+  { 107, -1 },
+  { 71, -3 },
+  { 72, 0 },
+  { 72, -3 },
+  { 74, 0 },
+  { 74, -2 },
+  { 75, 0 },
+  { 75, -2 },
+  { 108, -5 },
+  { 108, -3 },
+  { 95, -1 },
+  { 95, -2 },
+  { 92, -4 },
+  { 93, -3 },
+  { 93, -1 },
+  { 96, -3 },
+  { 96, -1 },
+  { 109, -3 },
+  { 109, -1 },
+  { 94, -3 },
+  { 94, -3 },
+  { 94, -3 },
+  { 94, -3 },
+  { 94, -3 },
+  { 94, -3 },
+  { 94, -3 },
+  { 94, -3 },
+  { 94, -3 },
+  { 94, -2 },
+  { 88, -3 },
+  { 88, -2 },
+  { 88, -3 },
+  { 88, -3 },
+  { 88, -3 },
+  { 88, -3 },
+  { 88, -3 },
+  { 88, -3 },
+  { 88, -3 },
+  { 88, -4 },
+  { 88, -4 },
+  { 88, -3 },
+  { 88, -5 },
+  { 88, -4 },
+  { 88, -5 },
+  { 88, -4 },
+  { 88, -4 },
+  { 88, -3 },
+  { 88, -4 },
+  { 88, -3 },
+  { 88, -5 },
+  { 88, -5 },
+  { 73, -1 },
+  { 110, -1 },
+  { 70, -1 },
+  { 86, -1 },
+  { 83, 0 },
+  { 83, -4 },
+  { 97, 0 },
+  { 97, -1 },
+  { 97, -1 },
+  { 107, 0 },
+};
+
+/*
+** Perform a reduce action and the shift that must immediately
+** follow the reduce.
+*/
+void yypParser::yy_reduce(
+  unsigned int yyruleno           /* Number of the rule by which to reduce */
+){
+  int yygoto;                     /* The next state */
+  int yyact;                      /* The next action */
+  yyStackEntry *yymsp;            /* The top of the parser's stack */
+  int yysize;                     /* Amount to pop the stack */
+  yymsp = yytos;
+#ifndef NDEBUG
+  if( yyTraceFILE && yyruleno<(int)(sizeof(yyRuleName)/sizeof(yyRuleName[0])) ){
+    yysize = yyRuleInfo[yyruleno].nrhs;
+    fprintf(yyTraceFILE, "%sReduce [%s], go to state %d.\n", yyTracePrompt,
+      yyRuleName[yyruleno], yymsp[yysize].stateno);
+  }
+#endif /* NDEBUG */
+
+  /* Check that the stack is large enough to grow by a single entry
+  ** if the RHS of the rule is empty.  This ensures that there is room
+  ** enough on the stack to push the LHS value */
+  if( yyRuleInfo[yyruleno].nrhs==0 ){
+#ifdef YYTRACKMAXSTACKDEPTH
+    if( yyidx()>yyhwm ){
+      yyhwm++;
+      assert(yyhwm == yyidx());
+    }
+#endif
+#if YYSTACKDEPTH>0 
+    if( yytos>=yystackEnd ){
+      yyStackOverflow();
+      return;
+    }
+#else
+    if( yytos>=&yystack[yystksz-1] ){
+      if( yyGrowStack() ){
+        yyStackOverflow();
+        return;
+      }
+      yymsp = yytos;
+    }
+#endif
+  }
+
+  switch( yyruleno ){
+  /* Beginning here are the reduction cases.  A typical example
+  ** follows:
+  **   case 0:
+  **  #line <lineno> <grammarfile>
+  **     { ... }           // User supplied code
+  **  #line <lineno> <thisfile>
+  **     break;
+  */
+/********** Begin reduce actions **********************************************/
+      case 0: /* cmd ::= CREATE CLASS IDENTITY|STRING if_not_exists_opt EXTENDS VERTEX|EDGE SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &name=yy_cast< Token >(std::addressof(yymsp[-4].minor.yy0));
+  auto &checkIfNotExists=yy_cast< bool >(std::addressof(yymsp[-3].minor.yy215));
+  auto &type=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+#line 76 "/root/repo/src/sql_parser.y"
+{
+    this->createClass(name, type, checkIfNotExists);
+}
+#line 1689 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(name);
+  yy_destructor(checkIfNotExists);
+  yy_destructor(type);
+  yy_constructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+}
+        break;
+      case 1: /* cmd ::= CREATE CLASS IDENTITY|STRING if_not_exists_opt EXTENDS IDENTITY|STRING SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &name=yy_cast< Token >(std::addressof(yymsp[-4].minor.yy0));
+  auto &checkIfNotExists=yy_cast< bool >(std::addressof(yymsp[-3].minor.yy215));
+  auto &extend=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+#line 79 "/root/repo/src/sql_parser.y"
+{
+    this->createClass(name, extend, checkIfNotExists);
+}
+#line 1709 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(name);
+  yy_destructor(checkIfNotExists);
+  yy_destructor(extend);
+  yy_constructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+}
+        break;
+      case 2: /* cmd ::= ALTER CLASS IDENTITY|STRING IDENTITY term SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &name=yy_cast< Token >(std::addressof(yymsp[-3].minor.yy0));
+  auto &attr=yy_cast< Token >(std::addressof(yymsp[-2].minor.yy0));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[-1].minor.yy166));
+#line 84 "/root/repo/src/sql_parser.y"
+{
+    this->alterClass(name, attr, value);
+}
+#line 1728 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(name);
+  yy_destructor(attr);
+  yy_destructor(value);
+  yy_constructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+}
+        break;
+      case 3: /* cmd ::= DROP CLASS IDENTITY|STRING if_exists_opt SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &name=yy_cast< Token >(std::addressof(yymsp[-2].minor.yy0));
+  auto &checkIfExists=yy_cast< bool >(std::addressof(yymsp[-1].minor.yy215));
+#line 89 "/root/repo/src/sql_parser.y"
+{
+    this->dropClass(name, checkIfExists);
+}
+#line 1746 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(name);
+  yy_destructor(checkIfExists);
+  yy_constructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+}
+        break;
+      case 4: /* cmd ::= CREATE PROPERTY IDENTITY|STRING DOT IDENTITY|STRING if_not_exists_opt IDENTITY|STRING SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-7].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &className=yy_cast< Token >(std::addressof(yymsp[-5].minor.yy0));
+  auto &propName=yy_cast< Token >(std::addressof(yymsp[-3].minor.yy0));
+  auto &checkIfNotExists=yy_cast< bool >(std::addressof(yymsp[-2].minor.yy215));
+  auto &type=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+#line 96 "/root/repo/src/sql_parser.y"
+{
+    this->createProperty(className, propName, type, checkIfNotExists);
+}
+#line 1766 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(className);
+  yy_destructor(propName);
+  yy_destructor(checkIfNotExists);
+  yy_destructor(type);
+  yy_constructor< Token >(std::addressof(yymsp[-7].minor.yy0));
+}
+        break;
+      case 5: /* cmd ::= ALTER PROPERTY IDENTITY|STRING DOT IDENTITY|STRING IDENTITY term SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-7].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &className=yy_cast< Token >(std::addressof(yymsp[-5].minor.yy0));
+  auto &propName=yy_cast< Token >(std::addressof(yymsp[-3].minor.yy0));
+  auto &attr=yy_cast< Token >(std::addressof(yymsp[-2].minor.yy0));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[-1].minor.yy166));
+#line 101 "/root/repo/src/sql_parser.y"
+{
+    this->alterProperty(className, propName, attr, value);
+}
+#line 1788 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(className);
+  yy_destructor(propName);
+  yy_destructor(attr);
+  yy_destructor(value);
+  yy_constructor< Token >(std::addressof(yymsp[-7].minor.yy0));
+}
+        break;
+      case 6: /* cmd ::= DROP PROPERTY IDENTITY|STRING DOT IDENTITY|STRING if_exists_opt SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &className=yy_cast< Token >(std::addressof(yymsp[-4].minor.yy0));
+  auto &propName=yy_cast< Token >(std::addressof(yymsp[-2].minor.yy0));
+  auto &checkIfExists=yy_cast< bool >(std::addressof(yymsp[-1].minor.yy215));
+#line 106 "/root/repo/src/sql_parser.y"
+{
+    this->dropProperty(className, propName, checkIfExists);
+}
+#line 1809 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(className);
+  yy_destructor(propName);
+  yy_destructor(checkIfExists);
+  yy_constructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+}
+        break;
+      case 7: /* cmd ::= CREATE VERTEX IDENTITY|STRING props_opt SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &name=yy_cast< Token >(std::addressof(yymsp[-2].minor.yy0));
+  auto &prop=yy_cast< nogdb::Record >(std::addressof(yymsp[-1].minor.yy56));
+#line 115 "/root/repo/src/sql_parser.y"
+{
+    this->createVertex(name, prop);
+}
+#line 1827 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(name);
+  yy_destructor(prop);
+  yy_constructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+}
+        break;
+      case 8: /* cmd ::= create_edge_stmt SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &s=yy_cast< CreateEdgeArgs >(std::addressof(yymsp[-1].minor.yy123));
+#line 121 "/root/repo/src/sql_parser.y"
+{
+    this->createEdge(s);
+}
+#line 1841 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(s);
+  yy_constructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+}
+        break;
+      case 9: /* create_edge_stmt ::= CREATE EDGE IDENTITY|STRING FROM select_target_without_class TO select_target_without_class props_opt */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-7].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  auto &A=yy_constructor< CreateEdgeArgs >(std::addressof(yymsp[-7].minor.yy123));
+  auto &name=yy_cast< Token >(std::addressof(yymsp[-5].minor.yy0));
+  auto &src=yy_cast< Target >(std::addressof(yymsp[-3].minor.yy22));
+  auto &dest=yy_cast< Target >(std::addressof(yymsp[-1].minor.yy22));
+  auto &prop=yy_cast< nogdb::Record >(std::addressof(yymsp[0].minor.yy56));
+#line 126 "/root/repo/src/sql_parser.y"
+{
+    A = CreateEdgeArgs{name.toString(), move(src), move(dest), move(prop)};
+}
+#line 1861 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(name);
+  yy_destructor(src);
+  yy_destructor(dest);
+  yy_destructor(prop);
+}
+        break;
+      case 10: /* cmd ::= select_stmt SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &stmt=yy_cast< SelectArgs >(std::addressof(yymsp[-1].minor.yy186));
+#line 132 "/root/repo/src/sql_parser.y"
+{
+    this->select(stmt);
+}
+#line 1876 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(stmt);
+  yy_constructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+}
+        break;
+      case 11: /* select_stmt ::= SELECT projections from_opt where_opt group_by order_by skip limit */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-7].minor.yy0));
+  auto &A=yy_constructor< SelectArgs >(std::addressof(yymsp[-7].minor.yy186));
+  auto &proj=yy_cast< vector<Projection> >(std::addressof(yymsp[-6].minor.yy143));
+  auto &from=yy_cast< Target >(std::addressof(yymsp[-5].minor.yy22));
+  auto &where=yy_cast< Where >(std::addressof(yymsp[-4].minor.yy78));
+  auto &group=yy_cast< string >(std::addressof(yymsp[-3].minor.yy62));
+  auto &order=yy_cast< void * >(std::addressof(yymsp[-2].minor.yy157));
+  auto &skip=yy_cast< int >(std::addressof(yymsp[-1].minor.yy82));
+  auto &limit=yy_cast< int >(std::addressof(yymsp[0].minor.yy82));
+#line 137 "/root/repo/src/sql_parser.y"
+{
+    A = SelectArgs{move(proj), move(from), move(where), group, order, skip, limit};
+}
+#line 1896 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(proj);
+  yy_destructor(from);
+  yy_destructor(where);
+  yy_destructor(group);
+  yy_destructor(order);
+  yy_destructor(skip);
+  yy_destructor(limit);
+}
+        break;
+      case 12: /* projections ::= */
+{
+  auto &A=yy_constructor< vector<Projection> >(std::addressof(yymsp[1].minor.yy143));
+#line 143 "/root/repo/src/sql_parser.y"
+{ A = vector<Projection>(); }
+#line 1911 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 13: /* projections ::= STAR */
+{
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &A=yy_constructor< vector<Projection> >(std::addressof(yymsp[0].minor.yy143));
+#line 144 "/root/repo/src/sql_parser.y"
+{ A = vector<Projection>(); }
+#line 1920 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 14: /* projections ::= projections COMMA proj_alias */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_cast< vector<Projection> >(std::addressof(yymsp[-2].minor.yy143));
+  auto &X=yy_cast< Projection >(std::addressof(yymsp[0].minor.yy174));
+#line 145 "/root/repo/src/sql_parser.y"
+{ A.push_back(move(X)); }
+#line 1930 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 15: /* projections ::= proj_alias */
+{
+   vector<Projection>  A;
+  auto &X=yy_cast< Projection >(std::addressof(yymsp[0].minor.yy174));
+#line 146 "/root/repo/src/sql_parser.y"
+{ A = vector<Projection>{X}; }
+#line 1940 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< vector<Projection> >(std::addressof(yymsp[0].minor.yy143), std::move(A));
+}
+        break;
+      case 16: /* proj_alias ::= proj_item AS IDENTITY|STRING */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Projection  A;
+  auto &X=yy_cast< Projection >(std::addressof(yymsp[-2].minor.yy174));
+  auto &Y=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 150 "/root/repo/src/sql_parser.y"
+{
+    A = Projection(ProjectionType::ALIAS, make_shared<pair<Projection, string>>(move(X), Y.toString()));
+}
+#line 1955 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< Projection >(std::addressof(yymsp[-2].minor.yy174), std::move(A));
+}
+        break;
+      case 17: /* proj_item ::= LP proj_item RP */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &A=yy_constructor< Projection >(std::addressof(yymsp[-2].minor.yy174));
+  auto &X=yy_cast< Projection >(std::addressof(yymsp[-1].minor.yy174));
+#line 155 "/root/repo/src/sql_parser.y"
+{ A = move(X); }
+#line 1969 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 18: /* proj_item ::= IDENTITY */
+      case 19: /* proj_item ::= STRING */ yytestcase(yyruleno==19);
+{
+   Projection  A;
+  auto &X=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 156 "/root/repo/src/sql_parser.y"
+{
+    A = Projection(ProjectionType::PROPERTY, make_shared<string>(X.toString()));
+}
+#line 1982 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< Projection >(std::addressof(yymsp[0].minor.yy174), std::move(A));
+}
+        break;
+      case 20: /* proj_item ::= AT IDENTITY */
+{
+   Projection  A;
+  auto &X=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &Y=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 162 "/root/repo/src/sql_parser.y"
+{
+    Token atProp{X.z, static_cast<int>(Y.z + Y.n - X.z), X.t};
+    A = Projection(ProjectionType::PROPERTY, make_shared<string>(atProp.toString()));
+}
+#line 1997 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< Projection >(std::addressof(yymsp[-1].minor.yy174), std::move(A));
+}
+        break;
+      case 21: /* proj_item ::= IDENTITY LP projections RP */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+   Projection  A;
+  auto &fName=yy_cast< Token >(std::addressof(yymsp[-3].minor.yy0));
+  auto &args=yy_cast< vector<Projection> >(std::addressof(yymsp[-1].minor.yy143));
+#line 166 "/root/repo/src/sql_parser.y"
+{
+    A = Projection(ProjectionType::FUNCTION, make_shared<Function>(fName.toString(), move(args)));
+}
+#line 2014 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(fName);
+  yy_destructor(args);
+  yy_constructor< Projection >(std::addressof(yymsp[-3].minor.yy174), std::move(A));
+}
+        break;
+      case 22: /* proj_item ::= proj_item DOT proj_item */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Projection  A;
+  auto &X=yy_cast< Projection >(std::addressof(yymsp[-2].minor.yy174));
+  auto &Y=yy_cast< Projection >(std::addressof(yymsp[0].minor.yy174));
+#line 170 "/root/repo/src/sql_parser.y"
+{
+    A = Projection(ProjectionType::METHOD, make_shared<pair<Projection, Projection>>(move(X), move(Y)));
+}
+#line 2030 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< Projection >(std::addressof(yymsp[-2].minor.yy174), std::move(A));
+}
+        break;
+      case 23: /* proj_item ::= IDENTITY LP projections RP LB SIGNED|UNSIGNED RB */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+   Projection  A;
+  auto &fName=yy_cast< Token >(std::addressof(yymsp[-6].minor.yy0));
+  auto &fArgs=yy_cast< vector<Projection> >(std::addressof(yymsp[-4].minor.yy143));
+  auto &index=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+#line 173 "/root/repo/src/sql_parser.y"
+{
+    A = Projection(
+            ProjectionType::ARRAY_SELECTOR,
+            make_shared<pair<Projection, unsigned long>>(
+                Projection(ProjectionType::FUNCTION, make_shared<Function>(fName.toString(), move(fArgs))),
+                stoull(string(index.z, index.n))));
+}
+#line 2054 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(fName);
+  yy_destructor(fArgs);
+  yy_destructor(index);
+  yy_constructor< Projection >(std::addressof(yymsp[-6].minor.yy174), std::move(A));
+}
+        break;
+      case 24: /* proj_item ::= IDENTITY LB SIGNED|UNSIGNED RB */
+      case 25: /* proj_item ::= STRING LB SIGNED|UNSIGNED RB */ yytestcase(yyruleno==25);
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+   Projection  A;
+  auto &X=yy_cast< Token >(std::addressof(yymsp[-3].minor.yy0));
+  auto &index=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+#line 180 "/root/repo/src/sql_parser.y"
+{
+    A = Projection(
+            ProjectionType::ARRAY_SELECTOR,
+            make_shared<pair<Projection, unsigned long>>(
+                Projection(ProjectionType::PROPERTY, make_shared<string>(X.toString())),
+                stoull(string(index.z, index.n))));
+}
+#line 2077 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(index);
+  yy_constructor< Projection >(std::addressof(yymsp[-3].minor.yy174), std::move(A));
+}
+        break;
+      case 26: /* proj_item ::= IDENTITY LP projections RP LB cond RB */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+   Projection  A;
+  auto &fName=yy_cast< Token >(std::addressof(yymsp[-6].minor.yy0));
+  auto &fArgs=yy_cast< vector<Projection> >(std::addressof(yymsp[-4].minor.yy143));
+  auto &c=yy_cast< Condition >(std::addressof(yymsp[-1].minor.yy132));
+#line 194 "/root/repo/src/sql_parser.y"
+{
+    A = Projection(
+        ProjectionType::CONDITION,
+        make_shared<pair<Projection, Condition>>(
+            Projection(ProjectionType::FUNCTION, make_shared<Function>(fName.toString(), move(fArgs))),
+            c));
+}
+#line 2101 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(fName);
+  yy_destructor(fArgs);
+  yy_destructor(c);
+  yy_constructor< Projection >(std::addressof(yymsp[-6].minor.yy174), std::move(A));
+}
+        break;
+      case 27: /* from_opt ::= */
+      case 52: /* from_edge_opt ::= */ yytestcase(yyruleno==52);
+      case 54: /* to_edge_opt ::= */ yytestcase(yyruleno==54);
+{
+  auto &A=yy_constructor< Target >(std::addressof(yymsp[1].minor.yy22));
+#line 204 "/root/repo/src/sql_parser.y"
+{ A = Target(); }
+#line 2115 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 28: /* from_opt ::= FROM select_target */
+      case 53: /* from_edge_opt ::= FROM select_target_without_class */ yytestcase(yyruleno==53);
+      case 55: /* to_edge_opt ::= TO select_target_without_class */ yytestcase(yyruleno==55);
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< Target >(std::addressof(yymsp[-1].minor.yy22));
+  auto &X=yy_cast< Target >(std::addressof(yymsp[0].minor.yy22));
+#line 205 "/root/repo/src/sql_parser.y"
+{ A = X; }
+#line 2127 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 29: /* select_target ::= IDENTITY|STRING */
+{
+   Target  A;
+  auto &class_=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 208 "/root/repo/src/sql_parser.y"
+{
+    A = Target(TargetType::CLASS, make_shared<string>(class_.toString()));
+}
+#line 2139 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(class_);
+  yy_constructor< Target >(std::addressof(yymsp[0].minor.yy22), std::move(A));
+}
+        break;
+      case 30: /* select_target ::= select_target_without_class */
+{
+   Target  A;
+  auto &X=yy_cast< Target >(std::addressof(yymsp[0].minor.yy22));
+#line 211 "/root/repo/src/sql_parser.y"
+{ A = X; }
+#line 2150 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< Target >(std::addressof(yymsp[0].minor.yy22), std::move(A));
+}
+        break;
+      case 31: /* select_target_without_class ::= select_target_rids */
+{
+   Target  A;
+  auto &rids=yy_cast< RecordDescriptorSet >(std::addressof(yymsp[0].minor.yy59));
+#line 214 "/root/repo/src/sql_parser.y"
+{
+    A = Target(TargetType::RIDS, make_shared<RecordDescriptorSet>(move(rids)));
+}
+#line 2163 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(rids);
+  yy_constructor< Target >(std::addressof(yymsp[0].minor.yy22), std::move(A));
+}
+        break;
+      case 32: /* select_target_without_class ::= LP select_stmt RP */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &A=yy_constructor< Target >(std::addressof(yymsp[-2].minor.yy22));
+  auto &stmt=yy_cast< SelectArgs >(std::addressof(yymsp[-1].minor.yy186));
+#line 217 "/root/repo/src/sql_parser.y"
+{
+    A = Target(TargetType::NESTED, make_shared<SelectArgs>(move(stmt)));
+}
+#line 2178 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(stmt);
+}
+        break;
+      case 33: /* select_target_without_class ::= LP traverse_stmt RP */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &A=yy_constructor< Target >(std::addressof(yymsp[-2].minor.yy22));
+  auto &stmt=yy_cast< TraverseArgs >(std::addressof(yymsp[-1].minor.yy98));
+#line 220 "/root/repo/src/sql_parser.y"
+{
+    A = Target(TargetType::NESTED_TRAVERSE, make_shared<TraverseArgs>(move(stmt)));
+}
+#line 2192 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(stmt);
+}
+        break;
+      case 34: /* select_target_rids ::= rid */
+      case 82: /* rid_set ::= rid */ yytestcase(yyruleno==82);
+{
+   RecordDescriptorSet  A;
+  auto &X=yy_cast< RecordDescriptor >(std::addressof(yymsp[0].minor.yy3));
+#line 225 "/root/repo/src/sql_parser.y"
+{ A = RecordDescriptorSet{X}; }
+#line 2203 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< RecordDescriptorSet >(std::addressof(yymsp[0].minor.yy59), std::move(A));
+}
+        break;
+      case 35: /* select_target_rids ::= LP rid_set RP */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &A=yy_constructor< RecordDescriptorSet >(std::addressof(yymsp[-2].minor.yy59));
+  auto &X=yy_cast< RecordDescriptorSet >(std::addressof(yymsp[-1].minor.yy59));
+#line 226 "/root/repo/src/sql_parser.y"
+{ A = X; }
+#line 2216 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 36: /* where_opt ::= */
+{
+  auto &A=yy_constructor< Where >(std::addressof(yymsp[1].minor.yy78));
+#line 230 "/root/repo/src/sql_parser.y"
+{ A = Where(); }
+#line 2225 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 37: /* where_opt ::= WHERE multi_cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< Where >(std::addressof(yymsp[-1].minor.yy78));
+  auto &X=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[0].minor.yy209));
+#line 231 "/root/repo/src/sql_parser.y"
+{
+    A = Where(WhereType::MULTI_COND, X);
+}
+#line 2237 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 38: /* where_opt ::= WHERE cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< Where >(std::addressof(yymsp[-1].minor.yy78));
+  auto &X=yy_cast< Condition >(std::addressof(yymsp[0].minor.yy132));
+#line 234 "/root/repo/src/sql_parser.y"
+{
+    A = Where(WhereType::CONDITION, make_shared<Condition>(move(X)));
+}
+#line 2250 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 39: /* group_by ::= */
+{
+  auto &A=yy_constructor< string >(std::addressof(yymsp[1].minor.yy62));
+#line 240 "/root/repo/src/sql_parser.y"
+{ A = string(); }
+#line 2259 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 40: /* group_by ::= GROUP BY prop_name */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &X=yy_cast< string >(std::addressof(yymsp[0].minor.yy62));
+#line 241 "/root/repo/src/sql_parser.y"
+{ A = X; }
+#line 2270 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 41: /* skip ::= */
+      case 43: /* limit ::= */ yytestcase(yyruleno==43);
+{
+  auto &A=yy_constructor< int >(std::addressof(yymsp[1].minor.yy82));
+#line 253 "/root/repo/src/sql_parser.y"
+{ A = -1; }
+#line 2280 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 42: /* skip ::= SKIP SIGNED|UNSIGNED */
+      case 44: /* limit ::= LIMIT SIGNED|UNSIGNED */ yytestcase(yyruleno==44);
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< int >(std::addressof(yymsp[-1].minor.yy82));
+  auto &X=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 254 "/root/repo/src/sql_parser.y"
+{ A = stoi(string(X.z, X.n)); }
+#line 2291 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 45: /* cmd ::= update_stmt SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &stmt=yy_cast< UpdateArgs >(std::addressof(yymsp[-1].minor.yy73));
+#line 263 "/root/repo/src/sql_parser.y"
+{
+    this->update(stmt);
+}
+#line 2303 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(stmt);
+  yy_constructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+}
+        break;
+      case 46: /* update_stmt ::= UPDATE select_target props_opt where_opt */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  auto &A=yy_constructor< UpdateArgs >(std::addressof(yymsp[-3].minor.yy73));
+  auto &target=yy_cast< Target >(std::addressof(yymsp[-2].minor.yy22));
+  auto &prop=yy_cast< nogdb::Record >(std::addressof(yymsp[-1].minor.yy56));
+  auto &where=yy_cast< Where >(std::addressof(yymsp[0].minor.yy78));
+#line 268 "/root/repo/src/sql_parser.y"
+{
+    A = UpdateArgs{move(target), move(prop), move(where)};
+}
+#line 2319 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(target);
+  yy_destructor(prop);
+  yy_destructor(where);
+}
+        break;
+      case 47: /* cmd ::= delete_vertex_stmt SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &stmt=yy_cast< DeleteVertexArgs >(std::addressof(yymsp[-1].minor.yy211));
+#line 274 "/root/repo/src/sql_parser.y"
+{
+    this->deleteVertex(stmt);
+}
+#line 2333 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(stmt);
+  yy_constructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+}
+        break;
+      case 48: /* delete_vertex_stmt ::= DELETE VERTEX select_target where_opt */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  auto &A=yy_constructor< DeleteVertexArgs >(std::addressof(yymsp[-3].minor.yy211));
+  auto &target=yy_cast< Target >(std::addressof(yymsp[-1].minor.yy22));
+  auto &where=yy_cast< Where >(std::addressof(yymsp[0].minor.yy78));
+#line 279 "/root/repo/src/sql_parser.y"
+{
+    A = DeleteVertexArgs{move(target), move(where)};
+}
+#line 2349 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(target);
+  yy_destructor(where);
+}
+        break;
+      case 49: /* cmd ::= delete_edge_stmt SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &stmt=yy_cast< DeleteEdgeArgs >(std::addressof(yymsp[-1].minor.yy18));
+#line 285 "/root/repo/src/sql_parser.y"
+{
+    this->deleteEdge(stmt);
+}
+#line 2362 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(stmt);
+  yy_constructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+}
+        break;
+      case 50: /* delete_edge_stmt ::= DELETE EDGE select_target_rids */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< DeleteEdgeArgs >(std::addressof(yymsp[-2].minor.yy18));
+  auto &rids=yy_cast< RecordDescriptorSet >(std::addressof(yymsp[0].minor.yy59));
+#line 290 "/root/repo/src/sql_parser.y"
+{
+    auto target = Target(TargetType::RIDS, make_shared<RecordDescriptorSet>(move(rids)));
+    A = DeleteEdgeArgs{move(target), Target(), Target(), Where()};
+}
+#line 2378 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(rids);
+}
+        break;
+      case 51: /* delete_edge_stmt ::= DELETE EDGE IDENTITY|STRING from_edge_opt to_edge_opt where_opt */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+  auto &A=yy_constructor< DeleteEdgeArgs >(std::addressof(yymsp[-5].minor.yy18));
+  auto &name=yy_cast< Token >(std::addressof(yymsp[-3].minor.yy0));
+  auto &from=yy_cast< Target >(std::addressof(yymsp[-2].minor.yy22));
+  auto &to=yy_cast< Target >(std::addressof(yymsp[-1].minor.yy22));
+  auto &where=yy_cast< Where >(std::addressof(yymsp[0].minor.yy78));
+#line 294 "/root/repo/src/sql_parser.y"
+{
+    auto target = Target(TargetType::CLASS, make_shared<string>(name.toString()));
+    A = DeleteEdgeArgs{move(target), move(from), move(to), move(where)};
+}
+#line 2396 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(name);
+  yy_destructor(from);
+  yy_destructor(to);
+  yy_destructor(where);
+}
+        break;
+      case 56: /* cmd ::= traverse_stmt SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &stmt=yy_cast< TraverseArgs >(std::addressof(yymsp[-1].minor.yy98));
+#line 309 "/root/repo/src/sql_parser.y"
+{
+    this->traverse(stmt);
+}
+#line 2411 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(stmt);
+  yy_constructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+}
+        break;
+      case 57: /* traverse_stmt ::= TRAVERSE IDENTITY LP class_filter RP FROM rid_set min_depth_opt max_depth_opt strategy_opt */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-9].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-7].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+  auto &A=yy_constructor< TraverseArgs >(std::addressof(yymsp[-9].minor.yy98));
+  auto &direction=yy_cast< Token >(std::addressof(yymsp[-8].minor.yy0));
+  auto &filter=yy_cast< set<string> >(std::addressof(yymsp[-6].minor.yy172));
+  auto &root=yy_cast< RecordDescriptorSet >(std::addressof(yymsp[-3].minor.yy59));
+  auto &min_depth=yy_cast< long long >(std::addressof(yymsp[-2].minor.yy87));
+  auto &max_depth=yy_cast< long long >(std::addressof(yymsp[-1].minor.yy87));
+  auto &strategy=yy_cast< string >(std::addressof(yymsp[0].minor.yy62));
+#line 319 "/root/repo/src/sql_parser.y"
+{
+    A = TraverseArgs{direction.toString(), filter, root, min_depth, max_depth, strategy};
+}
+#line 2433 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(direction);
+  yy_destructor(filter);
+  yy_destructor(root);
+  yy_destructor(min_depth);
+  yy_destructor(max_depth);
+  yy_destructor(strategy);
+}
+        break;
+      case 58: /* class_filter ::= */
+{
+  auto &A=yy_constructor< set<string> >(std::addressof(yymsp[1].minor.yy172));
+#line 324 "/root/repo/src/sql_parser.y"
+{ A = set<string>(); }
+#line 2447 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 59: /* class_filter ::= name_set */
+{
+   set<string>  A;
+  auto &X=yy_cast< set<string> >(std::addressof(yymsp[0].minor.yy172));
+#line 325 "/root/repo/src/sql_parser.y"
+{ A = move(X); }
+#line 2456 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< set<string> >(std::addressof(yymsp[0].minor.yy172), std::move(A));
+}
+        break;
+      case 60: /* min_depth_opt ::= */
+{
+  auto &A=yy_constructor< long long >(std::addressof(yymsp[1].minor.yy87));
+#line 328 "/root/repo/src/sql_parser.y"
+{ A = 0; }
+#line 2466 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 61: /* min_depth_opt ::= MINDEPTH SIGNED|UNSIGNED */
+      case 63: /* max_depth_opt ::= MAXDEPTH SIGNED|UNSIGNED */ yytestcase(yyruleno==63);
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< long long >(std::addressof(yymsp[-1].minor.yy87));
+  auto &X=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 329 "/root/repo/src/sql_parser.y"
+{ A = stoll(string(X.z, X.n)); }
+#line 2477 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 62: /* max_depth_opt ::= */
+{
+  auto &A=yy_constructor< long long >(std::addressof(yymsp[1].minor.yy87));
+#line 332 "/root/repo/src/sql_parser.y"
+{ A = UINT_MAX; }
+#line 2486 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 64: /* strategy_opt ::= */
+{
+  auto &A=yy_constructor< string >(std::addressof(yymsp[1].minor.yy62));
+#line 336 "/root/repo/src/sql_parser.y"
+{ A = "DEPTH_FIRST"; }
+#line 2494 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 65: /* strategy_opt ::= STRATEGY IDENTITY */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< string >(std::addressof(yymsp[-1].minor.yy62));
+  auto &X=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 337 "/root/repo/src/sql_parser.y"
+{ A = X.toString(); }
+#line 2504 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 66: /* cmd ::= CREATE INDEX IDENTITY|STRING DOT IDENTITY|STRING index_type SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &className=yy_cast< Token >(std::addressof(yymsp[-4].minor.yy0));
+  auto &propName=yy_cast< Token >(std::addressof(yymsp[-2].minor.yy0));
+  auto &type=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+#line 341 "/root/repo/src/sql_parser.y"
+{
+    this->createIndex(className, propName, type);
+}
+#line 2521 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(className);
+  yy_destructor(propName);
+  yy_destructor(type);
+  yy_constructor< Token >(std::addressof(yymsp[-6].minor.yy0));
+}
+        break;
+      case 67: /* cmd ::= DROP INDEX IDENTITY|STRING DOT IDENTITY|STRING SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-4].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &className=yy_cast< Token >(std::addressof(yymsp[-3].minor.yy0));
+  auto &propName=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+#line 346 "/root/repo/src/sql_parser.y"
+{
+    this->dropIndex(className, propName);
+}
+#line 2540 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(className);
+  yy_destructor(propName);
+  yy_constructor< Token >(std::addressof(yymsp[-5].minor.yy0));
+}
+        break;
+      case 68: /* index_type ::= IDENTITY */
+      case 120: /* term_token ::= NULL|FLOAT|STRING|SIGNED|UNSIGNED|BLOB */ yytestcase(yyruleno==120);
+{
+   Token  A;
+  auto &X=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 352 "/root/repo/src/sql_parser.y"
+{ A = X; }
+#line 2553 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< Token >(std::addressof(yymsp[0].minor.yy0), std::move(A));
+}
+        break;
+      case 69: /* cmd ::= SHOW IDENTITY SEMI */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &target=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+#line 357 "/root/repo/src/sql_parser.y"
+{
+    this->show(target);
+}
+#line 2567 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(target);
+  yy_constructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+}
+        break;
+      case 70: /* if_not_exists_opt ::= */
+      case 72: /* if_exists_opt ::= */ yytestcase(yyruleno==72);
+{
+  auto &A=yy_constructor< bool >(std::addressof(yymsp[1].minor.yy215));
+#line 366 "/root/repo/src/sql_parser.y"
+{ A = false; }
+#line 2578 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 71: /* if_not_exists_opt ::= IF NOT EXISTS */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &A=yy_constructor< bool >(std::addressof(yymsp[-2].minor.yy215));
+#line 367 "/root/repo/src/sql_parser.y"
+{ A = true; }
+#line 2589 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 73: /* if_exists_opt ::= IF EXISTS */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &A=yy_constructor< bool >(std::addressof(yymsp[-1].minor.yy215));
+#line 369 "/root/repo/src/sql_parser.y"
+{ A = true; }
+#line 2599 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 74: /* props_opt ::= */
+{
+  auto &A=yy_constructor< nogdb::Record >(std::addressof(yymsp[1].minor.yy56));
+#line 374 "/root/repo/src/sql_parser.y"
+{ A = nogdb::Record(); }
+#line 2607 "/root/repo/src/sql_parser.cpp"
+}
+        break;
+      case 75: /* props_opt ::= SET props_list */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< nogdb::Record >(std::addressof(yymsp[-1].minor.yy56));
+  auto &X=yy_cast< nogdb::Record >(std::addressof(yymsp[0].minor.yy56));
+#line 375 "/root/repo/src/sql_parser.y"
+{ A = move(X); }
+#line 2617 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 76: /* props_list ::= props_list COMMA prop_name EQ term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_cast< nogdb::Record >(std::addressof(yymsp[-4].minor.yy56));
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 376 "/root/repo/src/sql_parser.y"
+{
+    A.set(prop, value.getBase());
+}
+#line 2632 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+}
+        break;
+      case 77: /* props_list ::= prop_name EQ term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   nogdb::Record  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 379 "/root/repo/src/sql_parser.y"
+{
+    A = nogdb::Record().set(prop, value.getBase());
+}
+#line 2647 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< nogdb::Record >(std::addressof(yymsp[-2].minor.yy56), std::move(A));
+}
+        break;
+      case 78: /* prop_name ::= IDENTITY|STRING */
+{
+   string  A;
+  auto &X=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 384 "/root/repo/src/sql_parser.y"
+{ A = X.toString(); }
+#line 2659 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< string >(std::addressof(yymsp[0].minor.yy62), std::move(A));
+}
+        break;
+      case 79: /* prop_name ::= AT IDENTITY */
+{
+   string  A;
+  auto &X=yy_cast< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &Y=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 385 "/root/repo/src/sql_parser.y"
+{ A = string(X.z, (Y.z + Y.n) - X.z); }
+#line 2671 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< string >(std::addressof(yymsp[-1].minor.yy62), std::move(A));
+}
+        break;
+      case 80: /* rid ::= SHARP SIGNED|UNSIGNED COLON SIGNED|UNSIGNED */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< RecordDescriptor >(std::addressof(yymsp[-3].minor.yy3));
+  auto &class_id=yy_cast< Token >(std::addressof(yymsp[-2].minor.yy0));
+  auto &pos_id=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 389 "/root/repo/src/sql_parser.y"
+{
+    A = RecordDescriptor(stoi(string(class_id.z, class_id.n)), stoi(string(pos_id.z, pos_id.n)));
+}
+#line 2688 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(class_id);
+  yy_destructor(pos_id);
+}
+        break;
+      case 81: /* rid_set ::= rid_set COMMA rid */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_cast< RecordDescriptorSet >(std::addressof(yymsp[-2].minor.yy59));
+  auto &X=yy_cast< RecordDescriptor >(std::addressof(yymsp[0].minor.yy3));
+#line 397 "/root/repo/src/sql_parser.y"
+{ A.insert(move(X)); }
+#line 2700 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 83: /* name_set ::= name_set COMMA IDENTITY|STRING */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_cast< set<string> >(std::addressof(yymsp[-2].minor.yy172));
+  auto &X=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 402 "/root/repo/src/sql_parser.y"
+{ A.insert(X.toString()); }
+#line 2711 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 84: /* name_set ::= IDENTITY|STRING */
+{
+   set<string>  A;
+  auto &X=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 403 "/root/repo/src/sql_parser.y"
+{ A = set<string>{X.toString()}; }
+#line 2721 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< set<string> >(std::addressof(yymsp[0].minor.yy172), std::move(A));
+}
+        break;
+      case 85: /* term_list ::= term_list COMMA term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_cast< vector<Bytes> >(std::addressof(yymsp[-2].minor.yy99));
+  auto &X=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 407 "/root/repo/src/sql_parser.y"
+{ A.push_back(move(X)); }
+#line 2733 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 86: /* term_list ::= term */
+{
+   vector<Bytes>  A;
+  auto &X=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 408 "/root/repo/src/sql_parser.y"
+{ A = vector<Bytes>{move(X)}; }
+#line 2743 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< vector<Bytes> >(std::addressof(yymsp[0].minor.yy99), std::move(A));
+}
+        break;
+      case 87: /* multi_cond ::= LP multi_cond RP */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &A=yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209));
+  auto &X=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[-1].minor.yy209));
+#line 419 "/root/repo/src/sql_parser.y"
+{ A = X; }
+#line 2756 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 88: /* multi_cond ::= multi_cond AND multi_cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   shared_ptr<MultiCondition>  A;
+  auto &X=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209));
+  auto &Y=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[0].minor.yy209));
+#line 420 "/root/repo/src/sql_parser.y"
+{ A = make_shared<MultiCondition>(*X && *Y); }
+#line 2768 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209), std::move(A));
+}
+        break;
+      case 89: /* multi_cond ::= multi_cond OR multi_cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   shared_ptr<MultiCondition>  A;
+  auto &X=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209));
+  auto &Y=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[0].minor.yy209));
+#line 421 "/root/repo/src/sql_parser.y"
+{ A = make_shared<MultiCondition>(*X || *Y); }
+#line 2782 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209), std::move(A));
+}
+        break;
+      case 90: /* multi_cond ::= multi_cond AND cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   shared_ptr<MultiCondition>  A;
+  auto &X=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209));
+  auto &Y=yy_cast< Condition >(std::addressof(yymsp[0].minor.yy132));
+#line 422 "/root/repo/src/sql_parser.y"
+{ A = make_shared<MultiCondition>(*X && Y); }
+#line 2796 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209), std::move(A));
+}
+        break;
+      case 91: /* multi_cond ::= multi_cond OR cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   shared_ptr<MultiCondition>  A;
+  auto &X=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209));
+  auto &Y=yy_cast< Condition >(std::addressof(yymsp[0].minor.yy132));
+#line 423 "/root/repo/src/sql_parser.y"
+{ A = make_shared<MultiCondition>(*X || Y); }
+#line 2810 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209), std::move(A));
+}
+        break;
+      case 92: /* multi_cond ::= cond AND multi_cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   shared_ptr<MultiCondition>  A;
+  auto &X=yy_cast< Condition >(std::addressof(yymsp[-2].minor.yy132));
+  auto &Y=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[0].minor.yy209));
+#line 424 "/root/repo/src/sql_parser.y"
+{ A = make_shared<MultiCondition>(X && *Y); }
+#line 2824 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209), std::move(A));
+}
+        break;
+      case 93: /* multi_cond ::= cond OR multi_cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   shared_ptr<MultiCondition>  A;
+  auto &X=yy_cast< Condition >(std::addressof(yymsp[-2].minor.yy132));
+  auto &Y=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[0].minor.yy209));
+#line 425 "/root/repo/src/sql_parser.y"
+{ A = make_shared<MultiCondition>(X || *Y); }
+#line 2838 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209), std::move(A));
+}
+        break;
+      case 94: /* multi_cond ::= cond AND cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   shared_ptr<MultiCondition>  A;
+  auto &X=yy_cast< Condition >(std::addressof(yymsp[-2].minor.yy132));
+  auto &Y=yy_cast< Condition >(std::addressof(yymsp[0].minor.yy132));
+#line 426 "/root/repo/src/sql_parser.y"
+{ A = make_shared<MultiCondition>(X && Y); }
+#line 2852 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209), std::move(A));
+}
+        break;
+      case 95: /* multi_cond ::= cond OR cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   shared_ptr<MultiCondition>  A;
+  auto &X=yy_cast< Condition >(std::addressof(yymsp[-2].minor.yy132));
+  auto &Y=yy_cast< Condition >(std::addressof(yymsp[0].minor.yy132));
+#line 427 "/root/repo/src/sql_parser.y"
+{ A = make_shared<MultiCondition>(X || Y); }
+#line 2866 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_destructor(Y);
+  yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-2].minor.yy209), std::move(A));
+}
+        break;
+      case 96: /* multi_cond ::= NOT multi_cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< shared_ptr<MultiCondition> >(std::addressof(yymsp[-1].minor.yy209));
+  auto &X=yy_cast< shared_ptr<MultiCondition> >(std::addressof(yymsp[0].minor.yy209));
+#line 428 "/root/repo/src/sql_parser.y"
+{ A = make_shared<MultiCondition>(!(*X)); }
+#line 2879 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 97: /* cond ::= LP cond RP */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  auto &A=yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132));
+  auto &X=yy_cast< Condition >(std::addressof(yymsp[-1].minor.yy132));
+#line 431 "/root/repo/src/sql_parser.y"
+{ A = move(X); }
+#line 2891 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 98: /* cond ::= NOT cond */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+  auto &A=yy_constructor< Condition >(std::addressof(yymsp[-1].minor.yy132));
+  auto &X=yy_cast< Condition >(std::addressof(yymsp[0].minor.yy132));
+#line 432 "/root/repo/src/sql_parser.y"
+{ A = !X; }
+#line 2902 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+}
+        break;
+      case 99: /* cond ::= prop_name EQ term */
+      case 105: /* cond ::= prop_name IS term */ yytestcase(yyruleno==105);
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 433 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).eq(value); }
+#line 2915 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132), std::move(A));
+}
+        break;
+      case 100: /* cond ::= prop_name NE term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 434 "/root/repo/src/sql_parser.y"
+{ A = !Condition(prop).eq(value); }
+#line 2929 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132), std::move(A));
+}
+        break;
+      case 101: /* cond ::= prop_name GT term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 435 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).gt(value.getBase()); }
+#line 2943 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132), std::move(A));
+}
+        break;
+      case 102: /* cond ::= prop_name LT term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 436 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).lt(value.getBase()); }
+#line 2957 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132), std::move(A));
+}
+        break;
+      case 103: /* cond ::= prop_name GE term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 437 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).ge(value.getBase()); }
+#line 2971 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132), std::move(A));
+}
+        break;
+      case 104: /* cond ::= prop_name LE term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 438 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).le(value.getBase()); }
+#line 2985 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132), std::move(A));
+}
+        break;
+      case 106: /* cond ::= prop_name IS NOT term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-3].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 440 "/root/repo/src/sql_parser.y"
+{ A = !Condition(prop).eq(value); }
+#line 3000 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-3].minor.yy132), std::move(A));
+}
+        break;
+      case 107: /* cond ::= prop_name CONTAIN CASE term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-3].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 441 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).contain(value.getBase()); }
+#line 3015 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-3].minor.yy132), std::move(A));
+}
+        break;
+      case 108: /* cond ::= prop_name CONTAIN term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 442 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).contain(value.getBase()).ignoreCase(); }
+#line 3029 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132), std::move(A));
+}
+        break;
+      case 109: /* cond ::= prop_name BEGIN WITH CASE term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-4].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 443 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).beginWith(value.getBase()); }
+#line 3045 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-4].minor.yy132), std::move(A));
+}
+        break;
+      case 110: /* cond ::= prop_name BEGIN WITH term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-3].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 444 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).beginWith(value.getBase()).ignoreCase(); }
+#line 3060 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-3].minor.yy132), std::move(A));
+}
+        break;
+      case 111: /* cond ::= prop_name END WITH CASE term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-4].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 445 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).endWith(value.getBase()); }
+#line 3076 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-4].minor.yy132), std::move(A));
+}
+        break;
+      case 112: /* cond ::= prop_name END WITH term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-3].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 446 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).endWith(value.getBase()).ignoreCase(); }
+#line 3091 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-3].minor.yy132), std::move(A));
+}
+        break;
+      case 113: /* cond ::= prop_name LIKE CASE term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-3].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 447 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).like(value.getBase()); }
+#line 3106 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-3].minor.yy132), std::move(A));
+}
+        break;
+      case 114: /* cond ::= prop_name LIKE term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 448 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).like(value.getBase()).ignoreCase(); }
+#line 3120 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132), std::move(A));
+}
+        break;
+      case 115: /* cond ::= prop_name REGEX CASE term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-3].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 449 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).regex(value.getBase()); }
+#line 3135 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-3].minor.yy132), std::move(A));
+}
+        break;
+      case 116: /* cond ::= prop_name REGEX term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-2].minor.yy62));
+  auto &value=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 450 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).regex(value.getBase()).ignoreCase(); }
+#line 3149 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value);
+  yy_constructor< Condition >(std::addressof(yymsp[-2].minor.yy132), std::move(A));
+}
+        break;
+      case 117: /* cond ::= prop_name BETWEEN term AND term */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-1].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-4].minor.yy62));
+  auto &value1=yy_cast< Bytes >(std::addressof(yymsp[-2].minor.yy166));
+  auto &value2=yy_cast< Bytes >(std::addressof(yymsp[0].minor.yy166));
+#line 451 "/root/repo/src/sql_parser.y"
+{ A = Condition(prop).between(value1.getBase(), value2.getBase()); }
+#line 3165 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(value1);
+  yy_destructor(value2);
+  yy_constructor< Condition >(std::addressof(yymsp[-4].minor.yy132), std::move(A));
+}
+        break;
+      case 118: /* cond ::= prop_name IDENTITY LB term_list RB */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+   Condition  A;
+  auto &prop=yy_cast< string >(std::addressof(yymsp[-4].minor.yy62));
+  auto &cmp=yy_cast< Token >(std::addressof(yymsp[-3].minor.yy0));
+  auto &values=yy_cast< vector<Bytes> >(std::addressof(yymsp[-1].minor.yy99));
+#line 452 "/root/repo/src/sql_parser.y"
+{
+    if (strncasecmp(cmp.z, "IN", cmp.n) == 0) {
+        vector<nogdb::Bytes> baseValues(values.size());
+        transform(values.begin(), values.end(), baseValues.begin(), [](const Bytes& v){ return v.getBase(); });
+        A = Condition(prop).in(baseValues);
+    } else {
+        this->syntax_error(-1, cmp);
+    }
+}
+#line 3190 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(prop);
+  yy_destructor(cmp);
+  yy_destructor(values);
+  yy_constructor< Condition >(std::addressof(yymsp[-4].minor.yy132), std::move(A));
+}
+        break;
+      case 119: /* term ::= term_token */
+{
+   Bytes  A;
+  auto &X=yy_cast< Token >(std::addressof(yymsp[0].minor.yy0));
+#line 464 "/root/repo/src/sql_parser.y"
+{ A = X.toBytes(); }
+#line 3203 "/root/repo/src/sql_parser.cpp"
+  yy_destructor(X);
+  yy_constructor< Bytes >(std::addressof(yymsp[0].minor.yy166), std::move(A));
+}
+        break;
+      case 121: /* input ::= cmd */
+      case 126: /* sort_order ::= ASC */ yytestcase(yyruleno==126);
+      case 127: /* sort_order ::= DESC */ yytestcase(yyruleno==127);
+{
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  yy_constructor< Token >(std::addressof(yymsp[0].minor.yy0));
+}
+        break;
+      case 123: /* order_by ::= */
+  yy_constructor< void * >(std::addressof(yymsp[1].minor.yy157));
+        break;
+      case 124: /* order_by ::= ORDER BY name_set sort_order */
+{
+  yy_destructor< Token >(std::addressof(yymsp[-3].minor.yy0));
+  yy_destructor< Token >(std::addressof(yymsp[-2].minor.yy0));
+  yy_destructor< set<string> >(std::addressof(yymsp[-1].minor.yy172));
+  yy_destructor< Token >(std::addressof(yymsp[0].minor.yy0));
+  yy_constructor< void * >(std::addressof(yymsp[-3].minor.yy157));
+}
+        break;
+      case 125: /* sort_order ::= */
+      case 128: /* index_type ::= */ yytestcase(yyruleno==128);
+  yy_constructor< Token >(std::addressof(yymsp[1].minor.yy0));
+        break;
+      default:
+      /* (122) proj_alias ::= proj_item */ yytestcase(yyruleno==122);
+        break;
+/********** End reduce actions ************************************************/
+  };
+  assert( yyruleno<sizeof(yyRuleInfo)/sizeof(yyRuleInfo[0]) );
+  yygoto = yyRuleInfo[yyruleno].lhs;
+  yysize = yyRuleInfo[yyruleno].nrhs;
+  yyact = yy_find_reduce_action(yymsp[yysize].stateno,(YYCODETYPE)yygoto);
+
+  /* There are no SHIFTREDUCE actions on nonterminals because the table
+  ** generator has simplified them to pure REDUCE actions. */
+  assert( !(yyact>YY_MAX_SHIFT && yyact<=YY_MAX_SHIFTREDUCE) );
+
+  /* It is not possible for a REDUCE to be followed by an error */
+  assert( yyact!=YY_ERROR_ACTION );
+
+  if( yyact==YY_ACCEPT_ACTION ){
+    yytos += yysize;
+    yy_accept();
+  }else{
+    yymsp += yysize+1;
+    yytos = yymsp;
+    yymsp->stateno = (YYACTIONTYPE)yyact;
+    yymsp->major = (YYCODETYPE)yygoto;
+    yyTraceShift(yyact);
+  }
+}
+
+/*
+** The following code executes when the parse fails
+*/
+#ifndef YYNOERRORRECOVERY
+void yypParser::yy_parse_failed(){
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    fprintf(yyTraceFILE,"%sFail!\n",yyTracePrompt);
+  }
+#endif
+  while( yytos>yystack ) yy_pop_parser_stack();
+  /* Here code is inserted which will be executed whenever the
+  ** parser fails */
+/************ Begin %parse_failure code ***************************************/
+/************ End %parse_failure code *****************************************/
+  LEMON_SUPER::parse_failure();
+}
+#endif /* YYNOERRORRECOVERY */
+
+/*
+** The following code executes when a syntax error first occurs.
+*/
+void yypParser::yy_syntax_error(
+  int yymajor,                   /* The major type of the error token */
+  ParseTOKENTYPE &yyminor        /* The minor type of the error token */
+){
+//#define TOKEN yyminor
+  auto &TOKEN = yyminor;
+/************ Begin %syntax_error code ****************************************/
+/************ End %syntax_error code ******************************************/
+  LEMON_SUPER::syntax_error(yymajor, TOKEN);
+}
+
+/*
+** The following is executed when the parser accepts
+*/
+void yypParser::yy_accept(){
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    fprintf(yyTraceFILE,"%sAccept!\n",yyTracePrompt);
+  }
+#endif
+#ifndef YYNOERRORRECOVERY
+  yyerrcnt = -1;
+#endif
+  assert( yytos==yystack );
+  /* Here code is inserted which will be executed whenever the
+  ** parser accepts */
+/*********** Begin %parse_accept code *****************************************/
+/*********** End %parse_accept code *******************************************/
+  LEMON_SUPER::parse_accept();
+}
+
+/* The main parser program.
+** The first argument is a pointer to a structure obtained from
+** "ParseAlloc" which describes the current state of the parser.
+** The second argument is the major token number.  The third is
+** the minor token.  The fourth optional argument is whatever the
+** user wants (and specified in the grammar) and is available for
+** use by the action routines.
+**
+** Inputs:
+** <ul>
+** <li> A pointer to the parser (an opaque structure.)
+** <li> The major token number.
+** <li> The minor token number.
+** <li> An option argument of a grammar-specified type.
+** </ul>
+**
+** Outputs:
+** None.
+*/
+
+
+
+void yypParser::parse(
+  int yymajor,                 /* The major token code number */
+  ParseTOKENTYPE &&yyminor       /* The value for the token */
+){
+  //YYMINORTYPE yyminorunion;
+  unsigned int yyact;            /* The parser action. */
+#if !defined(YYERRORSYMBOL) && !defined(YYNOERRORRECOVERY)
+  int yyendofinput;     /* True if we are at the end of input */
+#endif
+#ifdef YYERRORSYMBOL
+  int yyerrorhit = 0;   /* True if yymajor has invoked an error */
+#endif
+
+  assert( yytos!=0 );
+
+#if !defined(YYERRORSYMBOL) && !defined(YYNOERRORRECOVERY)
+  yyendofinput = (yymajor==0);
+#endif
+
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    fprintf(yyTraceFILE,"%sInput '%s'\n",yyTracePrompt,yyTokenName[yymajor]);
+  }
+#endif
+
+  do{
+    yyact = yy_find_shift_action(yytos->stateno, (YYCODETYPE)yymajor);
+    if( yyact <= YY_MAX_SHIFTREDUCE ){
+      yy_shift(yyact,yymajor,std::move(yyminor));
+#ifndef YYNOERRORRECOVERY
+      yyerrcnt--;
+#endif
+      yymajor = YYNOCODE;
+    }else if( yyact <= YY_MAX_REDUCE ){
+      yy_reduce(yyact-YY_MIN_REDUCE);
+    }else{
+      assert( yyact == YY_ERROR_ACTION );
+#ifdef YYERRORSYMBOL
+      int yymx;
+#endif
+#ifndef NDEBUG
+      if( yyTraceFILE ){
+        fprintf(yyTraceFILE,"%sSyntax Error!\n",yyTracePrompt);
+      }
+#endif
+#ifdef YYERRORSYMBOL
+      /* A syntax error has occurred.
+      ** The response to an error depends upon whether or not the
+      ** grammar defines an error token "ERROR".  
+      **
+      ** This is what we do if the grammar does define ERROR:
+      **
+      **  * Call the %syntax_error function.
+      **
+      **  * Begin popping the stack until we enter a state where
+      **    it is legal to shift the error symbol, then shift
+      **    the error symbol.
+      **
+      **  * Set the error count to three.
+      **
+      **  * Begin accepting and shifting new tokens.  No new error
+      **    processing will occur until three tokens have been
+      **    shifted successfully.
+      **
+      */
+      if( yyerrcnt<0 ){
+        yy_syntax_error(yymajor,yyminor);
+      }
+      yymx = yytos->major;
+      if( yymx==YYERRORSYMBOL || yyerrorhit ){
+#ifndef NDEBUG
+        if( yyTraceFILE ){
+          fprintf(yyTraceFILE,"%sDiscard input token %s\n",
+             yyTracePrompt,yyTokenName[yymajor]);
+        }
+#endif
+        //yy_destructor(yyminor);
+        yymajor = YYNOCODE;
+      }else{
+        while( yytos >= yystack
+            && yymx != YYERRORSYMBOL
+            && (yyact = yy_find_reduce_action(
+                        yytos->stateno,
+                        YYERRORSYMBOL)) >= YY_MIN_REDUCE
+        ){
+          yy_pop_parser_stack();
+        }
+        if( yytos < yystack || yymajor==0 ){
+          //yy_destructor(yyminor);
+          yy_parse_failed();
+#ifndef YYNOERRORRECOVERY
+          yyerrcnt = -1;
+#endif
+          yymajor = YYNOCODE;
+        }else if( yymx!=YYERRORSYMBOL ){
+          yy_shift(yyact,YYERRORSYMBOL,std::move(yyminor));
+        }
+      }
+      yyerrcnt = 3;
+      yyerrorhit = 1;
+#elif defined(YYNOERRORRECOVERY)
+      /* If the YYNOERRORRECOVERY macro is defined, then do not attempt to
+      ** do any kind of error recovery.  Instead, simply invoke the syntax
+      ** error routine and continue going as if nothing had happened.
+      **
+      ** Applications can set this macro (for example inside %include) if
+      ** they intend to abandon the parse upon the first syntax error seen.
+      */
+      yy_syntax_error(yymajor,yyminor);
+      //yy_destructor(yyminor);
+      yymajor = YYNOCODE;
+      
+#else  /* YYERRORSYMBOL is not defined */
+      /* This is what we do if the grammar does not define ERROR:
+      **
+      **  * Report an error message, and throw away the input token.
+      **
+      **  * If the input token is $, then fail the parse.
+      **
+      ** As before, subsequent error messages are suppressed until
+      ** three input tokens have been successfully shifted.
+      */
+      if( yyerrcnt<=0 ){
+        yy_syntax_error(yymajor,yyminor);
+      }
+      yyerrcnt = 3;
+      //yy_destructor(yyminor);
+      if( yyendofinput ){
+        yy_parse_failed();
+#ifndef YYNOERRORRECOVERY
+        yyerrcnt = -1;
+#endif
+      }
+      yymajor = YYNOCODE;
+#endif
+    }
+  }while( yymajor!=YYNOCODE && yytos>yystack );
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    yyStackEntry *i;
+    char cDiv = '[';
+    fprintf(yyTraceFILE,"%sReturn. Stack=",yyTracePrompt);
+    for(i=&yystack[1]; i<=yytos; i++){
+      fprintf(yyTraceFILE,"%c%s", cDiv, yyTokenName[i->major]);
+      cDiv = ' ';
+    }
+    if (cDiv == '[') fprintf(yyTraceFILE,"[");
+    fprintf(yyTraceFILE,"]\n");
+  }
+#endif
+  return;
+}
+
+
+bool yypParser::will_accept() const {
+
+
+  struct stack_entry {
+    int stateno;
+    int major;
+  };
+
+  int yyact;
+  const int yymajor = 0;
+  std::vector<stack_entry> stack;
+
+
+  // copy stack to stack.
+  stack.reserve(yyidx()+1);
+  std::transform(begin(), end(), std::back_inserter(stack), [](const yyStackEntry &e){
+    return stack_entry({e.stateno, e.major});
+  });
+
+  do {
+    yyact = yy_find_shift_action(stack.back().stateno, yymajor);
+    if (yyact <= YY_MAX_SHIFTREDUCE) {
+      // shift
+      return false;
+      //stack.push_back({yyact, yymajor});
+      //yymajor = YYNOCODE;
+    }
+    else if (yyact <= YY_MAX_REDUCE) {
+      // reduce...
+      unsigned yyruleno = yyact - YY_MIN_REDUCE;
+
+      int yygoto = yyRuleInfo[yyruleno].lhs;
+      int yysize = -yyRuleInfo[yyruleno].nrhs; /* stored as negative value */
+
+      while (yysize--) stack.pop_back();
+
+      yyact = yy_find_reduce_action(stack.back().stateno,(YYCODETYPE)yygoto);
+
+
+      if (yyact == YY_ACCEPT_ACTION) return true;
+
+      if( yyact>YY_MAX_SHIFT ){
+        yyact += YY_MIN_REDUCE - YY_MIN_SHIFTREDUCE;
+      }
+
+      stack.push_back({yyact, yygoto});
+    }
+    else {
+      return false;
+    }
+
+  } while (!stack.empty());
+
+  return false;
+
+
+}
+
+
+
+
+} // namespace
+#line 55 "/root/repo/src/sql_parser.y"
+
+unique_ptr<Context> Context::create(Transaction &txn) {
+    return unique_ptr<yypParser>(new yypParser(txn));
+}
+
+#line 3558 "/root/repo/src/sql_parser.cpp"
@@ -0,0 +1,68 @@
+#define TK_ANY                              1
+#define TK_IDENTITY                         2
+#define TK_STRING                           3
+#define TK_SIGNED                           4
+#define TK_UNSIGNED                         5
+#define TK_SHOW                             6
+#define TK_CREATE                           7
+#define TK_CLASS                            8
+#define TK_EXTENDS                          9
+#define TK_VERTEX                          10
+#define TK_EDGE                            11
+#define TK_SEMI                            12
+#define TK_ALTER                           13
+#define TK_DROP                            14
+#define TK_PROPERTY                        15
+#define TK_DOT                             16
+#define TK_FROM                            17
+#define TK_TO                              18
+#define TK_SELECT                          19
+#define TK_STAR                            20
+#define TK_COMMA                           21
+#define TK_AS                              22
+#define TK_LP                              23
+#define TK_RP                              24
+#define TK_AT                              25
+#define TK_LB                              26
+#define TK_RB                              27
+#define TK_WHERE                           28
+#define TK_GROUP                           29
+#define TK_BY                              30
+#define TK_ORDER                           31
+#define TK_ASC                             32
+#define TK_DESC                            33
+#define TK_SKIP                            34
+#define TK_LIMIT                           35
+#define TK_UPDATE                          36
+#define TK_DELETE                          37
+#define TK_TRAVERSE                        38
+#define TK_MINDEPTH                        39
+#define TK_MAXDEPTH                        40
+#define TK_STRATEGY                        41
+#define TK_INDEX                           42
+#define TK_IF                              43
+#define TK_NOT                             44
+#define TK_EXISTS                          45
+#define TK_SET                             46
+#define TK_EQ                              47
+#define TK_SHARP                           48
+#define TK_COLON                           49
+#define TK_OR                              50
+#define TK_AND                             51
+#define TK_LT                              52
+#define TK_GT                              53
+#define TK_GE                              54
+#define TK_LE                              55
+#define TK_NE                              56
+#define TK_IS                              57
+#define TK_CONTAIN                         58
+#define TK_CASE                            59
+#define TK_BEGIN                           60
+#define TK_WITH                            61
+#define TK_END                             62
+#define TK_LIKE                            63
+#define TK_REGEX                           64
+#define TK_BETWEEN                         65
+#define TK_NULL                            66
+#define TK_FLOAT                           67
+#define TK_BLOB                            68
@@ -63,6 +63,9 @@ unique_ptr<Context> Context::create(Transaction &txn) {
 %token_class typename IDENTITY|STRING.
 %token_class integer SIGNED|UNSIGNED.
 
+// keywords added after names could already be given to classes and properties stay usable as names
+%fallback IDENTITY SHOW.
+
 
 //////////////////// Input is a single SQL command
 input ::= cmd.
@@ -349,6 +352,13 @@ index_type ::= .
 index_type(A) ::= IDENTITY(X). { A = X; }
 
 
+//////////////////// The SHOW command ////////////////////
+// SHOW STORAGE: page counts, b-tree depth and entries of every table
+cmd ::= SHOW IDENTITY(target) SEMI. {
+    this->show(target);
+}
+
+
 //////////////////// Other options ////////////////////
 // if (not) exists
 %type if_not_exists_opt { bool }
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <string>
+#include <unistd.h>
 
 #include "datatype.hpp"
 #include "storage_engine.hpp"
@@ -66,6 +67,44 @@ namespace adapter {
             return *this;
         }
 
+        /**
+         * Page counts, b-tree depth and number of entries of the underlying table.
+         */
+        MDB_stat stat() const
+        {
+            if (_dbi == 0) {
+                throw NOGDB_INTERNAL_ERROR(NOGDB_INTERNAL_EMPTY_DBI);
+            }
+            return _dbi.stat();
+        }
+
+        /**
+         * Read every entry of the table, touching each page of its values, so that the b-tree and overflow
+         * pages are faulted into memory. Returns the number of entries.
+         */
+        size_t warmup() const
+        {
+            static const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            auto cursorHandler = cursor();
+            auto entries = size_t { 0 };
+            auto checksum = uint8_t { 0 };
+            for (auto keyValue = cursorHandler.getNext(); !keyValue.empty(); keyValue = cursorHandler.getNext()) {
+                auto data = keyValue.val.data.data<uint8_t>();
+                auto size = keyValue.val.data.size();
+                for (auto offset = size_t { 0 }; offset < size; offset += pageSize) {
+                    checksum ^= data[offset];
+                }
+                if (size != 0) {
+                    checksum ^= data[size - 1];
+                }
+                ++entries;
+            }
+            // keep the reads from being optimized away
+            volatile auto sink = checksum;
+            (void)sink;
+            return entries;
+        }
+
     protected:
         template <typename K, typename V>
         void put(const K& key, const V& val)
@@ -73,7 +112,45 @@ namespace adapter {
             if (_dbi == 0) {
                 throw NOGDB_INTERNAL_ERROR(NOGDB_INTERNAL_EMPTY_DBI);
             }
-            _dbi.put(key, val, _append, _overwrite);
+            try {
+                _dbi.put(key, val, _append, _overwrite);
+            } catch (const Error& error) {
+                // let the environment grow the map before the next write transaction on MDB_MAP_FULL
+                _txn->notifyError(error);
+                throw;
+            }
+        }
+
+        /**
+         * Write with MDB_APPEND regardless of how the table has been opened,
+         * the key must sort after every key already in the table.
+         */
+        template <typename K, typename V>
+        void append(const K& key, const V& val)
+        {
+            if (_dbi == 0) {
+                throw NOGDB_INTERNAL_ERROR(NOGDB_INTERNAL_EMPTY_DBI);
+            }
+            try {
+                _dbi.put(key, val, true, _overwrite);
+            } catch (const Error& error) {
+                _txn->notifyError(error);
+                throw;
+            }
+        }
+
+        template <typename K>
+        unsigned char* reserve(const K& key, size_t size)
+        {
+            if (_dbi == 0) {
+                throw NOGDB_INTERNAL_ERROR(NOGDB_INTERNAL_EMPTY_DBI);
+            }
+            try {
+                return _dbi.reserve(key, size);
+            } catch (const Error& error) {
+                _txn->notifyError(error);
+                throw;
+            }
         }
 
         template <typename K>
@@ -117,6 +194,9 @@ namespace adapter {
                 throw NOGDB_INTERNAL_ERROR(NOGDB_INTERNAL_EMPTY_DBI);
             }
             _dbi.drop(del);
+            if (del) {
+                _txn->closeDBi(_dbi);
+            }
         }
 
         lmdb::Cursor cursor() const
@@ -21,15 +21,33 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <climits>
+#include <condition_variable>
 #include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <unistd.h>
 #include <unordered_map>
+#include <vector>
 
+#include "constant.hpp"
 #include "lmdb_engine.hpp"
+#include "memory_engine.hpp"
 #include "utils.hpp"
 
 #include "nogdb/nogdb.h"
@@ -37,19 +55,84 @@
 #define DEFAULT_NOGDB_MAX_DATABASE_NUMBER 1024U
 #define DEFAULT_NOGDB_MAX_DATABASE_SIZE 1073741824UL // 1GB
 #define DEFAULT_NOGDB_MAX_READERS 65536U
+#define DEFAULT_NOGDB_FLUSH_INTERVAL 100U // ms
+#define DEFAULT_NOGDB_READ_TXN_POOL_SIZE 32U
+#define DEFAULT_NOGDB_BATCH_SIZE 1000U // mutations
+#define DEFAULT_NOGDB_BATCH_LATENCY 0U // ms, commit as soon as the writer is idle
 
 namespace nogdb {
 namespace storage_engine {
     using namespace utils::assertion;
 
+    /**
+     * How the memory map of an environment grows when it runs out of space.
+     * The map grows by a fixed step, or by a factor of its current size if the factor is greater than 1,
+     * but never beyond the limit. A zero limit disables the growth.
+     */
+    struct MapGrowthPolicy {
+        unsigned long step { 0 };
+        double factor { 0.0 };
+        unsigned long limit { 0 };
+
+        bool enabled() const
+        {
+            return limit != 0 && (step != 0 || factor > 1.0);
+        }
+
+        size_t increment(size_t mapSize) const
+        {
+            return (factor > 1.0) ? static_cast<size_t>(mapSize * (factor - 1.0)) : step;
+        }
+    };
+
+    /**
+     * Identifies a database handle by the name and the flags it has been opened with.
+     */
+    struct DBiKey {
+        std::string name;
+        unsigned int flags;
+
+        bool operator==(const DBiKey& other) const noexcept
+        {
+            return flags == other.flags && name == other.name;
+        }
+    };
+
+    struct DBiKeyHash {
+        size_t operator()(const DBiKey& key) const noexcept
+        {
+            return std::hash<std::string> {}(key.name) ^ key.flags;
+        }
+    };
+
+    using DBiHandles = std::unordered_map<DBiKey, lmdb::DBHandler, DBiKeyHash>;
+
     class LMDBEnv {
     public:
-        LMDBEnv(const std::string& dbPath, unsigned int dbNum, unsigned long dbSize, unsigned int readers)
+        LMDBEnv(const std::string& dbPath,
+            unsigned int dbNum,
+            unsigned long dbSize,
+            unsigned int readers,
+            lmdb::Flag flags = lmdb::DEFAULT_ENV_FLAG,
+            const MapGrowthPolicy& growthPolicy = MapGrowthPolicy {},
+            StorageEngine engine = StorageEngine::LMDB,
+            MapAdvice mapAdvice = MapAdvice::NORMAL)
+            : _dbPath { dbPath }
+            , _engine { engine }
+            , _mapAdvice { mapAdvice }
+            , _readOnly { engine == StorageEngine::LMDB && (flags & MDB_RDONLY) != 0 }
+            , _growthPolicy { growthPolicy }
         {
-            if (!utils::io::fileExists(dbPath)) {
-                mkdir(dbPath.c_str(), 0755);
+            if (engine == StorageEngine::MEMORY) {
+                _env = lmdb::Env { memory::createEnv(dbNum, dbSize, readers) };
+            } else {
+                if (!utils::io::fileExists(dbPath)) {
+                    mkdir(dbPath.c_str(), 0755);
+                }
+                _env = lmdb::Env::open(dbPath, dbNum, dbSize, readers, flags);
             }
-            _env = std::move(lmdb::Env::create(dbNum, dbSize, readers).open(dbPath));
+            _pageSize = _env.stat().ms_psize;
+            adviseMap();
         }
 
         ~LMDBEnv() noexcept
@@ -60,40 +143,600 @@ namespace storage_engine {
             }
         }
 
-        LMDBEnv(LMDBEnv&& other) noexcept
+        LMDBEnv(const LMDBEnv& other) = delete;
+
+        LMDBEnv& operator=(const LMDBEnv& other) = delete;
+
+        void close() noexcept
         {
-            using std::swap;
-            swap(_env, other._env);
+            if (_readerMonitor.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(_readerMonitorMutex);
+                    _readerMonitorStopped = true;
+                }
+                _readerMonitorCond.notify_one();
+                _readerMonitor.join();
+            }
+            if (_flusher.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(_flusherMutex);
+                    _flusherStopped = true;
+                }
+                _flusherCond.notify_one();
+                _flusher.join();
+                // make everything committed so far durable before the environment goes away
+                try {
+                    _env.sync(true);
+                } catch (...) {
+                }
+            }
+            _env.close();
         }
 
-        LMDBEnv& operator=(LMDBEnv&& other) noexcept
+        void sync(bool force = true)
         {
-            if (this != &other) {
-                using std::swap;
-                swap(_env, other._env);
-            }
-            return *this;
+            _env.sync(force);
         }
 
-        void close() noexcept
+        /**
+         * Start a background thread flushing the environment to disk every interval.
+         * Used by environments opened with MDB_NOSYNC where commits do not flush by themselves.
+         */
+        void startFlusher(const std::chrono::milliseconds& interval)
         {
-            _env.close();
+            require(!_flusher.joinable());
+            _flusherStopped = false;
+            _flusher = std::thread([this, interval]() {
+                auto lock = std::unique_lock<std::mutex>(_flusherMutex);
+                while (!_flusherCond.wait_for(lock, interval, [this]() { return _flusherStopped; })) {
+                    try {
+                        _env.sync(true);
+                    } catch (...) {
+                        // keep flushing, a failed sync will be retried on the next interval
+                    }
+                }
+            });
+        }
+
+        /**
+         * Start a background thread clearing the reader slots left behind by dead processes every interval,
+         * which also reports a read transaction once it has been open for longer than the maximum age, if any.
+         */
+        void startReaderMonitor(const std::chrono::milliseconds& interval, const std::chrono::milliseconds& maxAge)
+        {
+            require(!_readerMonitor.joinable());
+            _readerMonitorStopped = false;
+            _readerMonitor = std::thread([this, interval, maxAge]() {
+                auto lock = std::unique_lock<std::mutex>(_readerMonitorMutex);
+                while (!_readerMonitorCond.wait_for(lock, interval, [this]() { return _readerMonitorStopped; })) {
+                    try {
+                        auto overdue = false;
+                        auto stats = ReaderStats {};
+                        auto handler = std::function<void(const ReaderStats&)> {};
+                        {
+                            std::lock_guard<std::mutex> readerLock(_readerMutex);
+                            stats = checkReaders(maxAge, overdue);
+                            handler = _longReaderHandler;
+                        }
+                        if (overdue && handler) {
+                            handler(stats);
+                        }
+                    } catch (...) {
+                        // keep monitoring, the readers will be checked again on the next interval
+                    }
+                }
+            });
+        }
+
+        ReaderStats readerStats()
+        {
+            auto overdue = false;
+            std::lock_guard<std::mutex> lock(_readerMutex);
+            return checkReaders(std::chrono::milliseconds::zero(), overdue);
         }
 
-        lmdb::EnvHandler* handle() const noexcept
+        void setLongReaderHandler(std::function<void(const ReaderStats&)> handler)
+        {
+            std::lock_guard<std::mutex> lock(_readerMutex);
+            _longReaderHandler = std::move(handler);
+        }
+
+        lmdb::EnvHandler handle() const noexcept
         {
             return _env.handle();
         }
 
+        MDB_envinfo info() const
+        {
+            return _env.info();
+        }
+
+        MDB_stat stat() const
+        {
+            return _env.stat();
+        }
+
+        /**
+         * The number of pages of the data file in use which are in the page cache, counted with mincore(2)
+         * on a mapping of our own. Always 0 for an environment which is not backed by a file.
+         */
+        size_t residentPages(size_t& totalPages) const
+        {
+            totalPages = 0;
+            if (_engine != StorageEngine::LMDB) {
+                return 0;
+            }
+            static const auto systemPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            auto size = (_env.info().me_last_pgno + 1) * static_cast<size_t>(_pageSize);
+            auto fd = open((_dbPath + DB_DATA_NAME).c_str(), O_RDONLY);
+            if (fd < 0) {
+                return 0;
+            }
+            auto resident = size_t { 0 };
+            auto map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (map != MAP_FAILED) {
+                auto pages = std::vector<unsigned char>((size + systemPageSize - 1) / systemPageSize);
+                if (mincore(map, size, pages.data()) == 0) {
+                    totalPages = size / _pageSize;
+                    resident = static_cast<size_t>(std::count_if(pages.cbegin(), pages.cend(), [](unsigned char page) { return page & 1; }))
+                        * systemPageSize / _pageSize;
+                }
+                munmap(map, size);
+            }
+            return resident;
+        }
+
+        /**
+         * Copy the environment from a read snapshot, optionally compacted by omitting its free pages.
+         * The writer keeps running, but the map is not resized until the copy is complete.
+         */
+        void copy(const std::string& path, bool compact)
+        {
+            acquireTxn();
+            try {
+                _env.copy(path, compact);
+            } catch (...) {
+                releaseTxn();
+                throw;
+            }
+            releaseTxn();
+        }
+
+        /**
+         * Stream a copy of the data file to a file descriptor, e.g. a pipe, and return the number of bytes written.
+         * The copy is relayed through a pipe of our own, as the size of a compacted copy is only known once it is written.
+         */
+        size_t copy(int fd, bool compact)
+        {
+            int relayFds[2];
+            if (pipe(relayFds) != 0) {
+                throw NOGDB_STORAGE_ERROR(errno);
+            }
+            auto written = size_t { 0 };
+            auto relayError = 0;
+            auto relay = std::thread([&]() {
+                char buffer[65536];
+                auto size = ssize_t { 0 };
+                while ((size = read(relayFds[0], buffer, sizeof(buffer))) != 0) {
+                    if (size < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        relayError = errno;
+                        break;
+                    }
+                    // keep draining the pipe after a failed write so that the copy is not blocked
+                    for (auto offset = ssize_t { 0 }; relayError == 0 && offset < size;) {
+                        auto result = write(fd, buffer + offset, static_cast<size_t>(size - offset));
+                        if (result < 0 && errno != EINTR) {
+                            relayError = errno;
+                        } else if (result > 0) {
+                            offset += result;
+                            written += static_cast<size_t>(result);
+                        }
+                    }
+                }
+                ::close(relayFds[0]);
+            });
+            auto copyError = 0;
+            acquireTxn();
+            try {
+                _env.copy(relayFds[1], compact);
+            } catch (const Error& error) {
+                copyError = error.code();
+            }
+            releaseTxn();
+            ::close(relayFds[1]);
+            relay.join();
+            if (copyError != 0 || relayError != 0) {
+                throw NOGDB_STORAGE_ERROR((copyError != 0) ? copyError : relayError);
+            }
+            return written;
+        }
+
+        /**
+         * Every transaction of this process is registered between its begin and its end,
+         * so that the memory map is never resized underneath a running transaction.
+         * A read-only environment adopts the map grown by the writing process the same way.
+         */
+        void acquireTxn()
+        {
+            if (_growthPolicy.enabled() || _readOnly) {
+                std::lock_guard<std::mutex> lock(_resizeMutex);
+                ++_activeTxns;
+            }
+        }
+
+        /**
+         * The last transaction to end carries out a growth which could not be done while it was running.
+         */
+        void releaseTxn() noexcept
+        {
+            if (_growthPolicy.enabled() || _readOnly) {
+                {
+                    std::lock_guard<std::mutex> lock(_resizeMutex);
+                    if (--_activeTxns == 0 && _growthPending) {
+                        try {
+                            grow();
+                        } catch (...) {
+                            // the next write transaction will try again
+                        }
+                    }
+                }
+                _resizeCond.notify_all();
+            }
+        }
+
+        /**
+         * Grow the memory map before a write transaction begins if the free space is running low,
+         * or if the previous write transaction has failed with MDB_MAP_FULL.
+         * The map can only be resized while no transaction of this process is running, otherwise
+         * the growth is left to the last of them to end, see releaseTxn().
+         */
+        void prepareWrite()
+        {
+            if (_growthPolicy.enabled()) {
+                auto info = _env.info();
+                if (_growthPending || (info.me_mapsize < _growthPolicy.limit && freeSpace(info) < _growthPolicy.increment(info.me_mapsize) / 2)) {
+                    {
+                        std::lock_guard<std::mutex> lock(_resizeMutex);
+                        _growthPending = true;
+                        if (_activeTxns == 0) {
+                            grow();
+                        }
+                    }
+                    _resizeCond.notify_all();
+                }
+            }
+        }
+
+        void notifyMapFull() noexcept
+        {
+            _growthPending = true;
+        }
+
+        /**
+         * Wait for the growth requested by a write transaction which has failed with MDB_MAP_FULL.
+         * It is carried out as soon as no transaction of this process is running, so the caller
+         * must not hold any transaction of this environment.
+         * Returns true if the map has been grown since the given resize count, i.e. the failed write
+         * is worth retrying, or false if the map has already reached its limit.
+         */
+        bool awaitGrowth(unsigned long resizeCount)
+        {
+            if (!_growthPolicy.enabled()) {
+                return false;
+            }
+            auto lock = std::unique_lock<std::mutex>(_resizeMutex);
+            if (_growthPending && _activeTxns == 0) {
+                grow();
+            }
+            _resizeCond.wait(lock, [this]() { return !_growthPending; });
+            return _resizeCount != resizeCount;
+        }
+
+        /**
+         * Adopt the map size set by another process after a transaction has failed with MDB_MAP_RESIZED.
+         * Returns false if a transaction of this process is still running, in which case the map
+         * cannot be adopted yet.
+         */
+        bool adoptMapSize()
+        {
+            std::lock_guard<std::mutex> lock(_resizeMutex);
+            if (_activeTxns != 0) {
+                return false;
+            }
+            _env.setMapSize(0);
+            adviseMap();
+            return true;
+        }
+
+        unsigned long getResizeCount() const noexcept
+        {
+            return _resizeCount;
+        }
+
+        bool isGrowthEnabled() const noexcept
+        {
+            return _growthPolicy.enabled();
+        }
+
+        bool isReadOnly() const noexcept
+        {
+            return _readOnly;
+        }
+
+        /**
+         * Database handles exported to the whole environment by a committed transaction,
+         * which can be used by any transaction begun afterwards without opening them again.
+         */
+        bool findDBi(const DBiKey& key, lmdb::DBHandler& handle) const
+        {
+            std::lock_guard<std::mutex> lock(_dbiMutex);
+            auto found = _dbis.find(key);
+            if (found != _dbis.cend()) {
+                handle = found->second;
+                return true;
+            }
+            return false;
+        }
+
+        void cacheDBis(const DBiHandles& handles)
+        {
+            std::lock_guard<std::mutex> lock(_dbiMutex);
+            for (const auto& entry : handles) {
+                _dbis[entry.first] = entry.second;
+            }
+        }
+
+        /**
+         * lmdb does not allow handles to be opened by concurrent transactions, nor while a transaction
+         * which opened some is being committed or aborted, so every handle missing from the cache of the
+         * environment is opened under this lock, which is also held to finish such a transaction.
+         */
+        lmdb::DBi openDBi(const lmdb::TransactionHandler txnHandler, const std::string& dbName,
+            bool numericKey, bool unique)
+        {
+            std::lock_guard<std::mutex> lock(_dbiOpenMutex);
+            return lmdb::DBi::open(txnHandler, dbName, numericKey, unique);
+        }
+
+        std::unique_lock<std::mutex> lockDBiOpen()
+        {
+            return std::unique_lock<std::mutex>(_dbiOpenMutex);
+        }
+
+        void evictDBi(const lmdb::DBHandler handle) noexcept
+        {
+            std::lock_guard<std::mutex> lock(_dbiMutex);
+            evict(_dbis, handle);
+        }
+
+        static void evict(DBiHandles& handles, const lmdb::DBHandler handle) noexcept
+        {
+            for (auto it = handles.begin(); it != handles.end();) {
+                if (it->second == handle) {
+                    it = handles.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
     private:
+        struct ReaderSeen {
+            std::chrono::steady_clock::time_point since;
+            bool reported;
+        };
+
         lmdb::Env _env { nullptr };
+        unsigned int _pageSize { 0 };
+        const std::string _dbPath {};
+        const StorageEngine _engine { StorageEngine::LMDB };
+        const MapAdvice _mapAdvice { MapAdvice::NORMAL };
+        const bool _readOnly { false };
+
+        const MapGrowthPolicy _growthPolicy {};
+        std::atomic<bool> _growthPending { false };
+        std::atomic<unsigned long> _resizeCount { 0 };
+        std::mutex _resizeMutex {};
+        std::condition_variable _resizeCond {};
+        unsigned int _activeTxns { 0 };
+
+        std::thread _flusher {};
+        std::mutex _flusherMutex {};
+        std::condition_variable _flusherCond {};
+        bool _flusherStopped { false };
+
+        std::thread _readerMonitor {};
+        std::mutex _readerMonitorMutex {};
+        std::condition_variable _readerMonitorCond {};
+        bool _readerMonitorStopped { false };
+
+        // readers are told apart by their process, thread and snapshot, and aged from the first check seeing them
+        std::mutex _readerMutex {};
+        std::map<std::tuple<int, size_t, size_t>, ReaderSeen> _readersSeen {};
+        unsigned int _staleReadersCleared { 0 };
+        // none by default, the library leaves logging to the application
+        std::function<void(const ReaderStats&)> _longReaderHandler {};
+
+        mutable std::mutex _dbiMutex {};
+        DBiHandles _dbis {};
+        std::mutex _dbiOpenMutex {};
+
+        // must be called with the reader mutex held, overdue is set when the oldest reader is reported for the first time
+        ReaderStats checkReaders(const std::chrono::milliseconds& maxAge, bool& overdue)
+        {
+            auto stats = ReaderStats {};
+            _staleReadersCleared += static_cast<unsigned int>(_env.readerCheck());
+            stats.staleReadersCleared = _staleReadersCleared;
+            // sampled before the freelist is read so that the transaction reading it is not listed
+            auto readers = _env.readers();
+            auto now = std::chrono::steady_clock::now();
+            auto seen = decltype(_readersSeen) {};
+            auto oldest = seen.end();
+            for (const auto& reader : readers) {
+                auto key = std::make_tuple(reader.pid, reader.thread, reader.txnId);
+                auto found = _readersSeen.find(key);
+                auto entry = seen.emplace(key, (found != _readersSeen.cend()) ? found->second : ReaderSeen { now, false }).first;
+                if (oldest == seen.end() || entry->second.since < oldest->second.since
+                    || (entry->second.since == oldest->second.since && reader.txnId < std::get<2>(oldest->first))) {
+                    oldest = entry;
+                }
+            }
+            stats.numReaders = static_cast<unsigned int>(readers.size());
+            stats.lastTxnId = _env.info().me_last_txnid;
+            if (oldest != seen.end()) {
+                stats.oldestReaderPid = std::get<0>(oldest->first);
+                stats.oldestReaderAgeMs = std::chrono::duration<double, std::milli>(now - oldest->second.since).count();
+                if (maxAge.count() > 0 && !oldest->second.reported && now - oldest->second.since >= maxAge) {
+                    oldest->second.reported = true;
+                    overdue = true;
+                }
+            }
+            // the snapshot of the oldest reader, which may not be the one open for the longest time
+            for (const auto& reader : readers) {
+                if (stats.oldestReaderTxnId == 0 || reader.txnId < stats.oldestReaderTxnId) {
+                    stats.oldestReaderTxnId = reader.txnId;
+                }
+            }
+            _readersSeen.swap(seen);
+            countFreePages(stats);
+            return stats;
+        }
+
+        // the pages freed by a transaction cannot be reused while a reader of an earlier snapshot is open
+        void countFreePages(ReaderStats& stats)
+        {
+            if (_engine != StorageEngine::LMDB) {
+                return;
+            }
+            acquireTxn();
+            try {
+                auto txn = lmdb::Transaction::begin(_env.handle(), lmdb::TXN_RO);
+                auto cursor = lmdb::Cursor::open(txn.handle(), lmdb::FREE_DBI);
+                for (auto entry = cursor.getNext(); !entry.empty(); entry = cursor.getNext()) {
+                    // a list of page numbers prefixed with its length, keyed by the id of the freeing transaction
+                    auto pages = entry.val.data.numeric<size_t>();
+                    stats.freePages += pages;
+                    if (stats.oldestReaderTxnId != 0 && entry.key.data.numeric<size_t>() >= stats.oldestReaderTxnId) {
+                        stats.pinnedFreePages += pages;
+                    }
+                }
+            } catch (...) {
+                releaseTxn();
+                throw;
+            }
+            releaseTxn();
+        }
+
+        // the advice is only a hint, the kernel may ignore it, e.g. huge pages of a file system without them
+        void adviseMap() const
+        {
+            // MapAdvice::RANDOM is applied by lmdb itself with MDB_NORDAHEAD
+            if (_engine != StorageEngine::LMDB || _mapAdvice == MapAdvice::NORMAL || _mapAdvice == MapAdvice::RANDOM) {
+                return;
+            }
+            auto map = findMap();
+            if (map.first == nullptr) {
+                return;
+            }
+            switch (_mapAdvice) {
+            case MapAdvice::SEQUENTIAL:
+                madvise(map.first, map.second, MADV_SEQUENTIAL);
+                break;
+            case MapAdvice::WILLNEED:
+                madvise(map.first, std::min(map.second, (_env.info().me_last_pgno + 1) * static_cast<size_t>(_pageSize)), MADV_WILLNEED);
+                break;
+            case MapAdvice::HUGEPAGE:
+#ifdef MADV_HUGEPAGE
+                madvise(map.first, map.second, MADV_HUGEPAGE);
+#endif
+                break;
+            default:
+                break;
+            }
+        }
+
+        // lmdb only tells where the data file is mapped when it is opened with MDB_FIXEDMAP,
+        // so look it up in the mappings of the process, where they are listed
+        std::pair<void*, size_t> findMap() const
+        {
+            char dataPath[PATH_MAX];
+            if (realpath((_dbPath + DB_DATA_NAME).c_str(), dataPath) == nullptr) {
+                return std::make_pair(nullptr, size_t { 0 });
+            }
+            auto maps = std::ifstream("/proc/self/maps");
+            auto line = std::string {};
+            while (std::getline(maps, line)) {
+                auto pathStart = line.find('/');
+                if (pathStart == std::string::npos || line.compare(pathStart, std::string::npos, dataPath) != 0) {
+                    continue;
+                }
+                auto start = uintptr_t { 0 }, end = uintptr_t { 0 };
+                auto offset = size_t { 0 };
+                if (sscanf(line.c_str(), "%" SCNxPTR "-%" SCNxPTR " %*s %zx", &start, &end, &offset) == 3 && offset == 0) {
+                    return std::make_pair(reinterpret_cast<void*>(start), static_cast<size_t>(end - start));
+                }
+            }
+            return std::make_pair(nullptr, size_t { 0 });
+        }
+
+        size_t freeSpace(const MDB_envinfo& info) const
+        {
+            auto usedSpace = (info.me_last_pgno + 1) * static_cast<size_t>(_pageSize);
+            return (info.me_mapsize > usedSpace) ? info.me_mapsize - usedSpace : 0;
+        }
+
+        /**
+         * Must be called with the resize mutex held while no transaction of this process is running.
+         */
+        void grow()
+        {
+            // a failed growth is not retried until the next write transaction asks for it
+            _growthPending = false;
+            auto mapSize = _env.info().me_mapsize;
+            if (mapSize < _growthPolicy.limit) {
+                auto newSize = std::min<size_t>(mapSize + _growthPolicy.increment(mapSize), _growthPolicy.limit);
+                newSize = (newSize + _pageSize - 1) / _pageSize * _pageSize;
+                _env.setMapSize(newSize);
+                adviseMap();
+                ++_resizeCount;
+            }
+        }
     };
 
     class LMDBTxn {
     public:
         LMDBTxn(LMDBEnv* const env, const unsigned int txnMode)
         {
-            _txn = lmdb::Transaction::begin(env->handle(), txnMode);
+            if (txnMode == lmdb::TXN_RW) {
+                env->prepareWrite();
+            }
+            env->acquireTxn();
+            try {
+                _txn = lmdb::Transaction::begin(env->handle(), txnMode);
+            } catch (const Error& error) {
+                env->releaseTxn();
+                if (error.code() != MDB_MAP_RESIZED || !(env->isGrowthEnabled() || env->isReadOnly())) {
+                    throw;
+                }
+                // the map has been grown by another process, which can only be adopted
+                // while no other transaction of this process is running
+                if (!env->adoptMapSize()) {
+                    throw;
+                }
+                env->acquireTxn();
+                try {
+                    _txn = lmdb::Transaction::begin(env->handle(), txnMode);
+                } catch (...) {
+                    env->releaseTxn();
+                    throw;
+                }
+            }
+            _env = env;
+            _registered = true;
         }
 
         ~LMDBTxn() noexcept
@@ -111,6 +754,11 @@ namespace storage_engine {
         {
             using std::swap;
             swap(_txn, other._txn);
+            swap(_env, other._env);
+            swap(_registered, other._registered);
+            swap(_dbis, other._dbis);
+            swap(_newDBis, other._newDBis);
+            swap(_parents, other._parents);
         }
 
         LMDBTxn& operator=(LMDBTxn&& other) noexcept
@@ -118,17 +766,43 @@ namespace storage_engine {
             if (this != &other) {
                 using std::swap;
                 swap(_txn, other._txn);
+                swap(_env, other._env);
+                swap(_registered, other._registered);
+                swap(_dbis, other._dbis);
+                swap(_newDBis, other._newDBis);
+                swap(_parents, other._parents);
             }
             return *this;
         }
 
         lmdb::DBi openDBi(const std::string& dbName, bool numericKey = false, bool unique = true) const
         {
-            if (_txn.handle()) {
-                return lmdb::DBi::open(_txn.handle(), dbName, numericKey, unique);
-            } else {
+            if (!_txn.handle()) {
                 throw NOGDB_STORAGE_ERROR(MDB_BAD_TXN);
             }
+            auto key = DBiKey { dbName, (numericKey ? MDB_INTEGERKEY : 0U) | (unique ? 0U : MDB_DUPSORT) };
+            auto found = _dbis.find(key);
+            if (found != _dbis.cend()) {
+                return lmdb::DBi { _txn.handle(), found->second };
+            }
+            auto handle = lmdb::DBHandler {};
+            if (!_env->findDBi(key, handle)) {
+                // handles opened by this transaction are shared with the environment only once it commits
+                handle = _env->openDBi(_txn.handle(), dbName, numericKey, unique).handle();
+                _newDBis.emplace(key, handle);
+            }
+            _dbis.emplace(std::move(key), handle);
+            return lmdb::DBi { _txn.handle(), handle };
+        }
+
+        /**
+         * Must be called after a database has been deleted, as lmdb closes its handle immediately.
+         */
+        void closeDBi(const lmdb::DBi& dbi) const noexcept
+        {
+            LMDBEnv::evict(_dbis, dbi.handle());
+            LMDBEnv::evict(_newDBis, dbi.handle());
+            _env->evictDBi(dbi.handle());
         }
 
         lmdb::Cursor openCursor(const lmdb::DBi& dbi) const
@@ -144,23 +818,170 @@ namespace storage_engine {
 
         void commit()
         {
-            _txn.commit();
+            try {
+                // lmdb commits the nested transactions along with their parent, but their handles must be released first
+                while (isNested()) {
+                    commitNested();
+                }
+                auto lock = lockNewDBis();
+                _txn.commit();
+            } catch (const Error& error) {
+                notifyError(error);
+                clearDBis();
+                release();
+                throw;
+            }
             _txn = nullptr;
+            try {
+                _env->cacheDBis(_newDBis);
+            } catch (...) {
+            }
+            clearDBis();
+            release();
         }
 
         void rollback() noexcept
         {
-            _txn.abort();
+            while (isNested()) {
+                abortNested();
+            }
+            {
+                auto lock = lockNewDBis();
+                _txn.abort();
+            }
             _txn = nullptr;
+            clearDBis();
+            release();
+        }
+
+        /**
+         * Begin a write transaction nested in the current one, which takes its place until it is either
+         * committed into its parent or aborted, leaving the parent as it was when the nested one began.
+         */
+        void beginNested()
+        {
+            auto nested = lmdb::Transaction::begin(_txn.env(), lmdb::TXN_RW, _txn.handle());
+            _parents.emplace_back(Parent { std::move(_txn), _newDBis });
+            _txn = std::move(nested);
+        }
+
+        void commitNested()
+        {
+            require(isNested());
+            auto& parent = _parents.back();
+            try {
+                _txn.commit();
+            } catch (...) {
+                // a failed nested commit is aborted by lmdb
+                restoreParent();
+                throw;
+            }
+            _txn = std::move(parent.txn);
+            _parents.pop_back();
+        }
+
+        void abortNested() noexcept
+        {
+            {
+                auto lock = lockNewDBis();
+                _txn.abort();
+            }
+            restoreParent();
+        }
+
+        bool isNested() const noexcept
+        {
+            return !_parents.empty();
+        }
+
+        /**
+         * Release the snapshot of a read-only transaction but keep its handle and reader slot,
+         * so that it can be reused later by renew() without the cost of a new transaction.
+         */
+        void reset() noexcept
+        {
+            {
+                auto lock = lockNewDBis();
+                _txn.reset();
+            }
+            clearDBis();
+            release();
+        }
+
+        void renew()
+        {
+            _env->acquireTxn();
+            _registered = true;
+            try {
+                _txn.renew();
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+
+        void notifyError(const Error& error) const noexcept
+        {
+            if (_env && error.code() == MDB_MAP_FULL) {
+                _env->notifyMapFull();
+            }
         }
 
-        lmdb::TransactionHandler* handle() const noexcept
+        lmdb::TransactionHandler handle() const noexcept
         {
             return _txn.handle();
         }
 
     private:
         lmdb::Transaction _txn { nullptr };
+        LMDBEnv* _env { nullptr };
+        bool _registered { false };
+        // handles resolved by this transaction, and those of them opened by this transaction
+        mutable DBiHandles _dbis {};
+        mutable DBiHandles _newDBis {};
+
+        struct Parent {
+            lmdb::Transaction txn;
+            // the handles opened by the parent when the nested transaction began
+            DBiHandles newDBis;
+        };
+        std::vector<Parent> _parents {};
+
+        void restoreParent() noexcept
+        {
+            // lmdb closes the handles opened by an aborted transaction
+            auto& parent = _parents.back();
+            for (auto it = _newDBis.begin(); it != _newDBis.end();) {
+                if (parent.newDBis.find(it->first) == parent.newDBis.cend()) {
+                    LMDBEnv::evict(_dbis, it->second);
+                    it = _newDBis.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            _txn = std::move(parent.txn);
+            _parents.pop_back();
+        }
+
+        // lmdb exports or closes the handles opened by a transaction when it ends
+        std::unique_lock<std::mutex> lockNewDBis() const
+        {
+            return _newDBis.empty() ? std::unique_lock<std::mutex> {} : _env->lockDBiOpen();
+        }
+
+        void clearDBis() noexcept
+        {
+            _dbis.clear();
+            _newDBis.clear();
+        }
+
+        void release() noexcept
+        {
+            if (_registered) {
+                _env->releaseTxn();
+                _registered = false;
+            }
+        }
     };
 
 }
@@ -20,32 +20,61 @@
  */
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "datarecord.hpp"
 #include "dbinfo_adapter.hpp"
 #include "index.hpp"
 #include "lmdb_engine.hpp"
 #include "relation.hpp"
-#include "schema_adapter.hpp"
+#include "schema.hpp"
+#include "validate.hpp"
 
 #include "nogdb/nogdb.h"
 
 namespace nogdb {
 
-struct TransactionSchemaCache {
-    std::unordered_map<std::string, adapter::schema::ClassAccessInfo> byName {};
-    std::unordered_map<ClassId, adapter::schema::ClassAccessInfo> byId {};
-    std::unordered_map<ClassId, adapter::schema::PropertyNameMapInfo> propertyNameMap {};
+struct Transaction::ReadTxnPool {
+    struct Entry {
+        storage_engine::LMDBTxn* txnBase;
+        Adapter* adapter;
+        relation::GraphUtils* graph;
+        TransactionSchemaCache* schemaCache;
 
-    void invalidate() noexcept
+        void destroy() noexcept
+        {
+            delete txnBase;
+            delete adapter;
+            delete graph;
+            delete schemaCache;
+        }
+    };
+
+    ~ReadTxnPool() noexcept
     {
-        byName.clear();
-        byId.clear();
-        propertyNameMap.clear();
+        for (auto& entry : entries) {
+            entry.destroy();
+        }
     }
+
+    std::mutex mutex {};
+    std::vector<Entry> entries {};
 };
 
+void* Transaction::createReadTxnPool()
+{
+    auto pool = new ReadTxnPool {};
+    pool->entries.reserve(DEFAULT_NOGDB_READ_TXN_POOL_SIZE);
+    return pool;
+}
+
+void Transaction::destroyReadTxnPool(void* pool) noexcept
+{
+    delete static_cast<ReadTxnPool*>(pool);
+}
+
 Transaction::Adapter::Adapter()
     : _dbInfo { nullptr }
     , _class { nullptr }
@@ -82,12 +111,24 @@ Transaction::Adapter::~Adapter() noexcept
     }
 }
 
+void Transaction::Adapter::clearCache() noexcept
+{
+    _dbInfo->clearCache();
+    _class->clearCache();
+}
+
 Transaction::Transaction(Context& ctx, const TxnMode& mode)
     : _txnMode { mode }
     , _txnCtx { &ctx }
 {
-    _schemaCache = new TransactionSchemaCache {};
+    if (mode == TxnMode::READ_WRITE && ctx.isReadOnly()) {
+        throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_READ_ONLY);
+    }
     try {
+        if (mode == TxnMode::READ_ONLY && renewReadTxn()) {
+            return;
+        }
+        _schemaCache = new TransactionSchemaCache {};
         _txnBase = new storage_engine::LMDBTxn(
             _txnCtx->_envHandler,
             (mode == TxnMode::READ_WRITE) ? storage_engine::lmdb::TXN_RW : storage_engine::lmdb::TXN_RO);
@@ -127,6 +168,8 @@ Transaction::Transaction(Transaction&& txn) noexcept
     , _adapter { txn._adapter }
     , _graph { txn._graph }
     , _schemaCache { txn._schemaCache }
+    , _updatedRecords { std::move(txn._updatedRecords) }
+    , _savepoints { std::move(txn._savepoints) }
 {
     txn._txnCtx = nullptr;
     txn._txnBase = nullptr;
@@ -149,6 +192,8 @@ Transaction& Transaction::operator=(Transaction&& txn) noexcept
         _adapter = txn._adapter;
         _graph = txn._graph;
         _schemaCache = txn._schemaCache;
+        _updatedRecords = std::move(txn._updatedRecords);
+        _savepoints = std::move(txn._savepoints);
 
         txn._txnCtx = nullptr;
         txn._txnBase = nullptr;
@@ -161,6 +206,9 @@ Transaction& Transaction::operator=(Transaction&& txn) noexcept
 
 void Transaction::commit()
 {
+    if (recycleReadTxn()) {
+        return;
+    }
     if (_txnBase) {
         try {
             _txnBase->commit();
@@ -182,6 +230,7 @@ void Transaction::commit()
     } else {
         throw NOGDB_TXN_ERROR(NOGDB_TXN_COMPLETED);
     }
+    _savepoints.clear();
     if (_adapter) {
         delete _adapter;
         _adapter = nullptr;
@@ -198,11 +247,15 @@ void Transaction::commit()
 
 void Transaction::rollback() noexcept
 {
+    if (recycleReadTxn()) {
+        return;
+    }
     if (_txnBase) {
         _txnBase->rollback();
         delete _txnBase;
         _txnBase = nullptr;
     }
+    _savepoints.clear();
     if (_adapter) {
         delete _adapter;
         _adapter = nullptr;
@@ -217,4 +270,157 @@ void Transaction::rollback() noexcept
     }
 }
 
+void Transaction::savepoint()
+{
+    BEGIN_VALIDATION(this)
+        .isTxnValid()
+        .isTxnCompleted();
+
+    try {
+        _txnBase->beginNested();
+        _savepoints.push_back(_updatedRecords);
+        rebindAdapters();
+    } catch (const Error& err) {
+        rollback();
+        throw NOGDB_FATAL_ERROR(err);
+    } catch (...) {
+        rollback();
+        std::rethrow_exception(std::current_exception());
+    }
+}
+
+void Transaction::rollbackTo()
+{
+    BEGIN_VALIDATION(this)
+        .isTxnValid()
+        .isTxnCompleted();
+
+    if (_savepoints.empty()) {
+        throw NOGDB_TXN_ERROR(NOGDB_TXN_NO_SAVEPOINT);
+    }
+    try {
+        _txnBase->abortNested();
+        _updatedRecords = std::move(_savepoints.back());
+        _savepoints.pop_back();
+        static_cast<TransactionSchemaCache*>(_schemaCache)->invalidate();
+        rebindAdapters();
+    } catch (const Error& err) {
+        rollback();
+        throw NOGDB_FATAL_ERROR(err);
+    } catch (...) {
+        rollback();
+        std::rethrow_exception(std::current_exception());
+    }
+}
+
+void Transaction::release()
+{
+    BEGIN_VALIDATION(this)
+        .isTxnValid()
+        .isTxnCompleted();
+
+    if (_savepoints.empty()) {
+        throw NOGDB_TXN_ERROR(NOGDB_TXN_NO_SAVEPOINT);
+    }
+    try {
+        _txnBase->commitNested();
+        _savepoints.pop_back();
+        rebindAdapters();
+    } catch (const Error& err) {
+        rollback();
+        throw NOGDB_FATAL_ERROR(err);
+    } catch (...) {
+        rollback();
+        std::rethrow_exception(std::current_exception());
+    }
+}
+
+void Transaction::rollbackOnError() noexcept
+{
+    if (_savepoints.empty() || _txnBase == nullptr) {
+        rollback();
+        return;
+    }
+    // only the work since the innermost savepoint is discarded, and the savepoint is set again
+    try {
+        _txnBase->abortNested();
+        _updatedRecords = _savepoints.back();
+        static_cast<TransactionSchemaCache*>(_schemaCache)->invalidate();
+        _txnBase->beginNested();
+        rebindAdapters();
+    } catch (...) {
+        rollback();
+    }
+}
+
+void Transaction::rebindAdapters()
+{
+    // the schema and relation adapters hold table handles of the transaction they have been opened by
+    delete _adapter;
+    _adapter = nullptr;
+    delete _graph;
+    _graph = nullptr;
+    _adapter = new Adapter(_txnBase);
+    _graph = new relation::GraphUtils(_txnBase, _txnCtx->_versionEnabled);
+}
+
+bool Transaction::renewReadTxn()
+{
+    auto pool = static_cast<ReadTxnPool*>(_txnCtx->_readTxnPool);
+    if (pool == nullptr) {
+        return false;
+    }
+    auto entry = ReadTxnPool::Entry {};
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (pool->entries.empty()) {
+            return false;
+        }
+        entry = pool->entries.back();
+        pool->entries.pop_back();
+    }
+    try {
+        entry.txnBase->renew();
+    } catch (...) {
+        // e.g. the map has been grown by another process, so begin a new transaction instead
+        entry.destroy();
+        return false;
+    }
+    _txnBase = entry.txnBase;
+    _adapter = entry.adapter;
+    _graph = entry.graph;
+    _schemaCache = entry.schemaCache;
+    return true;
+}
+
+bool Transaction::recycleReadTxn() noexcept
+{
+    if (_txnMode != TxnMode::READ_ONLY || _txnCtx == nullptr
+        || _txnBase == nullptr || _adapter == nullptr || _graph == nullptr || _schemaCache == nullptr) {
+        return false;
+    }
+    auto pool = static_cast<ReadTxnPool*>(_txnCtx->_readTxnPool);
+    if (pool == nullptr) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (pool->entries.size() >= DEFAULT_NOGDB_READ_TXN_POOL_SIZE) {
+            return false;
+        }
+        // cached metadata and data record handles are only valid for the snapshot being released
+        _txnBase->reset();
+        _adapter->clearCache();
+        _graph->clearCache();
+        static_cast<TransactionSchemaCache*>(_schemaCache)->invalidate();
+        pool->entries.push_back(ReadTxnPool::Entry {
+            _txnBase, _adapter, _graph, static_cast<TransactionSchemaCache*>(_schemaCache) });
+    }
+    _txnBase = nullptr;
+    _adapter = nullptr;
+    _graph = nullptr;
+    _schemaCache = nullptr;
+    return true;
+}
+
 }
@@ -91,6 +91,12 @@ namespace io {
         return stat((char*)fileName.c_str(), &fileStat) == 0;
     }
 
+    size_t fileSize(const std::string& fileName)
+    {
+        struct stat fileStat;
+        return (stat((char*)fileName.c_str(), &fileStat) == 0) ? static_cast<size_t>(fileStat.st_size) : 0;
+    }
+
 #ifdef __MINGW32__
     int mkdir(const char* pathname, int mode)
     {
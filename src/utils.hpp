@@ -133,6 +133,7 @@ namespace assertion {
 // input/output
 namespace io {
     bool fileExists(const std::string& fileName);
+    size_t fileSize(const std::string& fileName);
     int mkdir(const char* pathname, int mode);
     int openLockFile(const char* pathname);
     int unlockFile(int fd);
@@ -58,7 +58,7 @@ namespace validate {
 
     Validator& Validator::isPropertyIdMaxReach()
     {
-        if ((_txn->_adapter->dbInfo()->getMaxPropertyId() >= UINT16_MAX)) {
+        if ((_txn->_adapter->dbInfo()->getMaxPropertyId() >= OFFSET_TABLE_PROPERTY_ID - 1)) {
             throw NOGDB_CONTEXT_ERROR(NOGDB_CTX_MAXPROPERTY_REACH);
         }
         return *this;
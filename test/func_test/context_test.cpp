@@ -19,6 +19,14 @@
  *
  */
 
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
 #include "func_test.h"
 
 struct ClassSchema {
@@ -902,3 +910,901 @@ void test_multiple_ctx()
         assert(false);
     }
 }
+
+void test_durability_ctx()
+{
+    auto setup = [](nogdb::ContextInitializer& ctxi) { ctxi.setDurability(nogdb::DurabilityMode::ASYNC, 10); };
+    run_on_private_db("durability", setup, [](const std::string& dbPath) {
+        auto rdesc = nogdb::RecordDescriptor {};
+        {
+            nogdb::Context asyncCtx { dbPath };
+            assert(asyncCtx.getDurabilityMode() == nogdb::DurabilityMode::ASYNC);
+            assert(asyncCtx.getFlushInterval() == 10);
+            auto txn = asyncCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("durability", nogdb::ClassType::VERTEX);
+            txn.addProperty("durability", "value", nogdb::PropertyType::INTEGER);
+            rdesc = txn.addVertex("durability", nogdb::Record {}.set("value", 42));
+            txn.commit();
+        }
+        {
+            nogdb::Context asyncCtx { dbPath };
+            assert(asyncCtx.getDurabilityMode() == nogdb::DurabilityMode::ASYNC);
+            assert(asyncCtx.getFlushInterval() == 10);
+            auto txn = asyncCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            assert(txn.fetchRecord(rdesc).getInt("value") == 42);
+            txn.rollback();
+        }
+    });
+}
+
+void test_map_growth_ctx()
+{
+    // the map of an in-memory database does not have a size
+    auto setup = [](nogdb::ContextInitializer& ctxi) {
+        ctxi.setStorageEngine(nogdb::StorageEngine::LMDB)
+            .setMaxDBSize(1UL * 1024 * 1024)
+            .setMapGrowth(1UL * 1024 * 1024, 64UL * 1024 * 1024);
+    };
+    run_on_private_db("growth", setup, [](const std::string& dbPath) {
+        nogdb::Context growthCtx { dbPath };
+        assert(growthCtx.getMaxDBSizeLimit() == 64UL * 1024 * 1024);
+        {
+            auto txn = growthCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("growth", nogdb::ClassType::VERTEX);
+            txn.addProperty("growth", "payload", nogdb::PropertyType::TEXT);
+            txn.commit();
+        }
+        // about 8MB of records in total, far beyond the initial map size
+        const auto payload = std::string(64 * 1024, 'x');
+        for (auto i = 0; i < 128; ++i) {
+            auto txn = growthCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addVertex("growth", nogdb::Record {}.set("payload", payload));
+            txn.commit();
+        }
+        assert(growthCtx.getMapResizeCount() > 0);
+        {
+            // an open reader defers the growth instead of holding back the writer, which replays
+            // the batch that has run out of space once the map has been grown after the reader ends
+            auto reader = growthCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            const auto resizeCount = growthCtx.getMapResizeCount();
+            auto batch = growthCtx.beginBatchTxn();
+            for (auto i = 0; i < 64; ++i) {
+                batch.addVertex("growth", nogdb::Record {}.set("payload", payload));
+            }
+            auto result = batch.commit();
+            assert(result.wait_for(std::chrono::milliseconds(50)) == std::future_status::timeout);
+            assert(growthCtx.getMapResizeCount() == resizeCount);
+            reader.rollback();
+            assert(result.get().size() == 64);
+            assert(growthCtx.getMapResizeCount() > resizeCount);
+        }
+        auto txn = growthCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txn.find("growth").get().size() == 192);
+        txn.rollback();
+    });
+}
+
+void test_concurrent_ctx()
+{
+    run_on_private_db("concurrent", [](nogdb::ContextInitializer&) {}, [](const std::string& dbPath) {
+        auto rdesc = nogdb::RecordDescriptor {};
+        {
+            nogdb::Context writerCtx { dbPath };
+            auto txn = writerCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("concurrent", nogdb::ClassType::VERTEX);
+            txn.addProperty("concurrent", "value", nogdb::PropertyType::INTEGER);
+            rdesc = txn.addVertex("concurrent", nogdb::Record {}.set("value", 42));
+            txn.commit();
+        }
+
+        nogdb::Context sharedCtx { dbPath };
+        std::atomic<unsigned int> failures { 0 };
+        auto workers = std::vector<std::thread> {};
+        for (auto i = 0; i < 8; ++i) {
+            workers.emplace_back([&] {
+                try {
+                    for (auto j = 0; j < 200; ++j) {
+                        // contexts opened, copied and destroyed concurrently share one environment
+                        nogdb::Context localCtx { dbPath };
+                        auto copiedCtx = localCtx;
+                        auto& readCtx = (j % 2 == 0) ? copiedCtx : sharedCtx;
+                        auto txn = readCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+                        if (txn.fetchRecord(rdesc).getInt("value") != 42) {
+                            ++failures;
+                        }
+                        txn.rollback();
+                    }
+                } catch (...) {
+                    ++failures;
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        assert(failures == 0);
+        sharedCtx = nogdb::Context {};
+
+        // the environment must have been closed by the last context, so it can be reopened, while an in-memory
+        // database is kept by run_on_private_db
+        nogdb::Context reopenedCtx { dbPath };
+        auto txn = reopenedCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txn.find("concurrent").get().size() == 1);
+        txn.rollback();
+    });
+}
+
+void test_memory_engine_ctx()
+{
+    // the database is created by the test, which is about its lifetime
+    run_on_private_db("memory", nullptr, [](const std::string& dbPath) {
+        auto rdesc = nogdb::RecordDescriptor {};
+        {
+            auto memoryCtx = nogdb::ContextInitializer(dbPath).setStorageEngine(nogdb::StorageEngine::MEMORY).init();
+            assert(memoryCtx.getStorageEngine() == nogdb::StorageEngine::MEMORY);
+            auto txn = memoryCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("memory", nogdb::ClassType::VERTEX);
+            txn.addProperty("memory", "value", nogdb::PropertyType::INTEGER);
+            rdesc = txn.addVertex("memory", nogdb::Record {}.set("value", 1));
+            txn.commit();
+
+            // readers keep the snapshot they have begun with
+            auto reader = memoryCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            txn = memoryCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.update(rdesc, nogdb::Record {}.set("value", 2));
+            txn.addVertex("memory", nogdb::Record {}.set("value", 3));
+            txn.commit();
+            assert(reader.fetchRecord(rdesc).getInt("value") == 1);
+            assert(reader.find("memory").get().size() == 1);
+            reader.rollback();
+
+            nogdb::Context otherCtx { dbPath };
+            assert(otherCtx.getStorageEngine() == nogdb::StorageEngine::MEMORY);
+            txn = otherCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            assert(txn.fetchRecord(rdesc).getInt("value") == 2);
+            assert(txn.find("memory").get().size() == 2);
+            txn.rollback();
+            // nothing is written to disk, not even the settings
+            assert(access(dbPath.c_str(), F_OK) != 0);
+            try {
+                nogdb::ContextInitializer(dbPath).setStorageEngine(nogdb::StorageEngine::MEMORY).init();
+                assert(false);
+            } catch (const nogdb::Error& ex) {
+                REQUIRE(ex, NOGDB_CTX_ALREADY_INITIALIZED, "NOGDB_CTX_ALREADY_INITIALIZED");
+            }
+        }
+        // the graph is discarded along with the last context
+        try {
+            nogdb::Context memoryCtx { dbPath };
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, NOGDB_CTX_UNINITIALIZED, "NOGDB_CTX_UNINITIALIZED");
+        }
+        auto memoryCtx = nogdb::ContextInitializer(dbPath).setStorageEngine(nogdb::StorageEngine::MEMORY).init();
+        auto txn = memoryCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        try {
+            txn.find("memory").get();
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, NOGDB_CTX_NOEXST_CLASS, "NOGDB_CTX_NOEXST_CLASS");
+        }
+        txn.rollback();
+        assert(access(dbPath.c_str(), F_OK) != 0);
+    });
+}
+
+void test_backup_ctx()
+{
+    // a backup is a copy of an LMDB environment
+    auto setup = [](nogdb::ContextInitializer& ctxi) { ctxi.setStorageEngine(nogdb::StorageEngine::LMDB); };
+    run_on_private_db("backup", setup, [](const std::string& dbPath) {
+        const auto copyPath = dbPath + "_copy";
+        const auto compactPath = dbPath + "_compact";
+        const auto streamPath = dbPath + "_stream";
+        clear_dir(copyPath);
+        clear_dir(compactPath);
+        remove(streamPath.c_str());
+        auto rdesc = nogdb::RecordDescriptor {};
+        nogdb::Context backupCtx { dbPath };
+        {
+            auto txn = backupCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("backup", nogdb::ClassType::VERTEX);
+            txn.addClass("scratch", nogdb::ClassType::VERTEX);
+            txn.addProperty("backup", "value", nogdb::PropertyType::INTEGER);
+            txn.addProperty("scratch", "payload", nogdb::PropertyType::TEXT);
+            rdesc = txn.addVertex("backup", nogdb::Record {}.set("value", 42));
+            for (auto i = 0; i < 256; ++i) {
+                txn.addVertex("scratch", nogdb::Record {}.set("payload", std::string(4096, 'x')));
+            }
+            txn.commit();
+            txn = backupCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.dropClass("scratch");
+            txn.commit();
+        }
+
+        // the writer keeps committing while a copy is running
+        auto copyStats = nogdb::BackupStats {};
+        auto copier = std::thread([&]() { copyStats = backupCtx.backup(copyPath); });
+        {
+            auto txn = backupCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addVertex("backup", nogdb::Record {}.set("value", 1));
+            txn.commit();
+        }
+        copier.join();
+        auto compactStats = backupCtx.backup(compactPath, true);
+        assert(copyStats.path == copyPath);
+        assert(!copyStats.compacted && compactStats.compacted);
+        assert(compactStats.bytesWritten > 0);
+        assert(compactStats.bytesWritten < copyStats.bytesWritten);
+        assert(copyStats.durationMs >= 0.0);
+
+        {
+            nogdb::Context copyCtx { copyPath };
+            auto txn = copyCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            assert(txn.fetchRecord(rdesc).getInt("value") == 42);
+            assert(txn.find("backup").get().size() >= 1);
+            txn.rollback();
+        }
+        {
+            nogdb::Context compactCtx { compactPath };
+            auto txn = compactCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            assert(txn.fetchRecord(rdesc).getInt("value") == 42);
+            assert(txn.find("backup").get().size() == 2);
+            txn.rollback();
+        }
+
+        // a copy over an existing one is refused
+        try {
+            backupCtx.backup(copyPath);
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, EEXIST, "EEXIST");
+        }
+        // so is a copy into a directory which cannot be created
+        try {
+            backupCtx.backup(copyPath + "_missing/copy");
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, ENOENT, "ENOENT");
+        }
+
+        auto fd = open(streamPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        auto streamStats = backupCtx.backup(fd, true);
+        close(fd);
+        struct stat streamStat;
+        assert(stat(streamPath.c_str(), &streamStat) == 0);
+        assert(streamStats.path.empty());
+        assert(streamStats.bytesWritten == static_cast<size_t>(streamStat.st_size));
+        assert(streamStats.bytesWritten > 0);
+        clear_dir(copyPath);
+        clear_dir(compactPath);
+        remove(streamPath.c_str());
+    });
+
+    // an in-memory database has no data file to copy
+    auto memorySetup = [](nogdb::ContextInitializer& ctxi) { ctxi.setStorageEngine(nogdb::StorageEngine::MEMORY); };
+    run_on_private_db("backup_memory", memorySetup, [](const std::string& dbPath) {
+        const auto copyPath = dbPath + "_copy";
+        const auto streamPath = dbPath + "_stream";
+        nogdb::Context memoryCtx { dbPath };
+        try {
+            memoryCtx.backup(copyPath);
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, ENOTSUP, "ENOTSUP");
+        }
+        assert(access(copyPath.c_str(), F_OK) != 0);
+        auto fd = open(streamPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        try {
+            memoryCtx.backup(fd);
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, ENOTSUP, "ENOTSUP");
+        }
+        close(fd);
+        remove(streamPath.c_str());
+    });
+}
+
+void test_reader_monitor_ctx()
+{
+    auto setup = [](nogdb::ContextInitializer& ctxi) {
+        ctxi.setStorageEngine(nogdb::StorageEngine::LMDB).setReaderMonitor(10, 50);
+    };
+    run_on_private_db("reader_monitor", setup, [](const std::string& dbPath) {
+        std::atomic<int> reported { 0 };
+        std::atomic<int> reportedPid { 0 };
+        nogdb::Context monitorCtx { dbPath };
+        assert(monitorCtx.getReaderCheckInterval() == 10);
+        assert(monitorCtx.getMaxReaderAge() == 50);
+        monitorCtx.setLongReaderHandler([&](const nogdb::ReaderStats& stats) {
+            reportedPid = stats.oldestReaderPid;
+            ++reported;
+        });
+        auto rdesc = nogdb::RecordDescriptor {};
+        {
+            auto txn = monitorCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("monitor", nogdb::ClassType::VERTEX);
+            txn.addProperty("monitor", "value", nogdb::PropertyType::INTEGER);
+            rdesc = txn.addVertex("monitor", nogdb::Record {}.set("value", 0));
+            txn.commit();
+        }
+        auto idleStats = monitorCtx.getReaderStats();
+        assert(idleStats.numReaders == 0);
+        assert(idleStats.oldestReaderTxnId == 0);
+        assert(idleStats.pinnedFreePages == 0);
+
+        // every commit frees the pages of the previous snapshot, which the reader keeps pinned
+        auto reader = monitorCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        for (auto i = 1; i <= 8; ++i) {
+            auto txn = monitorCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.update(rdesc, nogdb::Record {}.set("value", i));
+            txn.commit();
+        }
+        auto stats = monitorCtx.getReaderStats();
+        assert(stats.numReaders == 1);
+        assert(stats.oldestReaderPid == getpid());
+        assert(stats.oldestReaderTxnId > 0 && stats.oldestReaderTxnId < stats.lastTxnId);
+        assert(stats.pinnedFreePages > 0);
+        assert(stats.freePages >= stats.pinnedFreePages);
+
+        // the monitor reports the reader once it is older than the maximum age, and only once
+        for (auto i = 0; i < 500 && reported == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(reported == 1);
+        assert(reportedPid == getpid());
+        auto agedStats = monitorCtx.getReaderStats();
+        assert(agedStats.oldestReaderAgeMs >= 50.0);
+        assert(agedStats.oldestReaderAgeMs > stats.oldestReaderAgeMs);
+        assert(reader.fetchRecord(rdesc).getInt("value") == 0);
+        reader.rollback();
+
+        stats = monitorCtx.getReaderStats();
+        assert(stats.numReaders == 0);
+        assert(stats.pinnedFreePages == 0);
+        assert(stats.freePages > 0);
+        monitorCtx.setLongReaderHandler(nullptr);
+    });
+
+    auto memorySetup = [](nogdb::ContextInitializer& ctxi) { ctxi.setStorageEngine(nogdb::StorageEngine::MEMORY); };
+    run_on_private_db("reader_monitor_memory", memorySetup, [](const std::string& dbPath) {
+        // the readers of an in-memory graph are listed too, without any page to free
+        nogdb::Context memoryCtx { dbPath };
+        {
+            auto txn = memoryCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("monitor", nogdb::ClassType::VERTEX);
+            txn.commit();
+        }
+        auto memoryReader = memoryCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        {
+            auto txn = memoryCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addVertex("monitor");
+            txn.commit();
+        }
+        auto memoryStats = memoryCtx.getReaderStats();
+        assert(memoryStats.numReaders == 1);
+        assert(memoryStats.oldestReaderTxnId > 0 && memoryStats.oldestReaderTxnId < memoryStats.lastTxnId);
+        assert(memoryStats.freePages == 0);
+        memoryReader.rollback();
+        assert(memoryCtx.getReaderStats().numReaders == 0);
+    });
+}
+
+void test_warmup_ctx()
+{
+    // the pages warmed up are those of the map of an LMDB environment
+    auto setup = [](nogdb::ContextInitializer& ctxi) {
+        ctxi.setStorageEngine(nogdb::StorageEngine::LMDB).setMapAdvice(nogdb::MapAdvice::RANDOM);
+    };
+    run_on_private_db("warmup", setup, [](const std::string& dbPath) {
+        {
+            nogdb::Context warmupCtx { dbPath };
+            auto txn = warmupCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("warm", nogdb::ClassType::VERTEX);
+            txn.addClass("cold", nogdb::ClassType::VERTEX);
+            txn.addClass("link", nogdb::ClassType::EDGE);
+            txn.addProperty("warm", "value", nogdb::PropertyType::INTEGER);
+            txn.addProperty("warm", "payload", nogdb::PropertyType::BLOB);
+            txn.addProperty("cold", "name", nogdb::PropertyType::TEXT);
+            txn.addIndex("warm", "value");
+            txn.addIndex("cold", "name");
+            auto previous = nogdb::RecordDescriptor {};
+            for (auto i = 0; i < 100; ++i) {
+                auto vertex = txn.addVertex("warm",
+                    nogdb::Record {}.set("value", i - 50).set("payload", nogdb::Bytes { std::string(6000, 'w') }));
+                txn.addVertex("cold", nogdb::Record {}.set("name", "cold" + std::to_string(i)));
+                if (i > 0) {
+                    txn.addEdge("link", previous, vertex);
+                }
+                previous = vertex;
+            }
+            txn.commit();
+        }
+
+        nogdb::Context warmupCtx { dbPath };
+        assert(warmupCtx.getMapAdvice() == nogdb::MapAdvice::RANDOM);
+        auto entriesOf = [](const std::vector<nogdb::TableStat>& tables, const std::string& prefix) {
+            auto entries = size_t { 0 };
+            for (const auto& table : tables) {
+                if (table.name.compare(0, prefix.size(), prefix) == 0) {
+                    entries += table.entries;
+                }
+            }
+            return entries;
+        };
+        auto txn = warmupCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto storageStats = txn.getStorageStats();
+        txn.rollback();
+        auto relationEntries = entriesOf(storageStats.relations, "");
+
+        // the data, the positive and negative tables of the index, and both relation tables
+        auto stats = warmupCtx.warmup({ "warm" });
+        assert(stats.tables == 5);
+        assert(stats.entries == entriesOf(storageStats.classes, "warm") + entriesOf(storageStats.indexes, "warm.") + relationEntries);
+        assert(relationEntries >= 2 * 99);
+        assert(stats.totalPages > 0);
+        assert(stats.residentPages > 0 && stats.residentPages <= stats.totalPages);
+        assert(stats.residentPagesBefore <= stats.totalPages);
+        assert(stats.durationMs >= 0.0);
+
+        stats = warmupCtx.warmup({ "cold" }, false, false);
+        assert(stats.tables == 1);
+        assert(stats.entries == entriesOf(storageStats.classes, "cold"));
+
+        stats = warmupCtx.warmup();
+        assert(stats.tables == 3 + 3 + 2);
+        assert(stats.entries == entriesOf(storageStats.classes, "") + entriesOf(storageStats.indexes, "") + relationEntries);
+
+        try {
+            warmupCtx.warmup({ "missing" });
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, NOGDB_CTX_NOEXST_CLASS, "NOGDB_CTX_NOEXST_CLASS");
+        }
+    });
+}
+
+void test_sharded_ctx()
+{
+    const auto rootPath = DATABASE_PATH + "_sharded";
+    clear_dir(rootPath + "/shard-0");
+    clear_dir(rootPath + "/shard-1");
+    clear_dir(rootPath + "/shard-2");
+    clear_dir(rootPath);
+    try {
+        {
+            auto shardedCtx = nogdb::ShardedContextInitializer(rootPath, 3)
+                                  .setShardSettings([](nogdb::ContextInitializer& initializer) {
+                                      initializer.setMaxDBSize(64UL * 1024 * 1024);
+                                  })
+                                  .placeClass("person", 0)
+                                  .placeClass("knows", 0)
+                                  .placeClass("order", 1)
+                                  .partitionClass("event")
+                                  .init();
+            assert(shardedCtx.getNumShards() == 3);
+            assert(shardedCtx.getShardOf("person") == 0);
+            assert(shardedCtx.getShardOf("order") == 1);
+            assert(shardedCtx.isPartitioned("event"));
+            assert(shardedCtx.getShardsOf("event").size() == 3);
+            assert(shardedCtx.getShard(2).getMaxDBSize() == 64UL * 1024 * 1024);
+
+            auto txn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("person", nogdb::ClassType::VERTEX);
+            txn.addClass("knows", nogdb::ClassType::EDGE);
+            txn.addClass("order", nogdb::ClassType::VERTEX);
+            txn.addClass("event", nogdb::ClassType::VERTEX);
+            txn.addProperty("person", "name", nogdb::PropertyType::TEXT);
+            txn.addProperty("order", "amount", nogdb::PropertyType::INTEGER);
+            txn.addProperty("event", "key", nogdb::PropertyType::TEXT);
+            txn.addIndex("event", "key", true);
+            txn.commit();
+
+            // every shard has a writer of its own
+            auto personTxn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            auto alice = personTxn.getShardOf("person").addVertex("person", nogdb::Record {}.set("name", "alice"));
+            auto bob = personTxn.getShardOf("person").addVertex("person", nogdb::Record {}.set("name", "bob"));
+            personTxn.getShardOf("knows").addEdge("knows", alice, bob);
+            {
+                auto orderTxn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                for (auto i = 0; i < 10; ++i) {
+                    orderTxn.getShardOf("order").addVertex("order", nogdb::Record {}.set("amount", i));
+                }
+                orderTxn.commit();
+            }
+            personTxn.commit();
+
+            auto eventTxn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            for (auto i = 0; i < 30; ++i) {
+                auto key = "event" + std::to_string(i);
+                eventTxn.getShardOf("event", nogdb::Bytes { key }).addVertex("event", nogdb::Record {}.set("key", key));
+            }
+            eventTxn.commit();
+        }
+
+        nogdb::ShardedContext shardedCtx { rootPath };
+        assert(shardedCtx.getNumShards() == 3);
+        assert(shardedCtx.getShardOf("person") == 0);
+        assert(shardedCtx.isPartitioned("event"));
+        auto txn = shardedCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto people = txn.find("person", nogdb::Condition("name").eq("alice"));
+        assert(people.size() == 1);
+        assert(people[0].shard == 0);
+        assert(txn.getShard(0).traverseOut(people[0].descriptor).depth(1, 1).get().size() == 1);
+        auto orders = txn.find("order", nogdb::Condition("amount").ge(5));
+        assert(orders.size() == 5);
+        assert(orders[0].shard == 1);
+
+        // the records of a partitioned class are spread over every shard and found in the shard of their key
+        auto events = txn.find("event");
+        assert(events.size() == 30);
+        auto shardsUsed = std::set<unsigned int> {};
+        for (const auto& event : events) {
+            auto key = event.record.getText("key");
+            assert(event.shard == shardedCtx.getShardOf("event", nogdb::Bytes { key }));
+            shardsUsed.insert(event.shard);
+        }
+        assert(shardsUsed.size() > 1);
+        assert(txn.find("event", nogdb::Condition("key").eq(std::string { "event7" })).size() == 1);
+        txn.rollback();
+
+        try {
+            shardedCtx.getShardOf("event");
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, NOGDB_CTX_INVALID_SHARD, "NOGDB_CTX_INVALID_SHARD");
+        }
+        try {
+            shardedCtx.getShard(3);
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, NOGDB_CTX_INVALID_SHARD, "NOGDB_CTX_INVALID_SHARD");
+        }
+        try {
+            nogdb::ShardedContextInitializer(rootPath, 2).init();
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, NOGDB_CTX_ALREADY_INITIALIZED, "NOGDB_CTX_ALREADY_INITIALIZED");
+        }
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+    clear_dir(rootPath + "/shard-0");
+    clear_dir(rootPath + "/shard-1");
+    clear_dir(rootPath + "/shard-2");
+    clear_dir(rootPath);
+}
+
+void test_sharded_edges_ctx()
+{
+    const auto rootPath = DATABASE_PATH + "_sharded_edges";
+    clear_dir(rootPath + "/shard-0");
+    clear_dir(rootPath + "/shard-1");
+    clear_dir(rootPath + "/shard-2");
+    clear_dir(rootPath);
+    auto countProxies = [](nogdb::ShardedTxn& txn, unsigned int shard) {
+        return txn.getShard(shard).find("_nogdb_shard_proxy").get().size();
+    };
+    try {
+        auto shardedCtx = nogdb::ShardedContextInitializer(rootPath, 3)
+                              .placeClass("person", 0)
+                              .placeClass("knows", 0)
+                              .placeClass("order", 1)
+                              .placeClass("item", 2)
+                              .partitionClass("placed")
+                              .init();
+        auto schemaTxn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+        schemaTxn.addClass("person", nogdb::ClassType::VERTEX);
+        schemaTxn.addClass("knows", nogdb::ClassType::EDGE);
+        schemaTxn.addClass("order", nogdb::ClassType::VERTEX);
+        schemaTxn.addClass("item", nogdb::ClassType::VERTEX);
+        schemaTxn.addClass("placed", nogdb::ClassType::EDGE);
+        schemaTxn.addProperty("person", "name", nogdb::PropertyType::TEXT);
+        schemaTxn.addProperty("order", "amount", nogdb::PropertyType::INTEGER);
+        schemaTxn.addProperty("placed", "at", nogdb::PropertyType::INTEGER);
+        schemaTxn.commit();
+
+        // an edge between shards has a copy in the shard of each of its ends
+        auto txn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+        auto alice = nogdb::ShardedRecordDescriptor { 0, txn.getShardOf("person").addVertex("person", nogdb::Record {}.set("name", "alice")) };
+        auto bob = nogdb::ShardedRecordDescriptor { 0, txn.getShardOf("person").addVertex("person", nogdb::Record {}.set("name", "bob")) };
+        auto order1 = nogdb::ShardedRecordDescriptor { 1, txn.getShardOf("order").addVertex("order", nogdb::Record {}.set("amount", 10)) };
+        auto order2 = nogdb::ShardedRecordDescriptor { 1, txn.getShardOf("order").addVertex("order", nogdb::Record {}.set("amount", 20)) };
+        assert(txn.addEdge("knows", alice, bob).size() == 1);
+        auto alicePlaced = txn.addEdge("placed", alice, order1, nogdb::Record {}.set("at", 1));
+        assert(alicePlaced.size() == 2);
+        assert(alicePlaced[0].shard == 0);
+        assert(alicePlaced[1].shard == 1);
+        txn.addEdge("placed", bob, order2, nogdb::Record {}.set("at", 2));
+        txn.commit();
+        assert(shardedCtx.getPartialCommit().empty());
+
+        {
+            auto readTxn = shardedCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto outEdges = readTxn.findOutEdge(alice);
+            assert(outEdges.size() == 2);
+            auto placed = readTxn.findOutEdge(bob);
+            assert(placed.size() == 1);
+            assert(placed[0].record.getInt("at") == 2);
+            auto dst = readTxn.fetchDst(nogdb::ShardedRecordDescriptor { placed[0].shard, placed[0].descriptor });
+            assert(dst.shard == 1);
+            assert(dst.descriptor.rid == order2.descriptor.rid);
+            assert(dst.record.getInt("amount") == 20);
+            auto inEdges = readTxn.findInEdge(order1);
+            assert(inEdges.size() == 1);
+            auto src = readTxn.fetchSrc(nogdb::ShardedRecordDescriptor { inEdges[0].shard, inEdges[0].descriptor });
+            assert(src.shard == 0);
+            assert(src.record.getText("name") == "alice");
+
+            auto reached = readTxn.traverseOut(alice, 1, 2);
+            assert(reached.size() == 3);
+            auto orders = std::set<nogdb::RecordId> {};
+            for (const auto& vertex : reached) {
+                if (vertex.shard == 1) {
+                    orders.insert(vertex.descriptor.rid);
+                }
+            }
+            assert(orders.size() == 2);
+            assert(readTxn.traverseOut(alice, 0, 1).size() == 3);
+            assert(readTxn.traverseOut(alice, 2, 2).size() == 1);
+            auto sources = readTxn.traverseIn(order2, 1, 2);
+            assert(sources.size() == 2);
+            assert(sources[0].shard == 0);
+            assert(sources[0].record.getText("name") == "bob");
+            assert(sources[1].record.getText("name") == "alice");
+        }
+
+        // a reader sees a write over several shards in all of them or in none
+        {
+            auto readTxn = shardedCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto writeTxn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            writeTxn.getShardOf("person").addVertex("person", nogdb::Record {}.set("name", "carol"));
+            writeTxn.getShardOf("order").addVertex("order", nogdb::Record {}.set("amount", 30));
+            writeTxn.commit();
+            assert(readTxn.find("person").size() == 2);
+            assert(readTxn.find("order").size() == 2);
+            auto laterTxn = shardedCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            assert(laterTxn.find("person").size() == 3);
+            assert(laterTxn.find("order").size() == 3);
+        }
+
+        // removing either copy of an edge between shards removes the other one and the proxies
+        txn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+        assert(countProxies(txn, 0) == 2);
+        assert(countProxies(txn, 1) == 2);
+        txn.remove(alicePlaced[1]);
+        assert(txn.findOutEdge(alice).size() == 1);
+        assert(txn.findInEdge(order1).empty());
+        assert(countProxies(txn, 0) == 1);
+        assert(countProxies(txn, 1) == 1);
+        // as does removing a vertex with an edge to another shard
+        txn.remove(bob);
+        assert(txn.findInEdge(order2).empty());
+        assert(countProxies(txn, 0) == 0);
+        assert(countProxies(txn, 1) == 0);
+        assert(txn.findOutEdge(alice).empty());
+        txn.commit();
+
+        // the writers of an edge between shards are taken in the same order whichever way the edge goes
+        auto addEdges = [&](const nogdb::ShardedRecordDescriptor& src, const nogdb::ShardedRecordDescriptor& dst) {
+            for (auto i = 0; i < 20; ++i) {
+                auto edgeTxn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                edgeTxn.addEdge("placed", src, dst);
+                edgeTxn.commit();
+            }
+        };
+        auto forward = std::async(std::launch::async, addEdges, alice, order1);
+        auto backward = std::async(std::launch::async, addEdges, order1, alice);
+        assert(forward.wait_for(std::chrono::seconds(30)) == std::future_status::ready);
+        assert(backward.wait_for(std::chrono::seconds(30)) == std::future_status::ready);
+        forward.get();
+        backward.get();
+        txn = shardedCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txn.findOutEdge(alice).size() == 20);
+        assert(txn.findInEdge(alice).size() == 20);
+        assert(txn.findInEdge(order1).size() == 20);
+        txn.rollback();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+    clear_dir(rootPath + "/shard-0");
+    clear_dir(rootPath + "/shard-1");
+    clear_dir(rootPath + "/shard-2");
+    clear_dir(rootPath);
+}
+
+void test_sharded_partial_commit_ctx()
+{
+    const auto rootPath = DATABASE_PATH + "_sharded_commit";
+    const auto journalPath = rootPath + "/.commit.nogdb";
+    clear_dir(rootPath + "/shard-0");
+    clear_dir(rootPath + "/shard-1");
+    clear_dir(rootPath + "/shard-2");
+    clear_dir(rootPath);
+    auto readJournal = [&]() {
+        auto journal = std::ifstream(journalPath);
+        auto sequence = uint64_t { 0 };
+        auto state = std::string {};
+        journal >> sequence >> state;
+        return std::make_pair(sequence, state);
+    };
+    try {
+        auto sequence = uint64_t { 0 };
+        {
+            auto shardedCtx = nogdb::ShardedContextInitializer(rootPath, 3)
+                                  .placeClass("person", 0)
+                                  .placeClass("order", 1)
+                                  .placeClass("item", 2)
+                                  .init();
+            auto txn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("person", nogdb::ClassType::VERTEX);
+            txn.addClass("order", nogdb::ClassType::VERTEX);
+            txn.addClass("item", nogdb::ClassType::VERTEX);
+            txn.commit();
+            assert(readJournal().second == "done");
+
+            txn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.getShardOf("person").addVertex("person");
+            txn.getShardOf("item").addVertex("item");
+            txn.commit();
+            sequence = readJournal().first;
+            assert(readJournal().second == "done");
+            assert(shardedCtx.getPartialCommit().empty());
+        }
+
+        // as if the process had stopped after shard 0 committed the last write, which shard 1 took part in too
+        {
+            auto journal = std::ofstream(journalPath, std::ios::trunc);
+            journal << sequence << " pending 0 1\n";
+        }
+        {
+            nogdb::ShardedContext shardedCtx { rootPath };
+            auto partial = shardedCtx.getPartialCommit();
+            assert(partial.size() == 1);
+            assert(partial[0] == 0);
+            // still reported by the other contexts of the root folder
+            assert(nogdb::ShardedContext { rootPath }.getPartialCommit().size() == 1);
+            shardedCtx.clearPartialCommit();
+            assert(shardedCtx.getPartialCommit().empty());
+        }
+        assert(nogdb::ShardedContext { rootPath }.getPartialCommit().empty());
+
+        // a journal left pending by a write which every shard has committed is complete
+        {
+            auto journal = std::ofstream(journalPath, std::ios::trunc);
+            journal << sequence << " pending 0 2\n";
+        }
+        {
+            nogdb::ShardedContext shardedCtx { rootPath };
+            assert(shardedCtx.getPartialCommit().empty());
+            assert(readJournal().second == "done");
+            auto txn = shardedCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            assert(txn.find("person").size() == 1);
+            assert(txn.find("item").size() == 1);
+            txn.rollback();
+
+            txn = shardedCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.getShardOf("order").addVertex("order");
+            txn.getShardOf("item").addVertex("item");
+            txn.commit();
+            assert(readJournal().first == sequence + 1);
+        }
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+    clear_dir(rootPath + "/shard-0");
+    clear_dir(rootPath + "/shard-1");
+    clear_dir(rootPath + "/shard-2");
+    clear_dir(rootPath);
+}
+
+void test_read_only_ctx()
+{
+    // a read-only environment and its lock file are those of LMDB
+    auto setup = [](nogdb::ContextInitializer& ctxi) {
+        ctxi.setStorageEngine(nogdb::StorageEngine::LMDB)
+            .setDurability(nogdb::DurabilityMode::ASYNC)
+            .setReaderMonitor(50);
+    };
+    run_on_private_db("read_only", setup, [](const std::string& dbPath) {
+        {
+            nogdb::Context writeCtx { dbPath };
+            auto txn = writeCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("item", nogdb::ClassType::VERTEX);
+            txn.addClass("link", nogdb::ClassType::EDGE);
+            txn.addProperty("item", "value", nogdb::PropertyType::INTEGER);
+            txn.addIndex("item", "value");
+            auto previous = nogdb::RecordDescriptor {};
+            for (auto i = 0; i < 20; ++i) {
+                auto vertex = txn.addVertex("item", nogdb::Record {}.set("value", i));
+                if (i > 0) {
+                    txn.addEdge("link", previous, vertex);
+                }
+                previous = vertex;
+            }
+            txn.commit();
+        }
+
+        {
+            nogdb::Context readCtx { dbPath, nogdb::OpenMode::READ_ONLY };
+            assert(readCtx.isReadOnly());
+            assert(readCtx.getOpenMode() == nogdb::OpenMode::READ_ONLY);
+            auto txn = readCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            assert(txn.find("item").get().size() == 20);
+            assert(txn.find("item").where(nogdb::Condition("value").lt(5)).indexed().get().size() == 5);
+            auto first = txn.find("item").where(nogdb::Condition("value").eq(0)).get();
+            assert(txn.traverseOut(first[0].descriptor).depth(1, 19).get().size() == 19);
+            txn.rollback();
+
+            try {
+                readCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                assert(false);
+            } catch (const nogdb::Error& ex) {
+                REQUIRE(ex, NOGDB_CTX_READ_ONLY, "NOGDB_CTX_READ_ONLY");
+            }
+            try {
+                nogdb::Transaction writeTxn { readCtx, nogdb::TxnMode::READ_WRITE };
+                assert(false);
+            } catch (const nogdb::Error& ex) {
+                REQUIRE(ex, NOGDB_CTX_READ_ONLY, "NOGDB_CTX_READ_ONLY");
+            }
+            try {
+                readCtx.beginBatchTxn();
+                assert(false);
+            } catch (const nogdb::Error& ex) {
+                REQUIRE(ex, NOGDB_CTX_READ_ONLY, "NOGDB_CTX_READ_ONLY");
+            }
+            try {
+                readCtx.beginBulkLoad();
+                assert(false);
+            } catch (const nogdb::Error& ex) {
+                REQUIRE(ex, NOGDB_CTX_READ_ONLY, "NOGDB_CTX_READ_ONLY");
+            }
+            // the environment of the process is read-only, so it can't be shared with a writing context
+            try {
+                nogdb::Context writeCtx { dbPath };
+                assert(false);
+            } catch (const nogdb::Error& ex) {
+                REQUIRE(ex, NOGDB_CTX_READ_ONLY, "NOGDB_CTX_READ_ONLY");
+            }
+            auto copyCtx = readCtx;
+            assert(copyCtx.isReadOnly());
+            assert(copyCtx.beginTxn(nogdb::TxnMode::READ_ONLY).find("item").get().size() == 20);
+        }
+
+        {
+            // a read-only context of a database opened for writing shares its environment, but still can't write
+            nogdb::Context writeCtx { dbPath };
+            nogdb::Context readCtx { dbPath, nogdb::OpenMode::READ_ONLY };
+            auto txn = writeCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addVertex("item", nogdb::Record {}.set("value", 20));
+            txn.commit();
+            assert(readCtx.beginTxn(nogdb::TxnMode::READ_ONLY).find("item").get().size() == 21);
+            try {
+                readCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                assert(false);
+            } catch (const nogdb::Error& ex) {
+                REQUIRE(ex, NOGDB_CTX_READ_ONLY, "NOGDB_CTX_READ_ONLY");
+            }
+        }
+
+        {
+            // the lock file is neither used nor created
+            unlink((dbPath + "/lock.mdb").c_str());
+            nogdb::Context readCtx { dbPath, nogdb::OpenMode::READ_ONLY_NO_LOCK };
+            auto txn = readCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            assert(txn.find("item").get().size() == 21);
+            txn.rollback();
+            assert(readCtx.getReaderStats().numReaders == 0);
+            assert(access((dbPath + "/lock.mdb").c_str(), F_OK) != 0);
+        }
+    });
+}
+
@@ -96,11 +96,23 @@ int main()
     std::cout << "\n\x1B[96mEnd-to-end tests for a database context copying and re-opening should:\x1B[0m\n";
     exec(test_reopen_ctx, "reopening a context");
     exec(test_ctx_move, "moving contexts");
+    exec(test_durability_ctx, "persisting the durability mode of a context");
+    exec(test_map_growth_ctx, "growing the map size of a context on demand");
+    exec(test_concurrent_ctx, "sharing a context between threads");
+    exec(test_memory_engine_ctx, "keeping a graph in memory only");
+    exec(test_backup_ctx, "copying a context while it is written");
+    exec(test_reader_monitor_ctx, "monitoring the read transactions of a context");
+    exec(test_warmup_ctx, "warming up the tables of a context");
+    exec(test_sharded_ctx, "spreading classes over several environments");
+    exec(test_sharded_edges_ctx, "connecting vertices of different shards");
+    exec(test_sharded_partial_commit_ctx, "detecting a write committed by some of its shards");
+    exec(test_read_only_ctx, "opening a database read-only");
 #endif
     // type
 #ifdef TEST_RECORD_OPERATIONS
     std::cout << "\n\x1B[96mEnd-to-end tests for types in a database should:\x1B[0m\n";
     exec(test_bytes_only, "converting primitive types to bytes");
+    exec(test_bytes_copy, "copying and moving short and long bytes");
     exec(test_record_with_bytes, "getting/setting bytes from/to record");
     exec(test_invalid_record_with_bytes, "getting values from record with invalid properties");
     exec(test_invalid_record_property_name, "setting values into record with invalid property names");
@@ -129,6 +141,10 @@ int main()
     exec(test_get_edge_all_cursor, "retrieving a cursor of incoming and outgoing edges from a vertex");
     exec(test_get_invalid_edge_all_cursor, "retrieving a cursor of incoming and outgoing edges from an invalid vertex");
     exec(test_update_vertex, "updating a vertex");
+    exec(test_update_vertex_patch, "patching some properties of a vertex");
+    exec(test_fetched_record, "reading and changing a fetched record");
+    exec(test_fetched_record_basic_info, "reading the basic info of a fetched record");
+    exec(test_concurrent_record_reads, "reading a fetched record from several threads");
     exec(test_update_invalid_vertex, "updating an invalid vertex");
     exec(test_delete_vertex_only, "deleting a vertex (without edges)");
     exec(test_delete_all_vertices, "deleting all vertices in the same class");
@@ -173,6 +189,9 @@ int main()
     exec(test_get_set_empty_value, "setting and getting an empty value of a record");
     exec(test_get_invalid_record, "getting an invalid record");
     exec(test_get_set_large_record, "setting and getting a large size of value in a record");
+    exec(test_get_set_large_value_out_of_record, "setting and getting large values stored out of their records");
+    exec(test_compress_records, "compressing the records of a class");
+    exec(test_record_format, "writing records with an offset table");
     exec(test_overwrite_basic_info, "setting values with overwritten basic info");
     exec(test_standalone_vertex, "getting in-edges and out-edges from a standalone vertex");
     exec(test_delete_vertex_with_edges, "deleting a vertex (with edges)");
@@ -182,10 +201,12 @@ int main()
     exec(test_drop_class_with_relations, "dropping a class with some relations and reloading the database");
     exec(test_get_count_vertex, "getting a number of vertex records in result set via count()");
     exec(test_get_count_edge, "getting a number of edge records in result set via count()");
+    exec(test_storage_stats, "reporting the storage statistics of the tables");
 
     std::cout << "\n\x1B[96mEnd-to-end tests for create/update/delete operations with record versioning should:\x1B[0m\n";
     exec(test_version_add_vertex_edge, "adding new vertices and edges with record versioning");
     exec(test_version_update_vertex_edge, "updating vertices and edges with record versioning");
+    exec(test_version_patch_vertex_edge, "patching vertices and edges with record versioning");
     exec(test_version_update_src_dst_edge, "updating src and dst vertices of edges with record versioning");
     exec(test_version_remove_vertex_edge, "removing vertices and edges with record versioning");
     exec(test_version_remove_all_vertex_edge, "removing all vertices and edges with record versioning");
@@ -227,6 +248,7 @@ int main()
     exec(test_bfs_traverse_multi_vertices, "traversing a graph using bfs algorithm with multi-vertex sources");
     exec(test_bfs_traverse_multi_vertices_with_condition, "traversing a graph using bfs algorithm with multi-vertex sources and conditions");
     exec(destroy_test_graph, "destroying the graph for testing graph operations");
+    exec(test_legacy_relation_keys, "migrating legacy relation keys");
 #endif
     // find
 #ifdef TEST_FIND_OPERATIONS
@@ -243,6 +265,8 @@ int main()
     exec(test_find_edge, "finding records from an edge class with a given condition");
     exec(test_find_invalid_edge, "finding records from an invalid edge class or with an invalid condition");
     exec(test_find_vertex_cursor, "finding cursors from a vertex class with a given condition");
+    exec(test_find_vertex_view, "finding record views from a vertex class and comparing them with records");
+    exec(test_find_raw_condition, "finding records with conditions checked on their raw data");
     exec(test_find_invalid_vertex_cursor, "finding cursors from an invalid vertex class or an invalid condition");
     exec(test_find_edge_cursor, "finding cursors from an edge class with a given condition");
     exec(test_find_invalid_edge_cursor, "finding cursors from an invalid edge class or with an invalid condition");
@@ -394,6 +418,7 @@ int main()
     exec(test_search_by_index_extended_class_cursor_condition, "getting cursor from indexing with extended class with condition");
 //    exec(test_search_by_index_extended_class_multicondition, "getting records from indexing with extended class with condition");
 //    exec(test_search_by_index_extended_class_cursor_multicondition, "getting cursor from indexing with extended class with condition");
+    exec(test_search_by_index_concurrently, "getting records by indexes from concurrent read transactions");
 #endif
     // ctx
 #ifdef TEST_CONTEXT_OPERATIONS
@@ -475,6 +500,12 @@ int main()
     exec(test_txn_modify_edges_multiversion_commit, "committing multi-version txn when modifying edges with vertices");
     exec(test_txn_modify_edges_multiversion_rollback, "aborting multi-version txn when modifying edges with vertices");
     exec(test_txn_reopen_ctx, "reopening context and committing txn with vertices and edges");
+    exec(test_txn_recycle_read_only, "reusing read-only txns after they are completed");
+    exec(test_txn_reuse_dropped_tables, "reusing tables after dropping classes and indexes");
+    exec(test_txn_batch_commit, "committing batches submitted from several threads");
+    exec(test_txn_batch_settings, "writing batches with the settings of the context");
+    exec(test_txn_bulk_load, "loading records, relations and indexes in bulk");
+    exec(test_txn_savepoints, "rolling back to savepoints and releasing them");
     exec(test_txn_invalid_operations, "committing txn with invalid operations");
 #endif
 
@@ -519,6 +550,8 @@ int main()
     exec(test_sql_create_index, "creating index with sql command");
     exec(test_sql_create_index_unique, "creating unique index with sql command");
     exec(test_sql_drop_index, "droping index with sql command");
+    exec(test_sql_show_storage, "showing storage statistics with sql command");
+    exec(test_sql_show_as_identifier, "using show as a class and a property name with sql command");
 #endif
 
     destroy_context();
@@ -52,6 +52,17 @@ extern void test_reopen_ctx_v6(); // with records, extended classes, and indexin
 // extern void test_locked_ctx();
 extern void test_invalid_ctx();
 extern void test_multiple_ctx();
+extern void test_durability_ctx();
+extern void test_map_growth_ctx();
+extern void test_concurrent_ctx();
+extern void test_memory_engine_ctx();
+extern void test_backup_ctx();
+extern void test_reader_monitor_ctx();
+extern void test_warmup_ctx();
+extern void test_sharded_ctx();
+extern void test_sharded_edges_ctx();
+extern void test_sharded_partial_commit_ctx();
+extern void test_read_only_ctx();
 
 #endif
 
@@ -76,6 +87,7 @@ extern void test_alter_invalid_property();
 // record operations testing
 #ifdef TEST_RECORD_OPERATIONS
 extern void test_bytes_only();
+extern void test_bytes_copy();
 extern void test_record_with_bytes();
 extern void test_invalid_record_with_bytes();
 extern void test_invalid_record_property_name();
@@ -88,6 +100,10 @@ extern void test_get_invalid_vertices();
 extern void test_get_vertex_cursor();
 extern void test_get_invalid_vertex_cursor();
 extern void test_update_vertex();
+extern void test_update_vertex_patch();
+extern void test_fetched_record();
+extern void test_fetched_record_basic_info();
+extern void test_concurrent_record_reads();
 extern void test_update_invalid_vertex();
 extern void test_delete_vertex_only();
 extern void test_delete_invalid_vertex();
@@ -133,6 +149,9 @@ extern void test_get_invalid_edge();
 extern void test_get_set_empty_value();
 extern void test_get_invalid_record();
 extern void test_get_set_large_record();
+extern void test_get_set_large_value_out_of_record();
+extern void test_compress_records();
+extern void test_record_format();
 extern void test_overwrite_basic_info();
 extern void test_standalone_vertex();
 extern void test_delete_vertex_with_edges();
@@ -144,12 +163,14 @@ extern void test_drop_and_find_extended_class();
 extern void test_conflict_property();
 extern void test_version_add_vertex_edge();
 extern void test_version_update_vertex_edge();
+extern void test_version_patch_vertex_edge();
 extern void test_version_update_src_dst_edge();
 extern void test_version_remove_vertex_edge();
 extern void test_version_remove_all_vertex_edge();
 extern void test_version_drop_vertex_edge();
 extern void test_get_count_vertex();
 extern void test_get_count_edge();
+extern void test_storage_stats();
 #endif
 
 // graph operations testing
@@ -186,6 +207,7 @@ extern void test_shortest_path_cursor_with_condition();
 extern void test_bfs_traverse_multi_edges_with_condition();
 extern void test_bfs_traverse_multi_vertices();
 extern void test_bfs_traverse_multi_vertices_with_condition();
+extern void test_legacy_relation_keys();
 // extern void test_shortest_path_dijkstra();
 #endif
 
@@ -201,6 +223,8 @@ extern void test_create_informative_graph();
 extern void test_find_vertex();
 extern void test_find_invalid_vertex();
 extern void test_find_vertex_cursor();
+extern void test_find_vertex_view();
+extern void test_find_raw_condition();
 extern void test_find_invalid_vertex_cursor();
 extern void test_find_edge();
 extern void test_find_invalid_edge();
@@ -310,6 +334,7 @@ extern void test_search_by_index_extended_class_condition();
 extern void test_search_by_index_extended_class_cursor_condition();
 extern void test_search_by_index_extended_class_multicondition();
 extern void test_search_by_index_extended_class_cursor_multicondition();
+extern void test_search_by_index_concurrently();
 #endif
 
 // schema transaction testing
@@ -383,6 +408,12 @@ extern void test_txn_modify_edges_multiversion_commit();
 extern void test_txn_modify_edges_multiversion_rollback();
 extern void test_txn_rollback_when_destroy();
 extern void test_txn_reopen_ctx();
+extern void test_txn_recycle_read_only();
+extern void test_txn_reuse_dropped_tables();
+extern void test_txn_batch_commit();
+extern void test_txn_batch_settings();
+extern void test_txn_bulk_load();
+extern void test_txn_savepoints();
 extern void test_txn_invalid_operations();
 #endif
 
@@ -426,4 +457,6 @@ extern void test_sql_traverse();
 extern void test_sql_create_index();
 extern void test_sql_create_index_unique();
 extern void test_sql_drop_index();
+extern void test_sql_show_storage();
+extern void test_sql_show_as_identifier();
 #endif
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cassert>
+#include <cstdlib>
 #include <dirent.h>
 #include <functional>
 #include <iostream>
@@ -36,20 +37,34 @@
 
 #include "nogdb/nogdb.h"
 
-inline void init()
+inline void clear_dir(const std::string& dbPath)
 {
-    // clear_dir
-    DIR* theFolder = opendir(DATABASE_PATH.c_str());
+    DIR* theFolder = opendir(dbPath.c_str());
     if (theFolder != NULL) {
         struct dirent* next_file;
-        char filepath[256];
         while ((next_file = readdir(theFolder)) != NULL) {
-            sprintf(filepath, "%s/%s", DATABASE_PATH.c_str(), next_file->d_name);
-            remove(filepath);
+            auto filepath = dbPath + "/" + next_file->d_name;
+            remove(filepath.c_str());
         }
         closedir(theFolder);
-        rmdir(DATABASE_PATH.c_str());
+        rmdir(dbPath.c_str());
+    }
+}
+
+inline nogdb::StorageEngine test_storage_engine()
+{
+    auto storageEngine = std::getenv("NOGDB_TEST_STORAGE_ENGINE");
+    if (storageEngine != nullptr && std::string { storageEngine } == "memory") {
+        return nogdb::StorageEngine::MEMORY;
     }
+    return nogdb::StorageEngine::LMDB;
+}
+
+inline void init()
+{
+    // an in-memory database only lives as long as one of its contexts, which is kept until the test exits
+    static nogdb::Context memoryCtx {};
+    clear_dir(DATABASE_PATH);
     // create database
     auto ctxi = nogdb::ContextInitializer(DATABASE_PATH);
 #ifdef ENABLE_TEST_RECORD_VERSION
@@ -58,7 +73,40 @@ inline void init()
 #else
     std::cout << "Initializing Database Context...\n";
 #endif
-    ctxi.init();
+    if (test_storage_engine() == nogdb::StorageEngine::MEMORY) {
+        std::cout << "Using the in-memory storage engine...\n";
+        memoryCtx = ctxi.setStorageEngine(nogdb::StorageEngine::MEMORY).init();
+    } else {
+        ctxi.init();
+    }
+}
+
+// runs a test which needs context options of its own on a database of its own, removed before and after the test;
+// the database is created by setup on the storage engine of the run unless setup picks another one, and an in-memory
+// database is kept until the test ends so that the test can open it by its path. A test without setup creates its
+// database itself.
+inline void run_on_private_db(const std::string& name, const std::function<void(nogdb::ContextInitializer&)>& setup,
+    const std::function<void(const std::string&)>& test)
+{
+    const auto dbPath = DATABASE_PATH + "_" + name;
+    clear_dir(dbPath);
+    try {
+        auto memoryCtx = nogdb::Context {};
+        if (setup) {
+            auto ctxi = nogdb::ContextInitializer(dbPath);
+            ctxi.setStorageEngine(test_storage_engine());
+            setup(ctxi);
+            auto ctx = ctxi.init();
+            if (ctx.getStorageEngine() == nogdb::StorageEngine::MEMORY) {
+                memoryCtx = std::move(ctx);
+            }
+        }
+        test(dbPath);
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+    clear_dir(dbPath);
 }
 
 #define REQUIRE(_err, _exp, _msg) require(_err, _exp, _msg, __FUNCTION__, __LINE__, __FILE__)
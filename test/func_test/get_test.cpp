@@ -2082,6 +2082,133 @@ void test_find_vertex_cursor()
     txn.commit();
 }
 
+void test_find_vertex_view()
+{
+    auto txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+    try {
+        auto res = txn.find("locations").get();
+        auto views = txn.find("locations").getView();
+        assert(views.size() == res.size());
+        for (size_t i = 0; i < res.size(); ++i) {
+            const auto& record = res[i].record;
+            const auto& view = views[i].record;
+            assert(views[i].descriptor == res[i].descriptor);
+            assert(view.getClassName() == record.getClassName());
+            assert(view.getRecordId() == res[i].descriptor.rid);
+            assert(view.getVersion() == record.getVersion());
+            assert(view.getText("name") == record.getText("name"));
+            assert(view.get("@recordId").toText() == record.get("@recordId").toText());
+            assert(view.size() == record.size());
+            if (!record.get("temperature").empty()) {
+                assert(view.getInt("temperature") == record.getInt("temperature"));
+            }
+            if (!record.get("price").empty()) {
+                assert(view.getBigInt("price") == record.getBigInt("price"));
+            }
+            if (!record.get("coordinates").empty()) {
+                auto expected = Coordinates {};
+                auto actual = Coordinates {};
+                record.get("coordinates").convertTo(expected);
+                view.get("coordinates").convertTo(actual);
+                assert(actual.x == expected.x);
+                assert(actual.y == expected.y);
+            }
+            auto copy = view.toRecord();
+            assert(copy.getText("name") == record.getText("name"));
+            assert(copy.getClassName() == record.getClassName());
+        }
+
+        views = txn.find("locations").where(nogdb::Condition("name").eq("Pentagon")).getView();
+        assert(views.size() == 1);
+        assert(views[0].record.getInt("temperature") == 18);
+        assert(views[0].record.getText("unknown").empty());
+        assert(views[0].record.get("rating").empty());
+
+        auto cursor = txn.find("locations").where(nogdb::Condition("rating").eq(4.5)).getCursor();
+        ASSERT_SIZE(cursor, 2);
+        cursor.next();
+        assert(cursor.getView().record.getText("name") == "New York Tower");
+        cursor.next();
+        assert(cursor.getView().record.getText("name") == "Empire State Building");
+        assert(cursor->record.getText("name") == "Empire State Building");
+
+        auto edges = txn.find("street").get();
+        auto edgeViews = txn.find("street").getView();
+        assert(edgeViews.size() == edges.size());
+        for (size_t i = 0; i < edges.size(); ++i) {
+            assert(edgeViews[i].record.getText("name") == edges[i].record.getText("name"));
+            if (!edges[i].record.get("distance").empty()) {
+                assert(edgeViews[i].record.getReal("distance") == edges[i].record.getReal("distance"));
+            }
+        }
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    try {
+        auto views = txn.find("locations").where(nogdb::Condition("name").eq("Pentagon")).getView();
+        views[0].record.getReal("rating");
+        assert(false);
+    } catch (const nogdb::Error& ex) {
+        REQUIRE(ex, NOGDB_CTX_NOEXST_PROPERTY, "NOGDB_CTX_NOEXST_PROPERTY");
+    }
+    txn.rollback();
+}
+
+void test_find_raw_condition()
+{
+    auto txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+    try {
+        // a condition on a property is checked on the raw records, and a matching record is returned entirely
+        auto res = txn.find("locations").where(nogdb::Condition("temperature").eq(18)).get();
+        ASSERT_SIZE(res, 1);
+        assert(res[0].record.getText("name") == "Pentagon");
+        assert(res[0].record.getBigInt("price") == 300000LL);
+        assert(res[0].record.getClassName() == "locations");
+        res = txn.find("locations").where(nogdb::Condition("name").beginWith("Empire")).get();
+        ASSERT_SIZE(res, 1);
+        assert(res[0].record.getIntU("postcode") == 10250U);
+        assert(txn.find("locations").where(nogdb::Condition("temperature").gt(15)).count() == 3);
+        assert(txn.find("locations").where(!nogdb::Condition("temperature").gt(15)).count() == 1);
+        assert(txn.find("locations").where(nogdb::Condition("temperature").null()).count() == 1);
+        assert(txn.find("locations").where(nogdb::Condition("price")).count() == 4);
+        assert(txn.find("locations")
+                   .where(nogdb::Condition("name").in(std::vector<std::string> { "Pentagon", "ThaiCC Tower" }))
+                   .count()
+            == 2);
+        ASSERT_SIZE(txn.find("locations").where(nogdb::Condition("rating").lt(4.0)).getCursor(), 1);
+        assert(txn.find("street").where(nogdb::Condition("distance").le(15.0)).count() == 3);
+        ASSERT_SIZE(txn.find("street").where(nogdb::Condition("temperature").null()).get(), 6);
+
+        // a multi-condition only decodes the properties it is on, unless it needs the whole record
+        res = txn.find("locations")
+                  .where(nogdb::Condition("temperature").ge(18) && nogdb::Condition("name").eq("Pentagon"))
+                  .get();
+        ASSERT_SIZE(res, 1);
+        assert(res[0].record.getText("name") == "Pentagon");
+        assert(res[0].record.getIntU("postcode") == 10475U);
+        assert(txn.find("locations")
+                   .where(nogdb::Condition("temperature").null() || nogdb::Condition("price").null())
+                   .count()
+            == 2);
+        assert(txn.find("locations")
+                   .where(nogdb::Condition("temperature").null() && [](const nogdb::Record& record) {
+                       return record.getText("name") == "Empire State Building";
+                   })
+                   .count()
+            == 1);
+        assert(txn.find("locations")
+                   .where(nogdb::Condition("name").null() || nogdb::Condition("@className").eq("locations"))
+                   .count()
+            == 5);
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+    txn.rollback();
+}
+
 void test_find_invalid_vertex_cursor()
 {
     auto txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
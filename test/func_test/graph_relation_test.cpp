@@ -20,6 +20,7 @@
  */
 
 #include "func_test.h"
+#include "lmdb/lmdb.h"
 #include "setup_cleanup.h"
 #include <set>
 
@@ -730,3 +731,90 @@ void test_get_invalid_edge_all_more()
         REQUIRE(ex, NOGDB_GRAPH_NOEXST_VERTEX, "NOGDB_GRAPH_NOEXST_VERTEX");
     }
 }
+
+void test_legacy_relation_keys()
+{
+    // the relation tables are rewritten with LMDB directly
+    auto setup = [](nogdb::ContextInitializer& ctxi) { ctxi.setStorageEngine(nogdb::StorageEngine::LMDB); };
+    run_on_private_db("legacy_relation", setup, [](const std::string& dbPath) {
+        auto v1 = nogdb::RecordDescriptor {}, v2 = nogdb::RecordDescriptor {}, v3 = nogdb::RecordDescriptor {};
+        auto e1 = nogdb::RecordDescriptor {}, e2 = nogdb::RecordDescriptor {};
+        {
+            nogdb::Context ctx { dbPath };
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("persons", nogdb::ClassType::VERTEX);
+            txn.addClass("knows", nogdb::ClassType::EDGE);
+            v1 = txn.addVertex("persons");
+            v2 = txn.addVertex("persons");
+            v3 = txn.addVertex("persons");
+            e1 = txn.addEdge("knows", v1, v2);
+            e2 = txn.addEdge("knows", v2, v3);
+            txn.commit();
+        }
+
+        // rewrite the relation tables the way older versions stored them, with "classId:positionId" keys
+        MDB_env* env = nullptr;
+        MDB_txn* txn = nullptr;
+        assert(mdb_env_create(&env) == 0);
+        assert(mdb_env_set_maxdbs(env, 1024) == 0);
+        assert(mdb_env_open(env, dbPath.c_str(), MDB_NOTLS, 0664) == 0);
+        assert(mdb_txn_begin(env, nullptr, 0, &txn) == 0);
+        for (const auto& name : { ".relations#in", ".relations#out" }) {
+            MDB_dbi dbi;
+            MDB_cursor* cursor = nullptr;
+            MDB_val key, value;
+            auto entries = std::vector<std::pair<std::string, std::string>> {};
+            assert(mdb_dbi_open(txn, name, MDB_DUPSORT, &dbi) == 0);
+            assert(mdb_cursor_open(txn, dbi, &cursor) == 0);
+            while (mdb_cursor_get(cursor, &key, &value, MDB_NEXT) == 0) {
+                assert(key.mv_size == 6);
+                auto bytes = static_cast<const unsigned char*>(key.mv_data);
+                auto classId = (uint32_t { bytes[0] } << 8) | bytes[1];
+                auto positionId = (uint32_t { bytes[2] } << 24) | (uint32_t { bytes[3] } << 16)
+                    | (uint32_t { bytes[4] } << 8) | bytes[5];
+                entries.emplace_back(std::to_string(classId) + ":" + std::to_string(positionId),
+                    std::string(static_cast<const char*>(value.mv_data), value.mv_size));
+            }
+            mdb_cursor_close(cursor);
+            assert(entries.size() == 2);
+            assert(mdb_drop(txn, dbi, 0) == 0);
+            for (const auto& entry : entries) {
+                key = MDB_val { entry.first.size(), const_cast<char*>(entry.first.data()) };
+                value = MDB_val { entry.second.size(), const_cast<char*>(entry.second.data()) };
+                assert(mdb_put(txn, dbi, &key, &value, 0) == 0);
+            }
+        }
+        MDB_dbi dbInfo;
+        auto formatKey = std::string { "?relation_format" };
+        MDB_val key { formatKey.size(), const_cast<char*>(formatKey.data()) };
+        assert(mdb_dbi_open(txn, ".dbinfo", 0, &dbInfo) == 0);
+        assert(mdb_del(txn, dbInfo, &key, nullptr) == 0);
+        assert(mdb_txn_commit(txn) == 0);
+        mdb_env_close(env);
+
+        // the legacy keys are migrated on open and the graph reads the same as before
+        auto ctx = nogdb::Context { dbPath };
+        auto rtxn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto outEdges = rtxn.findOutEdge(v2).get();
+        assert(outEdges.size() == 1 && outEdges[0].descriptor == e2);
+        auto inEdges = rtxn.findInEdge(v2).get();
+        assert(inEdges.size() == 1 && inEdges[0].descriptor == e1);
+        assert(rtxn.findEdge(v2).count() == 2);
+        assert(rtxn.findOutEdge(v3).count() == 0);
+        auto reached = rtxn.traverseOut(v1).depth(1, 2).get();
+        assert(reached.size() == 2);
+        assert(reached[0].descriptor == v2 && reached[1].descriptor == v3);
+        assert(rtxn.traverseIn(v3).depth(1, 2).get().size() == 2);
+        assert(rtxn.fetchDst(e1).descriptor == v2);
+        rtxn.rollback();
+
+        // new relations are written with the fixed-width keys next to the migrated ones
+        auto wtxn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+        auto e3 = wtxn.addEdge("knows", v3, v1);
+        wtxn.commit();
+        rtxn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(rtxn.findOutEdge(v3).get()[0].descriptor == e3);
+        assert(rtxn.traverseOut(v3).depth(1, 2).count() == 2);
+        rtxn.rollback();
+    });
+}
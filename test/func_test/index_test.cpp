@@ -19,6 +19,9 @@
  *
  */
 
+#include <atomic>
+#include <thread>
+
 #include "func_test.h"
 #include "setup_cleanup.h"
 
@@ -1993,13 +1996,13 @@ void test_search_by_index_unique_cursor_multicondition()
         auto cursor = txn.find("index_test").indexed().where(cond).getCursor();
         assert(cursor.count() == 1);
         cursor.next();
-        assert(cursor.getDescriptor() == rdesc1);
+        assert(cursor->descriptor == rdesc1);
 
         cond = nogdb::Condition("index_text").eq("beta") and nogdb::Condition("index_int").eq(int32_t { 20 });
         cursor = txn.find("index_test").indexed().where(cond).getCursor();
         assert(cursor.count() == 1);
         cursor.next();
-        assert(cursor.getDescriptor() == rdesc2);
+        assert(cursor->descriptor == rdesc2);
 
         cond = nogdb::Condition("index_text").eq("alpha") and nogdb::Condition("index_int").eq(int32_t { 30 });
         cursor = txn.find("index_test").indexed().where(cond).getCursor();
@@ -2067,7 +2070,7 @@ void test_search_by_index_non_unique_cursor_multicondition()
         cursor = txn.find("index_test").indexed().where(cond).getCursor();
         assert(cursor.count() == 1);
         cursor.next();
-        assert(cursor.getDescriptor() == rdesc3);
+        assert(cursor->descriptor == rdesc3);
 
         cond = nogdb::Condition("index_text").eq("gamma") and nogdb::Condition("index_int").eq(int32_t { 10 });
         cursor = txn.find("index_test").indexed().where(cond).getCursor();
@@ -2206,7 +2209,7 @@ void test_search_by_index_extended_class_cursor_multicondition()
         cursor = txn.find("index_mc_sub").indexed().where(cond).getCursor();
         assert(cursor.count() == 1);
         cursor.next();
-        assert(cursor.getDescriptor() == rdesc3);
+        assert(cursor->descriptor == rdesc3);
 
         cond = nogdb::Condition("prop_text").eq("baz") and nogdb::Condition("prop_int").eq(int32_t { 5 });
         cursor = txn.find("index_mc_sub").indexed().where(cond).getCursor();
@@ -2229,3 +2232,86 @@ void test_search_by_index_extended_class_cursor_multicondition()
         assert(false);
     }
 }
+
+void test_search_by_index_concurrently()
+{
+    auto setup = [](nogdb::ContextInitializer& ctxi) { ctxi.setLargeValueThreshold(128); };
+    run_on_private_db("concurrent_index", setup, [](const std::string& dbPath) {
+        auto largeText = std::string(256, 'z');
+        {
+            nogdb::Context ctx { dbPath };
+            auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("sensors", nogdb::ClassType::VERTEX);
+            txn.addProperty("sensors", "code", nogdb::PropertyType::TEXT);
+            txn.addProperty("sensors", "reading", nogdb::PropertyType::INTEGER);
+            txn.addProperty("sensors", "serial", nogdb::PropertyType::UNSIGNED_BIGINT);
+            txn.addProperty("sensors", "note", nogdb::PropertyType::TEXT);
+            txn.addIndex("sensors", "code", true);
+            txn.addIndex("sensors", "reading", false);
+            txn.addIndex("sensors", "serial", true);
+            for (auto i = 0; i < 100; ++i) {
+                txn.addVertex("sensors", nogdb::Record {}
+                                             .set("code", "s" + std::to_string(i))
+                                             .set("reading", i % 10 - 5)
+                                             .set("serial", static_cast<uint64_t>(i))
+                                             .set("note", largeText));
+            }
+            txn.commit();
+        }
+
+        // index and value tables are found in the handle cache of a freshly opened environment,
+        // while a writer opens the tables of new indexes at the same time
+        nogdb::Context ctx { dbPath };
+        std::atomic<unsigned int> failures { 0 };
+        auto workers = std::vector<std::thread> {};
+        for (auto i = 0; i < 6; ++i) {
+            workers.emplace_back([&, i] {
+                try {
+                    for (auto j = 0; j < 100; ++j) {
+                        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+                        auto key = (i * 17 + j) % 100;
+                        auto res = txn.find("sensors").where(nogdb::Condition("code").eq("s" + std::to_string(key))).indexed().get();
+                        if (res.size() != 1 || res[0].record.getText("note") != largeText) {
+                            ++failures;
+                        }
+                        if (txn.find("sensors").where(nogdb::Condition("reading").lt(0)).indexed().count() != 50) {
+                            ++failures;
+                        }
+                        if (txn.find("sensors").where(nogdb::Condition("serial").ge(static_cast<uint64_t>(key))).indexed().count()
+                            != static_cast<size_t>(100 - key)) {
+                            ++failures;
+                        }
+                        txn.rollback();
+                    }
+                } catch (...) {
+                    ++failures;
+                }
+            });
+        }
+        workers.emplace_back([&] {
+            try {
+                for (auto j = 0; j < 10; ++j) {
+                    auto className = "gauges" + std::to_string(j);
+                    auto txn = ctx.beginTxn(nogdb::TxnMode::READ_WRITE);
+                    txn.addClass(className, nogdb::ClassType::VERTEX);
+                    txn.addProperty(className, "level", nogdb::PropertyType::REAL);
+                    txn.addIndex(className, "level", false);
+                    txn.addVertex(className, nogdb::Record {}.set("level", -0.5 * j));
+                    txn.commit();
+                }
+            } catch (...) {
+                ++failures;
+            }
+        });
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        assert(failures == 0);
+
+        auto txn = ctx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        for (auto j = 1; j < 10; ++j) {
+            assert(txn.find("gauges" + std::to_string(j)).where(nogdb::Condition("level").lt(0.0)).indexed().count() == 1);
+        }
+        txn.rollback();
+    });
+}
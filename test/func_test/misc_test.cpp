@@ -149,6 +149,297 @@ void test_get_set_large_record()
     destroy_vertex_book();
 }
 
+void test_get_set_large_value_out_of_record()
+{
+    auto setup = [](nogdb::ContextInitializer& ctxi) { ctxi.setLargeValueThreshold(256); };
+    run_on_private_db("large_value", setup, [](const std::string& dbPath) {
+        auto largeText = std::string(4096, 'x');
+        auto largeBlob = std::string(1024, 'b');
+        // still short enough to be an index key
+        auto mediumText = std::string(300, 'm');
+        auto rdesc = nogdb::RecordDescriptor {};
+        {
+            nogdb::Context largeCtx { dbPath };
+            assert(largeCtx.getLargeValueThreshold() == 256);
+            auto txn = largeCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("documents", nogdb::ClassType::VERTEX);
+            txn.addProperty("documents", "content", nogdb::PropertyType::TEXT);
+            txn.addProperty("documents", "attachment", nogdb::PropertyType::BLOB);
+            txn.addProperty("documents", "size", nogdb::PropertyType::INTEGER);
+            txn.addClass("links", nogdb::ClassType::EDGE);
+            txn.addProperty("links", "note", nogdb::PropertyType::TEXT);
+            rdesc = txn.addVertex("documents", nogdb::Record {}
+                                                   .set("content", largeText)
+                                                   .set("attachment", nogdb::Bytes { largeBlob })
+                                                   .set("size", 1));
+            auto other = txn.addVertex("documents", nogdb::Record {}.set("content", "small").set("size", 2));
+            auto edge = txn.addEdge("links", rdesc, other, nogdb::Record {}.set("note", largeText));
+            txn.commit();
+
+            txn = largeCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            auto record = txn.fetchRecord(rdesc);
+            assert(record.getText("content") == largeText);
+            assert(record.get("attachment").toText() == largeBlob);
+            assert(record.getInt("size") == 1);
+            assert(txn.fetchRecord(edge).getText("note") == largeText);
+            // a condition on a small property returns records with their large values
+            auto res = txn.find("documents").where(nogdb::Condition("size").eq(1)).get();
+            assert(res.size() == 1);
+            assert(res[0].record.getText("content") == largeText);
+            assert(txn.find("documents").where(nogdb::Condition("size").ge(1)).count() == 2);
+            assert(txn.find("documents").where(nogdb::Condition("content").eq(largeText)).count() == 1);
+            assert(txn.find("documents").where(nogdb::Condition("content").eq("small")).count() == 1);
+            auto views = txn.find("documents").where(nogdb::Condition("size").eq(1)).getView();
+            assert(views.size() == 1);
+            assert(views[0].record.getText("content") == largeText);
+            assert(views[0].record.size() == 3);
+            assert(views[0].record.toRecord().get("attachment").toText() == largeBlob);
+            txn.rollback();
+
+            // patching a property keeps the other values, in and out of the record
+            txn = largeCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.update(rdesc, nogdb::Record {}.set("size", 5), nogdb::UpdateMode::PATCH);
+            record = txn.fetchRecord(rdesc);
+            assert(record.getText("content") == largeText);
+            assert(record.get("attachment").toText() == largeBlob);
+            assert(record.getInt("size") == 5);
+            txn.update(rdesc,
+                nogdb::Record {}.set("content", "tiny").set("attachment", nogdb::Bytes { largeBlob + "c" }),
+                nogdb::UpdateMode::PATCH);
+            record = txn.fetchRecord(rdesc);
+            assert(record.getText("content") == "tiny");
+            assert(record.get("attachment").toText() == largeBlob + "c");
+            assert(record.getInt("size") == 5);
+            txn.rollback();
+
+            // a large value turned small is moved back into its record, and the other way around
+            txn = largeCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.update(rdesc, nogdb::Record {}.set("content", "tiny").set("size", 3));
+            assert(txn.fetchRecord(rdesc).getText("content") == "tiny");
+            assert(txn.fetchRecord(rdesc).get("attachment").empty());
+            txn.update(other, nogdb::Record {}.set("content", mediumText).set("size", 2));
+            txn.addIndex("documents", "content");
+            txn.commit();
+
+            txn = largeCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+            res = txn.find("documents").where(nogdb::Condition("content").eq(mediumText)).indexed().get();
+            assert(res.size() == 1);
+            assert(res[0].descriptor == other);
+            assert(txn.fetchRecord(other).getText("content") == mediumText);
+            txn.rollback();
+
+            txn = largeCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.dropIndex("documents", "content");
+            txn.remove(edge);
+            txn.remove(other);
+            assert(txn.find("documents").get().size() == 1);
+            txn.removeAll("links");
+            txn.commit();
+        }
+        // the threshold is kept along with the other settings
+        nogdb::Context largeCtx { dbPath };
+        assert(largeCtx.getLargeValueThreshold() == 256);
+        auto txn = largeCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+        auto added = txn.addVertex("documents", nogdb::Record {}.set("content", largeText).set("size", 4));
+        assert(txn.fetchRecord(added).getText("content") == largeText);
+        txn.dropClass("documents");
+        txn.commit();
+    });
+}
+
+void test_compress_records()
+{
+    try {
+        const auto statuses = std::vector<std::string> { "active", "suspended", "pending", "closed" };
+        auto descriptors = std::vector<nogdb::RecordDescriptor> {};
+        auto edge = nogdb::RecordDescriptor {};
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.addClass("accounts", nogdb::ClassType::VERTEX);
+        txn.addProperty("accounts", "name", nogdb::PropertyType::TEXT);
+        txn.addProperty("accounts", "status", nogdb::PropertyType::TEXT);
+        txn.addProperty("accounts", "address", nogdb::PropertyType::TEXT);
+        txn.addProperty("accounts", "number", nogdb::PropertyType::INTEGER);
+        txn.addClass("transfers", nogdb::ClassType::EDGE);
+        txn.addProperty("transfers", "memo", nogdb::PropertyType::TEXT);
+        for (auto i = 0; i < 500; ++i) {
+            descriptors.emplace_back(txn.addVertex("accounts", nogdb::Record {}
+                                                              .set("name", "account holder " + std::to_string(i))
+                                                              .set("status", statuses[i % statuses.size()])
+                                                              .set("address", "42 Sukhumvit Road, Khlong Toei, Bangkok 10110")
+                                                              .set("number", i)));
+        }
+        edge = txn.addEdge("transfers", descriptors[0], descriptors[1], nogdb::Record {}.set("memo", "monthly rent"));
+        txn.commit();
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        auto stats = txn.enableCompression("accounts");
+        assert(stats.className == "accounts");
+        assert(stats.records == 500);
+        assert(stats.dictionarySize > 0);
+        assert(stats.compressedBytes * 2 < stats.rawBytes);
+        assert(txn.enableCompression("transfers", 0).dictionarySize == 0);
+        txn.commit();
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto record = txn.fetchRecord(descriptors[7]);
+        assert(record.getText("name") == "account holder 7");
+        assert(record.getText("status") == "closed");
+        assert(record.getInt("number") == 7);
+        assert(txn.fetchRecord(edge).getText("memo") == "monthly rent");
+        assert(txn.fetchSrc(edge).descriptor == descriptors[0]);
+        assert(txn.find("accounts").where(nogdb::Condition("status").eq("pending")).count() == 125);
+        auto res = txn.find("accounts").where(nogdb::Condition("number").eq(42)).get();
+        assert(res.size() == 1);
+        assert(res[0].record.getText("name") == "account holder 42");
+        auto views = txn.find("accounts").where(nogdb::Condition("number").lt(3)).getView();
+        assert(views.size() == 3);
+        for (const auto& view : views) {
+            assert(view.record.getText("address") == "42 Sukhumvit Road, Khlong Toei, Bangkok 10110");
+        }
+        txn.rollback();
+
+        // records written afterwards are compressed with the same dictionary
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.update(descriptors[7], nogdb::Record {}.set("name", "renamed").set("status", "active").set("number", 7));
+        auto added = txn.addVertex("accounts", nogdb::Record {}.set("name", "newcomer").set("status", "pending"));
+        txn.update(descriptors[9], nogdb::Record {}.set("status", "closed"), nogdb::UpdateMode::PATCH);
+        txn.addIndex("accounts", "number");
+        txn.remove(descriptors[8]);
+        txn.commit();
+        {
+            auto loader = ctx->beginBulkLoad();
+            descriptors.emplace_back(loader.addVertex("accounts", nogdb::Record {}.set("name", "bulk").set("number", 1000)));
+            loader.commit();
+        }
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txn.fetchRecord(descriptors[7]).getText("name") == "renamed");
+        assert(txn.fetchRecord(added).getText("status") == "pending");
+        assert(txn.fetchRecord(descriptors[9]).getText("status") == "closed");
+        assert(txn.fetchRecord(descriptors[9]).getText("address") == "42 Sukhumvit Road, Khlong Toei, Bangkok 10110");
+        assert(txn.fetchRecord(descriptors.back()).getText("name") == "bulk");
+        res = txn.find("accounts").where(nogdb::Condition("number").eq(1000)).indexed().get();
+        assert(res.size() == 1);
+        assert(res[0].record.getText("name") == "bulk");
+        assert(txn.find("accounts").get().size() == 501);
+        txn.rollback();
+
+        // the records of a class are still read once its compression is disabled
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        assert(txn.fetchRecord(descriptors[100]).getText("name") == "account holder 100");
+        txn.disableCompression("accounts");
+        txn.disableCompression("accounts");
+        assert(txn.fetchRecord(descriptors[100]).getText("name") == "account holder 100");
+        assert(txn.find("accounts").where(nogdb::Condition("status").eq("active")).count() == 125);
+        txn.dropIndex("accounts", "number");
+        txn.removeAll("transfers");
+        txn.dropClass("transfers");
+        txn.dropClass("accounts");
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+}
+
+void test_record_format()
+{
+    auto setup = [](nogdb::ContextInitializer& ctxi) { ctxi.enableVersion().setLargeValueThreshold(256); };
+    run_on_private_db("record_format", setup, [](const std::string& dbPath) {
+        auto largeText = std::string(512, 'x');
+        auto v1 = nogdb::RecordDescriptor {}, v2 = nogdb::RecordDescriptor {}, empty = nogdb::RecordDescriptor {};
+        auto edge = nogdb::RecordDescriptor {};
+        {
+            nogdb::Context formatCtx { dbPath };
+            assert(formatCtx.getRecordFormat() == nogdb::RecordFormat::V1);
+            auto txn = formatCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("books", nogdb::ClassType::VERTEX);
+            txn.addProperty("books", "title", nogdb::PropertyType::TEXT);
+            txn.addProperty("books", "pages", nogdb::PropertyType::INTEGER);
+            txn.addProperty("books", "price", nogdb::PropertyType::REAL);
+            txn.addProperty("books", "content", nogdb::PropertyType::TEXT);
+            txn.addClass("cites", nogdb::ClassType::EDGE);
+            txn.addProperty("cites", "page", nogdb::PropertyType::INTEGER);
+            v1 = txn.addVertex("books", nogdb::Record {}.set("title", "Dune").set("pages", 412).set("price", 9.5));
+            v2 = txn.addVertex("books", nogdb::Record {}.set("title", "Emma").set("content", largeText));
+            empty = txn.addVertex("books", nogdb::Record {});
+            edge = txn.addEdge("cites", v1, v2, nogdb::Record {}.set("page", 7));
+            txn.commit();
+
+            // the records are rewritten behind an offset table, along with those added later
+            txn = formatCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            assert(txn.rewriteRecords("books", nogdb::RecordFormat::V2) == 2);
+            assert(txn.rewriteRecords("cites", nogdb::RecordFormat::V2) == 1);
+            auto v3 = txn.addVertex("books", nogdb::Record {}.set("title", "Ulysses").set("pages", 730));
+            txn.commit();
+
+            txn = formatCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            assert(txn.rewriteRecords("books", nogdb::RecordFormat::V2) == 0);
+            auto record = txn.fetchRecord(v1);
+            assert(record.getText("title") == "Dune");
+            assert(record.getInt("pages") == 412);
+            assert(record.getReal("price") == 9.5);
+            assert(record.getVersion() == 1);
+            assert(txn.fetchRecord(v2).getText("content") == largeText);
+            assert(txn.fetchRecord(v3).getInt("pages") == 730);
+            assert(txn.fetchRecord(empty).empty());
+            assert(txn.fetchRecord(edge).getInt("page") == 7);
+            assert(txn.fetchSrc(edge).descriptor == v1);
+            assert(txn.fetchDst(edge).descriptor == v2);
+            auto res = txn.find("books").where(nogdb::Condition("pages").gt(500)).get();
+            assert(res.size() == 1);
+            assert(res[0].descriptor == v3);
+            auto views = txn.find("books").where(nogdb::Condition("title").eq("Emma")).getView();
+            assert(views.size() == 1);
+            assert(views[0].record.getText("content") == largeText);
+            assert(views[0].record.get("pages").empty());
+            assert((views[0].record.getProperties() == std::vector<std::string> { "content", "title" }));
+
+            // patches keep the offset table of a record
+            txn.update(v1, nogdb::Record {}.set("pages", 500).set("content", largeText), nogdb::UpdateMode::PATCH);
+            record = txn.fetchRecord(v1);
+            assert(record.getText("title") == "Dune");
+            assert(record.getInt("pages") == 500);
+            assert(record.getText("content") == largeText);
+            assert(record.getVersion() == 2);
+            txn.update(v2, nogdb::Record {}.set("title", "Persuasion"));
+            views = txn.find("books").where(nogdb::Condition("title").eq("Persuasion")).getView();
+            assert(views.size() == 1);
+            assert(views[0].record.get("content").empty());
+            txn.commit();
+
+            // and can be rewritten back
+            txn = formatCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            assert(txn.rewriteRecords("books", nogdb::RecordFormat::V1) == 3);
+            assert(txn.fetchRecord(v1).getText("content") == largeText);
+            assert(txn.fetchRecord(v3).getText("title") == "Ulysses");
+            txn.commit();
+        }
+    });
+
+    auto formatSetup = [](nogdb::ContextInitializer& ctxi) { ctxi.setRecordFormat(nogdb::RecordFormat::V2); };
+    run_on_private_db("record_format_v2", formatSetup, [](const std::string& dbPath) {
+        auto v1 = nogdb::RecordDescriptor {};
+        {
+            nogdb::Context formatCtx { dbPath };
+            auto txn = formatCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+            txn.addClass("books", nogdb::ClassType::VERTEX);
+            txn.addProperty("books", "title", nogdb::PropertyType::TEXT);
+            txn.addProperty("books", "pages", nogdb::PropertyType::INTEGER);
+            v1 = txn.addVertex("books", nogdb::Record {}.set("title", "Dune").set("pages", 412));
+            assert(txn.rewriteRecords("books", nogdb::RecordFormat::V2) == 0);
+            txn.commit();
+        }
+        // the format is kept along with the other settings
+        nogdb::Context formatCtx { dbPath };
+        assert(formatCtx.getRecordFormat() == nogdb::RecordFormat::V2);
+        auto txn = formatCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txn.fetchRecord(v1).getText("title") == "Dune");
+        assert(txn.find("books").where(nogdb::Condition("pages").eq(412)).count() == 1);
+        txn.rollback();
+    });
+}
+
 void test_overwrite_basic_info()
 {
     init_vertex_book();
@@ -949,6 +1240,44 @@ void test_version_update_vertex_edge()
     }
 }
 
+void test_version_patch_vertex_edge()
+{
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        auto v1_1 = txn.find("vertex_version_1").where(nogdb::Condition("name").eq("11")).get()[0];
+        auto v2_1 = txn.find("vertex_version_2").where(nogdb::Condition("name").eq("21")).get()[0];
+        auto e11_21 = txn.find("edge_version").where(nogdb::Condition("name").eq("11->21")).get()[0];
+
+        txn.update(v1_1.descriptor, nogdb::Record {}.set("name", "11"), nogdb::UpdateMode::PATCH);
+        txn.update(e11_21.descriptor, nogdb::Record {}.set("name", "11->21"), nogdb::UpdateMode::PATCH);
+
+        auto res = txn.fetchRecord(v1_1.descriptor);
+        assert(res.getText("name") == "11");
+        res = txn.fetchRecord(e11_21.descriptor);
+        assert(res.getText("name") == "11->21");
+        assert(txn.fetchSrc(e11_21.descriptor).descriptor == v1_1.descriptor);
+        assert(txn.fetchDst(e11_21.descriptor).descriptor == v2_1.descriptor);
+        if (ctx->isVersionEnabled()) {
+            res = txn.fetchRecord(v1_1.descriptor);
+            ASSERT_EQ(res.getVersion(), uint64_t { 3 });
+            res = txn.fetchRecord(v2_1.descriptor);
+            ASSERT_EQ(res.getVersion(), uint64_t { 2 });
+            res = txn.fetchRecord(e11_21.descriptor);
+            ASSERT_EQ(res.getVersion(), uint64_t { 3 });
+        } else {
+            res = txn.fetchRecord(v1_1.descriptor);
+            ASSERT_EQ(res.getVersion(), uint64_t { 0 });
+            res = txn.fetchRecord(e11_21.descriptor);
+            ASSERT_EQ(res.getVersion(), uint64_t { 0 });
+        }
+
+        txn.rollback();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+}
+
 void test_version_update_src_dst_edge()
 {
     try {
@@ -1389,4 +1718,70 @@ void test_get_count_edge() {
         std::cout << "\nError: " << ex.what() << std::endl;
         assert(false);
     }
-}
\ No newline at end of file
+}
+
+void test_storage_stats()
+{
+    auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+    try {
+        txn.addClass("stats", nogdb::ClassType::VERTEX);
+        txn.addProperty("stats", "value", nogdb::PropertyType::INTEGER);
+        txn.addProperty("stats", "name", nogdb::PropertyType::TEXT);
+        txn.addIndex("stats", "value");
+        txn.addIndex("stats", "name", true);
+        txn.addClass("stats_link", nogdb::ClassType::EDGE);
+        auto prev = nogdb::RecordDescriptor {};
+        for (auto i = 0; i < 100; ++i) {
+            auto rdesc = txn.addVertex("stats", nogdb::Record {}
+                .set("value", i - 30)
+                .set("name", "v" + std::to_string(i)));
+            if (i > 0) {
+                txn.addEdge("stats_link", prev, rdesc);
+            }
+            prev = rdesc;
+        }
+        txn.commit();
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto stats = txn.getStorageStats();
+        assert(stats.dbPath == DATABASE_PATH);
+        assert(stats.pageSize > 0);
+        assert(stats.usedSize == (stats.lastPageId + 1) * stats.pageSize);
+        assert(stats.usedSize <= stats.mapSize);
+        assert(stats.numReaders >= 1 && stats.numReaders <= stats.maxReaders);
+
+        auto findTable = [](const std::vector<nogdb::TableStat>& tables, const std::string& name) {
+            auto found = std::find_if(tables.cbegin(), tables.cend(), [&name](const nogdb::TableStat& table) {
+                return table.name == name;
+            });
+            assert(found != tables.cend());
+            return *found;
+        };
+        // a record table also holds the next position id
+        auto vertices = findTable(stats.classes, "stats");
+        assert(vertices.entries == 101);
+        assert(vertices.depth >= 1);
+        assert(vertices.leafPages >= 1);
+        assert(findTable(stats.classes, "stats_link").entries == 100);
+        assert(findTable(stats.indexes, "stats.value").entries == 70);
+        assert(findTable(stats.indexes, "stats.value#negative").entries == 30);
+        assert(findTable(stats.indexes, "stats.name").entries == 100);
+        assert(findTable(stats.relations, "relations#in").entries == 99);
+        assert(findTable(stats.relations, "relations#out").entries == 99);
+
+        // counting without a condition relies on the number of entries of a record table
+        assert(txn.find("stats").count() == 100);
+        assert(txn.find("stats_link").count() == 99);
+        txn.rollback();
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.dropIndex("stats", "value");
+        txn.dropIndex("stats", "name");
+        txn.dropClass("stats_link");
+        txn.dropClass("stats");
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+}
@@ -1785,3 +1785,70 @@ void test_sql_drop_index()
     txn.dropClass("V");
     txn.commit();
 }
+
+void test_sql_show_as_identifier()
+{
+    auto txn = ctx->beginTxn(TxnMode::READ_WRITE);
+    try {
+        SQL::execute(txn, "CREATE CLASS show EXTENDS VERTEX");
+        SQL::execute(txn, "CREATE PROPERTY show.show TEXT");
+        SQL::execute(txn, "CREATE VERTEX show SET show='time'");
+        auto result = SQL::execute(txn, "SELECT show FROM show WHERE show='time'");
+        assert(result.type() == result.RESULT_SET);
+        auto& rows = result.get<ResultSet>();
+        assert(rows.size() == 1);
+        assert(rows[0].record.getText("show") == "time");
+        // and still a command of its own
+        assert(SQL::execute(txn, "SHOW STORAGE").type() == result.RESULT_SET);
+    } catch (const Error& e) {
+        cout << "\nError: " << e.what() << endl;
+        assert(false);
+    }
+    txn.rollback();
+}
+
+void test_sql_show_storage()
+{
+    auto txn = ctx->beginTxn(TxnMode::READ_WRITE);
+    txn.addClass("V", ClassType::VERTEX);
+    txn.addProperty("V", "p", PropertyType::BIGINT);
+    txn.addIndex("V", "p");
+    txn.addVertex("V", Record {}.set("p", -1LL));
+    txn.addVertex("V", Record {}.set("p", 1LL));
+
+    try {
+        SQL::Result result = SQL::execute(txn, "SHOW STORAGE");
+        assert(result.type() == result.RESULT_SET);
+        auto& rows = result.get<ResultSet>();
+        assert(rows.size() > 1);
+        assert(rows[0].record.getText("type") == "environment");
+        assert(rows[0].record.getBigIntU("map_size") >= rows[0].record.getBigIntU("used_size"));
+        auto found = 0;
+        for (const auto& row : rows) {
+            auto type = row.record.getText("type");
+            auto name = row.record.getText("name");
+            if (type == "class" && name == "V") {
+                assert(row.record.getBigIntU("entries") == 3);
+                ++found;
+            } else if (type == "index" && (name == "V.p" || name == "V.p#negative")) {
+                assert(row.record.getBigIntU("entries") == 1);
+                ++found;
+            }
+        }
+        assert(found == 3);
+
+        try {
+            SQL::execute(txn, "SHOW SOMETHING");
+            assert(false);
+        } catch (const Error& ex) {
+            REQUIRE(ex, NOGDB_SQL_SYNTAX_ERROR, "NOGDB_SQL_SYNTAX_ERROR");
+        }
+    } catch (const Error& e) {
+        cout << "\nError: " << e.what() << endl;
+        assert(false);
+    }
+
+    txn.dropIndex("V", "p");
+    txn.dropClass("V");
+    txn.commit();
+}
@@ -18,6 +18,9 @@
  *  along with this program. If not, see <http://www.gnu.org/licenses/>.
  *
  */
+
+#include <thread>
+
 #include "func_test.h"
 #include "setup_cleanup.h"
 
@@ -1744,6 +1747,422 @@ void test_txn_reopen_ctx()
     destroy_vertex_island();
 }
 
+void test_txn_recycle_read_only()
+{
+    init_vertex_island();
+    init_edge_bridge();
+
+    try {
+        auto txnRw = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txnRw.addVertex("islands", nogdb::Record {}.set("name", "Koh Samui"));
+        txnRw.commit();
+
+        auto txnRo = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txnRo.find("islands").get().size() == 1);
+        assert(txnRo.getDBInfo().numClass == 2);
+        txnRo.rollback();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    try {
+        auto txnRw = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        auto v1 = txnRw.find("islands").where(nogdb::Condition("name").eq("Koh Samui")).get();
+        auto v2 = txnRw.addVertex("islands", nogdb::Record {}.set("name", "Koh Tao"));
+        txnRw.addEdge("bridge", v1[0].descriptor, v2, nogdb::Record {}.set("name", "red"));
+        txnRw.addClass("temples", nogdb::ClassType::VERTEX);
+        txnRw.commit();
+
+        // a recycled read-only transaction must see the new snapshot rather than any cached metadata
+        auto txnRo = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txnRo.find("islands").get().size() == 2);
+        assert(txnRo.getDBInfo().numClass == 3);
+        assert(txnRo.getClass("temples").name == "temples");
+        auto resE = txnRo.find("bridge").get();
+        assert(resE.size() == 1);
+        auto res = txnRo.fetchSrcDst(resE[0].descriptor);
+        assert(res[0].record.get("name").toText() == "Koh Samui");
+        assert(res[1].record.get("name").toText() == "Koh Tao");
+        txnRo.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    try {
+        auto txnRo1 = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        auto txnRw = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txnRw.addVertex("islands", nogdb::Record {}.set("name", "Koh Phangan"));
+        txnRw.dropClass("temples");
+        txnRw.commit();
+
+        auto txnRo2 = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txnRo1.find("islands").get().size() == 2);
+        assert(txnRo1.getClass("temples").name == "temples");
+        assert(txnRo2.find("islands").get().size() == 3);
+        txnRo1.rollback();
+        txnRo2.rollback();
+
+        auto txnRo3 = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        txnRo3.getClass("temples");
+        assert(false);
+    } catch (const nogdb::Error& ex) {
+        REQUIRE(ex, NOGDB_CTX_NOEXST_CLASS, "NOGDB_CTX_NOEXST_CLASS");
+    }
+
+    destroy_edge_bridge();
+    destroy_vertex_island();
+}
+
+void test_txn_reuse_dropped_tables()
+{
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.addClass("temples", nogdb::ClassType::VERTEX);
+        txn.addProperty("temples", "name", nogdb::PropertyType::TEXT);
+        txn.addIndex("temples", "name", false);
+        txn.addVertex("temples", nogdb::Record {}.set("name", "Wat Arun"));
+        txn.commit();
+
+        // lmdb closes the handle of a deleted table even if the transaction is aborted later
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.dropIndex("temples", "name");
+        txn.dropClass("temples");
+        txn.rollback();
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txn.find("temples").get().size() == 1);
+        auto res = txn.find("temples").indexed().where(nogdb::Condition("name").eq("Wat Arun")).get();
+        assert(res.size() == 1);
+        txn.commit();
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.dropIndex("temples", "name");
+        txn.dropClass("temples");
+        txn.addClass("temples", nogdb::ClassType::VERTEX);
+        txn.addProperty("temples", "name", nogdb::PropertyType::TEXT);
+        txn.addIndex("temples", "name", false);
+        txn.addVertex("temples", nogdb::Record {}.set("name", "Wat Pho"));
+        txn.commit();
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        res = txn.find("temples").get();
+        assert(res.size() == 1);
+        assert(res[0].record.get("name").toText() == "Wat Pho");
+        res = txn.find("temples").indexed().where(nogdb::Condition("name").eq("Wat Arun")).get();
+        assert(res.empty());
+        txn.commit();
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.dropIndex("temples", "name");
+        txn.dropClass("temples");
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+}
+
+void test_txn_batch_commit()
+{
+    init_vertex_island();
+    init_edge_bridge();
+
+    try {
+        // small batches submitted from several threads are committed by the writer in groups
+        auto futures = std::vector<std::future<std::vector<nogdb::RecordDescriptor>>>(4);
+        auto workers = std::vector<std::thread> {};
+        for (auto i = 0; i < 4; ++i) {
+            workers.emplace_back([i, &futures] {
+                auto batch = ctx->beginBatchTxn();
+                for (auto j = 0; j < 10; ++j) {
+                    batch.addVertex("islands", nogdb::Record {}.set("name", "island" + std::to_string(i * 10 + j)));
+                }
+                futures[i] = batch.commit();
+                assert(batch.size() == 0);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        auto vertices = std::vector<nogdb::RecordDescriptor> {};
+        for (auto& future : futures) {
+            auto rdescs = future.get();
+            assert(rdescs.size() == 10);
+            vertices.insert(vertices.end(), rdescs.cbegin(), rdescs.cend());
+        }
+
+        auto batch = ctx->beginBatchTxn();
+        auto edges = batch.addEdge("bridge", vertices[0], vertices[1], nogdb::Record {}.set("name", "red"))
+                         .update(vertices[2], nogdb::Record {}.set("name", "Koh Tao"))
+                         .remove(vertices[3])
+                         .commit()
+                         .get();
+        assert(edges.size() == 3);
+        assert(edges[1] == vertices[2]);
+
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txn.find("islands").get().size() == 39);
+        assert(txn.fetchRecord(vertices[2]).getText("name") == "Koh Tao");
+        auto res = txn.fetchSrcDst(edges[0]);
+        assert(res[0].descriptor == vertices[0]);
+        assert(res[1].descriptor == vertices[1]);
+        txn.rollback();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    // a failing batch is rejected on its own while the batches grouped with it are committed
+    auto valid = ctx->beginBatchTxn().addVertex("islands", nogdb::Record {}.set("name", "Koh Lipe")).commit();
+    auto invalid = ctx->beginBatchTxn().addVertex("invalid_islands").commit();
+    try {
+        assert(valid.get().size() == 1);
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+    try {
+        invalid.get();
+        assert(false);
+    } catch (const nogdb::Error& ex) {
+        REQUIRE(ex, NOGDB_CTX_NOEXST_CLASS, "NOGDB_CTX_NOEXST_CLASS");
+    }
+
+    destroy_edge_bridge();
+    destroy_vertex_island();
+}
+
+void test_txn_batch_settings()
+{
+    auto setup = [](nogdb::ContextInitializer& ctxi) {
+        ctxi.setLargeValueThreshold(256).setRecordFormat(nogdb::RecordFormat::V2);
+    };
+    run_on_private_db("batch_settings", setup, [](const std::string& dbPath) {
+        auto largeText = std::string(4000, 'b');
+        nogdb::Context batchCtx { dbPath };
+        auto txn = batchCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.addClass("notes", nogdb::ClassType::VERTEX);
+        txn.addProperty("notes", "title", nogdb::PropertyType::TEXT);
+        txn.addProperty("notes", "body", nogdb::PropertyType::TEXT);
+        txn.commit();
+
+        // batched writes are stored with the settings of the context, so a large value is kept out of its record
+        auto rdescs = batchCtx.beginBatchTxn()
+                          .addVertex("notes", nogdb::Record {}.set("title", "long").set("body", largeText))
+                          .commit()
+                          .get();
+        assert(rdescs.size() == 1);
+        txn = batchCtx.beginTxn(nogdb::TxnMode::READ_ONLY);
+        assert(txn.fetchRecord(rdescs[0]).getText("body") == largeText);
+        auto stats = txn.getStorageStats();
+        auto notes = std::find_if(stats.classes.cbegin(), stats.classes.cend(),
+            [](const nogdb::TableStat& stat) { return stat.name == "notes"; });
+        assert(notes != stats.classes.cend());
+        assert(notes->overflowPages == 0);
+        txn.rollback();
+
+        // and in the record format of the context, so there is nothing to rewrite
+        rdescs = batchCtx.beginBatchTxn().addVertex("notes", nogdb::Record {}.set("title", "short")).commit().get();
+        txn = batchCtx.beginTxn(nogdb::TxnMode::READ_WRITE);
+        assert(txn.rewriteRecords("notes", nogdb::RecordFormat::V2) == 0);
+        assert(txn.rewriteRecords("notes", nogdb::RecordFormat::V1) == 2);
+        assert(txn.fetchRecord(rdescs[0]).getText("title") == "short");
+        txn.rollback();
+    });
+}
+
+void test_txn_bulk_load()
+{
+    init_vertex_island();
+    init_edge_bridge();
+
+    auto existing = nogdb::RecordDescriptor {};
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.addIndex("islands", "name", true);
+        txn.addIndex("bridge", "length", false);
+        existing = txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Samui"));
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    auto vertices = std::vector<nogdb::RecordDescriptor> {};
+    try {
+        auto loader = ctx->beginBulkLoad();
+        for (auto i = 0; i < 100; ++i) {
+            vertices.push_back(loader.addVertex("islands",
+                nogdb::Record {}.set("name", "island" + std::to_string(99 - i)).set("area", 1.5 * i)));
+        }
+        for (auto i = 0; i < 100; ++i) {
+            loader.addEdge("bridge", vertices[i], vertices[(i * 7 + 3) % 100],
+                nogdb::Record {}.set("length", static_cast<uint32_t>(i % 10)));
+        }
+        loader.addEdge("bridge", existing, vertices[0], nogdb::Record {}.set("name", "to the mainland"));
+        loader.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        assert(vertices[0].rid.second > existing.rid.second);
+        assert(txn.find("islands").get().size() == 101);
+        assert(txn.find("bridge").get().size() == 101);
+        auto res = txn.find("islands").indexed().where(nogdb::Condition("name").eq("island42")).get();
+        assert(res.size() == 1);
+        assert(res[0].descriptor == vertices[57]);
+        assert(res[0].record.getReal("area") == 1.5 * 57);
+        res = txn.find("bridge").indexed().where(nogdb::Condition("length").eq(3U)).get();
+        assert(res.size() == 10);
+        res = txn.findOutEdge(vertices[1]).get();
+        assert(res.size() == 1);
+        assert(txn.fetchDst(res[0].descriptor).descriptor == vertices[10]);
+        assert(txn.findInEdge(vertices[0]).get().size() == 2);
+        assert(txn.findOutEdge(existing).get().size() == 1);
+        // records added afterwards continue after the loaded position ids
+        auto next = txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Tao"));
+        assert(next.rid.second > vertices.back().rid.second);
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    // a unique index violation is reported at commit and nothing is loaded
+    try {
+        auto loader = ctx->beginBulkLoad();
+        loader.addVertex("islands", nogdb::Record {}.set("name", "Koh Lipe"));
+        loader.addVertex("islands", nogdb::Record {}.set("name", "island0"));
+        loader.commit();
+        assert(false);
+    } catch (const nogdb::Error& ex) {
+        REQUIRE(ex, NOGDB_CTX_UNIQUE_CONSTRAINT, "NOGDB_CTX_UNIQUE_CONSTRAINT");
+    }
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        assert(txn.find("islands").indexed().where(nogdb::Condition("name").eq("Koh Lipe")).get().empty());
+        assert(txn.find("islands").get().size() == 102);
+        txn.dropIndex("islands", "name");
+        txn.dropIndex("bridge", "length");
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    destroy_edge_bridge();
+    destroy_vertex_island();
+}
+
+void test_txn_savepoints()
+{
+    init_vertex_island();
+    init_edge_bridge();
+
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.addIndex("islands", "name", true);
+        auto samui = txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Samui"));
+        txn.savepoint();
+        auto tao = txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Tao"));
+        txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Phangan"));
+        txn.release();
+
+        // a failed operation discards the work since the savepoint only
+        txn.savepoint();
+        txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Lipe"));
+        try {
+            txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Samui"));
+            assert(false);
+        } catch (const nogdb::FatalError& err) {
+            assert(err.code() == NOGDB_CTX_UNIQUE_CONSTRAINT);
+        }
+        assert(txn.find("islands").where(nogdb::Condition("name").eq("Koh Lipe")).get().empty());
+        txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Chang"));
+        txn.release();
+
+        // nested savepoints
+        txn.savepoint();
+        txn.addEdge("bridge", samui, tao, nogdb::Record {}.set("name", "ferry"));
+        txn.savepoint();
+        txn.addEdge("bridge", tao, samui, nogdb::Record {}.set("name", "return ferry"));
+        txn.addProperty("islands", "population", nogdb::PropertyType::UNSIGNED_INTEGER);
+        txn.update(samui, nogdb::Record {}.set("name", "Koh Samui").set("population", 60000U));
+        txn.rollbackTo();
+        assert(txn.findInEdge(samui).get().empty());
+        assert(txn.findOutEdge(samui).get().size() == 1);
+        assert(txn.getProperties(txn.getClass("islands")).size() == 2);
+        assert(txn.fetchRecord(samui).get("population").empty());
+        txn.release();
+
+        // tables created since a savepoint are dropped by rolling back to it
+        txn.savepoint();
+        txn.addIndex("islands", "area");
+        txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Mak").set("area", 16.0));
+        txn.rollbackTo();
+        txn.addIndex("islands", "area");
+        assert(txn.find("islands").indexed().where(nogdb::Condition("area").eq(16.0)).get().empty());
+        txn.dropIndex("islands", "area");
+
+        // a savepoint still set is kept by the commit
+        txn.savepoint();
+        txn.addVertex("islands", nogdb::Record {}.set("name", "Koh Kood"));
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        auto res = txn.find("islands").get();
+        assert(res.size() == 5);
+        for (const auto& name : { "Koh Samui", "Koh Tao", "Koh Phangan", "Koh Chang", "Koh Kood" }) {
+            assert(txn.find("islands").indexed().where(nogdb::Condition("name").eq(name)).get().size() == 1);
+        }
+        assert(txn.find("bridge").get().size() == 1);
+        txn.dropIndex("islands", "name");
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "Error: " << ex.what() << std::endl;
+        assert(false);
+    }
+
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.rollbackTo();
+        assert(false);
+    } catch (const nogdb::Error& ex) {
+        REQUIRE(ex, NOGDB_TXN_NO_SAVEPOINT, "NOGDB_TXN_NO_SAVEPOINT");
+    }
+
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        txn.savepoint();
+        txn.release();
+        txn.release();
+        assert(false);
+    } catch (const nogdb::Error& ex) {
+        REQUIRE(ex, NOGDB_TXN_NO_SAVEPOINT, "NOGDB_TXN_NO_SAVEPOINT");
+    }
+
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        txn.savepoint();
+        assert(false);
+    } catch (const nogdb::Error& ex) {
+        REQUIRE(ex, NOGDB_TXN_INVALID_MODE, "NOGDB_TXN_INVALID_MODE");
+    }
+
+    destroy_edge_bridge();
+    destroy_vertex_island();
+}
+
 void test_txn_invalid_operations()
 {
     init_vertex_island();
@@ -103,6 +103,70 @@ void test_bytes_only()
     assert(tmp.z == blob_value.z);
 }
 
+void test_bytes_copy()
+{
+    // a short value is kept in the bytes themselves, and a long one shared by their copies
+    auto short_text = std::string { "short" };
+    auto long_text = std::string(100, 'l');
+    auto short_vb = nogdb::Bytes { short_text };
+    auto long_vb = nogdb::Bytes { long_text };
+
+    auto short_copy = short_vb;
+    auto long_copy = long_vb;
+    assert(short_copy.toText() == short_text);
+    assert(long_copy.toText() == long_text);
+    assert(short_copy.getConstRaw() != short_vb.getConstRaw());
+    assert(long_copy.getConstRaw() == long_vb.getConstRaw());
+    assert(short_copy.size() == short_text.size());
+    assert(long_copy.size() == long_text.size());
+
+    auto short_moved = std::move(short_copy);
+    auto long_moved = std::move(long_copy);
+    assert(short_moved.toText() == short_text);
+    assert(long_moved.toText() == long_text);
+    assert(short_copy.empty() && short_copy.size() == 0);
+    assert(long_copy.empty() && long_copy.size() == 0);
+
+    // a shared value outlives the bytes it has been copied from
+    long_vb = short_vb;
+    short_vb = nogdb::Bytes {};
+    assert(long_vb.toText() == short_text);
+    assert(short_vb.empty());
+    assert(long_moved.toText() == long_text);
+
+    auto values = std::vector<nogdb::Bytes> {};
+    for (auto i = 0; i < 64; ++i) {
+        values.emplace_back(nogdb::Bytes { std::string(static_cast<size_t>(i), 'v') });
+    }
+    auto copies = values;
+    values.clear();
+    for (auto i = 0; i < 64; ++i) {
+        assert(copies[i].toText() == std::string(static_cast<size_t>(i), 'v'));
+    }
+    assert(nogdb::Bytes::toBytes(vv_c_str).convert<std::vector<std::vector<std::string>>>().size() == 3u);
+
+    // writing to a shared value gives the bytes their own copy first
+    auto shared_vb = nogdb::Bytes { long_text };
+    auto shared_copy = shared_vb;
+    auto raw = shared_copy.getRaw();
+    assert(raw != shared_vb.getConstRaw());
+    raw[0] = 'w';
+    assert(shared_copy.getRaw() == raw);
+    assert(static_cast<unsigned char*>(shared_copy) == raw);
+    assert(shared_vb.toText() == long_text);
+    assert(shared_copy.toText() == "w" + long_text.substr(1));
+
+    // bytes given without a copy are owned as they are
+    auto owned = new unsigned char[long_text.size()];
+    std::copy(long_text.cbegin(), long_text.cend(), owned);
+    auto owned_vb = nogdb::Bytes { owned, long_text.size(), false };
+    assert(owned_vb.getConstRaw() == owned);
+    auto owned_copy = owned_vb;
+    owned_vb = nogdb::Bytes {};
+    assert(owned_copy.getConstRaw() == owned);
+    assert(owned_copy.toText() == long_text);
+}
+
 void test_record_with_bytes()
 {
     nogdb::Record r {};
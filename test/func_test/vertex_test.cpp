@@ -22,7 +22,9 @@
 #include "func_test.h"
 #include "setup_cleanup.h"
 #include <climits>
+#include <atomic>
 #include <set>
+#include <thread>
 #include <vector>
 
 void test_create_vertex()
@@ -387,6 +389,233 @@ void test_update_vertex()
     destroy_vertex_book();
 }
 
+void test_update_vertex_patch()
+{
+    init_vertex_book();
+    auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+    try {
+        txn.addIndex("books", "pages");
+        nogdb::Record r {};
+        r.set("title", "Lion King").set("price", 100.0).set("pages", 320);
+        auto rdesc1 = txn.addVertex("books", r);
+        r.set("title", "Tarzan").set("price", 60.0).set("pages", 360);
+        auto rdesc2 = txn.addVertex("books", r);
+
+        // a value of the same size
+        txn.update(rdesc1, nogdb::Record {}.set("price", 50.0), nogdb::UpdateMode::PATCH);
+        auto record = txn.fetchRecord(rdesc1);
+        assert(record.get("title").toText() == "Lion King");
+        assert(record.get("price").toReal() == 50);
+        assert(record.get("pages").toInt() == 320);
+        assert(record.get("words").empty());
+
+        // a longer value and a new property, along with an indexed one
+        txn.update(rdesc1,
+            nogdb::Record {}.set("title", "The Lion King").set("words", 90000ULL).set("pages", 400),
+            nogdb::UpdateMode::PATCH);
+        record = txn.fetchRecord(rdesc1);
+        assert(record.get("title").toText() == "The Lion King");
+        assert(record.get("price").toReal() == 50);
+        assert(record.get("pages").toInt() == 400);
+        assert(record.get("words").toBigIntU() == 90000ULL);
+        assert(txn.find("books").where(nogdb::Condition("pages").eq(320)).indexed().get().empty());
+        auto res = txn.find("books").where(nogdb::Condition("pages").eq(400)).indexed().get();
+        assert(res.size() == 1);
+        assert(res[0].descriptor == rdesc1);
+
+        // nothing to patch
+        txn.update(rdesc2, nogdb::Record {}, nogdb::UpdateMode::PATCH);
+        record = txn.fetchRecord(rdesc2);
+        assert(record.get("title").toText() == "Tarzan");
+        assert(record.get("price").toReal() == 60);
+        assert(record.get("pages").toInt() == 360);
+
+        // a replaced record can be patched back
+        txn.update(rdesc2, nogdb::Record {});
+        txn.update(rdesc2, nogdb::Record {}.set("title", "Tarzan"), nogdb::UpdateMode::PATCH);
+        record = txn.fetchRecord(rdesc2);
+        assert(record.get("title").toText() == "Tarzan");
+        assert(record.get("pages").empty());
+        txn.commit();
+
+        txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+        record = txn.fetchRecord(rdesc1);
+        assert(record.get("title").toText() == "The Lion King");
+        assert(record.get("words").toBigIntU() == 90000ULL);
+        txn.rollback();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+    txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+    txn.dropIndex("books", "pages");
+    txn.commit();
+    destroy_vertex_book();
+}
+
+void test_fetched_record()
+{
+    init_vertex_book();
+    auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+    try {
+        auto rdesc = txn.addVertex("books",
+            nogdb::Record {}.set("title", "Lion King").set("price", 100.0).set("pages", 320).set("words", 90000ULL));
+        auto rdescEmpty = txn.addVertex("books", nogdb::Record {});
+
+        auto record = txn.fetchRecord(rdesc);
+        assert(record.size() == 4);
+        assert(!record.empty());
+        assert((record.getProperties() == std::vector<std::string> { "pages", "price", "title", "words" }));
+        assert(record.getText("title") == "Lion King");
+        assert(record.getReal("price") == 100.0);
+        assert(record.getInt("pages") == 320);
+        assert(record.getBigIntU("words") == 90000ULL);
+        assert(record.getText("unknown") == "");
+        assert(record.getClassName() == "books");
+        try {
+            record.getInt("unknown");
+            assert(false);
+        } catch (const nogdb::Error& ex) {
+            REQUIRE(ex, NOGDB_CTX_NOEXST_PROPERTY, "NOGDB_CTX_NOEXST_PROPERTY");
+        }
+
+        // the map of all properties is only built on request
+        auto properties = record.getAll();
+        assert(properties.size() == 4);
+        assert(properties.at("title").toText() == "Lion King");
+        assert(properties.at("pages").toInt() == 320);
+
+        // a fetched record can be changed and written back
+        record.set("title", "The Lion King").unset("words");
+        assert(record.size() == 3);
+        assert(record.getText("title") == "The Lion King");
+        assert(record.getReal("price") == 100.0);
+        assert(record.get("words").empty());
+        txn.update(rdesc, record);
+        record = txn.fetchRecord(rdesc);
+        assert(record.getText("title") == "The Lion King");
+        assert(record.getInt("pages") == 320);
+        assert(record.get("words").empty());
+        assert(record.size() == 3);
+
+        auto emptyRecord = txn.fetchRecord(rdescEmpty);
+        assert(emptyRecord.empty());
+        assert(emptyRecord.getAll().empty());
+        assert(emptyRecord.getClassName() == "books");
+
+        record.clear();
+        assert(record.empty());
+        assert(record.getBasicInfo().empty());
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+    destroy_vertex_book();
+}
+
+void test_fetched_record_basic_info()
+{
+    init_vertex_book();
+    auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+    try {
+        auto rdesc = txn.addVertex("books", nogdb::Record {}.set("title", "Lion King").set("pages", 320));
+
+        auto record = txn.fetchRecord(rdesc);
+        assert(record.getClassName() == "books");
+        assert(record.getRecordId() == rdesc.rid);
+        assert(record.getDepth() == 0);
+        assert(record.getText("@className") == "books");
+        assert(record.getText("@recordId") == nogdb::rid2str(rdesc.rid));
+
+        // the basic info is read the same way once written as bytes
+        auto basicInfo = record.getBasicInfo();
+        assert(basicInfo.size() == 4);
+        assert(basicInfo.at("@className").toText() == "books");
+        assert(basicInfo.at("@recordId").toText() == nogdb::rid2str(rdesc.rid));
+        assert(basicInfo.at("@depth").toIntU() == 0);
+        assert(record.getRecordId() == rdesc.rid);
+        assert(record.getClassName() == "books");
+        assert(record.getVersion() == basicInfo.at("@version").toBigIntU());
+
+        record = txn.find("books").where(nogdb::Condition("pages").eq(320)).get()[0].record;
+        assert(record.getRecordId() == rdesc.rid);
+        record.unset("@className");
+        assert(record.getClassName().empty());
+        assert(record.getRecordId() == rdesc.rid);
+        assert(record.getBasicInfo().size() == 3);
+
+        // a copy keeps the basic info of a record
+        auto copied = txn.find("books").get()[0].record;
+        auto other = copied;
+        assert(other.getClassName() == "books");
+        assert(other.getRecordId() == rdesc.rid);
+        assert(other.getBasicInfo().size() == 4);
+        assert(copied.getBasicInfo().size() == 4);
+
+        auto view = txn.find("books").getView()[0].record.toRecord();
+        assert(view.getClassName() == "books");
+        assert(view.getRecordId() == rdesc.rid);
+        assert(view.getText("title") == "Lion King");
+
+        // the name shared by the records of a class is not changed by renaming the class
+        auto named = txn.find("books").get();
+        txn.renameClass("books", "novels");
+        assert(named[0].record.getClassName() == "books");
+        assert(txn.fetchRecord(rdesc).getClassName() == "novels");
+        assert(txn.find("novels").getView()[0].record.getClassName() == "novels");
+        txn.renameClass("novels", "books");
+        txn.commit();
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+    destroy_vertex_book();
+}
+
+void test_concurrent_record_reads()
+{
+    init_vertex_book();
+    try {
+        auto txn = ctx->beginTxn(nogdb::TxnMode::READ_WRITE);
+        auto rdesc = txn.addVertex("books", nogdb::Record {}.set("title", "Dune").set("pages", 412).set("price", 9.5));
+        txn.commit();
+
+        // the const accessors of one decoded record fill its maps once, whichever thread calls them first
+        for (auto round = 0; round < 20; ++round) {
+            txn = ctx->beginTxn(nogdb::TxnMode::READ_ONLY);
+            const auto record = txn.fetchRecord(rdesc);
+            txn.rollback();
+            std::atomic<unsigned int> failures { 0 };
+            auto readers = std::vector<std::thread> {};
+            for (auto i = 0; i < 4; ++i) {
+                readers.emplace_back([&, i] {
+                    for (auto j = 0; j < 50; ++j) {
+                        auto ok = ((i + j) % 2 == 0) ? record.getBasicInfo().size() == 4 : record.getClassName() == "books";
+                        ok = ok && record.getRecordId() == rdesc.rid;
+                        ok = ok && record.getAll().size() == 3;
+                        ok = ok && record.getText("@className") == "books";
+                        ok = ok && record.getText("title") == "Dune";
+                        auto copied = record;
+                        ok = ok && copied.getInt("pages") == 412 && copied.getBasicInfo().size() == 4;
+                        if (!ok) {
+                            ++failures;
+                        }
+                    }
+                });
+            }
+            for (auto& reader : readers) {
+                reader.join();
+            }
+            assert(failures == 0);
+        }
+    } catch (const nogdb::Error& ex) {
+        std::cout << "\nError: " << ex.what() << std::endl;
+        assert(false);
+    }
+    destroy_vertex_book();
+}
+
 void test_update_invalid_vertex()
 {
     init_vertex_book();